@@ -62,6 +62,7 @@ struct GraphicsPipelineDescriptor;
 struct ImageInitialization;
 struct MultiSamplingDescriptor;
 struct OpenGLDependentStateDescriptor;
+struct OpenGLRendererConfiguration;
 struct PipelineLayoutDescriptor;
 struct ProfileOpenGLDescriptor;
 struct QueryHeapDescriptor;
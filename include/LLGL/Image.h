@@ -108,11 +108,21 @@ class LLGL_EXPORT Image
         /**
         \brief Resizes the image and resamples the pixels from the previous image buffer.
         \param[in] extent Specifies the new image size.
-        \param[in] filter Specifies the sampling filter.
-        \brief GenerateImageBuffer
-        \todo Not implemented yet.
+        \param[in] filter Specifies the sampling filter. SamplerFilter::Nearest maps to ResampleFilter::Nearest and SamplerFilter::Linear maps to ResampleFilter::Linear.
+        \param[in] threadCount Specifies the number of threads to use for resampling (see ConvertImageBuffer for more details). By default 0.
+        \see Resize(const Extent3D&, const ResampleFilter, std::size_t)
+        */
+        void Resize(const Extent3D& extent, const SamplerFilter filter, std::size_t threadCount = 0);
+
+        /**
+        \brief Resizes the image and resamples the pixels from the previous image buffer with the specified filter.
+        \param[in] extent Specifies the new image size. If any of its components is zero, the image buffer is released.
+        \param[in] filter Specifies the resampling filter.
+        \param[in] threadCount Specifies the number of threads to use for resampling (see ConvertImageBuffer for more details). By default 0.
+        \throw std::invalid_argument If the image has a compressed format or the depth-stencil format.
+        \see ResizeImageBuffer
         */
-        void Resize(const Extent3D& extent, const SamplerFilter filter);
+        void Resize(const Extent3D& extent, const ResampleFilter filter, std::size_t threadCount = 0);
 
         //! Swaps all attributes with the specified image.
         void Swap(Image& rhs);
@@ -208,6 +218,27 @@ class LLGL_EXPORT Image
         */
         void MirrorXYPlane();
 
+        /* ----- MIP-maps ----- */
+
+        /**
+        \brief Generates a MIP-map chain with this image as base level.
+        \param[in] mipChainDesc Specifies the MIP-map chain descriptor. Its \c arrayLayers member is ignored, since the image is a single layer.
+        \param[in] threadCount Specifies the number of threads to use for filtering each MIP-map level (see ConvertImageBuffer for more details). By default 0.
+        \return The new allocated MIP-map chain buffer with the same format and data type as this image. This image is not modified.
+        \remarks Use GetMipChainOffset to determine the offset of each MIP-map level within the returned buffer.
+        \throw std::invalid_argument If the image is empty, has a compressed format or the depth-stencil format.
+        \see GenerateMipChainBuffer
+        */
+        ByteBuffer GenerateMipChain(const MipChainDescriptor& mipChainDesc, std::size_t threadCount = 0) const;
+
+        /**
+        \brief Returns the offset (in bytes) of the specified MIP-map level within a MIP-map chain buffer of this image.
+        \remarks If 'mipLevel' is equal to the number of MIP-map levels, the return value is the size of the entire MIP-map chain.
+        \see GenerateMipChain
+        \see MipChainOffset
+        */
+        std::size_t GetMipChainOffset(std::uint32_t mipLevel) const;
+
         /* ----- Attributes ----- */
 
         //! Returns a source image descriptor for this image with read-only access to the image data.
@@ -16,6 +16,7 @@
 #include "ColorRGBA.h"
 #include <memory>
 #include <cstdint>
+#include <functional>
 
 
 namespace LLGL
@@ -63,6 +64,21 @@ enum class ImageFormat
     CompressedRGBA, //!< Generic compressed format with four color components: Red, Green, Blue, Alpha.
 };
 
+/**
+\brief Image resampling filter enumeration.
+\see ResizeImageBuffer
+\see Image::Resize(const Extent3D&, const ResampleFilter, std::size_t)
+\see MipChainDescriptor::filter
+*/
+enum class ResampleFilter
+{
+    Nearest,    //!< Takes the nearest source pixel.
+    Box,        //!< Averages all source pixels by their coverage of the destination pixel. This is the area filter for minification.
+    Linear,     //!< Interpolates linearly between the source pixels, i.e. bilinear or trilinear filtering, widened when the image is minified.
+    Lanczos,    //!< Lanczos filter with three lobes. Produces the sharpest results, but may overshoot near hard edges.
+    Kaiser,     //!< Kaiser-windowed sinc filter with three lobes. Sharper than the box filter with less ringing than the Lanczos filter, which makes it well suited for MIP-map generation.
+};
+
 
 /* ----- Structures ----- */
 
@@ -136,6 +152,46 @@ struct DstImageDescriptor
     std::size_t dataSize    = 0;
 };
 
+/**
+\brief Callback interface for asynchronous texture read operations.
+\param[in] imageDesc Specifies the destination image descriptor that was passed to RenderSystem::ReadTextureAsync.
+When this callback is invoked, the image data has already been written to the destination image.
+\see RenderSystem::ReadTextureAsync
+\ingroup group_callbacks
+*/
+using ReadTextureCallback = std::function<void(const DstImageDescriptor& imageDesc)>;
+
+/**
+\brief Descriptor structure for the generation of a MIP-map chain on the CPU.
+\see GenerateMipChainBuffer
+\see Image::GenerateMipChain
+*/
+struct MipChainDescriptor
+{
+    //! Specifies the filter to downsample each MIP-map level from the previous one. By default ResampleFilter::Box.
+    ResampleFilter  filter      = ResampleFilter::Box;
+
+    /**
+    \brief Number of MIP-map levels, including the base level. By default 0.
+    \remarks If this is 0, the full MIP-map chain down to a single pixel is generated (see NumMipLevels).
+    */
+    std::uint32_t   mipLevels   = 0;
+
+    /**
+    \brief Number of array layers of the base level. By default 1.
+    \remarks The array layers of the base level are stored consecutively, and each layer is downsampled independently.
+    For cube textures, this must include the six faces of each cube (see TextureDescriptor::arrayLayers).
+    */
+    std::uint32_t   arrayLayers = 1;
+
+    /**
+    \brief Specifies whether the color components are sRGB encoded. By default false.
+    \remarks If this is true, the color components are converted to linear space before they are filtered and converted back to sRGB space afterwards,
+    so the average brightness of each MIP-map level is preserved. The alpha component is always filtered linearly.
+    */
+    bool            sRGB        = false;
+};
+
 
 /* ----- Functions ----- */
 
@@ -196,6 +252,7 @@ LLGL_EXPORT bool FindSuitableImageFormat(const Format format, ImageFormat& image
 \param[in] threadCount Specifies the number of threads to use for conversion.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+The threads are taken from a persistent thread pool that is shared by the entire library (see RenderSystemConfiguration::threadCount).
 \return True if any conversion was necessary. Otherwise, no conversion was necessary and the destination buffer is not modified!
 \note Compressed images and depth-stencil images cannot be converted.
 \throw std::invalid_argument If a compressed image format is specified either as source or destination.
@@ -222,6 +279,7 @@ LLGL_EXPORT bool ConvertImageBuffer(
 \param[in] threadCount Specifies the number of threads to use for conversion.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+The threads are taken from a persistent thread pool that is shared by the entire library (see RenderSystemConfiguration::threadCount).
 \return Byte buffer with the converted image data or null if no conversion is necessary.
 This can be casted to the respective target data type (e.g. <code>unsigned char</code>, <code>int</code>, <code>float</code> etc.).
 \note Compressed images and depth-stencil images cannot be converted.
@@ -241,6 +299,89 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     std::size_t                 threadCount = 0
 );
 
+/**
+\brief Resizes the source image into the destination image with a separable resampling filter.
+\param[in] srcImageDesc Specifies the source image descriptor.
+\param[in] srcExtent Specifies the extent of the source image.
+\param[out] dstImageDesc Specifies the destination image descriptor. This must have the same format and data type as the source image.
+\param[in] dstExtent Specifies the extent of the destination image.
+\param[in] filter Specifies the resampling filter.
+\param[in] threadCount Specifies the number of threads to use for resampling (see ConvertImageBuffer for more details). By default 0.
+\remarks The image is filtered separately along each axis whose size changes, so 1D, 2D, and 3D images are supported.
+All data types are filtered with 32-bit floating-point precision. Normalized integer components are clamped to their range after filtering.
+\throw std::invalid_argument If the source and destination images have a different format or data type.
+\throw std::invalid_argument If a compressed image format or the depth-stencil format is specified.
+\throw std::invalid_argument If the source or destination buffer size is too small for the respective extent.
+\throw std::invalid_argument If the source or destination buffer is a null pointer.
+\see ResampleFilter
+*/
+LLGL_EXPORT void ResizeImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    const ResampleFilter        filter,
+    std::size_t                 threadCount = 0
+);
+
+/**
+\brief Returns the offset (in bytes) of the specified MIP-map level within a MIP-map chain buffer.
+\param[in] format Specifies the image format.
+\param[in] dataType Specifies the image data type.
+\param[in] extent Specifies the extent of the base level.
+\param[in] arrayLayers Specifies the number of array layers of each MIP-map level.
+\param[in] mipLevel Specifies the MIP-map level. If this is equal to the number of MIP-map levels, the return value is the size of the entire MIP-map chain.
+\remarks A MIP-map chain buffer stores all MIP-map levels consecutively, beginning with the base level,
+and the array layers of each MIP-map level consecutively. The extent of each MIP-map level is half the extent of the previous one, but at least 1.
+\note Compressed formats are not supported.
+\see GenerateMipChainBuffer
+*/
+LLGL_EXPORT std::size_t MipChainOffset(
+    const ImageFormat   format,
+    const DataType      dataType,
+    const Extent3D&     extent,
+    std::uint32_t       arrayLayers,
+    std::uint32_t       mipLevel
+);
+
+/**
+\brief Generates a MIP-map chain from the specified base level on the CPU.
+\param[in] imageDesc Specifies the image descriptor of the base level.
+\param[in] extent Specifies the extent of the base level, excluding the number of array layers.
+\param[in] mipChainDesc Specifies the MIP-map chain descriptor.
+\param[in] threadCount Specifies the number of threads to use for filtering each MIP-map level (see ConvertImageBuffer for more details). By default 0.
+\return The new allocated MIP-map chain buffer with the same format and data type as the base level. Use MipChainOffset to determine the offset of each MIP-map level.
+\remarks Each MIP-map level is downsampled from the previous one, which is retained with floating-point precision between the levels.
+The returned buffer can be passed to RenderSystem::CreateTexture in a single call when the texture is created with MiscFlags::InitialMipChain.
+Usage example for a 2D texture:
+\code
+LLGL::MipChainDescriptor mipChainDesc;
+mipChainDesc.filter = LLGL::ResampleFilter::Kaiser;
+mipChainDesc.sRGB   = true;
+
+auto mipChain       = LLGL::GenerateMipChainBuffer(imageDesc, extent, mipChainDesc, LLGL::Constants::maxThreadCount);
+auto mipChainSize   = LLGL::MipChainOffset(imageDesc.format, imageDesc.dataType, extent, 1, LLGL::NumMipLevels(extent.width, extent.height));
+
+LLGL::TextureDescriptor textureDesc;
+textureDesc.format      = LLGL::Format::BGRA8sRGB;
+textureDesc.extent      = extent;
+textureDesc.miscFlags   = LLGL::MiscFlags::InitialMipChain;
+
+LLGL::SrcImageDescriptor mipChainImageDesc { imageDesc.format, imageDesc.dataType, mipChain.get(), mipChainSize };
+auto texture = renderer->CreateTexture(textureDesc, &mipChainImageDesc);
+\endcode
+\throw std::invalid_argument If a compressed image format or the depth-stencil format is specified, or the sRGB conversion is enabled for a depth format.
+\throw std::invalid_argument If the buffer size of the base level is too small for the specified extent and number of array layers.
+\see MipChainDescriptor
+\see MipChainOffset
+*/
+LLGL_EXPORT ByteBuffer GenerateMipChainBuffer(
+    const SrcImageDescriptor&   imageDesc,
+    const Extent3D&             extent,
+    const MipChainDescriptor&   mipChainDesc,
+    std::size_t                 threadCount = 0
+);
+
 /**
 \brief Generates an image buffer with the specified fill data for each pixel.
 \param[in] format Specifies the image format of each pixel in the output image.
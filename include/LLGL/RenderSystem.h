@@ -14,6 +14,7 @@
 #include "CommandQueue.h"
 #include "CommandBufferExt.h"
 #include "RenderSystemFlags.h"
+#include "ImageFlags.h"
 #include "RenderingProfiler.h"
 #include "RenderingDebugger.h"
 
@@ -80,6 +81,11 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         \param[in] renderSystemDesc Specifies the render system descriptor structure. The 'moduleName' member of this strucutre must not be empty.
         \param[in] profiler Optional pointer to a rendering profiler. This is only supported if LLGL was compiled with the \c LLGL_ENABLE_DEBUG_LAYER flag.
         If this is used, the counters of the profiler must be reset manually.
+        If LLGL was compiled with the \c LLGL_ENABLE_PROFILE_COUNTERS flag and no debugger is specified,
+        the renderer counts into thread-local storage that is merged into the profiler by RenderingProfiler::NextProfile, instead of using the debug layer.
+        In this case, only the counters of FrameProfile are recorded, but no timing scopes and no trace events.
+        Commands are counted when they are encoded rather than when they are submitted, i.e. a command buffer that is submitted multiple times counts its commands only once,
+        and they are added to the frame profile in which they have been encoded. The debug layer, in contrast, counts the commands of each submission.
         \param[in] debugger Optional pointer to a rendering debugger. This is only supported if LLGL was compiled with the \c LLGL_ENABLE_DEBUG_LAYER flag.
         If the default debugger is used (i.e. no sub class of RenderingDebugger), then all reports will be send to the Log.
         In order to see any reports from the Log, use either Log::SetReportCallback or Log::SetReportCallbackStd.
@@ -115,6 +121,14 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         static void Unload(std::unique_ptr<RenderSystem>&& renderSystem);
 
+        /**
+        \brief Releases the reference to the thread pool that is shared by all render systems.
+        \remarks The worker threads of that pool are joined when the last render system is destroyed.
+        Therefore, a render system must not be destroyed during static destruction, e.g. by a global \c std::unique_ptr inside a shared library.
+        \see RenderSystemConfiguration::threadCount
+        */
+        virtual ~RenderSystem();
+
         /**
         \brief Rendering API identification number.
         \remarks This can be a value of the RendererID entries.
@@ -168,6 +182,28 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
             return config_;
         }
 
+        /**
+        \brief Queries the memory statistics of all memory heaps this render system allocates resources from.
+        \param[out] heapStatistics Specifies the output list that receives one entry for each memory heap.
+        \return True if the renderer supports memory heap statistics. Otherwise, the output list is cleared and the return value is false.
+        \remarks This can be used to detect oversubscription of video memory before the device is lost,
+        e.g. by comparing MemoryHeapStatistics::reservedSize with MemoryHeapStatistics::budget.
+        \note Only supported with: Vulkan.
+        \see MemoryHeapStatistics
+        */
+        virtual bool QueryMemoryHeapStatistics(std::vector<MemoryHeapStatistics>& heapStatistics);
+
+        /**
+        \brief Queries the data of the pipeline cache, which contains all graphics and compute pipelines that have been created so far.
+        \param[out] data Specifies the output buffer that receives the pipeline cache data.
+        \return True if the renderer supports pipeline caches. Otherwise, the output buffer is cleared and the return value is false.
+        \remarks This data can be passed to the renderer configuration of the next render system (e.g. VulkanRendererConfiguration::pipelineCacheData)
+        to avoid that all pipelines are compiled from scratch at application startup.
+        For the OpenGL renderer, this is the data of the program binary cache, which must be enabled by OpenGLRendererConfiguration::programBinaryCache.
+        \note Only supported with: Vulkan, OpenGL.
+        */
+        virtual bool QueryPipelineCache(std::vector<char>& data);
+
         /* ----- Render Context ----- */
 
         /**
@@ -337,6 +373,29 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
         */
         virtual void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) = 0;
 
+        /**
+        \brief Reads the image data from a region of the specified texture without blocking the CPU until the GPU has finished the copy.
+        \param[in] texture Specifies the texture object to read from.
+        \param[in] textureRegion Specifies the texture region to read from, i.e. the MIP-map level, offset, and extent (see TextureRegion).
+        \param[out] imageDesc Specifies the destination image descriptor to write the texture data to.
+        The memory of \c imageDesc.data must remain valid until the callback has been invoked.
+        \param[in] callback Optional callback that is invoked after the image data has been written to the destination image. This can be null.
+        \remarks Renderers that do not support asynchronous reads (or partial reads of a MIP-map level) perform a synchronous read with the ReadTexture function,
+        and invoke the callback before this function returns. In this case, the texture region must cover the entire MIP-map level.
+        For the Vulkan renderer, the callback is invoked during a subsequent call to CommandQueue::Submit, CommandQueue::WaitFence,
+        or CommandQueue::WaitIdle after the GPU has finished the copy, or when another texture read operation is scheduled.
+        \throws std::invalid_argument If 'imageDesc.data' is null.
+        \throws std::runtime_error If the renderer only supports synchronous reads and the texture region does not cover the entire MIP-map level.
+        \see ReadTexture
+        \see ReadTextureCallback
+        */
+        virtual void ReadTextureAsync(
+            const Texture&              texture,
+            const TextureRegion&        textureRegion,
+            const DstImageDescriptor&   imageDesc,
+            const ReadTextureCallback&  callback
+        );
+
         /**
         \brief Generates all MIP-maps for the specified texture.
         \param[in,out] texture Specifies the texture whose MIP-maps are to be generated.
@@ -516,7 +575,8 @@ class LLGL_EXPORT RenderSystem : public NonCopyable
 
     protected:
 
-        RenderSystem() = default;
+        //! Adds a reference to the thread pool that is shared by all render systems.
+        RenderSystem();
 
         //! Sets the renderer information.
         void SetRendererInfo(const RendererInfo& info);
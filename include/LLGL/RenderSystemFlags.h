@@ -185,6 +185,8 @@ struct RenderSystemConfiguration
     \brief Specifies the number of threads that will be used internally by the render system. By default Constants::maxThreadCount.
     \remarks This is mainly used by the Direct3D render systems, e.g. inside the "CreateTexture" and "WriteTexture" functions
     to convert the image data into the respective hardware texture format. OpenGL does this automatically.
+    The threads are kept in a persistent thread pool that is shared by all render systems, so this also determines the size of that pool.
+    The pool is created with the first render system and its threads are joined when the last render system is destroyed.
     \see Constants::maxThreadCount
     */
     std::size_t         threadCount         = Constants::maxThreadCount;
@@ -211,6 +213,7 @@ struct RendererID
     static const int Direct3D12 = 0x00000008; //!< ID number for a Direct3D 12 renderer.
     static const int Vulkan     = 0x00000009; //!< ID number for a Vulkan renderer.
     static const int Metal      = 0x0000000a; //!< ID number for a Metal renderer.
+    static const int Null       = 0x0000000b; //!< ID number for the headless Null renderer (no GPU, window, or driver involved).
 
     static const int Reserved   = 0x000000ff; //!< Highest ID number for reserved future renderers. Value is 0x000000ff.
 };
@@ -231,6 +234,45 @@ struct RendererInfo
     std::string shadingLanguageName;
 };
 
+/**
+\brief Memory heap statistics structure.
+\note Only supported with: Vulkan.
+\see RenderSystem::QueryMemoryHeapStatistics
+*/
+struct MemoryHeapStatistics
+{
+    //! Size (in bytes) of the memory heap as reported by the device.
+    std::uint64_t   heapSize                = 0;
+
+    /**
+    \brief Memory budget (in bytes) of the memory heap.
+    \remarks Reserving more memory than this might result in heavy paging or even in a lost device.
+    For the Vulkan renderer, this is estimated as 80% of the heap size.
+    */
+    std::uint64_t   budget                  = 0;
+
+    //! Specifies whether the memory heap is local to the device, i.e. video memory.
+    bool            deviceLocal             = false;
+
+    //! Number of allocations within the memory heap, e.g. one for each buffer and texture.
+    std::uint32_t   numAllocations          = 0;
+
+    //! Number of allocations that occupy an entire native memory block on their own.
+    std::uint32_t   numDedicatedAllocations = 0;
+
+    //! Number of native memory blocks (e.g. VkDeviceMemory objects) within the memory heap.
+    std::uint32_t   numMemoryBlocks         = 0;
+
+    //! Number of bytes that are occupied by allocations.
+    std::uint64_t   usedSize                = 0;
+
+    //! Number of bytes that are reserved by native memory blocks, i.e. the used size plus the free space that is available for further allocations.
+    std::uint64_t   reservedSize            = 0;
+
+    //! Size (in bytes) of the largest free block that can be allocated without reserving further memory.
+    std::uint64_t   largestFreeBlockSize    = 0;
+};
+
 /**
 \brief Application descriptor structure.
 \note Only supported with: Vulkan.
@@ -269,17 +311,68 @@ struct VulkanRendererConfiguration
     \remarks Vulkan only allows a limited set of device memory objects (e.g. 4096 on a GPU with 8 GB of VRAM).
     This member specifies the minimum size used for hardware memory allocation of such a memory chunk.
     The Vulkan render system automatically manages sub-region allocation and defragmentation.
+    Allocations that are larger than half of this size, as well as color and depth-stencil attachments, get a dedicated memory chunk.
     */
     std::uint64_t               minDeviceMemoryAllocationSize   = 1024*1024;
 
     /**
     \brief Specifies whether fragmentation of the device memory blocks shall be kept low. By default false.
-    \remarks If this is true, each buffer and image allocation first tries to find a reusable device memory block
-    within a single VkDeviceMemory chunk (which might be potentially slower).
-    Whenever a VkDeviceMemory chunk is full, the memory manager tries to reduce fragmentation anyways.
+    \remarks If this is true, each buffer and image allocation is placed into the most densely used VkDeviceMemory chunk that can hold it
+    (which might be potentially slower), so that sparsely used chunks are more likely to become empty and be released.
+    Otherwise, the first chunk that can hold the allocation is used.
+    Within each chunk, released blocks are always merged with adjacent free blocks.
     */
     bool                        reduceDeviceMemoryFragmentation = false;
 
+    /**
+    \brief Size of the persistent staging ring buffer for buffer and texture uploads. By default 4*1024*1024, i.e. 4 MB of host visible memory.
+    \remarks Buffer and texture uploads are batched into a single transfer command buffer that is submitted without waiting for its completion.
+    The batch is submitted at the latest when the next command buffer or fence is submitted to the command queue.
+    Uploads that exceed half of this size are staged in dedicated buffers instead.
+    */
+    std::uint64_t               stagingRingBufferSize           = 4*1024*1024;
+
+    /**
+    \brief Maximal number of bytes that are relocated per command buffer submission to reduce device memory fragmentation. By default 0, i.e. defragmentation is disabled.
+    \remarks If this is non-zero, each call to CommandQueue::Submit for a command buffer incrementally moves buffers
+    into more densely used VkDeviceMemory chunks or to lower offsets within their chunks, so that free space is merged and empty chunks are released.
+    Only buffers that are exclusively bound as vertex or index buffers and that are not part of a buffer array are relocated.
+    Command buffers that have been encoded before a relocation still refer to the previous buffer, which is retained until none of them can be submitted anymore:
+    a command buffer without the CommandBufferFlags::MultiSubmit or CommandBufferFlags::DeferredSubmit flags once it has been submitted,
+    and any other command buffer once it has been encoded again or released. No further buffers are relocated while previous buffers are retained.
+    */
+    std::uint64_t               defragmentationBudget           = 0;
+
+    /**
+    \brief Optional pointer to the initial data of the pipeline cache. By default null.
+    \remarks This data is typically retrieved by RenderSystem::QueryPipelineCache in a previous run of the application.
+    It only needs to be valid until the render system has been created. If this is specified, \c pipelineCacheFilename is not read.
+    Data that has been generated for another device or driver version (validated by its vendor ID, device ID, and pipeline cache UUID) is discarded,
+    i.e. all pipelines are then created from scratch.
+    \see pipelineCacheDataSize
+    */
+    const void*                 pipelineCacheData               = nullptr;
+
+    //! Specifies the size (in bytes) of the initial pipeline cache data. By default 0.
+    std::size_t                 pipelineCacheDataSize           = 0;
+
+    /**
+    \brief Optional filename of the pipeline cache. By default empty.
+    \remarks If this is not empty, the initial pipeline cache data is read from this file (unless \c pipelineCacheData is specified),
+    and the pipeline cache is written back to this file when the render system is destroyed.
+    A missing or invalid file is not an error; the pipeline cache is then initially empty.
+    */
+    std::string                 pipelineCacheFilename;
+
+    /**
+    \brief Maximal number of frames that can be in flight, i.e. that are processed by the GPU while the CPU encodes the next frames. By default 2.
+    \remarks Each render context has its own set of semaphores and a fence for each frame in flight.
+    RenderContext::Present only blocks until the frame that was presented this number of frames ago has been completed.
+    Resources that are released while frames are still in flight are destroyed once all previously submitted commands have been completed.
+    A value of 1 serializes CPU and GPU work. A value of 0 is clamped to 1.
+    */
+    std::uint32_t               maxFramesInFlight               = 2;
+
     #if 0//TODO: integrate them into the Vulkan renderer
     /**
     \brief List of enabled Vulkan extensions.
@@ -295,6 +388,43 @@ struct VulkanRendererConfiguration
     #endif
 };
 
+/**
+\brief Structure for an OpenGL renderer specific configuration.
+\see VulkanRendererConfiguration
+*/
+struct OpenGLRendererConfiguration
+{
+    /**
+    \brief Specifies whether linked shader programs are stored in a program binary cache. By default false.
+    \remarks If this is true, each shader program is loaded from its program binary if the cache contains an entry for it.
+    The cache entries are keyed by a hash of the attached shader sources, the vertex formats, and the driver vendor, renderer, and version,
+    i.e. a driver update invalidates all entries. If the driver rejects a program binary, the shader program is linked from its shaders as usual.
+    Shader programs with stream-output attributes are never cached.
+    This requires the \c GL_ARB_get_program_binary extension, otherwise this member is ignored.
+    \see RenderSystem::QueryPipelineCache
+    */
+    bool                        programBinaryCache              = false;
+
+    /**
+    \brief Optional pointer to the initial data of the program binary cache. By default null.
+    \remarks This data is typically retrieved by RenderSystem::QueryPipelineCache in a previous run of the application.
+    It only needs to be valid until the render system has been created. If this is specified, \c programBinaryCacheFilename is not read.
+    \see programBinaryCacheDataSize
+    */
+    const void*                 programBinaryCacheData          = nullptr;
+
+    //! Specifies the size (in bytes) of the initial program binary cache data. By default 0.
+    std::size_t                 programBinaryCacheDataSize      = 0;
+
+    /**
+    \brief Optional filename of the program binary cache. By default empty.
+    \remarks If this is not empty, the initial program binary cache data is read from this file (unless \c programBinaryCacheData is specified),
+    and the program binary cache is written back to this file when the render system is destroyed.
+    A missing or invalid file is not an error; the program binary cache is then initially empty.
+    */
+    std::string                 programBinaryCacheFilename;
+};
+
 /**
 \brief Render system descriptor structure.
 \remarks This can be used for some refinements of a specific renderer, e.g. to configure the Vulkan device memory manager.
@@ -349,6 +479,7 @@ struct RenderSystemDescriptor
     \endcode
     \see rendererConfigSize
     \see VulkanRendererConfiguration
+    \see OpenGLRendererConfiguration
     */
     const void* rendererConfig      = nullptr;
 
@@ -14,6 +14,13 @@
 #include "GraphicsPipelineFlags.h"
 #include <cstdint>
 #include <algorithm>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <functional>
+#include <chrono>
 
 
 namespace LLGL
@@ -22,7 +29,7 @@ namespace LLGL
 
 /**
 \brief Profile of a rendered frame.
-\see RenderingProfiler::NextFrame
+\see RenderingProfiler::NextProfile
 */
 struct FrameProfile
 {
@@ -253,13 +260,204 @@ struct FrameProfile
             \see CommandQueue::Submit(Fence&)
             */
             std::uint32_t fenceSubmissions;
+
+            /**
+            \brief Counter for all redundant state commands that have been removed from command buffers during encoding.
+            \remarks This is only counted by the OpenGL backend for command buffers with the CommandBufferFlags::MultiSubmit flag,
+            if LLGL has been built with \c LLGL_GL_ENABLE_CMDBUFFER_OPTIMIZER.
+            Like all other counters, this is counted for each submission by the debug layer, but only once per encoding by the profile counters (see RenderSystem::Load).
+            \see CommandBuffer::End
+            */
+            std::uint32_t redundantStateEliminations;
         };
 
         //! All proflile values as linear array.
-        std::uint32_t values[32];
+        std::uint32_t values[33];
     };
 };
 
+/**
+\brief Timing record of a named scope within a frame.
+\remarks A scope is enclosed by a call to \c PushDebugGroup and \c PopDebugGroup on a command buffer.
+\see CommandBuffer::PushDebugGroup
+\see FrameTimings::scopes
+*/
+struct ProfileScope
+{
+    //! Name of the debug group this scope has been recorded for.
+    std::string     name;
+
+    //! Index of the parent scope within FrameTimings::scopes, or 0xFFFFFFFF if this is a top-level scope. By default 0xFFFFFFFF.
+    std::uint32_t   parent  = ~0u;
+
+    //! Nesting depth of this scope. Top-level scopes have a depth of zero. By default 0.
+    std::uint32_t   depth   = 0;
+
+    /**
+    \brief CPU time (in nanoseconds) that has been spent to encode the commands of this scope, including all nested scopes.
+    \remarks This is measured with a monotonic clock between the calls to \c PushDebugGroup and \c PopDebugGroup.
+    */
+    std::uint64_t   cpuTime = 0;
+
+    /**
+    \brief GPU time (in nanoseconds) that has been spent to execute the commands of this scope, including all nested scopes.
+    \remarks This is measured with queries of type QueryType::TimeElapsed.
+    */
+    std::uint64_t   gpuTime = 0;
+};
+
+/**
+\brief Hierarchical timing record of all scopes within a frame.
+\see RenderingProfiler::NextTimings
+*/
+struct FrameTimings
+{
+    //! Number of the frame these timings have been recorded in.
+    std::uint64_t               frame   = 0;
+
+    //! All scopes that have been submitted within the frame. Parent scopes always precede their nested scopes.
+    std::vector<ProfileScope>   scopes;
+};
+
+/**
+\brief Statistics of a profile value over all frames in the history of a rendering profiler.
+\remarks Percentiles are determined with the nearest-rank method.
+\see RenderingProfiler::QueryCounterStatistics
+\see RenderingProfiler::QueryScopeStatistics
+\see RenderingProfiler::QueryFrameTimeStatistics
+*/
+struct ProfileStatistics
+{
+    //! Number of frames the statistics have been computed from.
+    std::uint32_t   numSamples  = 0;
+
+    //! Minimum value.
+    double          min         = 0.0;
+
+    //! Maximum value.
+    double          max         = 0.0;
+
+    //! Arithmetic mean value.
+    double          mean        = 0.0;
+
+    //! Median value, i.e. the 50th percentile.
+    double          p50         = 0.0;
+
+    //! 95th percentile.
+    double          p95         = 0.0;
+
+    //! 99th percentile.
+    double          p99         = 0.0;
+};
+
+/**
+\brief Resource types the memory accounting of a rendering profiler distinguishes.
+\see MemoryAllocation::type
+\see MemorySnapshot::resourceTypes
+*/
+enum class MemoryResourceType
+{
+    //! Buffer resources. \see RenderSystem::CreateBuffer
+    Buffer = 0,
+
+    //! Texture resources, including all MIP-map levels and array layers. \see RenderSystem::CreateTexture
+    Texture,
+
+    /**
+    \brief Internal buffers of render targets. \see RenderSystem::CreateRenderTarget
+    \remarks This covers attachments without a texture, and multi-sampled color buffers when multi-sampling is enabled.
+    Textures that are attached to a render target are accounted as MemoryResourceType::Texture only.
+    */
+    RenderTarget,
+};
+
+/**
+\brief Memory usage of a class of resources.
+\see MemorySnapshot
+*/
+struct MemoryUsage
+{
+    //! Number of live resources.
+    std::uint64_t   numResources    = 0;
+
+    //! Size (in bytes) of all live resources.
+    std::uint64_t   liveSize        = 0;
+
+    //! Maximum size (in bytes) all live resources have occupied at the same time.
+    std::uint64_t   peakSize        = 0;
+};
+
+/**
+\brief Memory allocation of a single resource.
+\remarks The size is an estimate that is computed from the resource descriptor, i.e. it does not include alignment or padding of the backend.
+\see MemorySnapshot::allocations
+*/
+struct MemoryAllocation
+{
+    //! Unique number of this allocation. Allocations are numbered consecutively, starting with 1.
+    std::uint64_t       id          = 0;
+
+    //! Number of the frame this resource has been created in.
+    std::uint64_t       frame       = 0;
+
+    //! Resource type of this allocation.
+    MemoryResourceType  type        = MemoryResourceType::Buffer;
+
+    //! Binding flags of the resource. This can be a bitwise OR combination of the BindFlags entries.
+    long                bindFlags   = 0;
+
+    //! Size (in bytes) of this allocation.
+    std::uint64_t       size        = 0;
+
+    //! Memory tag that was active when the resource has been created. \see RenderingProfiler::SetMemoryTag
+    std::string         tag;
+};
+
+/**
+\brief Snapshot of the memory usage of all live resources at a point in time.
+\see RenderingProfiler::TakeMemorySnapshot
+\see RenderingProfiler::DiffMemorySnapshots
+*/
+struct MemorySnapshot
+{
+    //! Number of the frame the snapshot has been taken in.
+    std::uint64_t                           frame   = 0;
+
+    //! Memory usage of all resources.
+    MemoryUsage                             total;
+
+    //! Memory usage per resource type. This array is indexed by the MemoryResourceType entries.
+    MemoryUsage                             resourceTypes[3];
+
+    /**
+    \brief Memory usage per binding flag, e.g. <code>bindFlags[BindFlags::VertexBuffer]</code>.
+    \remarks Each resource is accounted for each of its binding flags. Resources without binding flags are accounted with the key 0.
+    */
+    std::map<long, MemoryUsage>             bindFlags;
+
+    //! Memory usage per memory tag. Resources that have been created without a tag are accounted with the empty string.
+    std::map<std::string, MemoryUsage>      tags;
+
+    //! All live allocations, sorted by their ID. This is empty if the snapshot has been taken without allocations.
+    std::vector<MemoryAllocation>           allocations;
+};
+
+/**
+\brief Difference between two memory snapshots.
+\see RenderingProfiler::DiffMemorySnapshots
+*/
+struct MemorySnapshotDiff
+{
+    //! Difference of the size (in bytes) of all live resources, i.e. the second snapshot minus the first snapshot.
+    std::int64_t                    sizeDelta   = 0;
+
+    //! Allocations that are live in the second snapshot but not in the first one. These are the candidates for leaks.
+    std::vector<MemoryAllocation>   allocated;
+
+    //! Allocations that are live in the first snapshot but not in the second one.
+    std::vector<MemoryAllocation>   released;
+};
+
 /**
 \brief Rendering profiler model class.
 \remarks This can be used to profile the renderer draw calls and buffer updates.
@@ -270,12 +468,42 @@ class LLGL_EXPORT RenderingProfiler
 
     public:
 
+        /**
+        \brief Callback interface for frames that exceed the frame budget.
+        \param[in] frame Specifies the number of the frame.
+        \param[in] frameTime Specifies the time (in nanoseconds) of the frame.
+        \param[in] profile Specifies the counters of the frame.
+        \see SetFrameBudget
+        */
+        using FrameBudgetCallback = std::function<void(std::uint64_t frame, std::uint64_t frameTime, const FrameProfile& profile)>;
+
+    public:
+
+        RenderingProfiler();
+        ~RenderingProfiler();
+
+        RenderingProfiler(const RenderingProfiler&) = delete;
+        RenderingProfiler& operator = (const RenderingProfiler&) = delete;
+
         /**
         \brief Returns the current frame profile and resets the counters for the next frame.
         \param[out] outputProfile Optional pointer to an output profile to retrieve the current values. By default null.
+        \remarks This also ends the current frame for the timing scopes, and stores the frame in the history.
+        The frame time is measured between two calls to this function.
+        \see GetCurrentFrame
+        \see SetHistorySize
         */
         void NextProfile(FrameProfile* outputProfile = nullptr);
 
+        /**
+        \brief Retrieves the timings of the oldest frame whose GPU times have been resolved.
+        \param[out] outputTimings Specifies the output timings.
+        \return True if there were resolved frame timings, otherwise the output timings remain unchanged.
+        \remarks GPU times are resolved asynchronously, i.e. the timings of a frame are usually available a few frames after the frame has ended.
+        \see ProfileScope
+        */
+        bool NextTimings(FrameTimings& outputTimings);
+
         /**
         \brief Accumulates the specified profile with the current values.
         \param[in] profile Specifies the input profile whose values are to be merged with the current values.
@@ -283,8 +511,213 @@ class LLGL_EXPORT RenderingProfiler
         */
         void Accumulate(const FrameProfile& profile);
 
+        /**
+        \brief Posts the specified frame timings once they have been resolved.
+        \remarks This is called by the debug layer. If more than \c maxFrameTimings frames are pending, the oldest timings are discarded.
+        \see NextTimings
+        */
+        void PostTimings(FrameTimings&& timings);
+
+        //! Returns the number of the current frame, which is incremented by each call to NextProfile.
+        inline std::uint64_t GetCurrentFrame() const
+        {
+            return currentFrame_;
+        }
+
+        /**
+        \brief Starts streaming trace events into the specified file in the Chrome trace event format (JSON).
+        \param[in] filename Specifies the output filename. The file can be loaded into standard trace viewers such as "chrome://tracing" or Perfetto.
+        \param[in] maxBufferSize Specifies the maximum size (in bytes) of trace events that are buffered before they are written to the file. By default 65536.
+        \remarks The debug layer records command buffer encodings, queue submissions, fence waits, resource creations, and buffer and texture writes.
+        If a trace is already in progress, it is stopped first.
+        This must not be called while other threads record trace events.
+        \throws std::runtime_error If the file could not be opened.
+        \see StopTrace
+        */
+        void StartTrace(const std::string& filename, std::size_t maxBufferSize = 65536);
+
+        /**
+        \brief Stops the current trace and closes the trace file.
+        \remarks This is also called when the profiler is destroyed.
+        \see StartTrace
+        */
+        void StopTrace();
+
+        //! Returns true if a trace is in progress.
+        inline bool IsTracing() const
+        {
+            return (traceSink_ != nullptr);
+        }
+
+        //! Returns the time (in nanoseconds) since the current trace has been started, or zero if no trace is in progress.
+        std::uint64_t GetTraceTime() const;
+
+        /**
+        \brief Records a trace event for the calling thread, if a trace is in progress.
+        \param[in] category Specifies the event category, e.g. "Resource".
+        \param[in] name Specifies the event name, e.g. "CreateBuffer".
+        \param[in] startTime Specifies the start time (in nanoseconds) of the event. This should be retrieved with GetTraceTime.
+        \param[in] duration Specifies the duration (in nanoseconds) of the event.
+        \param[in] size Specifies an optional size (in bytes) of the event. If this is zero, the size is omitted. By default 0.
+        \remarks This is called by the debug layer and is thread-safe.
+        */
+        void TraceEvent(const char* category, const char* name, std::uint64_t startTime, std::uint64_t duration, std::uint64_t size = 0);
+
+        /**
+        \brief Allocates a ring buffer for the history of the last frames, and clears all previous frames.
+        \param[in] numFrames Specifies the number of frames the history keeps. If this is zero, the history is disabled. By default the history is disabled.
+        \param[in] maxScopes Specifies the maximum number of distinct scope names that are kept in the history. This is clamped to 64. By default 32.
+        \remarks After this call, recording frames into the history does not allocate any memory,
+        except for the first occurrence of each scope name.
+        \see QueryCounterStatistics
+        \see QueryScopeStatistics
+        \see QueryFrameTimeStatistics
+        */
+        void SetHistorySize(std::size_t numFrames, std::size_t maxScopes = 32);
+
+        //! Returns the number of frames the history keeps.
+        inline std::size_t GetHistorySize() const
+        {
+            return history_.size();
+        }
+
+        /**
+        \brief Sets the budget for the frame time.
+        \param[in] frameTime Specifies the frame time (in nanoseconds). If this is zero, the budget is disabled.
+        \param[in] callback Specifies the callback that is invoked by NextProfile for each frame that exceeds the budget.
+        */
+        void SetFrameBudget(std::uint64_t frameTime, const FrameBudgetCallback& callback);
+
+        /**
+        \brief Computes the statistics of a counter over all frames in the history.
+        \param[in] index Specifies the index of the counter within FrameProfile::values, e.g. <code>offsetof(FrameProfile, drawCommands) / sizeof(std::uint32_t)</code>.
+        \param[out] statistics Specifies the output statistics.
+        \return True if the history contains at least one frame and the index is valid.
+        */
+        bool QueryCounterStatistics(std::size_t index, ProfileStatistics& statistics) const;
+
+        /**
+        \brief Computes the statistics of the time (in nanoseconds) of a named scope over all frames in the history that contain this scope.
+        \param[in] name Specifies the name of the scope. The times of all scopes with this name are summed up per frame.
+        \param[in] gpuTime Specifies whether to compute the statistics of the GPU time or the CPU time.
+        \param[out] statistics Specifies the output statistics.
+        \return True if the history contains at least one frame with the specified scope.
+        \remarks Only frames whose timings have already been resolved are considered.
+        \see ProfileScope
+        */
+        bool QueryScopeStatistics(const std::string& name, bool gpuTime, ProfileStatistics& statistics) const;
+
+        /**
+        \brief Computes the statistics of the frame time (in nanoseconds) over all frames in the history.
+        \param[out] statistics Specifies the output statistics.
+        \return True if the history contains at least one frame.
+        */
+        bool QueryFrameTimeStatistics(ProfileStatistics& statistics) const;
+
+        /**
+        \brief Sets the memory tag for all resources that are created afterwards, e.g. "Shadows" or "Terrain".
+        \param[in] tag Specifies the new memory tag. An empty string clears the tag.
+        \remarks Memory is only accounted by the debug layer, i.e. the profiler must be passed to RenderSystem::Load together with a debugger.
+        \see MemoryAllocation::tag
+        */
+        void SetMemoryTag(const std::string& tag);
+
+        //! Returns the current memory tag.
+        inline const std::string& GetMemoryTag() const
+        {
+            return memoryTag_;
+        }
+
+        /**
+        \brief Accounts a new resource allocation with the current memory tag.
+        \param[in] type Specifies the resource type.
+        \param[in] bindFlags Specifies the binding flags of the resource.
+        \param[in] size Specifies the size (in bytes) of the resource.
+        \return Unique ID of the new allocation, which must be passed to TrackRelease when the resource is released.
+        \remarks This is called by the debug layer.
+        */
+        std::uint64_t TrackAllocation(const MemoryResourceType type, long bindFlags, std::uint64_t size);
+
+        /**
+        \brief Removes the specified allocation from the memory accounting.
+        \param[in] id Specifies the ID of the allocation, that was returned by TrackAllocation. If this is zero, the function call has no effect.
+        \remarks This is called by the debug layer.
+        */
+        void TrackRelease(std::uint64_t id);
+
+        /**
+        \brief Takes a snapshot of the current memory usage.
+        \param[out] snapshot Specifies the output snapshot.
+        \param[in] withAllocations Specifies whether to copy all live allocations into the snapshot. This is required for DiffMemorySnapshots. By default true.
+        */
+        void TakeMemorySnapshot(MemorySnapshot& snapshot, bool withAllocations = true) const;
+
+        /**
+        \brief Determines the difference between two memory snapshots, e.g. to find leaked resources between two points in time.
+        \param[in] first Specifies the earlier snapshot.
+        \param[in] second Specifies the later snapshot.
+        \param[out] diff Specifies the output difference.
+        \remarks Allocations are matched by their ID, so a resource whose memory has been reused by another resource is still reported.
+        */
+        static void DiffMemorySnapshots(const MemorySnapshot& first, const MemorySnapshot& second, MemorySnapshotDiff& diff);
+
         //! Current frame profile with all counter values.
-        FrameProfile frameProfile;
+        FrameProfile    frameProfile;
+
+        //! Maximum number of resolved frame timings that are kept until they are retrieved with NextTimings. By default 16.
+        std::size_t     maxFrameTimings = 16;
+
+    private:
+
+        struct TraceSink;
+
+        // Frame in the history; scope times are stored separately in 'historyScopeTimes_'.
+        struct HistoryFrame
+        {
+            std::uint64_t   frame       = 0;
+            std::uint64_t   frameTime   = 0;
+            std::uint64_t   scopeMask   = 0;
+            bool            valid       = false;
+            bool            resolved    = false;
+            FrameProfile    profile;
+        };
+
+    private:
+
+        void RecordHistoryFrame(std::uint64_t frameTime);
+        void RecordHistoryTimings(const FrameTimings& timings);
+
+        std::size_t FindHistoryScope(const std::string& name) const;
+
+        bool ComputeStatistics(std::size_t numSamples, ProfileStatistics& statistics) const;
+
+        void AddMemoryUsage(const MemoryAllocation& allocation);
+        void SubtractMemoryUsage(const MemoryAllocation& allocation);
+
+    private:
+
+        std::uint64_t                               currentFrame_       = 0;
+        std::deque<FrameTimings>                    frameTimings_;
+
+        std::unique_ptr<TraceSink>                  traceSink_;
+
+        std::chrono::steady_clock::time_point       frameStartTime_;
+        std::uint64_t                               frameBudget_        = 0;
+        FrameBudgetCallback                         frameBudgetCallback_;
+
+        std::vector<HistoryFrame>                   history_;
+        std::size_t                                 historyMaxScopes_   = 0;
+        std::vector<std::string>                    historyScopeNames_;
+        std::vector<std::uint64_t>                  historyScopeTimes_;
+        mutable std::vector<double>                 historySamples_;
+
+        std::string                                 memoryTag_;
+        std::uint64_t                               memoryNextID_       = 1;
+        std::map<std::uint64_t, MemoryAllocation>   memoryAllocations_;
+        MemoryUsage                                 memoryTotal_;
+        MemoryUsage                                 memoryTypes_[3];
+        std::map<long, MemoryUsage>                 memoryBindFlags_;
+        std::map<std::string, MemoryUsage>          memoryTags_;
 
 };
 
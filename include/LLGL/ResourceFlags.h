@@ -184,6 +184,17 @@ struct MiscFlags
         \remarks This can only be used with multi-sampled Texture resources (i.e. TextureType::Texture2DMS, TextureType::Texture2DMSArray).
         */
         FixedSamples = (1 << 1),
+
+        /**
+        \brief The initial image data of a Texture resource contains all MIP-map levels.
+        \remarks The MIP-map levels must be stored consecutively, beginning with the base level, and the array layers of each MIP-map level consecutively.
+        This is the layout of the buffers generated by GenerateMipChainBuffer and Image::GenerateMipChain.
+        Without this flag, only the base level is initialized with the initial image data. Compressed formats are not supported.
+        \note Only supported with: OpenGL, Vulkan, Direct3D 11.
+        \see RenderSystem::CreateTexture
+        \see MipChainOffset
+        */
+        InitialMipChain = (1 << 2),
     };
 };
 
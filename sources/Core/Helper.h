@@ -140,6 +140,23 @@ void RemoveFromUniqueSet(std::set<std::unique_ptr<T>>& cont, const TBase* entry)
     }
 }
 
+// Removes the specified entry from the set and returns its ownership, or null if the set does not contain the entry.
+template <typename T, typename TBase>
+std::unique_ptr<T> ExtractFromUniqueSet(std::set<std::unique_ptr<T>>& cont, const TBase* entry)
+{
+    for (auto it = cont.begin(); it != cont.end(); ++it)
+    {
+        if (it->get() == entry)
+        {
+            /* Release ownership before the entry is erased (elements of std::set cannot be moved in C++11) */
+            std::unique_ptr<T> object { const_cast<std::unique_ptr<T>&>(*it).release() };
+            cont.erase(it);
+            return object;
+        }
+    }
+    return nullptr;
+}
+
 template <typename BaseType, typename SubType>
 SubType* TakeOwnership(std::set<std::unique_ptr<BaseType>>& objectSet, std::unique_ptr<SubType>&& object)
 {
@@ -206,9 +206,39 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
     }
 }
 
-void Image::Resize(const Extent3D& extent, const SamplerFilter filter)
+void Image::Resize(const Extent3D& extent, const SamplerFilter filter, std::size_t threadCount)
 {
-    //todo
+    Resize(extent, (filter == SamplerFilter::Nearest ? ResampleFilter::Nearest : ResampleFilter::Linear), threadCount);
+}
+
+void Image::Resize(const Extent3D& extent, const ResampleFilter filter, std::size_t threadCount)
+{
+    if (extent != GetExtent())
+    {
+        if (data_ && GetNumPixels() > 0 && extent.width > 0 && extent.height > 0 && extent.depth > 0)
+        {
+            /* Resample previous image buffer into new image buffer */
+            const auto dataSize = ImageDataSize(GetFormat(), GetDataType(), extent.width * extent.height * extent.depth);
+            auto data = GenerateEmptyByteBuffer(dataSize, false);
+
+            ResizeImageBuffer(
+                QuerySrcDesc(),
+                GetExtent(),
+                DstImageDescriptor{ GetFormat(), GetDataType(), data.get(), dataSize },
+                extent,
+                filter,
+                threadCount
+            );
+
+            extent_ = extent;
+            data_   = std::move(data);
+        }
+        else
+        {
+            /* Allocate new image buffer or release it if the extent is zero */
+            Resize(extent);
+        }
+    }
 }
 
 void Image::Swap(Image& rhs)
@@ -487,6 +517,22 @@ void Image::MirrorXYPlane()
     //TODO
 }
 
+
+/* ----- MIP-maps ----- */
+
+ByteBuffer Image::GenerateMipChain(const MipChainDescriptor& mipChainDesc, std::size_t threadCount) const
+{
+    MipChainDescriptor layerMipChainDesc = mipChainDesc;
+    layerMipChainDesc.arrayLayers = 1;
+    return GenerateMipChainBuffer(QuerySrcDesc(), GetExtent(), layerMipChainDesc, threadCount);
+}
+
+std::size_t Image::GetMipChainOffset(std::uint32_t mipLevel) const
+{
+    return MipChainOffset(GetFormat(), GetDataType(), GetExtent(), 1, mipLevel);
+}
+
+
 /* ----- Attributes ----- */
 
 SrcImageDescriptor Image::QuerySrcDesc() const
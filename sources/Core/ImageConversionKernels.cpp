@@ -0,0 +1,916 @@
+/*
+ * ImageConversionKernels.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageConversionKernels.h"
+#include "Float16Compressor.h"
+#include "SIMDMacros.h"
+#include <cstdint>
+
+#if defined LLGL_SIMD_X86 && !defined _MSC_VER
+#   include <cpuid.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+Each kernel has a scalar variant with the same scalar expressions as the generic conversion in "ImageFlags.cpp",
+and a variant for each supported instruction set, which converts as many elements as possible and leaves the remaining elements to the scalar variant.
+The x86 variants are compiled for their instruction set with LLGL_SIMD_TARGET and selected at runtime.
+*/
+
+#ifdef LLGL_SIMD_X86
+#   define LLGL_KERNEL_X86(NAME) NAME
+#else
+#   define LLGL_KERNEL_X86(NAME) nullptr
+#endif
+
+#ifdef LLGL_SIMD_NEON
+#   define LLGL_KERNEL_NEON(NAME) NAME
+#else
+#   define LLGL_KERNEL_NEON(NAME) nullptr
+#endif
+
+
+/* ----- CPU feature detection ----- */
+
+#ifdef LLGL_SIMD_X86
+
+static void QueryCPUID(int leaf, int subLeaf, unsigned (&regs)[4])
+{
+    #ifdef _MSC_VER
+    int info[4] = {};
+    __cpuidex(info, leaf, subLeaf);
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<unsigned>(info[i]);
+    #else
+    __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+}
+
+// Returns the extended control register XCR0, which specifies the register states the OS preserves on context switches.
+static std::uint64_t QueryXCR0()
+{
+    #ifdef _MSC_VER
+    return _xgetbv(0);
+    #else
+    unsigned eax = 0, edx = 0;
+    __asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((static_cast<std::uint64_t>(edx) << 32) | eax);
+    #endif
+}
+
+static long DetectX86Features()
+{
+    long features = 0;
+
+    unsigned regs[4] = {};
+    QueryCPUID(0, 0, regs);
+    const auto maxLeaf = regs[0];
+
+    if (maxLeaf < 1)
+        return features;
+
+    QueryCPUID(1, 0, regs);
+    if ((regs[3] & (1u << 26)) != 0)
+        features |= SIMDFeatures::SSE2;
+    if ((regs[2] & (1u << 9)) != 0)
+        features |= SIMDFeatures::SSSE3;
+
+    /* AVX2 and F16C instructions require the OS to preserve the YMM registers */
+    const bool hasOSXSAVE   = ((regs[2] & (1u << 27)) != 0);
+    const bool hasAVX       = ((regs[2] & (1u << 28)) != 0);
+    const bool hasF16C      = ((regs[2] & (1u << 29)) != 0);
+
+    if (hasOSXSAVE && hasAVX && (QueryXCR0() & 0x6) == 0x6)
+    {
+        if (hasF16C)
+            features |= SIMDFeatures::F16C;
+        if (maxLeaf >= 7)
+        {
+            QueryCPUID(7, 0, regs);
+            if ((regs[1] & (1u << 5)) != 0)
+                features |= SIMDFeatures::AVX2;
+        }
+    }
+
+    return features;
+}
+
+#endif // /LLGL_SIMD_X86
+
+LLGL_EXPORT long GetSIMDFeatures()
+{
+    #if defined LLGL_SIMD_X86
+    static const long features = DetectX86Features();
+    return features;
+    #elif defined LLGL_SIMD_NEON
+    return SIMDFeatures::NEON;
+    #else
+    return 0;
+    #endif
+}
+
+
+/* ----- Data type conversion kernels ----- */
+
+static void ConvertUInt8ToFloat32(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+        dst[i] = static_cast<float>(static_cast<double>(src[i]) / 255.0);
+}
+
+#ifdef LLGL_SIMD_X86
+
+LLGL_SIMD_TARGET("sse2")
+static void ConvertUInt8ToFloat32SSE2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto zero  = _mm_setzero_si128();
+    const auto scale = _mm_set1_ps(255.0f);
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v8     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        auto v16Lo  = _mm_unpacklo_epi8(v8, zero);
+        auto v16Hi  = _mm_unpackhi_epi8(v8, zero);
+        _mm_storeu_ps(dst + i     , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v16Lo, zero)), scale));
+        _mm_storeu_ps(dst + i +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v16Lo, zero)), scale));
+        _mm_storeu_ps(dst + i +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v16Hi, zero)), scale));
+        _mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v16Hi, zero)), scale));
+    }
+
+    ConvertUInt8ToFloat32(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET("avx2")
+static void ConvertUInt8ToFloat32AVX2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto scale = _mm256_set1_ps(255.0f);
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v32 = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_div_ps(_mm256_cvtepi32_ps(v32), scale));
+    }
+
+    ConvertUInt8ToFloat32(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_X86
+
+#ifdef LLGL_SIMD_NEON
+
+static void ConvertUInt8ToFloat32NEON(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto scale = vdupq_n_f32(255.0f);
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v8     = vld1q_u8(src + i);
+        auto v16Lo  = vmovl_u8(vget_low_u8(v8));
+        auto v16Hi  = vmovl_u8(vget_high_u8(v8));
+        vst1q_f32(dst + i     , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16Lo))), scale));
+        vst1q_f32(dst + i +  4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16Lo))), scale));
+        vst1q_f32(dst + i +  8, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16Hi))), scale));
+        vst1q_f32(dst + i + 12, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16Hi))), scale));
+    }
+
+    ConvertUInt8ToFloat32(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+static void ConvertFloat32ToUInt8(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+        dst[i] = static_cast<std::uint8_t>(static_cast<double>(src[i]) * 255.0);
+}
+
+#ifdef LLGL_SIMD_X86
+
+// Converts 4 floats from the range [0, 1] to 32-bit integers in the range [0, 255]. The multiplication is done in double precision to match the generic conversion.
+LLGL_SIMD_TARGET("sse2")
+static inline __m128i ConvertFloat32x4ToUNorm8x4SSE2(const float* src)
+{
+    const auto scale = _mm_set1_pd(255.0);
+    auto v   = _mm_loadu_ps(src);
+    auto vLo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(v), scale));
+    auto vHi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), scale));
+    return _mm_unpacklo_epi64(vLo, vHi);
+}
+
+LLGL_SIMD_TARGET("avx2")
+static inline __m128i ConvertFloat32x4ToUNorm8x4AVX2(const float* src)
+{
+    return _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(src)), _mm256_set1_pd(255.0)));
+}
+
+LLGL_SIMD_TARGET("sse2")
+static void ConvertFloat32ToUInt8SSE2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v16Lo = _mm_packs_epi32(ConvertFloat32x4ToUNorm8x4SSE2(src + i     ), ConvertFloat32x4ToUNorm8x4SSE2(src + i +  4));
+        auto v16Hi = _mm_packs_epi32(ConvertFloat32x4ToUNorm8x4SSE2(src + i +  8), ConvertFloat32x4ToUNorm8x4SSE2(src + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(v16Lo, v16Hi));
+    }
+
+    ConvertFloat32ToUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET("avx2")
+static void ConvertFloat32ToUInt8AVX2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v16Lo = _mm_packs_epi32(ConvertFloat32x4ToUNorm8x4AVX2(src + i     ), ConvertFloat32x4ToUNorm8x4AVX2(src + i +  4));
+        auto v16Hi = _mm_packs_epi32(ConvertFloat32x4ToUNorm8x4AVX2(src + i +  8), ConvertFloat32x4ToUNorm8x4AVX2(src + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(v16Lo, v16Hi));
+    }
+
+    ConvertFloat32ToUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_X86
+
+#ifdef LLGL_SIMD_NEON
+
+// Converts 4 floats from the range [0, 1] to 16-bit integers in the range [0, 255]. The multiplication is done in double precision to match the generic conversion.
+static inline uint16x4_t ConvertFloat32x4ToUNorm8x4NEON(const float* src)
+{
+    const auto scale = vdupq_n_f64(255.0);
+    auto v   = vld1q_f32(src);
+    auto vLo = vcvtq_s64_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(v)), scale));
+    auto vHi = vcvtq_s64_f64(vmulq_f64(vcvt_high_f64_f32(v), scale));
+    return vqmovun_s32(vcombine_s32(vqmovn_s64(vLo), vqmovn_s64(vHi)));
+}
+
+static void ConvertFloat32ToUInt8NEON(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v16Lo = vcombine_u16(ConvertFloat32x4ToUNorm8x4NEON(src + i     ), ConvertFloat32x4ToUNorm8x4NEON(src + i +  4));
+        auto v16Hi = vcombine_u16(ConvertFloat32x4ToUNorm8x4NEON(src + i +  8), ConvertFloat32x4ToUNorm8x4NEON(src + i + 12));
+        vst1q_u8(dst + i, vcombine_u8(vqmovn_u16(v16Lo), vqmovn_u16(v16Hi)));
+    }
+
+    ConvertFloat32ToUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+static void ConvertFloat32ToFloat16(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint16_t*>(dstBuffer);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+        dst[i] = CompressFloat16(src[i]);
+}
+
+static void ConvertFloat16ToFloat32(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint16_t*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+        dst[i] = DecompressFloat16(src[i]);
+}
+
+#ifdef LLGL_SIMD_X86
+
+/*
+The SSE2 variants of the half-float conversions are branchless ports of 'CompressFloat16' and 'DecompressFloat16' (see "Float16Compressor.cpp"),
+and use the same constants. Each select operation 'a ^ ((b ^ a) & mask)' replaces 'a' with 'b' where the mask is set.
+*/
+
+LLGL_SIMD_TARGET("sse2")
+static inline __m128i SelectInt32x4SSE2(__m128i a, __m128i b, __m128i mask)
+{
+    return _mm_xor_si128(a, _mm_and_si128(_mm_xor_si128(b, a), mask));
+}
+
+// Compresses 4 floats into 4 half-floats in the lower 16 bits of each 32-bit integer.
+LLGL_SIMD_TARGET("sse2")
+static inline __m128i CompressFloat16x4SSE2(__m128 value)
+{
+    const auto signN    = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const auto infN     = _mm_set1_epi32(0x7F800000);
+    const auto maxN     = _mm_set1_epi32(0x477FE000);
+    const auto minN     = _mm_set1_epi32(0x38800000);
+    const auto nanN     = _mm_set1_epi32(0x7F802000);
+    const auto mulN     = _mm_castsi128_ps(_mm_set1_epi32(0x52000000));
+    const auto maxC     = _mm_set1_epi32(0x00023BFF);
+    const auto subC     = _mm_set1_epi32(0x000003FF);
+    const auto maxD     = _mm_set1_epi32(0x0001C000);
+    const auto minD     = _mm_set1_epi32(0x0001C000);
+
+    auto v      = _mm_castps_si128(value);
+    auto sign   = _mm_and_si128(v, signN);
+    v           = _mm_xor_si128(v, sign);
+    sign        = _mm_srli_epi32(sign, 16);
+
+    /* Correct subnormals */
+    auto s      = _mm_cvttps_epi32(_mm_mul_ps(mulN, _mm_castsi128_ps(v)));
+    v           = SelectInt32x4SSE2(v, s, _mm_cmpgt_epi32(minN, v));
+    v           = SelectInt32x4SSE2(v, infN, _mm_and_si128(_mm_cmpgt_epi32(infN, v), _mm_cmpgt_epi32(v, maxN)));
+    v           = SelectInt32x4SSE2(v, nanN, _mm_and_si128(_mm_cmpgt_epi32(nanN, v), _mm_cmpgt_epi32(v, infN)));
+    v           = _mm_srli_epi32(v, 13);
+    v           = SelectInt32x4SSE2(v, _mm_sub_epi32(v, maxD), _mm_cmpgt_epi32(v, maxC));
+    v           = SelectInt32x4SSE2(v, _mm_sub_epi32(v, minD), _mm_cmpgt_epi32(v, subC));
+
+    return _mm_or_si128(v, sign);
+}
+
+// Decompresses 4 half-floats in the lower 16 bits of each 32-bit integer into 4 floats.
+LLGL_SIMD_TARGET("sse2")
+static inline __m128 DecompressFloat16x4SSE2(__m128i value)
+{
+    const auto signC    = _mm_set1_epi32(0x00008000);
+    const auto mulC     = _mm_castsi128_ps(_mm_set1_epi32(0x33800000));
+    const auto maxC     = _mm_set1_epi32(0x00023BFF);
+    const auto subC     = _mm_set1_epi32(0x000003FF);
+    const auto norC     = _mm_set1_epi32(0x00000400);
+    const auto maxD     = _mm_set1_epi32(0x0001C000);
+    const auto minD     = _mm_set1_epi32(0x0001C000);
+
+    auto v      = value;
+    auto sign   = _mm_and_si128(v, signC);
+    v           = _mm_xor_si128(v, sign);
+    sign        = _mm_slli_epi32(sign, 16);
+    v           = SelectInt32x4SSE2(v, _mm_add_epi32(v, minD), _mm_cmpgt_epi32(v, subC));
+    v           = SelectInt32x4SSE2(v, _mm_add_epi32(v, maxD), _mm_cmpgt_epi32(v, maxC));
+
+    auto s      = _mm_castps_si128(_mm_mul_ps(mulC, _mm_cvtepi32_ps(v)));
+    auto mask   = _mm_cmpgt_epi32(norC, v);
+    v           = _mm_slli_epi32(v, 13);
+    v           = SelectInt32x4SSE2(v, s, mask);
+
+    return _mm_castsi128_ps(_mm_or_si128(v, sign));
+}
+
+// Packs the lower 16 bits of each 32-bit integer into 8 16-bit integers without saturation.
+LLGL_SIMD_TARGET("sse2")
+static inline __m128i PackInt32x8ToInt16x8SSE2(__m128i lo, __m128i hi)
+{
+    return _mm_packs_epi32(
+        _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+        _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16)
+    );
+}
+
+LLGL_SIMD_TARGET("sse2")
+static void ConvertFloat32ToFloat16SSE2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint16_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = PackInt32x8ToInt16x8SSE2(
+            CompressFloat16x4SSE2(_mm_loadu_ps(src + i    )),
+            CompressFloat16x4SSE2(_mm_loadu_ps(src + i + 4))
+        );
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v16);
+    }
+
+    ConvertFloat32ToFloat16(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET("sse2")
+static void ConvertFloat16ToFloat32SSE2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint16_t*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto zero = _mm_setzero_si128();
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i    , DecompressFloat16x4SSE2(_mm_unpacklo_epi16(v16, zero)));
+        _mm_storeu_ps(dst + i + 4, DecompressFloat16x4SSE2(_mm_unpackhi_epi16(v16, zero)));
+    }
+
+    ConvertFloat16ToFloat32(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET("avx,f16c")
+static void ConvertFloat32ToFloat16F16C(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint16_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    /* Round towards zero like 'CompressFloat16', and map values beyond the half-float range to infinity */
+    const auto absMask  = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const auto maxHalf  = _mm_set1_ps(65504.0f);
+    const auto absHalf  = _mm_set1_epi16(0x7FFF);
+    const auto infHalf  = _mm_set1_epi16(0x7C00);
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto vLo = _mm_loadu_ps(src + i);
+        auto vHi = _mm_loadu_ps(src + i + 4);
+
+        /* F16C quiets NaNs while 'CompressFloat16' keeps their payload, so convert blocks with NaNs like the SSE2 variant */
+        if (_mm_movemask_ps(_mm_or_ps(_mm_cmpunord_ps(vLo, vLo), _mm_cmpunord_ps(vHi, vHi))) != 0)
+        {
+            auto v16 = PackInt32x8ToInt16x8SSE2(CompressFloat16x4SSE2(vLo), CompressFloat16x4SSE2(vHi));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v16);
+            continue;
+        }
+
+        auto v16 = _mm_unpacklo_epi64(
+            _mm_cvtps_ph(vLo, _MM_FROUND_TO_ZERO),
+            _mm_cvtps_ph(vHi, _MM_FROUND_TO_ZERO)
+        );
+
+        auto overflow = _mm_packs_epi32(
+            _mm_castps_si128(_mm_cmpgt_ps(_mm_and_ps(vLo, absMask), maxHalf)),
+            _mm_castps_si128(_mm_cmpgt_ps(_mm_and_ps(vHi, absMask), maxHalf))
+        );
+
+        v16 = _mm_or_si128(
+            _mm_andnot_si128(_mm_and_si128(overflow, absHalf), v16),
+            _mm_and_si128(overflow, infHalf)
+        );
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v16);
+    }
+
+    ConvertFloat32ToFloat16(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET("avx,f16c")
+static void ConvertFloat16ToFloat32F16C(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint16_t*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto zero     = _mm_setzero_si128();
+    const auto absHalf  = _mm_set1_epi16(0x7FFF);
+    const auto infHalf  = _mm_set1_epi16(0x7C00);
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        /* F16C quiets NaNs while 'DecompressFloat16' keeps their payload, so convert blocks with NaNs like the SSE2 variant */
+        if (_mm_movemask_epi8(_mm_cmpgt_epi16(_mm_and_si128(v16, absHalf), infHalf)) != 0)
+        {
+            _mm_storeu_ps(dst + i    , DecompressFloat16x4SSE2(_mm_unpacklo_epi16(v16, zero)));
+            _mm_storeu_ps(dst + i + 4, DecompressFloat16x4SSE2(_mm_unpackhi_epi16(v16, zero)));
+            continue;
+        }
+
+        _mm_storeu_ps(dst + i    , _mm_cvtph_ps(v16));
+        _mm_storeu_ps(dst + i + 4, _mm_cvtph_ps(_mm_unpackhi_epi64(v16, v16)));
+    }
+
+    ConvertFloat16ToFloat32(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_X86
+
+#ifdef LLGL_SIMD_NEON
+
+static void ConvertFloat16ToFloat32NEON(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint16_t*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+    auto i = idxBegin;
+
+    for (; i + 4 <= idxEnd; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+
+    ConvertFloat16ToFloat32(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+
+/* ----- Image format conversion kernels ----- */
+
+static void ConvertRGBToRGBAUInt8(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        dst[i*4    ] = src[i*3    ];
+        dst[i*4 + 1] = src[i*3 + 1];
+        dst[i*4 + 2] = src[i*3 + 2];
+        dst[i*4 + 3] = 0xFF;
+    }
+}
+
+#ifdef LLGL_SIMD_X86
+
+LLGL_SIMD_TARGET("ssse3")
+static void ConvertRGBToRGBAUInt8SSSE3(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto shuffle  = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const auto alpha    = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    /* Each iteration reads 16 bytes but only converts 4 pixels (12 bytes), so stop early enough to stay within the source buffer */
+    for (; i + 6 <= idxEnd; i += 4)
+    {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_or_si128(_mm_shuffle_epi8(v, shuffle), alpha));
+    }
+
+    ConvertRGBToRGBAUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_X86
+
+#ifdef LLGL_SIMD_NEON
+
+static void ConvertRGBToRGBAUInt8NEON(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto rgb = vld3q_u8(src + i*3);
+
+        uint8x16x4_t rgba;
+        {
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(0xFF);
+        }
+        vst4q_u8(dst + i*4, rgba);
+    }
+
+    ConvertRGBToRGBAUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+static void ConvertRGBToRGBAFloat32(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        dst[i*4    ] = src[i*3    ];
+        dst[i*4 + 1] = src[i*3 + 1];
+        dst[i*4 + 2] = src[i*3 + 2];
+        dst[i*4 + 3] = 1.0f;
+    }
+}
+
+#ifdef LLGL_SIMD_X86
+
+LLGL_SIMD_TARGET("sse2")
+static void ConvertRGBToRGBAFloat32SSE2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto mask     = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const auto alpha    = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+    /* Each iteration reads 4 floats but only converts 1 pixel, so the last pixel is left to the scalar loop */
+    for (; i + 2 <= idxEnd; ++i)
+        _mm_storeu_ps(dst + i*4, _mm_or_ps(_mm_and_ps(_mm_loadu_ps(src + i*3), mask), alpha));
+
+    ConvertRGBToRGBAFloat32(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_X86
+
+#ifdef LLGL_SIMD_NEON
+
+static void ConvertRGBToRGBAFloat32NEON(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const float*>(srcBuffer);
+    auto dst = reinterpret_cast<float*>(dstBuffer);
+    auto i = idxBegin;
+
+    for (; i + 4 <= idxEnd; i += 4)
+    {
+        auto rgb = vld3q_f32(src + i*3);
+
+        float32x4x4_t rgba;
+        {
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_f32(1.0f);
+        }
+        vst4q_f32(dst + i*4, rgba);
+    }
+
+    ConvertRGBToRGBAFloat32(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+// Swaps the red and blue components, i.e. converts from BGRA to RGBA and vice versa.
+static void SwizzleBGRAToRGBAUInt8(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        dst[i*4    ] = src[i*4 + 2];
+        dst[i*4 + 1] = src[i*4 + 1];
+        dst[i*4 + 2] = src[i*4    ];
+        dst[i*4 + 3] = src[i*4 + 3];
+    }
+}
+
+#ifdef LLGL_SIMD_X86
+
+LLGL_SIMD_TARGET("sse2")
+static void SwizzleBGRAToRGBAUInt8SSE2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto maskGA = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const auto maskRB = _mm_set1_epi32(0x000000FF);
+
+    for (; i + 4 <= idxEnd; i += 4)
+    {
+        auto v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4));
+        auto ga = _mm_and_si128(v, maskGA);
+        auto r  = _mm_and_si128(_mm_srli_epi32(v, 16), maskRB);
+        auto b  = _mm_slli_epi32(_mm_and_si128(v, maskRB), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_or_si128(ga, _mm_or_si128(r, b)));
+    }
+
+    SwizzleBGRAToRGBAUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET("ssse3")
+static void SwizzleBGRAToRGBAUInt8SSSE3(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    for (; i + 4 <= idxEnd; i += 4)
+    {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_shuffle_epi8(v, shuffle));
+    }
+
+    SwizzleBGRAToRGBAUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET("avx2")
+static void SwizzleBGRAToRGBAUInt8AVX2(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    const auto shuffle = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+    );
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i*4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i*4), _mm256_shuffle_epi8(v, shuffle));
+    }
+
+    SwizzleBGRAToRGBAUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_X86
+
+#ifdef LLGL_SIMD_NEON
+
+static void SwizzleBGRAToRGBAUInt8NEON(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i = idxBegin;
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v = vld4q_u8(src + i*4);
+        auto r = v.val[2];
+        v.val[2] = v.val[0];
+        v.val[0] = r;
+        vst4q_u8(dst + i*4, v);
+    }
+
+    SwizzleBGRAToRGBAUInt8(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+
+/* ----- Kernel selection ----- */
+
+// Variants of a kernel for each instruction set. Variants that are not available are null.
+struct ImageConversionKernelVariants
+{
+    ImageConversionKernel scalar;
+    ImageConversionKernel sse2;
+    ImageConversionKernel ssse3;
+    ImageConversionKernel f16c;
+    ImageConversionKernel avx2;
+    ImageConversionKernel neon;
+};
+
+// Returns the variant with the widest instruction set of the specified SIMD features.
+static ImageConversionKernel SelectKernel(const ImageConversionKernelVariants& variants, long simdFeatures)
+{
+    if (variants.avx2 != nullptr && (simdFeatures & SIMDFeatures::AVX2) != 0)
+        return variants.avx2;
+    if (variants.f16c != nullptr && (simdFeatures & SIMDFeatures::F16C) != 0)
+        return variants.f16c;
+    if (variants.ssse3 != nullptr && (simdFeatures & SIMDFeatures::SSSE3) != 0)
+        return variants.ssse3;
+    if (variants.sse2 != nullptr && (simdFeatures & SIMDFeatures::SSE2) != 0)
+        return variants.sse2;
+    if (variants.neon != nullptr && (simdFeatures & SIMDFeatures::NEON) != 0)
+        return variants.neon;
+    return variants.scalar;
+}
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT ImageConversionKernel FindDataTypeConversionKernel(const DataType srcDataType, const DataType dstDataType, long simdFeatures)
+{
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float32)
+    {
+        return SelectKernel(
+            {
+                ConvertUInt8ToFloat32,
+                LLGL_KERNEL_X86(ConvertUInt8ToFloat32SSE2),
+                nullptr,
+                nullptr,
+                LLGL_KERNEL_X86(ConvertUInt8ToFloat32AVX2),
+                LLGL_KERNEL_NEON(ConvertUInt8ToFloat32NEON),
+            },
+            simdFeatures
+        );
+    }
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt8)
+    {
+        return SelectKernel(
+            {
+                ConvertFloat32ToUInt8,
+                LLGL_KERNEL_X86(ConvertFloat32ToUInt8SSE2),
+                nullptr,
+                nullptr,
+                LLGL_KERNEL_X86(ConvertFloat32ToUInt8AVX2),
+                LLGL_KERNEL_NEON(ConvertFloat32ToUInt8NEON),
+            },
+            simdFeatures
+        );
+    }
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::Float16)
+    {
+        return SelectKernel(
+            {
+                ConvertFloat32ToFloat16,
+                LLGL_KERNEL_X86(ConvertFloat32ToFloat16SSE2),
+                nullptr,
+                LLGL_KERNEL_X86(ConvertFloat32ToFloat16F16C),
+                nullptr,
+                nullptr,
+            },
+            simdFeatures
+        );
+    }
+    if (srcDataType == DataType::Float16 && dstDataType == DataType::Float32)
+    {
+        return SelectKernel(
+            {
+                ConvertFloat16ToFloat32,
+                LLGL_KERNEL_X86(ConvertFloat16ToFloat32SSE2),
+                nullptr,
+                LLGL_KERNEL_X86(ConvertFloat16ToFloat32F16C),
+                nullptr,
+                LLGL_KERNEL_NEON(ConvertFloat16ToFloat32NEON),
+            },
+            simdFeatures
+        );
+    }
+    return nullptr;
+}
+
+LLGL_EXPORT ImageConversionKernel FindFormatConversionKernel(const ImageFormat srcFormat, const ImageFormat dstFormat, const DataType dataType, long simdFeatures)
+{
+    if (srcFormat == ImageFormat::RGB && dstFormat == ImageFormat::RGBA)
+    {
+        if (dataType == DataType::UInt8)
+        {
+            return SelectKernel(
+                {
+                    ConvertRGBToRGBAUInt8,
+                    nullptr,
+                    LLGL_KERNEL_X86(ConvertRGBToRGBAUInt8SSSE3),
+                    nullptr,
+                    nullptr,
+                    LLGL_KERNEL_NEON(ConvertRGBToRGBAUInt8NEON),
+                },
+                simdFeatures
+            );
+        }
+        if (dataType == DataType::Float32)
+        {
+            return SelectKernel(
+                {
+                    ConvertRGBToRGBAFloat32,
+                    LLGL_KERNEL_X86(ConvertRGBToRGBAFloat32SSE2),
+                    nullptr,
+                    nullptr,
+                    nullptr,
+                    LLGL_KERNEL_NEON(ConvertRGBToRGBAFloat32NEON),
+                },
+                simdFeatures
+            );
+        }
+    }
+    else if ( ( srcFormat == ImageFormat::BGRA && dstFormat == ImageFormat::RGBA ) ||
+              ( srcFormat == ImageFormat::RGBA && dstFormat == ImageFormat::BGRA ) )
+    {
+        if (dataType == DataType::UInt8)
+        {
+            return SelectKernel(
+                {
+                    SwizzleBGRAToRGBAUInt8,
+                    LLGL_KERNEL_X86(SwizzleBGRAToRGBAUInt8SSE2),
+                    LLGL_KERNEL_X86(SwizzleBGRAToRGBAUInt8SSSE3),
+                    nullptr,
+                    LLGL_KERNEL_X86(SwizzleBGRAToRGBAUInt8AVX2),
+                    LLGL_KERNEL_NEON(SwizzleBGRAToRGBAUInt8NEON),
+                },
+                simdFeatures
+            );
+        }
+    }
+    return nullptr;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,66 @@
+/*
+ * ImageConversionKernels.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_CONVERSION_KERNELS_H
+#define LLGL_IMAGE_CONVERSION_KERNELS_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/ImageFlags.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Function pointer type for a specialized image conversion kernel.
+Converts all elements in the range [idxBegin, idxEnd), where an element is a single component for data type conversions, and a single pixel for format conversions.
+*/
+using ImageConversionKernel = void (*)(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd);
+
+// SIMD instruction sets the image conversion kernels can be specialized for.
+struct SIMDFeatures
+{
+    enum
+    {
+        SSE2    = (1 << 0),
+        SSSE3   = (1 << 1),
+        AVX2    = (1 << 2),
+        F16C    = (1 << 3),
+        NEON    = (1 << 4),
+    };
+};
+
+/*
+Returns the bitwise OR combination of all SIMD instruction sets (see SIMDFeatures) that are supported by both the build and the CPU.
+x86 instruction sets are determined once at runtime, so the kernels do not depend on the compiler flags.
+*/
+LLGL_EXPORT long GetSIMDFeatures();
+
+/*
+Returns the specialized kernel to convert the specified data types, or null if there is no kernel for this pair.
+The kernel uses the widest instruction set of the specified SIMD features. If this is zero, the kernel is scalar.
+The results are the same as for the generic conversion via the intermediate 'double' values.
+*/
+LLGL_EXPORT ImageConversionKernel FindDataTypeConversionKernel(const DataType srcDataType, const DataType dstDataType, long simdFeatures = GetSIMDFeatures());
+
+/*
+Returns the specialized kernel to convert the specified image formats with the same data type, or null if there is no kernel for this combination.
+The kernel uses the widest instruction set of the specified SIMD features. If this is zero, the kernel is scalar.
+*/
+LLGL_EXPORT ImageConversionKernel FindFormatConversionKernel(const ImageFormat srcFormat, const ImageFormat dstFormat, const DataType dataType, long simdFeatures = GetSIMDFeatures());
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -15,6 +15,8 @@
 #include "../Core/Helper.h"
 #include "../Core/Assertion.h"
 #include "Float16Compressor.h"
+#include "ImageConversionKernels.h"
+#include "ThreadPool.h"
 
 
 namespace LLGL
@@ -172,6 +174,13 @@ static void ConvertImageBufferDataTypeWorker(
     std::size_t                 idxBegin,
     std::size_t                 idxEnd)
 {
+    /* Use specialized kernel for common data type pairs */
+    if (auto kernel = FindDataTypeConversionKernel(srcDataType, dstDataType))
+    {
+        kernel(srcBuffer.raw, dstBuffer.raw, idxBegin, idxEnd);
+        return;
+    }
+
     double value = 0.0;
 
     for (auto i = idxBegin; i < idxEnd; ++i)
@@ -184,8 +193,19 @@ static void ConvertImageBufferDataTypeWorker(
     }
 }
 
-// Minimal number of entries each worker thread shall process
-static const std::size_t g_threadMinWorkSize = 64;
+// Minimal number of bytes each tile of a multi-threaded conversion shall cover.
+static const std::size_t g_tileMinSize = 16384;
+
+// Size of a cache line (in bytes). Tiles cover a multiple of this number of elements, so two tiles never share a cache line of the source or destination buffer.
+static const std::size_t g_cacheLineSize = 64;
+
+// Returns the number of elements each tile shall cover for the specified source and destination element sizes (in bytes).
+static std::size_t GetConversionTileSize(std::size_t srcElementSize, std::size_t dstElementSize)
+{
+    const auto elementSize  = std::max(srcElementSize, dstElementSize);
+    const auto tileSize     = (g_tileMinSize + elementSize - 1) / elementSize;
+    return ((tileSize + g_cacheLineSize - 1) / g_cacheLineSize * g_cacheLineSize);
+}
 
 static void ConvertImageBufferDataType(
     DataType    srcDataType,
@@ -207,39 +227,20 @@ static void ConvertImageBufferDataType(
     VariantConstBuffer src { srcBuffer };
     VariantBuffer dst { dstBuffer };
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
+    const auto tileSize = GetConversionTileSize(DataTypeSize(srcDataType), DataTypeSize(dstDataType));
 
-    if (threadCount > 1)
+    if (threadCount > 1 && imageSize > tileSize)
     {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
-        {
-            workers[i] = std::thread(
-                ConvertImageBufferDataTypeWorker,
-                srcDataType,
-                std::ref(src),
-                dstDataType,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
-        }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, offset, offset + workSizeRemain);
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
+        /* Execute conversion in tiles on the shared thread pool */
+        ThreadPool::ParallelForShared(
+            imageSize,
+            tileSize,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, idxBegin, idxEnd);
+            }
+        );
     }
     else
     {
@@ -424,6 +425,13 @@ static void ConvertImageBufferFormatWorker(
     std::size_t                 idxBegin,
     std::size_t                 idxEnd)
 {
+    /* Use specialized kernel for common format pairs */
+    if (auto kernel = FindFormatConversionKernel(srcFormat, dstFormat, srcDataType))
+    {
+        kernel(srcBuffer.raw, dstBuffer.raw, idxBegin, idxEnd);
+        return;
+    }
+
     /* Get size for source and destination formats */
     auto srcFormatSize  = ImageFormatSize(srcFormat);
     auto dstFormatSize  = ImageFormatSize(dstFormat);
@@ -470,50 +478,28 @@ static void ConvertImageBufferFormat(
     VariantConstBuffer src { srcImageDesc.data };
     VariantBuffer dst { dstImageDesc.data };
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
+    const auto tileSize = GetConversionTileSize(srcFormatSize * dataTypeSize, dstFormatSize * dataTypeSize);
 
-    if (threadCount > 1)
+    if (threadCount > 1 && imageSize > tileSize)
     {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
-        {
-            workers[i] = std::thread(
-                ConvertImageBufferFormatWorker,
-                srcImageDesc.format,
-                srcImageDesc.dataType,
-                std::ref(src),
-                dstImageDesc.format,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
-        }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-        {
-            ConvertImageBufferFormatWorker(
-                srcImageDesc.format,
-                srcImageDesc.dataType,
-                src,
-                dstImageDesc.format,
-                dst,
-                offset,
-                offset + workSizeRemain
-            );
-        }
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
+        /* Execute conversion in tiles on the shared thread pool */
+        ThreadPool::ParallelForShared(
+            imageSize,
+            tileSize,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                ConvertImageBufferFormatWorker(
+                    srcImageDesc.format,
+                    srcImageDesc.dataType,
+                    src,
+                    dstImageDesc.format,
+                    dst,
+                    idxBegin,
+                    idxEnd
+                );
+            }
+        );
     }
     else
     {
@@ -0,0 +1,1181 @@
+/*
+ * ImageResampler.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Constants.h>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <thread>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include "../Core/Helper.h"
+#include "../Core/Assertion.h"
+#include "Float16Compressor.h"
+#include "ThreadPool.h"
+#include "SIMDMacros.h"
+
+
+namespace LLGL
+{
+
+
+/*
+The resampler filters an image separately along each axis whose size changes, in the order of the strongest minification first.
+All passes operate on floating-point components. The first pass converts the source lines it reads and the last pass converts the lines it writes,
+so no converted copy of the entire source or destination image is allocated.
+The components are 32-bit floats, except for 32-bit integers and 64-bit floats, which require double precision to be reproduced exactly.
+*/
+
+/* ----- Internal constants ----- */
+
+// Minimal number of floating-point components each tile of a multi-threaded pass shall cover.
+static const std::size_t g_tileMinComponents = 4096;
+
+// Maximal number of components of a single line the vertical pass accumulates at once, so the destination stays in the L1 cache.
+static const std::size_t g_spanChunkSize = 4096;
+
+
+/* ----- Filter weights ----- */
+
+// Filter weights for each destination index along a single axis.
+template <typename TReal>
+struct ResampleWeights
+{
+    std::vector<std::uint32_t>  first;          // First source index for each destination index.
+    std::vector<std::uint32_t>  count;          // Number of source indices for each destination index.
+    std::vector<TReal>          weights;        // 'stride' weights for each destination index.
+    std::size_t                 stride  = 0;
+};
+
+static double Sinc(double x)
+{
+    if (std::abs(x) < 1.0e-8)
+        return 1.0;
+    x *= 3.14159265358979323846;
+    return (std::sin(x) / x);
+}
+
+// Modified Bessel function of the first kind of order zero, evaluated with its power series.
+static double BesselI0(double x)
+{
+    const double halfX = x * 0.5;
+    double sum = 1.0, term = 1.0;
+
+    for (int k = 1; k < 64 && term > sum * 1.0e-16; ++k)
+    {
+        const double t = halfX / k;
+        term *= t * t;
+        sum += term;
+    }
+
+    return sum;
+}
+
+// Kaiser window over the radius of the Kaiser filter, with the shape parameter 'alpha' = 4.
+static double KaiserWindow(double x)
+{
+    static const double alpha       = 4.0;
+    static const double invI0Alpha  = 1.0 / BesselI0(alpha);
+
+    const double t = x / 3.0;
+    return (BesselI0(alpha * std::sqrt(1.0 - t * t)) * invI0Alpha);
+}
+
+// Returns the radius (in source pixels) of the filter when the image is neither minified nor magnified.
+static double GetResampleFilterSupport(const ResampleFilter filter)
+{
+    switch (filter)
+    {
+        case ResampleFilter::Nearest:   return 0.5;
+        case ResampleFilter::Box:       return 0.5;
+        case ResampleFilter::Linear:    return 1.0;
+        case ResampleFilter::Lanczos:   return 3.0;
+        case ResampleFilter::Kaiser:    return 3.0;
+    }
+    return 0.5;
+}
+
+static double EvalResampleFilter(const ResampleFilter filter, double x)
+{
+    x = std::abs(x);
+    switch (filter)
+    {
+        case ResampleFilter::Linear:
+            return (x < 1.0 ? 1.0 - x : 0.0);
+        case ResampleFilter::Lanczos:
+            return (x < 3.0 ? Sinc(x) * Sinc(x / 3.0) : 0.0);
+        case ResampleFilter::Kaiser:
+            return (x < 3.0 ? Sinc(x) * KaiserWindow(x) : 0.0);
+        default:
+            return (x < 0.5 ? 1.0 : 0.0);
+    }
+}
+
+template <typename TReal>
+static void SetNearestResampleWeight(ResampleWeights<TReal>& rw, std::uint32_t i, double center, std::int64_t lastIndex)
+{
+    rw.first[i]                 = static_cast<std::uint32_t>(std::min(static_cast<std::int64_t>(center), lastIndex));
+    rw.count[i]                 = 1;
+    rw.weights[i * rw.stride]   = TReal(1);
+}
+
+template <typename TReal>
+static void ComputeResampleWeights(const ResampleFilter filter, std::uint32_t srcSize, std::uint32_t dstSize, ResampleWeights<TReal>& rw)
+{
+    /*
+    Destination pixel 'i' is centered at 'c = (i + 0.5) / scale' in source space, where source pixel 'j' covers the interval [j, j + 1).
+    The box filter weights each source pixel by its coverage of the destination pixel footprint [c - r, c + r) with 'r = 0.5 / scale'.
+    All other filters are evaluated at the source pixel centers, and are widened by the inverse scale when the image is minified.
+    Source indices outside the image are clamped to the edge.
+    */
+    const double scale          = static_cast<double>(dstSize) / static_cast<double>(srcSize);
+    const double filterScale    = (filter == ResampleFilter::Nearest ? 1.0 : std::min(scale, 1.0));
+    const double radius         = (filter == ResampleFilter::Box ? 0.5 / scale : GetResampleFilterSupport(filter) / filterScale);
+
+    rw.stride = static_cast<std::size_t>(std::ceil(2.0 * radius)) + 3;
+    rw.first.resize(dstSize);
+    rw.count.resize(dstSize);
+    rw.weights.assign(rw.stride * dstSize, TReal(0));
+
+    std::vector<double> weights(rw.stride);
+
+    const auto lastIndex = static_cast<std::int64_t>(srcSize) - 1;
+
+    for (std::uint32_t i = 0; i < dstSize; ++i)
+    {
+        const double center = (static_cast<double>(i) + 0.5) / scale;
+
+        if (filter == ResampleFilter::Nearest)
+        {
+            SetNearestResampleWeight(rw, i, center, lastIndex);
+            continue;
+        }
+
+        /* Accumulate weights of all source pixels within the filter radius */
+        const auto  lo      = static_cast<std::int64_t>(std::floor(center - radius - 0.5));
+        const auto  hi      = static_cast<std::int64_t>(std::ceil(center + radius - 0.5));
+        const auto  first   = std::max(lo, std::int64_t(0));
+        const auto  last    = std::min(hi, lastIndex);
+        double      sum     = 0.0;
+
+        std::fill(weights.begin(), weights.end(), 0.0);
+
+        for (auto j = lo; j <= hi; ++j)
+        {
+            double w = 0.0;
+
+            if (filter == ResampleFilter::Box)
+            {
+                const auto x = static_cast<double>(j);
+                w = std::max(0.0, std::min(x + 1.0, center + radius) - std::max(x, center - radius));
+            }
+            else
+                w = EvalResampleFilter(filter, (static_cast<double>(j) + 0.5 - center) * filterScale);
+
+            weights[static_cast<std::size_t>(std::max(first, std::min(j, last)) - first)] += w;
+            sum += w;
+        }
+
+        if (sum == 0.0)
+        {
+            /* Fall back to nearest source pixel */
+            SetNearestResampleWeight(rw, i, center, lastIndex);
+            continue;
+        }
+
+        /* Trim source pixels without contribution at both ends */
+        std::size_t begin = 0, end = static_cast<std::size_t>(last - first + 1);
+
+        while (begin + 1 < end && weights[begin] == 0.0)
+            ++begin;
+        while (end - 1 > begin && weights[end - 1] == 0.0)
+            --end;
+
+        /* Store normalized weights */
+        rw.first[i] = static_cast<std::uint32_t>(first) + static_cast<std::uint32_t>(begin);
+        rw.count[i] = static_cast<std::uint32_t>(end - begin);
+
+        for (auto k = begin; k < end; ++k)
+            rw.weights[i * rw.stride + (k - begin)] = static_cast<TReal>(weights[k] / sum);
+    }
+}
+
+
+/* ----- Data type conversion ----- */
+
+template <typename T, typename TReal>
+static void ReadNormalizedComponents(const void* srcBuffer, std::size_t offset, TReal* dst, std::size_t count)
+{
+    auto src = reinterpret_cast<const T*>(srcBuffer) + offset;
+
+    const auto min      = static_cast<TReal>(std::numeric_limits<T>::min());
+    const auto scale    = static_cast<TReal>(1.0 / (static_cast<double>(std::numeric_limits<T>::max()) - static_cast<double>(std::numeric_limits<T>::min())));
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = (static_cast<TReal>(src[i]) - min) * scale;
+}
+
+/*
+Clamps the normalized components to [0, 1] since filters with negative lobes can overshoot, and rounds to the nearest integer.
+The rounded value is offset to be non-negative, so the truncating integer conversion is equal to rounding down.
+*/
+template <typename T, typename TReal>
+static void WriteNormalizedComponents(const TReal* src, void* dstBuffer, std::size_t offset, std::size_t count)
+{
+    using TInt = typename std::conditional<(sizeof(T) < 4), std::int32_t, std::int64_t>::type;
+
+    auto dst = reinterpret_cast<T*>(dstBuffer) + offset;
+
+    const auto min      = static_cast<TInt>(std::numeric_limits<T>::min());
+    const auto range    = static_cast<TReal>(static_cast<double>(std::numeric_limits<T>::max()) - static_cast<double>(std::numeric_limits<T>::min()));
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto value = std::max(TReal(0), std::min(src[i], TReal(1)));
+        dst[i] = static_cast<T>(static_cast<TInt>(value * range + TReal(0.5)) + min);
+    }
+}
+
+template <typename T, typename TReal>
+static void ReadRealComponents(const void* srcBuffer, std::size_t offset, TReal* dst, std::size_t count)
+{
+    auto src = reinterpret_cast<const T*>(srcBuffer) + offset;
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<TReal>(src[i]);
+}
+
+template <typename T, typename TReal>
+static void WriteRealComponents(const TReal* src, void* dstBuffer, std::size_t offset, std::size_t count)
+{
+    auto dst = reinterpret_cast<T*>(dstBuffer) + offset;
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<T>(src[i]);
+}
+
+// Converts the components [offset, offset + count) of the source buffer into the first 'count' floating-point components of 'dst'.
+template <typename TReal>
+static void ReadComponents(DataType dataType, const void* src, std::size_t offset, TReal* dst, std::size_t count)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+            ReadNormalizedComponents<std::int8_t>(src, offset, dst, count);
+            break;
+        case DataType::UInt8:
+            ReadNormalizedComponents<std::uint8_t>(src, offset, dst, count);
+            break;
+        case DataType::Int16:
+            ReadNormalizedComponents<std::int16_t>(src, offset, dst, count);
+            break;
+        case DataType::UInt16:
+            ReadNormalizedComponents<std::uint16_t>(src, offset, dst, count);
+            break;
+        case DataType::Int32:
+            ReadNormalizedComponents<std::int32_t>(src, offset, dst, count);
+            break;
+        case DataType::UInt32:
+            ReadNormalizedComponents<std::uint32_t>(src, offset, dst, count);
+            break;
+        case DataType::Float16:
+            for (std::size_t i = 0; i < count; ++i)
+                dst[i] = static_cast<TReal>(DecompressFloat16(reinterpret_cast<const std::uint16_t*>(src)[offset + i]));
+            break;
+        case DataType::Float32:
+            ReadRealComponents<float>(src, offset, dst, count);
+            break;
+        case DataType::Float64:
+            ReadRealComponents<double>(src, offset, dst, count);
+            break;
+    }
+}
+
+// Converts the first 'count' floating-point components of 'src' into the components [offset, offset + count) of the destination buffer.
+template <typename TReal>
+static void WriteComponents(DataType dataType, const TReal* src, void* dst, std::size_t offset, std::size_t count)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+            WriteNormalizedComponents<std::int8_t>(src, dst, offset, count);
+            break;
+        case DataType::UInt8:
+            WriteNormalizedComponents<std::uint8_t>(src, dst, offset, count);
+            break;
+        case DataType::Int16:
+            WriteNormalizedComponents<std::int16_t>(src, dst, offset, count);
+            break;
+        case DataType::UInt16:
+            WriteNormalizedComponents<std::uint16_t>(src, dst, offset, count);
+            break;
+        case DataType::Int32:
+            WriteNormalizedComponents<std::int32_t>(src, dst, offset, count);
+            break;
+        case DataType::UInt32:
+            WriteNormalizedComponents<std::uint32_t>(src, dst, offset, count);
+            break;
+        case DataType::Float16:
+            for (std::size_t i = 0; i < count; ++i)
+                reinterpret_cast<std::uint16_t*>(dst)[offset + i] = CompressFloat16(static_cast<float>(src[i]));
+            break;
+        case DataType::Float32:
+            WriteRealComponents<float>(src, dst, offset, count);
+            break;
+        case DataType::Float64:
+            WriteRealComponents<double>(src, dst, offset, count);
+            break;
+    }
+}
+
+
+/* ----- sRGB conversion ----- */
+
+// Layout of the components of an sRGB encoded image. The alpha component is not encoded.
+struct SRGBComponentLayout
+{
+    std::size_t numComponents;
+    std::size_t alphaIndex;     // Index of the alpha component, or 'numComponents' if there is none.
+};
+
+static double SRGBToLinear(double x)
+{
+    return (x <= 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4));
+}
+
+static double LinearToSRGB(double x)
+{
+    return (x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055);
+}
+
+// Returns the table of linear values for all 8-bit sRGB values.
+template <typename TReal>
+static const TReal* GetSRGBDecodeTable()
+{
+    static const std::vector<TReal> table = []()
+    {
+        std::vector<TReal> values(256);
+        for (int i = 0; i < 256; ++i)
+            values[i] = static_cast<TReal>(SRGBToLinear(i / 255.0));
+        return values;
+    }();
+    return table.data();
+}
+
+/*
+Returns the table of linear values at the midpoints between all consecutive 8-bit sRGB values.
+The number of midpoints below a linear value is its 8-bit sRGB value rounded to the nearest integer.
+*/
+template <typename TReal>
+static const TReal* GetSRGBEncodeThresholds()
+{
+    static const std::vector<TReal> table = []()
+    {
+        std::vector<TReal> values(255);
+        for (int i = 0; i < 255; ++i)
+            values[i] = static_cast<TReal>(SRGBToLinear((i + 0.5) / 255.0));
+        return values;
+    }();
+    return table.data();
+}
+
+// Reads the components [offset, offset + count) of an sRGB encoded source buffer and converts the color components to linear space.
+template <typename TReal>
+static void ReadSRGBComponents(DataType dataType, const void* src, std::size_t offset, TReal* dst, std::size_t count, const SRGBComponentLayout& layout)
+{
+    auto component = offset % layout.numComponents;
+
+    if (dataType == DataType::UInt8)
+    {
+        const auto table    = GetSRGBDecodeTable<TReal>();
+        const auto srcBytes = reinterpret_cast<const std::uint8_t*>(src) + offset;
+        const auto scale    = static_cast<TReal>(1.0 / 255.0);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            dst[i] = (component != layout.alphaIndex ? table[srcBytes[i]] : static_cast<TReal>(srcBytes[i]) * scale);
+            if (++component == layout.numComponents)
+                component = 0;
+        }
+    }
+    else
+    {
+        ReadComponents(dataType, src, offset, dst, count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (component != layout.alphaIndex)
+                dst[i] = static_cast<TReal>(SRGBToLinear(static_cast<double>(dst[i])));
+            if (++component == layout.numComponents)
+                component = 0;
+        }
+    }
+}
+
+// Converts the color components of 'src' to sRGB space and writes them into the components [offset, offset + count) of the destination buffer. 'src' is modified.
+template <typename TReal>
+static void WriteSRGBComponents(DataType dataType, TReal* src, void* dst, std::size_t offset, std::size_t count, const SRGBComponentLayout& layout)
+{
+    auto component = offset % layout.numComponents;
+
+    if (dataType == DataType::UInt8)
+    {
+        const auto thresholds   = GetSRGBEncodeThresholds<TReal>();
+        const auto dstBytes     = reinterpret_cast<std::uint8_t*>(dst) + offset;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (component != layout.alphaIndex)
+                dstBytes[i] = static_cast<std::uint8_t>(std::upper_bound(thresholds, thresholds + 255, src[i]) - thresholds);
+            else
+                dstBytes[i] = static_cast<std::uint8_t>(std::max(TReal(0), std::min(src[i], TReal(1))) * TReal(255) + TReal(0.5));
+            if (++component == layout.numComponents)
+                component = 0;
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (component != layout.alphaIndex)
+                src[i] = static_cast<TReal>(LinearToSRGB(static_cast<double>(src[i])));
+            if (++component == layout.numComponents)
+                component = 0;
+        }
+
+        WriteComponents(dataType, src, dst, offset, count);
+    }
+}
+
+// Returns the component layout for sRGB encoded images of the specified format.
+static SRGBComponentLayout GetSRGBComponentLayout(const ImageFormat format)
+{
+    const auto numComponents = static_cast<std::size_t>(ImageFormatSize(format));
+    switch (format)
+    {
+        case ImageFormat::RGBA:
+        case ImageFormat::BGRA:
+            return { numComponents, 3 };
+        case ImageFormat::ARGB:
+        case ImageFormat::ABGR:
+            return { numComponents, 0 };
+        default:
+            return { numComponents, numComponents };
+    }
+}
+
+
+/* ----- Image buffers ----- */
+
+// Returns true if the specified data type is the floating-point type the components are filtered with.
+template <typename TReal>
+static bool IsResampleDataType(const DataType dataType)
+{
+    return (dataType == (sizeof(TReal) == sizeof(double) ? DataType::Float64 : DataType::Float32));
+}
+
+/*
+Image buffer a pass reads from. Lines are converted into a scratch buffer unless the buffer already has the floating-point type of the filter.
+If 'sRGB' is non-null, the color components are converted to linear space.
+*/
+template <typename TReal>
+struct ResampleSrcBuffer
+{
+    const void*                 data;
+    DataType                    dataType;
+    const SRGBComponentLayout*  sRGB;
+
+    const TReal* ReadLine(std::size_t offset, std::size_t count, std::vector<TReal>& scratch) const
+    {
+        if (sRGB == nullptr && IsResampleDataType<TReal>(dataType))
+            return (reinterpret_cast<const TReal*>(data) + offset);
+        scratch.resize(count);
+        if (sRGB != nullptr)
+            ReadSRGBComponents(dataType, data, offset, scratch.data(), count, *sRGB);
+        else
+            ReadComponents(dataType, data, offset, scratch.data(), count);
+        return scratch.data();
+    }
+};
+
+/*
+Image buffer a pass writes to. Lines are written into a scratch buffer first unless the buffer already has the floating-point type of the filter.
+If 'sRGB' is non-null, the color components are converted to sRGB space.
+*/
+template <typename TReal>
+struct ResampleDstBuffer
+{
+    void*                       data;
+    DataType                    dataType;
+    const SRGBComponentLayout*  sRGB;
+
+    TReal* BeginLine(std::size_t offset, std::size_t count, std::vector<TReal>& scratch) const
+    {
+        if (sRGB == nullptr && IsResampleDataType<TReal>(dataType))
+            return (reinterpret_cast<TReal*>(data) + offset);
+        scratch.resize(count);
+        return scratch.data();
+    }
+
+    void EndLine(std::size_t offset, std::size_t count, std::vector<TReal>& scratch) const
+    {
+        if (sRGB != nullptr)
+            WriteSRGBComponents(dataType, scratch.data(), data, offset, count, *sRGB);
+        else if (!IsResampleDataType<TReal>(dataType))
+            WriteComponents(dataType, scratch.data(), data, offset, count);
+    }
+};
+
+
+/* ----- Horizontal pass ----- */
+
+/*
+Resamples a single row of pixels with 'N' components into a row of 'dstWidth' pixels.
+Rows are contiguous, so the pixels of a single tap are accumulated component-wise.
+*/
+template <typename TReal, std::size_t N>
+static void ResampleRowN(const TReal* srcRow, TReal* dstRow, std::size_t dstWidth, const ResampleWeights<TReal>& rw)
+{
+    for (std::size_t i = 0; i < dstWidth; ++i)
+    {
+        auto    weights = &rw.weights[i * rw.stride];
+        auto    pixels  = srcRow + rw.first[i] * N;
+        TReal   accum[N];
+
+        for (std::size_t c = 0; c < N; ++c)
+            accum[c] = TReal(0);
+
+        for (std::uint32_t k = 0; k < rw.count[i]; ++k)
+        {
+            for (std::size_t c = 0; c < N; ++c)
+                accum[c] += weights[k] * pixels[k * N + c];
+        }
+
+        for (std::size_t c = 0; c < N; ++c)
+            dstRow[i * N + c] = accum[c];
+    }
+}
+
+#if defined LLGL_SIMD_SSE2 || defined LLGL_SIMD_NEON
+
+// Resamples a single row of 32-bit float pixels with 4 components, which are accumulated as a single vector.
+static void ResampleRowFloat4(const float* srcRow, float* dstRow, std::size_t dstWidth, const ResampleWeights<float>& rw)
+{
+    for (std::size_t i = 0; i < dstWidth; ++i)
+    {
+        auto weights    = &rw.weights[i * rw.stride];
+        auto pixels     = srcRow + rw.first[i] * 4;
+
+        #if defined LLGL_SIMD_SSE2
+
+        auto accum = _mm_setzero_ps();
+        for (std::uint32_t k = 0; k < rw.count[i]; ++k)
+            accum = _mm_add_ps(accum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(pixels + k * 4)));
+        _mm_storeu_ps(dstRow + i * 4, accum);
+
+        #else
+
+        auto accum = vdupq_n_f32(0.0f);
+        for (std::uint32_t k = 0; k < rw.count[i]; ++k)
+            accum = vmlaq_n_f32(accum, vld1q_f32(pixels + k * 4), weights[k]);
+        vst1q_f32(dstRow + i * 4, accum);
+
+        #endif
+    }
+}
+
+#endif
+
+static void ResampleRow(const double* srcRow, double* dstRow, std::size_t numComponents, std::size_t dstWidth, const ResampleWeights<double>& rw)
+{
+    switch (numComponents)
+    {
+        case 1: ResampleRowN<double, 1>(srcRow, dstRow, dstWidth, rw); break;
+        case 2: ResampleRowN<double, 2>(srcRow, dstRow, dstWidth, rw); break;
+        case 3: ResampleRowN<double, 3>(srcRow, dstRow, dstWidth, rw); break;
+        case 4: ResampleRowN<double, 4>(srcRow, dstRow, dstWidth, rw); break;
+    }
+}
+
+static void ResampleRow(const float* srcRow, float* dstRow, std::size_t numComponents, std::size_t dstWidth, const ResampleWeights<float>& rw)
+{
+    switch (numComponents)
+    {
+        case 1: ResampleRowN<float, 1>(srcRow, dstRow, dstWidth, rw); break;
+        case 2: ResampleRowN<float, 2>(srcRow, dstRow, dstWidth, rw); break;
+        case 3: ResampleRowN<float, 3>(srcRow, dstRow, dstWidth, rw); break;
+        #if defined LLGL_SIMD_SSE2 || defined LLGL_SIMD_NEON
+        case 4: ResampleRowFloat4(srcRow, dstRow, dstWidth, rw); break;
+        #else
+        case 4: ResampleRowN<float, 4>(srcRow, dstRow, dstWidth, rw); break;
+        #endif
+    }
+}
+
+// Resamples the rows [rowBegin, rowEnd) of the source image into the destination image.
+template <typename TReal>
+static void ResampleRows(
+    const ResampleSrcBuffer<TReal>& src,
+    const ResampleDstBuffer<TReal>& dst,
+    std::size_t                     numComponents,
+    std::size_t                     srcWidth,
+    std::size_t                     dstWidth,
+    const ResampleWeights<TReal>&   rw,
+    std::size_t                     rowBegin,
+    std::size_t                     rowEnd)
+{
+    std::vector<TReal> srcScratch, dstScratch;
+
+    const auto srcRowSize = srcWidth * numComponents;
+    const auto dstRowSize = dstWidth * numComponents;
+
+    for (auto row = rowBegin; row < rowEnd; ++row)
+    {
+        auto srcRow = src.ReadLine(row * srcRowSize, srcRowSize, srcScratch);
+        auto dstRow = dst.BeginLine(row * dstRowSize, dstRowSize, dstScratch);
+        ResampleRow(srcRow, dstRow, numComponents, dstWidth, rw);
+        dst.EndLine(row * dstRowSize, dstRowSize, dstScratch);
+    }
+}
+
+
+/* ----- Vertical pass ----- */
+
+// Stores 'dst[x] = w * src[x]' (if 'accumulate' is false) or 'dst[x] += w * src[x]' (if 'accumulate' is true) for all x in [0, count).
+static void AccumulateSpan(double* dst, const double* src, double w, std::size_t count, bool accumulate)
+{
+    if (accumulate)
+    {
+        for (std::size_t x = 0; x < count; ++x)
+            dst[x] += w * src[x];
+    }
+    else
+    {
+        for (std::size_t x = 0; x < count; ++x)
+            dst[x] = w * src[x];
+    }
+}
+
+static void AccumulateSpan(float* dst, const float* src, float w, std::size_t count, bool accumulate)
+{
+    std::size_t x = 0;
+
+    #if defined LLGL_SIMD_AVX2
+
+    const auto w8 = _mm256_set1_ps(w);
+    if (accumulate)
+    {
+        for (; x + 8 <= count; x += 8)
+            _mm256_storeu_ps(dst + x, _mm256_add_ps(_mm256_loadu_ps(dst + x), _mm256_mul_ps(w8, _mm256_loadu_ps(src + x))));
+    }
+    else
+    {
+        for (; x + 8 <= count; x += 8)
+            _mm256_storeu_ps(dst + x, _mm256_mul_ps(w8, _mm256_loadu_ps(src + x)));
+    }
+
+    #elif defined LLGL_SIMD_SSE2
+
+    const auto w4 = _mm_set1_ps(w);
+    if (accumulate)
+    {
+        for (; x + 4 <= count; x += 4)
+            _mm_storeu_ps(dst + x, _mm_add_ps(_mm_loadu_ps(dst + x), _mm_mul_ps(w4, _mm_loadu_ps(src + x))));
+    }
+    else
+    {
+        for (; x + 4 <= count; x += 4)
+            _mm_storeu_ps(dst + x, _mm_mul_ps(w4, _mm_loadu_ps(src + x)));
+    }
+
+    #elif defined LLGL_SIMD_NEON
+
+    if (accumulate)
+    {
+        for (; x + 4 <= count; x += 4)
+            vst1q_f32(dst + x, vmlaq_n_f32(vld1q_f32(dst + x), vld1q_f32(src + x), w));
+    }
+    else
+    {
+        for (; x + 4 <= count; x += 4)
+            vst1q_f32(dst + x, vmulq_n_f32(vld1q_f32(src + x), w));
+    }
+
+    #endif
+
+    if (accumulate)
+    {
+        for (; x < count; ++x)
+            dst[x] += w * src[x];
+    }
+    else
+    {
+        for (; x < count; ++x)
+            dst[x] = w * src[x];
+    }
+}
+
+/*
+Resamples lines of 'span' contiguous components along an outer axis, i.e. rows for the Y axis and slices for the Z axis.
+Each destination line is the weighted sum of its source lines, so the inner loop runs over contiguous memory.
+Work items are enumerated as (outer index, destination line, chunk of the span).
+*/
+template <typename TReal>
+static void ResampleLines(
+    const ResampleSrcBuffer<TReal>& src,
+    const ResampleDstBuffer<TReal>& dst,
+    std::size_t                     span,
+    std::size_t                     srcLines,
+    std::size_t                     dstLines,
+    const ResampleWeights<TReal>&   rw,
+    std::size_t                     numChunks,
+    std::size_t                     itemBegin,
+    std::size_t                     itemEnd)
+{
+    std::vector<TReal> srcScratch, dstScratch;
+
+    for (auto item = itemBegin; item < itemEnd; ++item)
+    {
+        const auto chunk        = item % numChunks;
+        const auto line         = (item / numChunks) % dstLines;
+        const auto outer        = item / numChunks / dstLines;
+
+        const auto offset       = chunk * g_spanChunkSize;
+        const auto count        = std::min(g_spanChunkSize, span - offset);
+
+        const auto srcOffset    = (outer * srcLines + rw.first[line]) * span + offset;
+        const auto dstOffset    = (outer * dstLines + line) * span + offset;
+        const auto weights      = &rw.weights[line * rw.stride];
+
+        auto dstLine = dst.BeginLine(dstOffset, count, dstScratch);
+
+        for (std::uint32_t k = 0; k < rw.count[line]; ++k)
+        {
+            auto srcLine = src.ReadLine(srcOffset + k * span, count, srcScratch);
+            AccumulateSpan(dstLine, srcLine, weights[k], count, (k > 0));
+        }
+
+        dst.EndLine(dstOffset, count, dstScratch);
+    }
+}
+
+
+/* ----- Resampler ----- */
+
+// Runs the specified function for all items in [0, count) in tiles of at least 'tileSize' items, either on the shared thread pool or on the calling thread.
+template <typename TFunc>
+static void ResampleParallelFor(std::size_t count, std::size_t tileSize, std::size_t threadCount, const TFunc& func)
+{
+    tileSize = std::max(tileSize, std::size_t(1));
+    if (threadCount > 1 && count > tileSize)
+        ThreadPool::ParallelForShared(count, tileSize, threadCount, func);
+    else
+        func(0, count);
+}
+
+static std::uint32_t GetExtentAxis(const Extent3D& extent, int axis)
+{
+    return (axis == 0 ? extent.width : axis == 1 ? extent.height : extent.depth);
+}
+
+static void SetExtentAxis(Extent3D& extent, int axis, std::uint32_t size)
+{
+    (axis == 0 ? extent.width : axis == 1 ? extent.height : extent.depth) = size;
+}
+
+static std::size_t GetExtentVolume(const Extent3D& extent)
+{
+    return (static_cast<std::size_t>(extent.width) * extent.height * extent.depth);
+}
+
+// Resamples the image 'src' along the specified axis into 'dst'.
+template <typename TReal>
+static void ResampleAxis(
+    const ResampleSrcBuffer<TReal>& src,
+    const ResampleDstBuffer<TReal>& dst,
+    const Extent3D&                 srcExtent,
+    std::uint32_t                   dstSize,
+    int                             axis,
+    std::size_t                     numComponents,
+    const ResampleFilter            filter,
+    std::size_t                     threadCount)
+{
+    ResampleWeights<TReal> rw;
+    ComputeResampleWeights(filter, GetExtentAxis(srcExtent, axis), dstSize, rw);
+
+    if (axis == 0)
+    {
+        /* Resample each row */
+        const auto numRows = static_cast<std::size_t>(srcExtent.height) * srcExtent.depth;
+        const auto rowSize = static_cast<std::size_t>(dstSize) * numComponents;
+
+        ResampleParallelFor(
+            numRows,
+            (g_tileMinComponents + rowSize - 1) / rowSize,
+            threadCount,
+            [&](std::size_t rowBegin, std::size_t rowEnd)
+            {
+                ResampleRows(src, dst, numComponents, srcExtent.width, dstSize, rw, rowBegin, rowEnd);
+            }
+        );
+    }
+    else
+    {
+        /* Resample each row (Y axis) or slice (Z axis) as a whole line */
+        const auto span         = (axis == 1 ? static_cast<std::size_t>(srcExtent.width) : static_cast<std::size_t>(srcExtent.width) * srcExtent.height) * numComponents;
+        const auto numOuter     = (axis == 1 ? static_cast<std::size_t>(srcExtent.depth) : std::size_t(1));
+        const auto srcLines     = static_cast<std::size_t>(axis == 1 ? srcExtent.height : srcExtent.depth);
+        const auto numChunks    = (span + g_spanChunkSize - 1) / g_spanChunkSize;
+        const auto chunkSize    = std::min(span, g_spanChunkSize);
+
+        ResampleParallelFor(
+            numOuter * dstSize * numChunks,
+            (g_tileMinComponents + chunkSize - 1) / chunkSize,
+            threadCount,
+            [&](std::size_t itemBegin, std::size_t itemEnd)
+            {
+                ResampleLines(src, dst, span, srcLines, dstSize, rw, numChunks, itemBegin, itemEnd);
+            }
+        );
+    }
+}
+
+template <typename TReal>
+static DataType GetResampleDataType()
+{
+    return (sizeof(TReal) == sizeof(double) ? DataType::Float64 : DataType::Float32);
+}
+
+/*
+Determines the axes to resample, beginning with the strongest minification to reduce the work of the subsequent passes.
+Returns the number of axes whose size changes.
+*/
+static int GetResampleAxes(const Extent3D& srcExtent, const Extent3D& dstExtent, int (&axes)[3])
+{
+    int numAxes = 0;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (GetExtentAxis(srcExtent, axis) != GetExtentAxis(dstExtent, axis))
+            axes[numAxes++] = axis;
+    }
+
+    auto GetAxisScale = [&](int axis)
+    {
+        return static_cast<double>(GetExtentAxis(dstExtent, axis)) / GetExtentAxis(srcExtent, axis);
+    };
+
+    std::stable_sort(axes, axes + numAxes, [&](int lhs, int rhs) { return (GetAxisScale(lhs) < GetAxisScale(rhs)); });
+
+    return numAxes;
+}
+
+// Resamples the image 'src' into 'dst' with one pass for each of the specified axes.
+template <typename TReal>
+static void ResampleImage(
+    ResampleSrcBuffer<TReal>        src,
+    const ResampleDstBuffer<TReal>& dst,
+    const Extent3D&                 srcExtent,
+    const Extent3D&                 dstExtent,
+    const int*                      axes,
+    int                             numAxes,
+    std::size_t                     numComponents,
+    const ResampleFilter            filter,
+    std::size_t                     threadCount)
+{
+    /* The first pass reads from the source image, intermediate passes from the previous pass */
+    std::unique_ptr<TReal[]> srcComponents, dstComponents;
+
+    Extent3D extent = srcExtent;
+
+    for (int i = 0; i < numAxes; ++i)
+    {
+        const auto axis     = axes[i];
+        const auto dstSize  = GetExtentAxis(dstExtent, axis);
+
+        Extent3D nextExtent = extent;
+        SetExtentAxis(nextExtent, axis, dstSize);
+
+        /* The last pass writes into the destination image, intermediate passes into a temporary floating-point image */
+        ResampleDstBuffer<TReal> passDst = dst;
+
+        if (i + 1 < numAxes)
+        {
+            dstComponents   = MakeUniqueArray<TReal>(GetExtentVolume(nextExtent) * numComponents);
+            passDst         = { dstComponents.get(), GetResampleDataType<TReal>(), nullptr };
+        }
+
+        ResampleAxis(src, passDst, extent, dstSize, axis, numComponents, filter, threadCount);
+
+        /* Keep ownership of the intermediate image for the next pass */
+        srcComponents   = std::move(dstComponents);
+        src             = { passDst.data, passDst.dataType, nullptr };
+        extent          = nextExtent;
+    }
+}
+
+template <typename TReal>
+static void ResizeImageBufferWithPrecision(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    const int*                  axes,
+    int                         numAxes,
+    const ResampleFilter        filter,
+    std::size_t                 threadCount)
+{
+    ResampleImage<TReal>(
+        { srcImageDesc.data, srcImageDesc.dataType, nullptr },
+        { dstImageDesc.data, dstImageDesc.dataType, nullptr },
+        srcExtent,
+        dstExtent,
+        axes,
+        numAxes,
+        static_cast<std::size_t>(ImageFormatSize(srcImageDesc.format)),
+        filter,
+        threadCount
+    );
+}
+
+// Returns true if the specified data type cannot be represented by 32-bit floats.
+static bool RequiresDoublePrecision(const DataType dataType)
+{
+    return (dataType == DataType::Int32 || dataType == DataType::UInt32 || dataType == DataType::Float64);
+}
+
+static void ValidateImageResizeParams(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent)
+{
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+    LLGL_ASSERT_PTR(dstImageDesc.data);
+    if (srcImageDesc.format != dstImageDesc.format || srcImageDesc.dataType != dstImageDesc.dataType)
+        throw std::invalid_argument("cannot resize image buffer with different source and destination format or data type");
+    if (IsCompressedFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot resize compressed image formats");
+    if (srcImageDesc.format == ImageFormat::DepthStencil)
+        throw std::invalid_argument("cannot resize depth-stencil image formats");
+    if (GetExtentVolume(srcExtent) == 0 && GetExtentVolume(dstExtent) != 0)
+        throw std::invalid_argument("cannot resize image buffer with empty source extent");
+
+    const auto bpp = static_cast<std::size_t>(ImageDataSize(srcImageDesc.format, srcImageDesc.dataType, 1));
+
+    if (srcImageDesc.dataSize < GetExtentVolume(srcExtent) * bpp)
+        throw std::invalid_argument("data size of source image descriptor is too small for image resize");
+    if (dstImageDesc.dataSize < GetExtentVolume(dstExtent) * bpp)
+        throw std::invalid_argument("data size of destination image descriptor is too small for image resize");
+}
+
+LLGL_EXPORT void ResizeImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    const ResampleFilter        filter,
+    std::size_t                 threadCount)
+{
+    /* Validate input parameters */
+    ValidateImageResizeParams(srcImageDesc, srcExtent, dstImageDesc, dstExtent);
+
+    if (GetExtentVolume(dstExtent) == 0)
+        return;
+
+    if (threadCount == Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Determine axes to resample */
+    int axes[3];
+    const int numAxes = GetResampleAxes(srcExtent, dstExtent, axes);
+
+    if (numAxes == 0)
+    {
+        /* Copy image buffer if the extent does not change */
+        ::memcpy(dstImageDesc.data, srcImageDesc.data, ImageDataSize(srcImageDesc.format, srcImageDesc.dataType, 1) * GetExtentVolume(dstExtent));
+        return;
+    }
+
+    /* Resample with double precision for data types that cannot be represented by 32-bit floats */
+    if (RequiresDoublePrecision(srcImageDesc.dataType))
+        ResizeImageBufferWithPrecision<double>(srcImageDesc, srcExtent, dstImageDesc, dstExtent, axes, numAxes, filter, threadCount);
+    else
+        ResizeImageBufferWithPrecision<float>(srcImageDesc, srcExtent, dstImageDesc, dstExtent, axes, numAxes, filter, threadCount);
+}
+
+
+/* ----- MIP-map chain ----- */
+
+static Extent3D GetMipExtent(const Extent3D& extent, std::uint32_t mipLevel)
+{
+    return Extent3D
+    {
+        std::max(1u, extent.width  >> mipLevel),
+        std::max(1u, extent.height >> mipLevel),
+        std::max(1u, extent.depth  >> mipLevel),
+    };
+}
+
+LLGL_EXPORT std::size_t MipChainOffset(
+    const ImageFormat   format,
+    const DataType      dataType,
+    const Extent3D&     extent,
+    std::uint32_t       arrayLayers,
+    std::uint32_t       mipLevel)
+{
+    const auto bytesPerPixel = static_cast<std::size_t>(ImageDataSize(format, dataType, 1));
+
+    std::size_t offset = 0;
+    for (std::uint32_t i = 0; i < mipLevel; ++i)
+        offset += GetExtentVolume(GetMipExtent(extent, i)) * arrayLayers * bytesPerPixel;
+
+    return offset;
+}
+
+/*
+Generates the MIP-map levels [1, numMipLevels) of the MIP-map chain buffer 'dst', whose base level has already been copied.
+Each level is downsampled from the previous one. Unless the data type is the floating-point type of the filter and the components are linear,
+each level is retained as a linear floating-point image for the next level and converted into the MIP-map chain buffer afterwards.
+*/
+template <typename TReal>
+static void GenerateMipChainWithPrecision(
+    const SrcImageDescriptor&   imageDesc,
+    const Extent3D&             extent,
+    std::uint32_t               numMipLevels,
+    std::uint32_t               arrayLayers,
+    const ResampleFilter        filter,
+    const SRGBComponentLayout*  sRGB,
+    char*                       dst,
+    std::size_t                 threadCount)
+{
+    const auto numComponents    = static_cast<std::size_t>(ImageFormatSize(imageDesc.format));
+    const auto bytesPerPixel    = static_cast<std::size_t>(ImageDataSize(imageDesc.format, imageDesc.dataType, 1));
+    const auto realDataType     = GetResampleDataType<TReal>();
+    const bool retainLevels     = (sRGB != nullptr || !IsResampleDataType<TReal>(imageDesc.dataType));
+
+    std::unique_ptr<TReal[]> prevLevel, nextLevel;
+
+    for (std::uint32_t mipLevel = 1; mipLevel < numMipLevels; ++mipLevel)
+    {
+        const auto srcExtent    = GetMipExtent(extent, mipLevel - 1);
+        const auto dstExtent    = GetMipExtent(extent, mipLevel);
+        const auto srcVolume    = GetExtentVolume(srcExtent);
+        const auto dstVolume    = GetExtentVolume(dstExtent);
+        const auto srcLevel     = dst + MipChainOffset(imageDesc.format, imageDesc.dataType, extent, arrayLayers, mipLevel - 1);
+        const auto dstLevel     = dst + MipChainOffset(imageDesc.format, imageDesc.dataType, extent, arrayLayers, mipLevel);
+
+        int axes[3];
+        const int numAxes = GetResampleAxes(srcExtent, dstExtent, axes);
+
+        if (retainLevels)
+            nextLevel = MakeUniqueArray<TReal>(dstVolume * arrayLayers * numComponents);
+
+        for (std::uint32_t arrayLayer = 0; arrayLayer < arrayLayers; ++arrayLayer)
+        {
+            /* The first level reads from the base level, all other levels from the previous level */
+            ResampleSrcBuffer<TReal> src { srcLevel + srcVolume * bytesPerPixel * arrayLayer, imageDesc.dataType, nullptr };
+
+            if (mipLevel == 1)
+                src.sRGB = sRGB;
+            else if (retainLevels)
+                src = { prevLevel.get() + srcVolume * numComponents * arrayLayer, realDataType, nullptr };
+
+            ResampleDstBuffer<TReal> dstBuffer { dstLevel + dstVolume * bytesPerPixel * arrayLayer, imageDesc.dataType, nullptr };
+
+            if (retainLevels)
+                dstBuffer = { nextLevel.get() + dstVolume * numComponents * arrayLayer, realDataType, nullptr };
+
+            ResampleImage(src, dstBuffer, srcExtent, dstExtent, axes, numAxes, numComponents, filter, threadCount);
+        }
+
+        if (retainLevels)
+        {
+            /* Convert retained level into the MIP-map chain buffer */
+            const auto numLevelComponents = dstVolume * arrayLayers * numComponents;
+
+            ResampleParallelFor(
+                numLevelComponents,
+                g_tileMinComponents,
+                threadCount,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    ResampleDstBuffer<TReal> levelBuffer { dstLevel, imageDesc.dataType, sRGB };
+                    std::vector<TReal> scratch;
+
+                    for (auto offset = begin; offset < end; offset += g_spanChunkSize)
+                    {
+                        const auto count    = std::min(g_spanChunkSize, end - offset);
+                        const auto line     = levelBuffer.BeginLine(offset, count, scratch);
+                        std::copy(nextLevel.get() + offset, nextLevel.get() + offset + count, line);
+                        levelBuffer.EndLine(offset, count, scratch);
+                    }
+                }
+            );
+
+            prevLevel = std::move(nextLevel);
+        }
+    }
+}
+
+LLGL_EXPORT ByteBuffer GenerateMipChainBuffer(
+    const SrcImageDescriptor&   imageDesc,
+    const Extent3D&             extent,
+    const MipChainDescriptor&   mipChainDesc,
+    std::size_t                 threadCount)
+{
+    /* Validate input parameters */
+    LLGL_ASSERT_PTR(imageDesc.data);
+    if (IsCompressedFormat(imageDesc.format))
+        throw std::invalid_argument("cannot generate MIP-map chain for compressed image formats");
+    if (IsDepthStencilFormat(imageDesc.format))
+    {
+        if (imageDesc.format == ImageFormat::DepthStencil)
+            throw std::invalid_argument("cannot generate MIP-map chain for depth-stencil image formats");
+        if (mipChainDesc.sRGB)
+            throw std::invalid_argument("cannot generate MIP-map chain with sRGB conversion for depth image formats");
+    }
+    if (GetExtentVolume(extent) == 0 || mipChainDesc.arrayLayers == 0)
+        throw std::invalid_argument("cannot generate MIP-map chain for empty image");
+
+    const auto maxMipLevels = NumMipLevels(extent.width, extent.height, extent.depth);
+    const auto numMipLevels = (mipChainDesc.mipLevels == 0 ? maxMipLevels : mipChainDesc.mipLevels);
+
+    if (numMipLevels > maxMipLevels)
+        throw std::invalid_argument("number of MIP-map levels exceeds the MIP-map chain of the image extent");
+
+    const auto baseLevelSize = MipChainOffset(imageDesc.format, imageDesc.dataType, extent, mipChainDesc.arrayLayers, 1);
+
+    if (imageDesc.dataSize < baseLevelSize)
+        throw std::invalid_argument("data size of image descriptor is too small for MIP-map chain generation");
+
+    if (threadCount == Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Allocate MIP-map chain buffer and copy base level */
+    auto dst = GenerateEmptyByteBuffer(MipChainOffset(imageDesc.format, imageDesc.dataType, extent, mipChainDesc.arrayLayers, numMipLevels), false);
+    ::memcpy(dst.get(), imageDesc.data, baseLevelSize);
+
+    /* Generate MIP-map levels with double precision for data types that cannot be represented by 32-bit floats */
+    const auto sRGBLayout   = GetSRGBComponentLayout(imageDesc.format);
+    const auto sRGB         = (mipChainDesc.sRGB ? &sRGBLayout : nullptr);
+
+    if (RequiresDoublePrecision(imageDesc.dataType))
+        GenerateMipChainWithPrecision<double>(imageDesc, extent, numMipLevels, mipChainDesc.arrayLayers, mipChainDesc.filter, sRGB, dst.get(), threadCount);
+    else
+        GenerateMipChainWithPrecision<float>(imageDesc, extent, numMipLevels, mipChainDesc.arrayLayers, mipChainDesc.filter, sRGB, dst.get(), threadCount);
+
+    return dst;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
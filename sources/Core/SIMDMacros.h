@@ -0,0 +1,57 @@
+/*
+ * SIMDMacros.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SIMD_MACROS_H
+#define LLGL_SIMD_MACROS_H
+
+
+/*
+Defines the LLGL_SIMD_* macros for each instruction set that is available at compile time and includes the respective intrinsic headers.
+LLGL_SIMD_X86 is defined for all x86 targets: functions can then use any x86 instruction set with LLGL_SIMD_TARGET,
+but must only be called if the CPU supports it (see GetSIMDFeatures in "ImageConversionKernels.h").
+No macro is defined if LLGL_ENABLE_SIMD is not defined.
+*/
+
+#ifdef LLGL_ENABLE_SIMD
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define LLGL_SIMD_SSE2
+#       include <emmintrin.h>
+#   endif
+#   if defined(__SSSE3__) || defined(__AVX2__)
+#       define LLGL_SIMD_SSSE3
+#       include <tmmintrin.h>
+#   endif
+#   if defined(__AVX2__)
+#       define LLGL_SIMD_AVX2
+#   endif
+#   if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#       define LLGL_SIMD_F16C
+#   endif
+#   if defined(LLGL_SIMD_AVX2) || defined(LLGL_SIMD_F16C)
+#       include <immintrin.h>
+#   endif
+#   if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#       define LLGL_SIMD_X86
+#       include <immintrin.h>
+#       if defined(_MSC_VER) && !defined(__clang__)
+#           define LLGL_SIMD_TARGET(ISA)
+#       else
+#           define LLGL_SIMD_TARGET(ISA) __attribute__((target(ISA)))
+#       endif
+#   endif
+#   if defined(__ARM_NEON) && defined(__aarch64__)
+#       define LLGL_SIMD_NEON
+#       include <arm_neon.h>
+#   endif
+#endif // /LLGL_ENABLE_SIMD
+
+
+#endif
+
+
+
+// ================================================================================
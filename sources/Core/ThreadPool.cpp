@@ -0,0 +1,351 @@
+/*
+ * ThreadPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ThreadPool.h"
+#include <LLGL/Constants.h>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Range of tiles [front, back) that have not been processed yet.
+struct ThreadPoolTileQueue
+{
+    std::mutex  mutex;
+    std::size_t front   = 0;
+    std::size_t back    = 0;
+};
+
+struct ThreadPool::Job
+{
+    Job(const TileFunction& func, std::size_t count, std::size_t tileSize, std::size_t numSlots) :
+        func     { func     },
+        count    { count    },
+        tileSize { tileSize },
+        queues   ( numSlots )
+    {
+    }
+
+    const TileFunction&                 func;
+    std::size_t                         count           = 0;
+    std::size_t                         tileSize        = 0;
+    std::vector<ThreadPoolTileQueue>    queues;                 // One queue per participating thread
+    std::size_t                         nextSlot        = 1;    // Next free slot for a worker thread (slot 0 is the calling thread); guarded by the pool mutex
+    std::size_t                         activeWorkers   = 0;    // Number of worker threads that are processing this job; guarded by 'mutex'
+    std::atomic<bool>                   cancelled       { false };
+    std::exception_ptr                  exception;              // First exception thrown by a worker thread; guarded by 'mutex'
+    std::mutex                          mutex;
+    std::condition_variable             cv;
+};
+
+static bool PopFrontTile(ThreadPoolTileQueue& queue, std::size_t& tile)
+{
+    std::lock_guard<std::mutex> guard { queue.mutex };
+    if (queue.front < queue.back)
+    {
+        tile = queue.front++;
+        return true;
+    }
+    return false;
+}
+
+static bool PopBackTile(ThreadPoolTileQueue& queue, std::size_t& tile)
+{
+    std::lock_guard<std::mutex> guard { queue.mutex };
+    if (queue.front < queue.back)
+    {
+        tile = --queue.back;
+        return true;
+    }
+    return false;
+}
+
+
+/*
+ * ThreadPool class
+ */
+
+ThreadPool::ThreadPool(std::size_t numWorkers)
+{
+    StartWorkers(numWorkers);
+}
+
+ThreadPool::~ThreadPool()
+{
+    StopWorkers();
+}
+
+void ThreadPool::Resize(std::size_t numWorkers)
+{
+    StopWorkers();
+    StartWorkers(numWorkers);
+}
+
+std::size_t ThreadPool::GetNumWorkers() const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    return workers_.size();
+}
+
+void ThreadPool::ParallelFor(std::size_t count, std::size_t tileSize, std::size_t maxThreads, const TileFunction& func)
+{
+    if (count == 0)
+        return;
+
+    /* Determine number of participating threads */
+    tileSize = std::max(tileSize, std::size_t(1));
+
+    const auto numTiles = (count + tileSize - 1) / tileSize;
+    const auto numSlots = std::min({ maxThreads, GetNumWorkers() + 1, numTiles });
+
+    if (numSlots <= 1)
+    {
+        /* Process entire range on the calling thread */
+        func(0, count);
+        return;
+    }
+
+    /* Distribute tiles in contiguous ranges over all slots */
+    Job job { func, count, tileSize, numSlots };
+
+    for (std::size_t i = 0; i < numSlots; ++i)
+    {
+        job.queues[i].front = numTiles * i / numSlots;
+        job.queues[i].back  = numTiles * (i + 1) / numSlots;
+    }
+
+    /* Publish job to worker threads */
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        jobs_.push_back(&job);
+    }
+    cv_.notify_all();
+
+    /* Retract job and wait until all worker threads have left it, so it can be destroyed */
+    auto retractJob = [this, &job]()
+    {
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            jobs_.erase(std::find(jobs_.begin(), jobs_.end(), &job));
+        }
+        std::unique_lock<std::mutex> lock { job.mutex };
+        job.cv.wait(lock, [&job]() { return (job.activeWorkers == 0); });
+    };
+
+    /* Process tiles on the calling thread as well */
+    try
+    {
+        RunJob(job, 0);
+    }
+    catch (...)
+    {
+        job.cancelled = true;
+        retractJob();
+        throw;
+    }
+
+    retractJob();
+
+    /* Rethrow exception of a worker thread on the calling thread */
+    if (job.exception)
+        std::rethrow_exception(job.exception);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ThreadPool::RunJob(Job& job, std::size_t slot)
+{
+    const auto numSlots = job.queues.size();
+
+    for (std::size_t tile = 0; !job.cancelled;)
+    {
+        bool found = PopFrontTile(job.queues[slot], tile);
+
+        for (std::size_t i = 1; !found && i < numSlots; ++i)
+            found = PopBackTile(job.queues[(slot + i) % numSlots], tile);
+
+        if (!found)
+            break;
+
+        const auto begin = tile * job.tileSize;
+        job.func(begin, std::min(begin + job.tileSize, job.count));
+    }
+}
+
+void ThreadPool::CancelJob(Job& job, const std::exception_ptr& exception)
+{
+    std::lock_guard<std::mutex> guard { job.mutex };
+    if (!job.exception)
+        job.exception = exception;
+    job.cancelled = true;
+}
+
+void ThreadPool::StartWorkers(std::size_t numWorkers)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    stop_ = false;
+    workers_.reserve(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; ++i)
+        workers_.emplace_back(&ThreadPool::WorkerProc, this);
+}
+
+void ThreadPool::StopWorkers()
+{
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        stop_ = true;
+        workers = std::move(workers_);
+        workers_.clear();
+    }
+    cv_.notify_all();
+
+    for (auto& w : workers)
+        w.join();
+}
+
+void ThreadPool::WorkerProc()
+{
+    while (true)
+    {
+        Job*        job     = nullptr;
+        std::size_t slot    = 0;
+
+        /* Wait for a job with a free slot */
+        {
+            std::unique_lock<std::mutex> lock { mutex_ };
+            cv_.wait(lock, [this, &job]() { return (stop_ || (job = FindJob()) != nullptr); });
+
+            if (stop_)
+                return;
+
+            slot = job->nextSlot++;
+
+            std::lock_guard<std::mutex> guard { job->mutex };
+            job->activeWorkers++;
+        }
+
+        /* Exceptions must not leave the worker thread, so pass them to the calling thread */
+        try
+        {
+            RunJob(*job, slot);
+        }
+        catch (...)
+        {
+            CancelJob(*job, std::current_exception());
+        }
+
+        /* Leave job and notify the calling thread while the lock is held, since the job is destroyed as soon as the calling thread observes no active workers */
+        {
+            std::lock_guard<std::mutex> guard { job->mutex };
+            job->activeWorkers--;
+            job->cv.notify_all();
+        }
+    }
+}
+
+ThreadPool::Job* ThreadPool::FindJob() const
+{
+    for (auto job : jobs_)
+    {
+        if (job->nextSlot < job->queues.size())
+            return job;
+    }
+    return nullptr;
+}
+
+
+/*
+ * Shared thread pool
+ */
+
+static std::mutex                   g_sharedPoolMutex;
+static std::shared_ptr<ThreadPool>  g_sharedPool;
+static std::size_t                  g_sharedPoolRefs    = 0;
+static std::size_t                  g_sharedThreadCount = Constants::maxThreadCount;
+
+// Returns the number of worker threads for the specified thread count that includes the calling thread.
+static std::size_t GetNumWorkersForThreadCount(std::size_t threadCount)
+{
+    if (threadCount == Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+    return (threadCount > 1 ? threadCount - 1 : 0);
+}
+
+void ThreadPool::ParallelForShared(std::size_t count, std::size_t tileSize, std::size_t maxThreads, const TileFunction& func)
+{
+    /* Keep a reference to the shared thread pool, so it stays alive even if the last render system releases it during this call */
+    std::shared_ptr<ThreadPool> pool;
+    std::size_t numWorkers = 0;
+    {
+        std::lock_guard<std::mutex> guard { g_sharedPoolMutex };
+        pool        = g_sharedPool;
+        numWorkers  = GetNumWorkersForThreadCount(g_sharedThreadCount);
+    }
+
+    if (pool)
+        pool->ParallelFor(count, tileSize, maxThreads, func);
+    else
+    {
+        /* Use a temporary thread pool without more worker threads than this call can use */
+        tileSize = std::max(tileSize, std::size_t(1));
+        const auto numTiles = (count + tileSize - 1) / tileSize;
+        numWorkers = std::min({ numWorkers, std::max(maxThreads, std::size_t(1)) - 1, (numTiles > 0 ? numTiles - 1 : 0) });
+
+        ThreadPool tempPool { numWorkers };
+        tempPool.ParallelFor(count, tileSize, maxThreads, func);
+    }
+}
+
+void ThreadPool::RetainShared()
+{
+    std::lock_guard<std::mutex> guard { g_sharedPoolMutex };
+    if (g_sharedPoolRefs++ == 0)
+        g_sharedPool = std::make_shared<ThreadPool>(GetNumWorkersForThreadCount(g_sharedThreadCount));
+}
+
+void ThreadPool::ReleaseShared()
+{
+    std::shared_ptr<ThreadPool> pool;
+    {
+        std::lock_guard<std::mutex> guard { g_sharedPoolMutex };
+        if (g_sharedPoolRefs > 0 && --g_sharedPoolRefs == 0)
+            pool = std::move(g_sharedPool);
+    }
+
+    /* Join worker threads outside of the lock, unless another thread still uses the pool and joins them when it releases its reference */
+    pool.reset();
+}
+
+void ThreadPool::SetSharedThreadCount(std::size_t threadCount)
+{
+    std::lock_guard<std::mutex> guard { g_sharedPoolMutex };
+    if (g_sharedThreadCount != threadCount)
+    {
+        g_sharedThreadCount = threadCount;
+        if (g_sharedPool)
+            g_sharedPool->Resize(GetNumWorkersForThreadCount(threadCount));
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
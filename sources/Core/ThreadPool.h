@@ -0,0 +1,122 @@
+/*
+ * ThreadPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Persistent pool of worker threads to process a range of elements in parallel.
+The range is split into tiles that are distributed over a queue per participating thread.
+Each thread processes the tiles of its own queue from the front and steals tiles from the back of other queues when its own queue is empty.
+Multiple threads can submit work to the same pool simultaneously.
+Exceptions thrown on a worker thread cancel the remaining tiles and are rethrown on the thread that called 'ParallelFor'.
+*/
+class ThreadPool : public NonCopyable
+{
+
+    public:
+
+        // Function to process all elements in the range [begin, end).
+        using TileFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+    public:
+
+        // Initializes the thread pool with the specified number of worker threads.
+        ThreadPool(std::size_t numWorkers = 0);
+        ~ThreadPool();
+
+        // Joins all worker threads and starts the specified number of new worker threads.
+        void Resize(std::size_t numWorkers);
+
+        // Returns the number of worker threads.
+        std::size_t GetNumWorkers() const;
+
+        /*
+        Calls 'func' for all tiles of the range [0, count) and returns when all tiles have been processed.
+        Each tile covers 'tileSize' elements, except the last one. The calling thread processes tiles as well.
+        At most 'maxThreads' threads, including the calling thread, process the tiles of this range.
+        If 'func' throws an exception, the remaining tiles are skipped and the first exception is rethrown on the calling thread.
+        */
+        void ParallelFor(std::size_t count, std::size_t tileSize, std::size_t maxThreads, const TileFunction& func);
+
+    public:
+
+        /*
+        Calls 'ParallelFor' on the thread pool that is shared by the entire library.
+        The shared thread pool only exists while a render system holds a reference to it (see 'RetainShared').
+        Otherwise, a temporary thread pool is used for this call.
+        */
+        static void ParallelForShared(std::size_t count, std::size_t tileSize, std::size_t maxThreads, const TileFunction& func);
+
+        /*
+        Adds a reference to the shared thread pool and creates it for the first reference.
+        It is created with the thread count of the last call to 'SetSharedThreadCount', or the number of hardware threads by default.
+        */
+        static void RetainShared();
+
+        /*
+        Removes a reference from the shared thread pool. The last reference stops and joins all worker threads,
+        so they are never joined during static destruction, e.g. while the loader lock is held on Windows.
+        */
+        static void ReleaseShared();
+
+        /*
+        Sets the number of threads for the shared thread pool, including the calling thread (see RenderSystemConfiguration::threadCount).
+        If this is 'Constants::maxThreadCount', the number of hardware threads is used.
+        */
+        static void SetSharedThreadCount(std::size_t threadCount);
+
+    private:
+
+        struct Job;
+
+        // Processes the tiles of the specified slot, then steals tiles from all other slots until no tiles are left.
+        static void RunJob(Job& job, std::size_t slot);
+
+        // Skips all remaining tiles of the specified job and stores the first exception.
+        static void CancelJob(Job& job, const std::exception_ptr& exception);
+
+        void StartWorkers(std::size_t numWorkers);
+        void StopWorkers();
+
+        void WorkerProc();
+        Job* FindJob() const;
+
+    private:
+
+        std::vector<std::thread>    workers_;
+        std::vector<Job*>           jobs_;
+        mutable std::mutex          mutex_;
+        std::condition_variable     cv_;
+        bool                        stop_       = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -8,6 +8,7 @@
 #include "AMD64Assembler.h"
 #include "AMD64Opcode.h"
 #include <limits.h>
+#include <algorithm>
 
 #include <fstream>//!!!
 #include <iomanip>
@@ -51,8 +52,18 @@ static const Reg g_amd64TempReg     = Reg::RAX;
 
 #endif
 
+/*
+List of callee-saved registers that keep integral entry point parameters across all function calls.
+These registers are preserved in both the Microsoft x64 calling convention and the System V AMD64 ABI.
+*/
+static const Reg g_amd64SavedRegs[] = { Reg::RBX, Reg::R12, Reg::R13, Reg::R14, Reg::R15 };
+
+// Size (in bytes) of the stack area at the bottom of the stack frame that is reserved for arguments of function calls.
+static const std::uint32_t g_amd64ArgStackSize = 128;
+
 static const std::size_t g_amd64IntParamsCount = sizeof(g_amd64IntParams)/sizeof(g_amd64IntParams[0]);
 static const std::size_t g_amd64FltParamsCount = sizeof(g_amd64FltParams)/sizeof(g_amd64FltParams[0]);
+static const std::size_t g_amd64SavedRegsCount = sizeof(g_amd64SavedRegs)/sizeof(g_amd64SavedRegs[0]);
 
 
 /*
@@ -82,9 +93,18 @@ void AMD64Assembler::Begin()
     #endif
     
     /* Reset data about local stack */
-    localStackSize_ = 128;//0;
+    localStackSize_ = 0;
     paramStackSize_ = 0;
     
+    /* Keep integral entry point parameters in callee-saved registers (RBX is always preserved) */
+    std::size_t numIntVarArgs = 0;
+    for (auto type : GetEntryVarArgs())
+    {
+        if (!IsFloat(type))
+            ++numIntVarArgs;
+    }
+    numSavedRegs_ = std::max(std::size_t(1), std::min(numIntVarArgs, g_amd64SavedRegsCount));
+    
     /* Write entry point prologue */
     WritePrologue();
     WriteStackFrame(GetEntryVarArgs(), GetStackAllocs());
@@ -110,6 +130,61 @@ void AMD64Assembler::End()
     #endif // /TEST
 }
 
+void AMD64Assembler::BeginIfNotEqual(const JITVarArg& base, std::int32_t offset, std::uint32_t value)
+{
+    /* Compare value in memory with immediate value, and jump to the end of this block if they are equal */
+    CmpMemImm32(LoadVarArgPtr(base.index), offset, value);
+    JERel32(0); // displacement (dummy)
+    
+    /* Store offset of the next instruction to update the jump displacement at the end of this block */
+    condJumps_.push_back(GetAssembly().size());
+}
+
+void AMD64Assembler::EndIf()
+{
+    if (!condJumps_.empty())
+    {
+        /* Override displacement dummy with distance from the conditional jump to the end of this block */
+        auto& code = GetAssembly();
+        auto rip = condJumps_.back();
+        condJumps_.pop_back();
+        
+        auto disp32 = static_cast<std::uint32_t>(code.size() - rip);
+        ::memcpy(&(code[rip - sizeof(disp32)]), &disp32, sizeof(disp32));
+    }
+}
+
+void AMD64Assembler::StoreDWord(const JITVarArg& base, std::int32_t offset, std::uint32_t value)
+{
+    MovMemDispImm32(LoadVarArgPtr(base.index), offset, value);
+}
+
+void AMD64Assembler::StoreStack(const JITStackPtr& dst, const void* data, std::size_t size)
+{
+    if (dst.index < stackChunkOffsets_.size())
+    {
+        auto byteAlignedData = reinterpret_cast<const std::uint8_t*>(data);
+        auto disp = -static_cast<std::int32_t>(stackChunkOffsets_[dst.index]);
+        
+        /* Store data in 64-bit immediate values via temporary register */
+        for (; size >= 8; size -= 8, byteAlignedData += 8, disp += 8)
+        {
+            std::uint64_t qword = 0;
+            ::memcpy(&qword, byteAlignedData, 8);
+            MovRegImm64(g_amd64TempReg, qword);
+            MovMemDispReg(Reg::RBP, disp, g_amd64TempReg);
+        }
+        
+        /* Store remaining data in 32-bit immediate values */
+        for (; size >= 4; size -= 4, byteAlignedData += 4, disp += 4)
+        {
+            std::uint32_t dword = 0;
+            ::memcpy(&dword, byteAlignedData, 4);
+            MovMemDispImm32(Reg::RBP, disp, dword);
+        }
+    }
+}
+
 void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farCall)
 {
     const auto& args = GetArgs();
@@ -142,13 +217,22 @@ void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farC
         
         if (arg.param < 0xF)
         {
-            if (arg.param < varArgDisp_.size())
+            if (arg.param < varArgs_.size())
             {
-                /* Move parameter from local stack into destination register */
-                if (IsFltReg(dstReg))
-                    MovDQURegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
+                const auto& varArg = varArgs_[arg.param];
+                if (varArg.inReg)
+                {
+                    /* Move parameter from callee-saved register into destination register */
+                    MovReg(dstReg, varArg.reg);
+                }
                 else
-                    MovRegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
+                {
+                    /* Move parameter from local stack into destination register */
+                    if (IsFltReg(dstReg))
+                        MovDQURegMem(dstReg, Reg::RBP, varArg.disp);
+                    else
+                        MovRegMem(dstReg, Reg::RBP, varArg.disp);
+                }
             }
         }
         else if (dstReg >= Reg::R8 && dstReg <= Reg::R15)
@@ -278,20 +362,16 @@ void AMD64Assembler::WritePrologue()
     PushReg(Reg::RBP);
     MovReg(Reg::RBP, Reg::RSP);
     
-    #if 1
-    /* Store general purpose registers */
-    //TODO: determine which registers must be stored
-    PushReg(Reg::RBX);
-    #endif
+    /* Store callee-saved registers */
+    for (std::size_t i = 0; i < numSavedRegs_; ++i)
+        PushReg(g_amd64SavedRegs[i]);
 }
 
 void AMD64Assembler::WriteEpilogue()
 {
-    #if 1
-    /* Restore general purpose registers */
-    //TODO: determine which registers must be restored
-    PopReg(Reg::RBX);
-    #endif
+    /* Restore callee-saved registers */
+    for (std::size_t i = numSavedRegs_; i > 0; --i)
+        PopReg(g_amd64SavedRegs[i - 1]);
 
     /* Restore base stack pointer (RBP) */
     PopReg(Reg::RBP);
@@ -302,30 +382,41 @@ void AMD64Assembler::WriteStackFrame(
     const std::vector<JIT::ArgType>&    varArgTypes,
     const std::vector<std::uint32_t>&   stackChunks)
 {
-    /* Determine required stack size for variadic arguments */
+    /* Determine required stack size for variadic arguments that are not kept in callee-saved registers */
     std::uint32_t varArgSize = 0;
+    std::size_t numVarArgRegs = 0;
+    
     for (auto type : varArgTypes)
-        varArgSize += (IsFloat(type) ? 16 : 8);
+    {
+        if (!IsFloat(type) && numVarArgRegs < numSavedRegs_)
+            ++numVarArgRegs;
+        else
+            varArgSize += (IsFloat(type) ? 16 : 8);
+    }
     
     /* Determine required stack size for allocations */
     std::uint32_t stackChunksSize = 0;
     for (auto chunk : stackChunks)
         stackChunksSize += chunk;
     
-    /* Allocate local stack */
-    localStackSize_ += varArgSize;
+    /*
+    Allocate local stack: [callee-saved registers][variadic arguments][stack chunks][arguments for function calls].
+    The stack pointer must be aligned to 16 bytes for each function call,
+    and it is already aligned after the return address and RBP have been pushed onto the stack.
+    */
+    const auto savedRegsSize = static_cast<std::uint32_t>(numSavedRegs_ * 8);
     
-    std::uint32_t chunkStackOffset = localStackSize_ + 8;
+    localStackSize_ = varArgSize + stackChunksSize + g_amd64ArgStackSize;
+    localStackSize_ = GetAlignedSize(savedRegsSize + localStackSize_, 16u) - savedRegsSize;
     
-    localStackSize_ += stackChunksSize;
+    SubImm32(Reg::RSP, localStackSize_);
     
-    if (localStackSize_ > 0)
-        SubImm32(Reg::RSP, localStackSize_);
-    
-    /* Store parameters in local stack */
+    /* Store parameters in callee-saved registers or local stack */
     std::size_t numIntRegs = 0, numFltRegs = 0;
-    std::int8_t paramStackOffset = 16; // first parameter at [EBP+16]
-    std::int8_t localStackOffset = -16; // local variables after preserved EBX
+    std::int8_t paramStackOffset = 16; // first parameter at [RBP+16]
+    std::int8_t localStackOffset = -static_cast<std::int8_t>(savedRegsSize); // local variables after callee-saved registers
+    
+    numVarArgRegs = 0;
     
     for (auto type : varArgTypes)
     {
@@ -350,30 +441,43 @@ void AMD64Assembler::WriteStackFrame(
             paramStackSize_ += 8;
         }
         
-        /* Store parameter in local stack */
-        if (IsFltReg(srcReg))
+        VarArgLocation varArg;
+        varArg.inReg    = false;
+        varArg.reg      = srcReg;
+        
+        if (!isFloat && numVarArgRegs < numSavedRegs_)
         {
+            /* Keep parameter in callee-saved register */
+            varArg.inReg    = true;
+            varArg.reg      = g_amd64SavedRegs[numVarArgRegs++];
+            MovReg(varArg.reg, srcReg);
+        }
+        else if (IsFltReg(srcReg))
+        {
+            /* Store parameter in local stack */
             localStackOffset -= 16; // SSE2 register size of 128 bits
             MovDQUMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
+            varArg.disp = Disp8{ localStackOffset };
         }
         else
         {
+            /* Store parameter in local stack */
             localStackOffset -= 8; // x64 register size of 64 bits
             MovMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
+            varArg.disp = Disp8{ localStackOffset };
         }
         
-        /* Store parameter offset within stack frame */
-        varArgDisp_.push_back(Disp8{ localStackOffset });
+        /* Store parameter location */
+        varArgs_.push_back(varArg);
     }
     
-    /* Determine stack base for arguments of subsequent calls */
-    argStackBase_.disp8 = localStackOffset;
+    /* Determine base pointer offsets for allocated stack chunks (below the variadic arguments) */
+    auto chunkStackOffset = static_cast<std::uint32_t>(savedRegsSize + varArgSize);
     
-    /* Determine stack base for allocated stack chunks */
     stackChunkOffsets_.reserve(stackChunks.size());
     for (auto chunk : stackChunks)
     {
-        chunkStackOffset += static_cast<std::int32_t>(chunk);
+        chunkStackOffset += chunk;
         stackChunkOffsets_.push_back(chunkStackOffset);
     }
 }
@@ -396,6 +500,21 @@ void AMD64Assembler::WriteOptREX(Reg reg, bool defaultsTo64Bit)
         WriteByte(REX_Prefix | prefix);
 }
 
+void AMD64Assembler::WriteOptREX(bool is64Bit, Reg reg, Reg rmReg)
+{
+    std::uint8_t prefix = 0;
+    
+    if (is64Bit)
+        prefix |= REX_W;
+    if (IsExtReg(reg))
+        prefix |= REX_R;
+    if (IsExtReg(rmReg))
+        prefix |= REX_B;
+    
+    if (prefix != 0)
+        WriteByte(REX_Prefix | prefix);
+}
+
 void AMD64Assembler::WriteOptDisp(const Displacement& disp)
 {
     if (disp.disp32 != 0)
@@ -413,6 +532,39 @@ void AMD64Assembler::WriteOptSIB(Reg reg)
         WriteByte((RegByte(reg) << 3) | RegByte(reg));
 }
 
+// Writes ModR/M, SIB, and displacement for the memory operand [memReg + disp]
+void AMD64Assembler::WriteModRMMem(std::uint8_t reg, Reg memReg, std::int32_t disp)
+{
+    std::uint8_t mode = 0;
+    
+    /* RBP and R13 can only be encoded with a displacement (otherwise it denotes RIP-relative addressing) */
+    if (disp != 0 || RegByte(memReg) == RegByte(Reg::RBP))
+        mode = (disp >= SCHAR_MIN && disp <= SCHAR_MAX ? Operand_Mod01 : Operand_Mod10);
+    
+    WriteByte(mode | ((reg & 0x07) << 3) | RegByte(memReg));
+    
+    /* RSP and R12 can only be encoded with a SIB byte */
+    if (RegByte(memReg) == RegByte(Reg::RSP))
+        WriteByte((RegByte(Reg::RSP) << 3) | RegByte(Reg::RSP));
+    
+    if (mode == Operand_Mod01)
+        WriteByte(static_cast<std::uint8_t>(static_cast<std::int8_t>(disp)));
+    else if (mode == Operand_Mod10)
+        WriteDWord(static_cast<std::uint32_t>(disp));
+}
+
+// Returns the register that holds the specified entry point parameter, or loads it into the temporary register
+Reg AMD64Assembler::LoadVarArgPtr(std::uint8_t idx)
+{
+    const auto& varArg = varArgs_.at(idx);
+    if (!varArg.inReg)
+    {
+        MovRegMem(g_amd64TempReg, Reg::RBP, varArg.disp);
+        return g_amd64TempReg;
+    }
+    return varArg.reg;
+}
+
 void AMD64Assembler::BeginSupplement(const Arg& arg)
 {
     Supplement supp;
@@ -515,7 +667,7 @@ void AMD64Assembler::Pop(Reg dstReg)
 // Opcode: 89 /r
 void AMD64Assembler::MovReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    WriteOptREX(Is64Reg(dstReg), srcReg, dstReg);
     WriteByte(Opcode_MovMemReg);
     WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
 }
@@ -555,7 +707,7 @@ void AMD64Assembler::MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displ
 
 void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp)
 {
-    WriteOptREX(srcReg); // prefix
+    WriteOptREX(Is64Reg(srcReg), srcReg, dstMemReg); // prefix
     WriteByte(Opcode_MovMemReg);
     WriteByte(ModRM(DispMod(disp), srcReg, dstMemReg));
     WriteOptSIB(dstMemReg);
@@ -564,13 +716,30 @@ void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& di
 
 void AMD64Assembler::MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
 {
-    WriteOptREX(dstReg);
+    WriteOptREX(Is64Reg(dstReg), dstReg, srcMemReg);
     WriteByte(Opcode_MovRegMem);
     WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
     WriteOptSIB(srcMemReg);
     WriteOptDisp(disp);
 }
 
+// Opcode: C7 /0 id
+void AMD64Assembler::MovMemDispImm32(Reg dstMemReg, std::int32_t disp, std::uint32_t dword)
+{
+    WriteOptREX(false, Reg::RAX, dstMemReg);
+    WriteByte(Opcode_MovMemImm);
+    WriteModRMMem(0, dstMemReg, disp);
+    WriteDWord(dword);
+}
+
+// Opcode: REX.W 89 /r
+void AMD64Assembler::MovMemDispReg(Reg dstMemReg, std::int32_t disp, Reg srcReg)
+{
+    WriteOptREX(true, srcReg, dstMemReg);
+    WriteByte(Opcode_MovMemReg);
+    WriteModRMMem(RegByte(srcReg), dstMemReg, disp);
+}
+
 #if 0 // UNUSED
 // dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
 void AMD64Assembler::MovSSRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
@@ -679,6 +848,26 @@ void AMD64Assembler::XOrReg(Reg dstReg, Reg srcReg)
     WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
 }
 
+/* ----- CMP ----- */
+
+// Opcode: 81 /7 id
+void AMD64Assembler::CmpMemImm32(Reg memReg, std::int32_t disp, std::uint32_t dword)
+{
+    WriteOptREX(false, Reg::RAX, memReg);
+    WriteByte(Opcode_CmpMemImm);
+    WriteModRMMem(7u, memReg, disp);
+    WriteDWord(dword);
+}
+
+/* ----- JMP ----- */
+
+// Opcode: 0F 84 cd
+void AMD64Assembler::JERel32(std::int32_t disp)
+{
+    Write(Opcode_JERel32, 2);
+    WriteDWord(static_cast<std::uint32_t>(disp));
+}
+
 /* ----- CALL ----- */
 
 void AMD64Assembler::CallNear(Reg reg)
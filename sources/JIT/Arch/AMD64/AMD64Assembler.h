@@ -31,6 +31,12 @@ class AMD64Assembler final : public JITCompiler
         void Begin() override;
         void End() override;
 
+        void BeginIfNotEqual(const JITVarArg& base, std::int32_t offset, std::uint32_t value) override;
+        void EndIf() override;
+
+        void StoreDWord(const JITVarArg& base, std::int32_t offset, std::uint32_t value) override;
+        void StoreStack(const JITStackPtr& dst, const void* data, std::size_t size) override;
+
     private:
 
         bool IsLittleEndian() const override;
@@ -52,8 +58,12 @@ class AMD64Assembler final : public JITCompiler
         );
 
         void WriteOptREX(Reg reg, bool defaultsTo64Bit = false);
+        void WriteOptREX(bool is64Bit, Reg reg, Reg rmReg);
         void WriteOptDisp(const Displacement& disp);
         void WriteOptSIB(Reg reg);
+        void WriteModRMMem(std::uint8_t reg, Reg memReg, std::int32_t disp);
+
+        Reg LoadVarArgPtr(std::uint8_t idx);
     
         void BeginSupplement(const Arg& arg);
         void EndSupplement();
@@ -78,6 +88,8 @@ class AMD64Assembler final : public JITCompiler
         void MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displacement& disp);
         void MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp);
         void MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
+        void MovMemDispImm32(Reg dstMemReg, std::int32_t disp, std::uint32_t dword);
+        void MovMemDispReg(Reg dstMemReg, std::int32_t disp, Reg srcReg);
     
         #if 0 // UNUSED
         void MovSSRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
@@ -95,6 +107,9 @@ class AMD64Assembler final : public JITCompiler
         void DivReg(Reg srcReg);
         void XOrReg(Reg dstReg, Reg srcReg);
 
+        void CmpMemImm32(Reg memReg, std::int32_t disp, std::uint32_t dword);
+        void JERel32(std::int32_t disp);
+
         void CallNear(Reg reg);
 
         void RetNear(std::uint16_t word = 0);
@@ -140,17 +155,27 @@ class AMD64Assembler final : public JITCompiler
             Disp32(std::int32_t disp);
         };
 
+        struct VarArgLocation
+        {
+            bool            inReg;  // Specifies whether the parameter is kept in a callee-saved register
+            Reg             reg;    // Callee-saved register that holds the parameter
+            Displacement    disp;   // Displacement of the parameter within the stack frame
+        };
+
     private:
     
-        std::uint32_t           	localStackSize_ = 0;
+        std::uint32_t               localStackSize_ = 0;
         std::uint16_t               paramStackSize_ = 0;
-        Displacement                argStackBase_;
+        std::size_t                 numSavedRegs_   = 0;
     
         // Supplement data that must be updated after encoding
         std::vector<Supplement>     supplements_;
     
-        // Displacements of parameters within stack frame
-        std::vector<Displacement>   varArgDisp_;
+        // Locations of parameters within callee-saved registers or stack frame
+        std::vector<VarArgLocation> varArgs_;
+
+        // Byte offsets of the displacements of conditional jumps that must be updated at the end of their block
+        std::vector<std::size_t>    condJumps_;
     
         // Base pointer offsets of stack allocations
         std::vector<std::uint32_t>  stackChunkOffsets_;
@@ -72,6 +72,7 @@ enum Opcode : std::uint8_t
     Opcode_PopReg       = 0x58, // 58 +rq
     Opcode_AddImm       = 0x81, // 81 /0 id
     Opcode_SubImm       = 0x81, // 81 /5 id
+    Opcode_CmpMemImm    = 0x81, // 81 /7 id
     Opcode_DivReg       = 0xF7, // F7 /6
     Opcode_XOrMemReg    = 0x31, // 31 /r
     Opcode_XOrRegMem    = 0x33, // 33 /r
@@ -88,6 +89,8 @@ enum Opcode : std::uint8_t
     Opcode_Int          = 0xCD, // CD ib
 };
 
+static const std::uint8_t Opcode_JERel32[2] = { 0x0F, 0x84 }; // 0F 84 cd
+
 static const std::uint8_t OpcodeSSE2_MovSSRegMem[3] = { 0xF3, 0x0F, 0x10 };
 static const std::uint8_t OpcodeSSE2_MovSSMemReg[3] = { 0xF3, 0x0F, 0x11 };
 
@@ -130,6 +130,24 @@ class LLGL_EXPORT JITCompiler : public NonCopyable
             FuncCall(GetMemberFuncPtr(func));
         }
 
+    public:
+
+        /*
+        Begins a conditional block, i.e. all instructions until the matching 'EndIf' are only executed
+        if the 32-bit value at the byte offset 'offset' of the entry point parameter 'base' is not equal to 'value'.
+        The entry point parameter 'base' must be a pointer.
+        */
+        virtual void BeginIfNotEqual(const JITVarArg& base, std::int32_t offset, std::uint32_t value) = 0;
+
+        // Ends the current conditional block (see 'BeginIfNotEqual').
+        virtual void EndIf() = 0;
+
+        // Stores the 32-bit value 'value' at the byte offset 'offset' of the entry point parameter 'base'.
+        virtual void StoreDWord(const JITVarArg& base, std::int32_t offset, std::uint32_t value) = 0;
+
+        // Stores the specified data in the stack allocation 'dst' with immediate values, i.e. without calling 'memcpy'.
+        virtual void StoreStack(const JITStackPtr& dst, const void* data, std::size_t size) = 0;
+
     protected:
 
         JITCompiler() = default;
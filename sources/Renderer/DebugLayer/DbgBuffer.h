@@ -32,6 +32,7 @@ class DbgBuffer : public Buffer
         std::uint64_t       elements    = 0;
         bool                initialized = false;
         bool                mapped      = false;
+        std::uint64_t       memoryID    = 0;
 
 };
 
@@ -8,6 +8,7 @@
 #include "DbgCommandBuffer.h"
 #include "DbgCore.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../../Core/Helper.h"
 
 #include "DbgRenderContext.h"
@@ -32,18 +33,29 @@ namespace LLGL
 DbgCommandBuffer::DbgCommandBuffer(
     CommandBuffer&                  instance,
     CommandBufferExt*               instanceExt,
+    RenderingProfiler*              profiler,
     RenderingDebugger*              debugger,
+    DbgScopeTimer*                  scopeTimer,
     const CommandBufferDescriptor&  desc,
     const RenderingCapabilities&    caps) :
         instance      { instance      },
         instanceExt   { instanceExt   },
         desc          { desc          },
+        profiler_     { profiler      },
         debugger_     { debugger      },
+        scopeTimer_   { scopeTimer    },
         features_     { caps.features },
         limits_       { caps.limits   }
 {
 }
 
+DbgCommandBuffer::~DbgCommandBuffer()
+{
+    /* Return queries of the last encoding, which are no longer referenced once its pending submissions have been resolved */
+    if (scopeTimer_)
+        scopeTimer_->ReleaseRecord(timingRecord_);
+}
+
 /* ----- Encoding ----- */
 
 void DbgCommandBuffer::Begin()
@@ -56,13 +68,31 @@ void DbgCommandBuffer::Begin()
     instance.Begin();
 
     profile_.commandBufferEncodings++;
+
+    if (profiler_ != nullptr && profiler_->IsTracing())
+        encodingStartTime_ = profiler_->GetTraceTime();
 }
 
 void DbgCommandBuffer::End()
 {
+    /* Close all timing scopes that are still open, since queries cannot span multiple command buffers */
+    while (!timingScopes_.empty())
+        EndTimingScope();
+
     if (debugger_)
         EnableRecording(false);
+
+    /* Take over the redundant state commands that the renderer has removed from this command buffer into the thread-local counters */
+    const auto counterIndex         = LLGL_PROFILE_COUNTER_INDEX(redundantStateEliminations);
+    const auto prevEliminations     = ReadProfileCounter(counterIndex);
+
     instance.End();
+
+    profile_.redundantStateEliminations += ReadProfileCounter(counterIndex) - prevEliminations;
+
+    /* Trace entire encoding on the calling thread */
+    if (profiler_ != nullptr && profiler_->IsTracing())
+        profiler_->TraceEvent("CommandBuffer", "Encode", encodingStartTime_, profiler_->GetTraceTime() - encodingStartTime_);
 }
 
 void DbgCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize)
@@ -75,7 +105,10 @@ void DbgCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset,
         AssertRecording();
     }
 
-    instance.UpdateBuffer(dstBufferDbg.instance, dstOffset, data, dataSize);
+    {
+        LLGL_DBG_TRACE("CommandBuffer", "UpdateBuffer", dataSize);
+        instance.UpdateBuffer(dstBufferDbg.instance, dstOffset, data, dataSize);
+    }
 
     profile_.bufferUpdates++;
 }
@@ -116,6 +149,11 @@ void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
     }
 
     instance.Execute(commandBufferDbg.instance);
+
+    /* Count the commands of the secondary command buffer for each execution, but not its encoding */
+    const auto numEncodings = profile_.commandBufferEncodings;
+    profile_.Accumulate(commandBufferDbg.profile_);
+    profile_.commandBufferEncodings = numEncodings;
 }
 
 /* ----- Configuration ----- */
@@ -437,6 +475,9 @@ void DbgCommandBuffer::BeginRenderPass(
         states_.insideRenderPass = true;
     }
 
+    /* Queries must not span render pass boundaries, so end the current time segment before the render pass begins */
+    EndTimingSegment();
+
     if (renderTarget.IsRenderContext())
     {
         auto& renderContextDbg = LLGL_CAST(DbgRenderContext&, renderTarget);
@@ -456,6 +497,8 @@ void DbgCommandBuffer::BeginRenderPass(
         instance.BeginRenderPass(renderTargetDbg.instance, renderPass, numClearValues, clearValues);
     }
 
+    BeginTimingSegment();
+
     profile_.renderPassSections++;
 }
 
@@ -470,7 +513,10 @@ void DbgCommandBuffer::EndRenderPass()
         states_.insideRenderPass = false;
     }
 
+    /* Continue current timing scope with a new time segment outside of the render pass */
+    EndTimingSegment();
     instance.EndRenderPass();
+    BeginTimingSegment();
 }
 
 /* ----- Pipeline States ----- */
@@ -833,10 +879,16 @@ void DbgCommandBuffer::PushDebugGroup(const char* name)
     
     debugGroups_.push(name);
     instance.PushDebugGroup(name);
+
+    if (scopeTimer_)
+        BeginTimingScope(name);
 }
 
 void DbgCommandBuffer::PopDebugGroup()
 {
+    if (scopeTimer_)
+        EndTimingScope();
+
     instance.PopDebugGroup();
     debugGroups_.pop();
     
@@ -984,6 +1036,10 @@ void DbgCommandBuffer::NextProfile(FrameProfile& outputProfile)
 {
     /* Copy frame profile values to output profile */
     std::copy(std::begin(profile_.values), std::end(profile_.values), std::begin(outputProfile.values));
+
+    /* Pass timing scopes of this submission on to the current frame; the record is kept for further submissions */
+    if (scopeTimer_)
+        scopeTimer_->SubmitRecord(timingRecord_);
 }
 
 
@@ -1444,6 +1500,75 @@ void DbgCommandBuffer::ResetFrameProfile()
 {
     /* Reset all counters of frame profile */
     std::fill(std::begin(profile_.values), std::end(profile_.values), 0);
+
+    /* Release timing scopes of previous encoding, since its queries are about to be replaced */
+    if (scopeTimer_)
+    {
+        scopeTimer_->ReleaseRecord(timingRecord_);
+        timingScopes_.clear();
+    }
+}
+
+void DbgCommandBuffer::BeginTimingScope(const char* name)
+{
+    /* End current time segment of the parent scope */
+    EndTimingSegment();
+
+    /* Append new scope to the record */
+    const auto index = static_cast<std::uint32_t>(timingRecord_.scopes.size());
+
+    ProfileScope scope;
+    {
+        scope.name      = name;
+        scope.parent    = (timingScopes_.empty() ? ~0u : timingScopes_.back().index);
+        scope.depth     = static_cast<std::uint32_t>(timingScopes_.size());
+    }
+    timingRecord_.scopes.push_back(std::move(scope));
+
+    timingScopes_.push_back({ index, std::chrono::steady_clock::now() });
+
+    BeginTimingSegment();
+}
+
+void DbgCommandBuffer::EndTimingScope()
+{
+    /* Ignore scopes that have been opened before the current encoding */
+    if (timingScopes_.empty())
+        return;
+
+    EndTimingSegment();
+
+    /* Store CPU time that has been spent within this scope */
+    const auto& timingScope = timingScopes_.back();
+    const auto  elapsedTime = std::chrono::steady_clock::now() - timingScope.startTime;
+
+    timingRecord_.scopes[timingScope.index].cpuTime = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsedTime).count()
+    );
+
+    timingScopes_.pop_back();
+
+    /* Continue with new time segment of the parent scope */
+    BeginTimingSegment();
+}
+
+void DbgCommandBuffer::BeginTimingSegment()
+{
+    if (!timingScopes_.empty())
+    {
+        timingQuery_ = scopeTimer_->AcquireQuery();
+        instance.BeginQuery(*timingQuery_->queryHeap);
+        timingRecord_.segments.push_back({ timingScopes_.back().index, timingQuery_ });
+    }
+}
+
+void DbgCommandBuffer::EndTimingSegment()
+{
+    if (timingQuery_)
+    {
+        instance.EndQuery(*timingQuery_->queryHeap);
+        timingQuery_ = nullptr;
+    }
 }
 
 
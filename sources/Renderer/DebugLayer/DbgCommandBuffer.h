@@ -13,9 +13,12 @@
 #include <LLGL/RenderingProfiler.h>
 #include "DbgGraphicsPipeline.h"
 #include "DbgQueryHeap.h"
+#include "DbgScopeTimer.h"
 #include <cstdint>
 #include <string>
 #include <stack>
+#include <vector>
+#include <chrono>
 
 
 namespace LLGL
@@ -39,10 +42,13 @@ class DbgCommandBuffer : public CommandBufferExt
         DbgCommandBuffer(
             CommandBuffer&                  instance,
             CommandBufferExt*               instanceExt,
+            RenderingProfiler*              profiler,
             RenderingDebugger*              debugger,
+            DbgScopeTimer*                  scopeTimer,
             const CommandBufferDescriptor&  desc,
             const RenderingCapabilities&    caps
         );
+        ~DbgCommandBuffer();
 
         /* ----- Encoding ----- */
 
@@ -229,11 +235,18 @@ class DbgCommandBuffer : public CommandBufferExt
 
         void ResetFrameProfile();
 
+        void BeginTimingScope(const char* name);
+        void EndTimingScope();
+        void BeginTimingSegment();
+        void EndTimingSegment();
+
     private:
 
         /* ----- Common objects ----- */
 
+        RenderingProfiler*              profiler_               = nullptr;
         RenderingDebugger*              debugger_               = nullptr;
+        DbgScopeTimer*                  scopeTimer_             = nullptr;
 
         const RenderingFeatures&        features_;
         const RenderingLimits&          limits_;
@@ -244,6 +257,18 @@ class DbgCommandBuffer : public CommandBufferExt
 
         FrameProfile                    profile_;
 
+        struct TimingScope
+        {
+            std::uint32_t                           index;
+            std::chrono::steady_clock::time_point   startTime;
+        };
+
+        std::uint64_t                   encodingStartTime_      = 0;
+
+        DbgScopeTimer::Record           timingRecord_;
+        std::vector<TimingScope>        timingScopes_;
+        DbgScopeTimer::Query*           timingQuery_            = nullptr;
+
         PrimitiveTopology               topology_               = PrimitiveTopology::TriangleList;
 
         struct Bindings
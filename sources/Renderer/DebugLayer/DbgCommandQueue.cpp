@@ -8,6 +8,7 @@
 #include "DbgCommandQueue.h"
 #include "DbgCommandBuffer.h"
 #include "DbgCore.h"
+#include "DbgScopeTimer.h"
 #include "../CheckedCast.h"
 #include <LLGL/RenderingProfiler.h>
 #include <LLGL/RenderingDebugger.h>
@@ -17,10 +18,15 @@ namespace LLGL
 {
 
 
-DbgCommandQueue::DbgCommandQueue(CommandQueue& instance, RenderingProfiler* profiler, RenderingDebugger* debugger) :
-    instance  { instance },
-    profiler_ { profiler },
-    debugger_ { debugger }
+DbgCommandQueue::DbgCommandQueue(
+    CommandQueue&       instance,
+    RenderingProfiler*  profiler,
+    RenderingDebugger*  debugger,
+    DbgScopeTimer*      scopeTimer) :
+        instance    { instance   },
+        profiler_   { profiler   },
+        debugger_   { debugger   },
+        scopeTimer_ { scopeTimer }
 {
 }
 
@@ -30,7 +36,10 @@ void DbgCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, commandBuffer);
 
-    instance.Submit(commandBufferDbg.instance);
+    {
+        LLGL_DBG_TRACE("Queue", "Submit", 0);
+        instance.Submit(commandBufferDbg.instance);
+    }
 
     if (profiler_)
     {
@@ -41,6 +50,10 @@ void DbgCommandQueue::Submit(CommandBuffer& commandBuffer)
 
         profiler_->Accumulate(profile);
     }
+
+    /* Resolve GPU times of previous frames */
+    if (scopeTimer_)
+        scopeTimer_->ResolveFrames(instance);
 }
 
 /* ----- Queries ----- */
@@ -62,18 +75,23 @@ bool DbgCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery
 
 void DbgCommandQueue::Submit(Fence& fence)
 {
-    instance.Submit(fence);
+    {
+        LLGL_DBG_TRACE("Queue", "SubmitFence", 0);
+        instance.Submit(fence);
+    }
     if (profiler_)
         profiler_->frameProfile.fenceSubmissions++;
 }
 
 bool DbgCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
+    LLGL_DBG_TRACE("Queue", "WaitFence", 0);
     return instance.WaitFence(fence, timeout);
 }
 
 void DbgCommandQueue::WaitIdle()
 {
+    LLGL_DBG_TRACE("Queue", "WaitIdle", 0);
     instance.WaitIdle();
 }
 
@@ -19,6 +19,7 @@ namespace LLGL
 class RenderingProfiler;
 class RenderingDebugger;
 class DbgQueryHeap;
+class DbgScopeTimer;
 
 class DbgCommandQueue : public CommandQueue
 {
@@ -30,7 +31,8 @@ class DbgCommandQueue : public CommandQueue
         DbgCommandQueue(
             CommandQueue&       instance,
             RenderingProfiler*  profiler,
-            RenderingDebugger*  debugger
+            RenderingDebugger*  debugger,
+            DbgScopeTimer*      scopeTimer
         );
 
         /* ----- Command Buffers ----- */
@@ -68,8 +70,9 @@ class DbgCommandQueue : public CommandQueue
             std::size_t     dataSize
         );
 
-        RenderingProfiler* profiler_ = nullptr;
-        RenderingDebugger* debugger_ = nullptr;
+        RenderingProfiler*  profiler_   = nullptr;
+        RenderingDebugger*  debugger_   = nullptr;
+        DbgScopeTimer*      scopeTimer_ = nullptr;
 
 };
 
@@ -29,6 +29,9 @@ namespace LLGL
 #define LLGL_DBG_ERROR_NOT_SUPPORTED(FEATURE) \
     LLGL_DBG_ERROR(ErrorType::UnsupportedFeature, std::string(FEATURE) + " not supported")
 
+#define LLGL_DBG_TRACE(CATEGORY, NAME, SIZE) \
+    DbgTraceScope dbgTraceScope_ { profiler_, (CATEGORY), (NAME), (SIZE) }
+
 
 inline void DbgSetSource(RenderingDebugger* debugger, const char* source)
 {
@@ -48,6 +51,41 @@ inline void DbgPostWarning(RenderingDebugger* debugger, WarningType type, const
         debugger->PostWarning(type, message);
 }
 
+// Records a trace event from the construction to the destruction of this scope, if the profiler has a trace in progress.
+class DbgTraceScope
+{
+
+    public:
+
+        DbgTraceScope(RenderingProfiler* profiler, const char* category, const char* name, std::uint64_t size = 0) :
+            profiler_ { (profiler != nullptr && profiler->IsTracing() ? profiler : nullptr) },
+            category_ { category                                                            },
+            name_     { name                                                                },
+            size_     { size                                                                }
+        {
+            if (profiler_)
+                startTime_ = profiler_->GetTraceTime();
+        }
+
+        ~DbgTraceScope()
+        {
+            if (profiler_)
+                profiler_->TraceEvent(category_, name_, startTime_, profiler_->GetTraceTime() - startTime_, size_);
+        }
+
+        DbgTraceScope(const DbgTraceScope&) = delete;
+        DbgTraceScope& operator = (const DbgTraceScope&) = delete;
+
+    private:
+
+        RenderingProfiler*  profiler_   = nullptr;
+        const char*         category_   = nullptr;
+        const char*         name_       = nullptr;
+        std::uint64_t       size_       = 0;
+        std::uint64_t       startTime_  = 0;
+
+};
+
 
 } // /namespace LLGL
 
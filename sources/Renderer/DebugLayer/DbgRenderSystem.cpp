@@ -18,6 +18,69 @@ namespace LLGL
 {
 
 
+/* ----- Internal functions ----- */
+
+// Returns the size (in bytes) of the specified number of texels, without truncation to 32 bits.
+static std::uint64_t GetTexelMemorySize(const Format format, std::uint64_t numTexels)
+{
+    return ((static_cast<std::uint64_t>(FormatBitSize(format)) * numTexels) / 8);
+}
+
+// Returns the size (in bytes) of all MIP-map levels, array layers, and samples of the specified texture.
+static std::uint64_t GetTextureMemorySize(const TextureDescriptor& desc)
+{
+    std::uint64_t size = 0;
+
+    /* Compressed formats store each MIP-map level in whole blocks of 4x4 texels, even if the level is smaller than that */
+    const auto blockSize = (IsCompressedFormat(desc.format) ? 4u : 1u);
+
+    /* Sum up all MIP-map levels; TextureSize already includes all array layers and cube faces */
+    auto mipDesc = desc;
+    for (std::uint32_t mipLevel = 0, numMipLevels = NumMipLevels(desc); mipLevel < numMipLevels; ++mipLevel)
+    {
+        mipDesc.extent.width    = GetAlignedSize(std::max(1u, desc.extent.width  >> mipLevel), blockSize);
+        mipDesc.extent.height   = GetAlignedSize(std::max(1u, desc.extent.height >> mipLevel), blockSize);
+        mipDesc.extent.depth    = std::max(1u, desc.extent.depth  >> mipLevel);
+        size += GetTexelMemorySize(desc.format, TextureSize(mipDesc));
+    }
+
+    if (IsMultiSampleTexture(desc.type))
+        size *= std::max(1u, desc.samples);
+
+    return size;
+}
+
+// Returns the size (in bytes) of the internal buffers of the specified render target, i.e. renderbuffers and multi-sampled color buffers.
+static std::uint64_t GetRenderTargetMemorySize(const RenderTargetDescriptor& desc)
+{
+    std::uint64_t size = 0;
+
+    const auto numTexels    = static_cast<std::uint64_t>(desc.resolution.width) * desc.resolution.height;
+    const auto numSamples   = static_cast<std::uint64_t>(desc.multiSampling.SampleCount());
+
+    for (const auto& attachment : desc.attachments)
+    {
+        if (auto texture = attachment.texture)
+        {
+            /* Color attachments are resolved from an internal multi-sampled buffer, unless the textures are multi-sampled themselves */
+            if (numSamples > 1 && !desc.customMultiSampling && attachment.type == AttachmentType::Color)
+            {
+                auto textureDbg = LLGL_CAST(DbgTexture*, texture);
+                size += GetTexelMemorySize(textureDbg->desc.format, numTexels) * numSamples;
+            }
+        }
+        else
+        {
+            /* Depth-stencil attachments without texture are stored in internal buffers */
+            auto format = (attachment.type == AttachmentType::Depth ? Format::D32Float : Format::D24UNormS8UInt);
+            size += GetTexelMemorySize(format, numTexels) * numSamples;
+        }
+    }
+
+    return size;
+}
+
+
 /*
 ~~~~~~ INFO ~~~~~~
 This is the debug layer render system.
@@ -36,6 +99,8 @@ DbgRenderSystem::DbgRenderSystem(
         features_ { caps_.features     },
         limits_   { caps_.limits       }
 {
+    if (profiler_)
+        scopeTimer_ = MakeUnique<DbgScopeTimer>(*instance_, *profiler_);
 }
 
 void DbgRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
@@ -44,6 +109,16 @@ void DbgRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
     instance_->SetConfiguration(config);
 }
 
+bool DbgRenderSystem::QueryMemoryHeapStatistics(std::vector<MemoryHeapStatistics>& heapStatistics)
+{
+    return instance_->QueryMemoryHeapStatistics(heapStatistics);
+}
+
+bool DbgRenderSystem::QueryPipelineCache(std::vector<char>& data)
+{
+    return instance_->QueryPipelineCache(data);
+}
+
 /* ----- Render Context ----- */
 
 RenderContext* DbgRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
@@ -58,7 +133,7 @@ RenderContext* DbgRenderSystem::CreateRenderContext(const RenderContextDescripto
         SetRenderingCaps(instance_->GetRenderingCaps());
         
         /* Instantiate command queue */
-        commandQueue_ = MakeUnique<DbgCommandQueue>(*(instance_->GetCommandQueue()), profiler_, debugger_);
+        commandQueue_ = MakeUnique<DbgCommandQueue>(*(instance_->GetCommandQueue()), profiler_, debugger_, scopeTimer_.get());
     }
     
     return TakeOwnership(renderContexts_, MakeUnique<DbgRenderContext>(*renderContextInstance));
@@ -83,7 +158,7 @@ CommandBuffer* DbgRenderSystem::CreateCommandBuffer(const CommandBufferDescripto
     return TakeOwnership(
         commandBuffers_,
         MakeUnique<DbgCommandBuffer>(
-            *instance_->CreateCommandBuffer(desc), nullptr, debugger_, desc, GetRenderingCaps()
+            *instance_->CreateCommandBuffer(desc), nullptr, profiler_, debugger_, scopeTimer_.get(), desc, GetRenderingCaps()
         )
     );
 }
@@ -95,7 +170,7 @@ CommandBufferExt* DbgRenderSystem::CreateCommandBufferExt(const CommandBufferDes
         return TakeOwnership(
             commandBuffers_,
             MakeUnique<DbgCommandBuffer>(
-                *instance, instance, debugger_, desc, GetRenderingCaps()
+                *instance, instance, profiler_, debugger_, scopeTimer_.get(), desc, GetRenderingCaps()
             )
         );
     }
@@ -121,6 +196,7 @@ Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void*
     }
 
     /* Create buffer object */
+    LLGL_DBG_TRACE("Resource", "CreateBuffer", desc.size);
     auto bufferDbg = MakeUnique<DbgBuffer>(*instance_->CreateBuffer(desc, initialData), desc.bindFlags);
 
     /* Store settings */
@@ -128,6 +204,9 @@ Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void*
     bufferDbg->elements     = (formatSize > 0 ? desc.size / formatSize : 0);
     bufferDbg->initialized  = (initialData != nullptr);
 
+    if (profiler_)
+        bufferDbg->memoryID = profiler_->TrackAllocation(MemoryResourceType::Buffer, desc.bindFlags, desc.size);
+
     return TakeOwnership(buffers_, std::move(bufferDbg));
 }
 
@@ -160,6 +239,8 @@ BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer
 
 void DbgRenderSystem::Release(Buffer& buffer)
 {
+    if (profiler_)
+        profiler_->TrackRelease(LLGL_CAST(DbgBuffer&, buffer).memoryID);
     ReleaseDbg(buffers_, buffer);
 }
 
@@ -189,7 +270,10 @@ void DbgRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, co
             LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'data' parameter");
     }
 
-    instance_->WriteBuffer(dstBufferDbg.instance, dstOffset, data, dataSize);
+    {
+        LLGL_DBG_TRACE("Transfer", "WriteBuffer", dataSize);
+        instance_->WriteBuffer(dstBufferDbg.instance, dstOffset, data, dataSize);
+    }
 
     if (profiler_)
         profiler_->frameProfile.bufferWrites++;
@@ -206,7 +290,11 @@ void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
         ValidateBufferMapping(bufferDbg, true);
     }
 
-    auto result = instance_->MapBuffer(bufferDbg.instance, access);
+    void* result = nullptr;
+    {
+        LLGL_DBG_TRACE("Transfer", "MapBuffer", bufferDbg.desc.size);
+        result = instance_->MapBuffer(bufferDbg.instance, access);
+    }
 
     bufferDbg.mapped = true;
 
@@ -226,7 +314,10 @@ void DbgRenderSystem::UnmapBuffer(Buffer& buffer)
         ValidateBufferMapping(bufferDbg, false);
     }
 
-    instance_->UnmapBuffer(bufferDbg.instance);
+    {
+        LLGL_DBG_TRACE("Transfer", "UnmapBuffer", bufferDbg.desc.size);
+        instance_->UnmapBuffer(bufferDbg.instance);
+    }
 
     bufferDbg.mapped = false;
 }
@@ -240,11 +331,21 @@ Texture* DbgRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, co
         LLGL_DBG_SOURCE;
         ValidateTextureDesc(textureDesc);
     }
-    return TakeOwnership(textures_, MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc));
+    const auto memorySize = GetTextureMemorySize(textureDesc);
+
+    LLGL_DBG_TRACE("Resource", "CreateTexture", memorySize);
+    auto textureDbg = MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc);
+
+    if (profiler_)
+        textureDbg->memoryID = profiler_->TrackAllocation(MemoryResourceType::Texture, textureDesc.bindFlags, memorySize);
+
+    return TakeOwnership(textures_, std::move(textureDbg));
 }
 
 void DbgRenderSystem::Release(Texture& texture)
 {
+    if (profiler_)
+        profiler_->TrackRelease(LLGL_CAST(DbgTexture&, texture).memoryID);
     ReleaseDbg(textures_, texture);
 }
 
@@ -259,7 +360,10 @@ void DbgRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textur
         ValidateTextureRegion(textureDbg, textureRegion);
     }
 
-    instance_->WriteTexture(textureDbg.instance, textureRegion, imageDesc);
+    {
+        LLGL_DBG_TRACE("Transfer", "WriteTexture", imageDesc.dataSize);
+        instance_->WriteTexture(textureDbg.instance, textureRegion, imageDesc);
+    }
 
     if (profiler_)
         profiler_->frameProfile.textureWrites++;
@@ -293,6 +397,32 @@ void DbgRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel
     instance_->ReadTexture(textureDbg.instance, mipLevel, imageDesc);
 }
 
+void DbgRenderSystem::ReadTextureAsync(const Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc, const ReadTextureCallback& callback)
+{
+    auto& textureDbg = LLGL_CAST(const DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateMipLevelLimit(textureRegion.mipLevel, textureDbg.mipLevels);
+        ValidateTextureRegion(textureDbg, textureRegion);
+
+        /* Validate output data size */
+        const auto requiredDataSize =
+        (
+            textureRegion.extent.width          *
+            textureRegion.extent.height         *
+            textureRegion.extent.depth          *
+            ImageFormatSize(imageDesc.format)   *
+            DataTypeSize(imageDesc.dataType)
+        );
+
+        ValidateTextureImageDataSize(imageDesc.dataSize, requiredDataSize);
+    }
+
+    instance_->ReadTextureAsync(textureDbg.instance, textureRegion, imageDesc, callback);
+}
+
 void DbgRenderSystem::GenerateMips(Texture& texture)
 {
     auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
@@ -334,6 +464,7 @@ void DbgRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
 
 Sampler* DbgRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
+    LLGL_DBG_TRACE("Resource", "CreateSampler", 0);
     return instance_->CreateSampler(desc);
     //return TakeOwnership(samplers_, MakeUnique<DbgSampler>());
 }
@@ -383,6 +514,7 @@ ResourceHeap* DbgRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
                 LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed to <ResourceViewDescriptor>");
         }
     }
+    LLGL_DBG_TRACE("Resource", "CreateResourceHeap", 0);
     return instance_->CreateResourceHeap(instanceDesc);
 }
 
@@ -422,14 +554,21 @@ RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
         }
     }
 
-    return TakeOwnership(
-        renderTargets_,
-        MakeUnique<DbgRenderTarget>(*instance_->CreateRenderTarget(instanceDesc), debugger_, desc)
-    );
+    const auto memorySize = GetRenderTargetMemorySize(desc);
+
+    LLGL_DBG_TRACE("Resource", "CreateRenderTarget", memorySize);
+    auto renderTargetDbg = MakeUnique<DbgRenderTarget>(*instance_->CreateRenderTarget(instanceDesc), debugger_, desc);
+
+    if (profiler_ && memorySize > 0)
+        renderTargetDbg->memoryID = profiler_->TrackAllocation(MemoryResourceType::RenderTarget, 0, memorySize);
+
+    return TakeOwnership(renderTargets_, std::move(renderTargetDbg));
 }
 
 void DbgRenderSystem::Release(RenderTarget& renderTarget)
 {
+    if (profiler_)
+        profiler_->TrackRelease(LLGL_CAST(DbgRenderTarget&, renderTarget).memoryID);
     ReleaseDbg(renderTargets_, renderTarget);
 }
 
@@ -437,6 +576,7 @@ void DbgRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* DbgRenderSystem::CreateShader(const ShaderDescriptor& desc)
 {
+    LLGL_DBG_TRACE("Resource", "CreateShader", 0);
     return TakeOwnership(shaders_, MakeUnique<DbgShader>(*instance_->CreateShader(desc), desc.type, debugger_));
 }
 
@@ -462,6 +602,7 @@ ShaderProgram* DbgRenderSystem::CreateShaderProgram(const ShaderProgramDescripto
         instanceDesc.fragmentShader         = GetInstanceShader(desc.fragmentShader);
         instanceDesc.computeShader          = GetInstanceShader(desc.computeShader);
     }
+    LLGL_DBG_TRACE("Resource", "CreateShaderProgram", 0);
     return TakeOwnership(shaderPrograms_, MakeUnique<DbgShaderProgram>(*instance_->CreateShaderProgram(instanceDesc), debugger_, desc, caps_));
 }
 
@@ -504,6 +645,7 @@ GraphicsPipeline* DbgRenderSystem::CreateGraphicsPipeline(const GraphicsPipeline
             if (desc.pipelineLayout != nullptr)
                 instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, desc.pipelineLayout)->instance);
         }
+        LLGL_DBG_TRACE("Resource", "CreateGraphicsPipeline", 0);
         return TakeOwnership(graphicsPipelines_, MakeUnique<DbgGraphicsPipeline>(*instance_->CreateGraphicsPipeline(instanceDesc), desc));
     }
     else
@@ -524,6 +666,7 @@ ComputePipeline* DbgRenderSystem::CreateComputePipeline(const ComputePipelineDes
             if (desc.pipelineLayout != nullptr)
                 instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, desc.pipelineLayout)->instance);
         }
+        LLGL_DBG_TRACE("Resource", "CreateComputePipeline", 0);
         return TakeOwnership(computePipelines_, MakeUnique<DbgComputePipeline>(*instance_->CreateComputePipeline(instanceDesc), desc));
     }
     else
@@ -24,6 +24,7 @@
 #include "DbgShader.h"
 #include "DbgShaderProgram.h"
 #include "DbgQueryHeap.h"
+#include "DbgScopeTimer.h"
 
 #include "../ContainerTypes.h"
 
@@ -43,6 +44,10 @@ class DbgRenderSystem : public RenderSystem
 
         void SetConfiguration(const RenderSystemConfiguration& config) override;
 
+        bool QueryMemoryHeapStatistics(std::vector<MemoryHeapStatistics>& heapStatistics) override;
+
+        bool QueryPipelineCache(std::vector<char>& data) override;
+
         /* ----- Render Context ------ */
 
         RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
@@ -81,6 +86,7 @@ class DbgRenderSystem : public RenderSystem
 
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) override;
+        void ReadTextureAsync(const Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc, const ReadTextureCallback& callback) override;
 
         void GenerateMips(Texture& texture) override;
         void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) override;
@@ -205,6 +211,8 @@ class DbgRenderSystem : public RenderSystem
         const RenderingFeatures&                features_;
         const RenderingLimits&                  limits_;
 
+        std::unique_ptr<DbgScopeTimer>          scopeTimer_;
+
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<DbgRenderContext>     renderContexts_;
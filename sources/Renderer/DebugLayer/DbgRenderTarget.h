@@ -38,6 +38,7 @@ class DbgRenderTarget : public RenderTarget
         }
 
         RenderTarget&           instance;
+        std::uint64_t           memoryID    = 0;
 
     private:
 
@@ -0,0 +1,166 @@
+/*
+ * DbgScopeTimer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DbgScopeTimer.h"
+#include <LLGL/RenderSystem.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+DbgScopeTimer::DbgScopeTimer(RenderSystem& renderSystem, RenderingProfiler& profiler) :
+    renderSystem_ { renderSystem },
+    profiler_     { profiler     }
+{
+}
+
+DbgScopeTimer::~DbgScopeTimer()
+{
+    for (auto& query : queries_)
+        renderSystem_.Release(*query.queryHeap);
+}
+
+DbgScopeTimer::Query* DbgScopeTimer::AcquireQuery()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Recycle query that is no longer referenced by any record or pending frame */
+    if (!freeQueries_.empty())
+    {
+        auto query = freeQueries_.back();
+        freeQueries_.pop_back();
+        query->refCount = 1;
+        return query;
+    }
+
+    /* Create new query heap */
+    QueryHeapDescriptor queryHeapDesc;
+    {
+        queryHeapDesc.type          = QueryType::TimeElapsed;
+        queryHeapDesc.numQueries    = 1;
+    }
+    auto queryHeap = renderSystem_.CreateQueryHeap(queryHeapDesc);
+
+    queries_.push_back({});
+    auto& query = queries_.back();
+    {
+        query.queryHeap = queryHeap;
+        query.refCount  = 1;
+    }
+    return (&query);
+}
+
+void DbgScopeTimer::ReleaseRecord(Record& record)
+{
+    if (!record.segments.empty())
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        for (const auto& segment : record.segments)
+            ReleaseQuery(segment.query);
+    }
+
+    record.scopes.clear();
+    record.segments.clear();
+}
+
+void DbgScopeTimer::SubmitRecord(const Record& record)
+{
+    if (record.scopes.empty())
+        return;
+
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Start new pending frame if the profiler has moved on to the next frame */
+    const auto currentFrame = profiler_.GetCurrentFrame();
+    if (pendingFrames_.empty() || pendingFrames_.back().timings.frame != currentFrame)
+    {
+        pendingFrames_.push_back({});
+        pendingFrames_.back().timings.frame = currentFrame;
+    }
+
+    auto& frame = pendingFrames_.back();
+
+    /* Append scopes and segments with their indices offset by the scopes of previous submissions */
+    const auto scopeOffset = static_cast<std::uint32_t>(frame.timings.scopes.size());
+
+    for (const auto& scope : record.scopes)
+    {
+        frame.timings.scopes.push_back(scope);
+        if (scope.parent != ~0u)
+            frame.timings.scopes.back().parent += scopeOffset;
+    }
+
+    /* Keep queries alive until the results of this submission have been resolved */
+    for (const auto& segment : record.segments)
+    {
+        segment.query->refCount++;
+        frame.segments.push_back({ segment.scope + scopeOffset, segment.query });
+    }
+}
+
+void DbgScopeTimer::ResolveFrames(CommandQueue& commandQueue)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    while (!pendingFrames_.empty())
+    {
+        auto& frame = pendingFrames_.front();
+
+        /* Frames are only complete once the profiler has moved on to the next frame */
+        if (frame.timings.frame >= profiler_.GetCurrentFrame())
+            break;
+
+        /* Poll results of all outstanding segments, and add their times to the respective scope and all its parent scopes */
+        auto& scopes = frame.timings.scopes;
+
+        frame.segments.erase(
+            std::remove_if(
+                frame.segments.begin(), frame.segments.end(),
+                [&](const Segment& segment)
+                {
+                    std::uint64_t elapsedTime = 0;
+                    if (!commandQueue.QueryResult(*segment.query->queryHeap, 0, 1, &elapsedTime, sizeof(elapsedTime)))
+                        return false;
+
+                    for (auto scope = segment.scope; scope != ~0u; scope = scopes[scope].parent)
+                        scopes[scope].gpuTime += elapsedTime;
+
+                    ReleaseQuery(segment.query);
+                    return true;
+                }
+            ),
+            frame.segments.end()
+        );
+
+        /* Wait for remaining results until the next call */
+        if (!frame.segments.empty())
+            break;
+
+        profiler_.PostTimings(std::move(frame.timings));
+        pendingFrames_.pop_front();
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void DbgScopeTimer::ReleaseQuery(Query* query)
+{
+    if (--query->refCount == 0)
+        freeQueries_.push_back(query);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
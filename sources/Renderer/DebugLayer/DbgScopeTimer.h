@@ -0,0 +1,118 @@
+/*
+ * DbgScopeTimer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_SCOPE_TIMER_H
+#define LLGL_DBG_SCOPE_TIMER_H
+
+
+#include <LLGL/RenderingProfiler.h>
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class CommandQueue;
+class QueryHeap;
+
+/*
+Timer for the named scopes of the rendering profiler (see ProfileScope).
+GPU times are measured with native queries of type QueryType::TimeElapsed, which are recycled once their results have been resolved.
+Since such queries cannot be nested with all backends, only one query is active at a time:
+a nested scope ends the current time segment of its parent scope, and the parent scope continues with a new segment once the nested scope has ended.
+Segments are also split at the beginning and end of each render pass, so no query spans a render pass boundary.
+Each record keeps its queries until its command buffer is encoded again, so every submission of the command buffer is resolved with the same queries.
+If a command buffer is submitted several times before its results are available, all of these submissions report the time of its most recent execution.
+The timer can be accessed by multiple encoding threads and the submitting thread at the same time.
+*/
+class DbgScopeTimer
+{
+
+    public:
+
+        // Native query and the number of records and pending frames that refer to it.
+        struct Query
+        {
+            QueryHeap*      queryHeap   = nullptr;
+            std::uint32_t   refCount    = 0;
+        };
+
+        // GPU time segment of a scope.
+        struct Segment
+        {
+            std::uint32_t   scope;
+            Query*          query;
+        };
+
+        // Scopes and GPU time segments of a single command buffer encoding.
+        struct Record
+        {
+            std::vector<ProfileScope>   scopes;
+            std::vector<Segment>        segments;
+        };
+
+    public:
+
+        DbgScopeTimer(RenderSystem& renderSystem, RenderingProfiler& profiler);
+        ~DbgScopeTimer();
+
+        DbgScopeTimer(const DbgScopeTimer&) = delete;
+        DbgScopeTimer& operator = (const DbgScopeTimer&) = delete;
+
+        // Returns a native query with a single query of type QueryType::TimeElapsed, which is owned by the calling record until it is released.
+        Query* AcquireQuery();
+
+        // Releases the queries of the specified record and clears it. Queries of pending submissions are recycled once their results have been resolved.
+        void ReleaseRecord(Record& record);
+
+        // Appends a copy of the specified record to the current frame of the profiler. The record keeps its queries.
+        void SubmitRecord(const Record& record);
+
+        // Resolves the GPU times of all completed frames without blocking, and posts their timings to the profiler.
+        void ResolveFrames(CommandQueue& commandQueue);
+
+    private:
+
+        struct PendingFrame
+        {
+            FrameTimings            timings;
+            std::vector<Segment>    segments;
+        };
+
+    private:
+
+        // Decrements the reference counter of the specified query and recycles it once it is no longer referenced.
+        void ReleaseQuery(Query* query);
+
+    private:
+
+        RenderSystem&               renderSystem_;
+        RenderingProfiler&          profiler_;
+
+        std::mutex                  mutex_;
+
+        std::deque<Query>           queries_;
+        std::vector<Query*>         freeQueries_;
+
+        std::deque<PendingFrame>    pendingFrames_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -30,6 +30,7 @@ class DbgTexture : public Texture
         Texture&            instance;
         TextureDescriptor   desc;
         std::uint32_t       mipLevels   = 1;
+        std::uint64_t       memoryID    = 0;
 
 };
 
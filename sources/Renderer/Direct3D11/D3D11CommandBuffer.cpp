@@ -9,6 +9,7 @@
 #include "D3D11RenderContext.h"
 #include "D3D11Types.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include "../../Core/Helper.h"
 #include <algorithm>
@@ -67,6 +68,8 @@ D3D11CommandBuffer::D3D11CommandBuffer(
 
 void D3D11CommandBuffer::Begin()
 {
+    LLGL_PROFILE_COUNT(commandBufferEncodings);
+
     // dummy
 }
 
@@ -81,12 +84,16 @@ void D3D11CommandBuffer::End()
 
 void D3D11CommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferUpdates);
+
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
     dstBufferD3D.UpdateSubresource(context_.Get(), data, static_cast<UINT>(dataSize), static_cast<UINT>(dstOffset));
 }
 
 void D3D11CommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
 {
+    LLGL_PROFILE_COUNT(bufferCopies);
+
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
     auto& srcBufferD3D = LLGL_CAST(D3D11Buffer&, srcBuffer);
 
@@ -175,6 +182,8 @@ static UINT GetClearFlagsDSV(long flags)
 
 void D3D11CommandBuffer::Clear(long flags)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     /* Clear color buffer */
     if ((flags & ClearFlags::Color) != 0)
     {
@@ -199,6 +208,8 @@ void D3D11CommandBuffer::Clear(long flags)
 
 void D3D11CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     for (; numAttachments-- > 0; ++attachments)
     {
         if ((attachments->flags & ClearFlags::Color) != 0)
@@ -229,6 +240,8 @@ void D3D11CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const At
 
 void D3D11CommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
 
     ID3D11Buffer* buffers[] = { bufferD3D.GetNative() };
@@ -240,6 +253,8 @@ void D3D11CommandBuffer::SetVertexBuffer(Buffer& buffer)
 
 void D3D11CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     auto& bufferArrayD3D = LLGL_CAST(D3D11BufferArray&, bufferArray);
     context_->IASetVertexBuffers(
         0,
@@ -252,12 +267,16 @@ void D3D11CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->IASetIndexBuffer(bufferD3D.GetNative(), bufferD3D.GetFormat(), 0);
 }
 
 void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->IASetIndexBuffer(bufferD3D.GetNative(), D3D11Types::Map(format), static_cast<UINT>(offset));
 }
@@ -266,6 +285,8 @@ void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std
 
 void D3D11CommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
 
     ID3D11Buffer* buffers[] = { bufferD3D.GetNative() };
@@ -276,6 +297,8 @@ void D3D11CommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 
 void D3D11CommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     auto& bufferArrayD3D = LLGL_CAST(D3D11BufferArray&, bufferArray);
     context_->SOSetTargets(
         bufferArrayD3D.GetCount(),
@@ -286,6 +309,8 @@ void D3D11CommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 
 void D3D11CommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    LLGL_PROFILE_COUNT(streamOutputSections);
+
     // dummy
 }
 
@@ -298,12 +323,16 @@ void D3D11CommandBuffer::EndStreamOutput()
 
 void D3D11CommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*firstSet*/)
 {
+    LLGL_PROFILE_COUNT(graphicsResourceHeapBindings);
+
     auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
     resourceHeapD3D.BindForGraphicsPipeline(context_.Get());
 }
 
 void D3D11CommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*firstSet*/)
 {
+    LLGL_PROFILE_COUNT(computeResourceHeapBindings);
+
     auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
     resourceHeapD3D.BindForComputePipeline(context_.Get());
 }
@@ -316,6 +345,8 @@ void D3D11CommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    LLGL_PROFILE_COUNT(renderPassSections);
+
     /* Bind render target/context */
     if (renderTarget.IsRenderContext())
         BindRenderContext(LLGL_CAST(D3D11RenderContext&, renderTarget));
@@ -339,12 +370,16 @@ void D3D11CommandBuffer::EndRenderPass()
 
 void D3D11CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_PROFILE_COUNT(graphicsPipelineBindings);
+
     auto& graphicsPipelineD3D = LLGL_CAST(D3D11GraphicsPipelineBase&, graphicsPipeline);
     graphicsPipelineD3D.Bind(*stateMngr_);
 }
 
 void D3D11CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_PROFILE_COUNT(computePipelineBindings);
+
     auto& computePipelineD3D = LLGL_CAST(D3D11ComputePipeline&, computePipeline);
     computePipelineD3D.Bind(*stateMngr_);
 }
@@ -353,6 +388,8 @@ void D3D11CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 
 void D3D11CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_PROFILE_COUNT(querySections);
+
     auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
 
     query *= queryHeapD3D.GetGroupSize();
@@ -391,6 +428,8 @@ void D3D11CommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 
 void D3D11CommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_PROFILE_COUNT(renderConditionSections);
+
     auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
     context_->SetPredication(
         queryHeapD3D.GetPredicate(query * queryHeapD3D.GetGroupSize()),
@@ -407,52 +446,72 @@ void D3D11CommandBuffer::EndRenderCondition()
 
 void D3D11CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     context_->Draw(numVertices, firstVertex);
 }
 
 void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     context_->DrawIndexed(numIndices, firstIndex, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     context_->DrawIndexed(numIndices, firstIndex, vertexOffset);
 }
 
 void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     context_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
 }
 
 void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     context_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->DrawInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
 
 void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     while (numCommands-- > 0)
     {
@@ -463,12 +522,16 @@ void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std:
 
 void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->DrawIndexedInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
 
 void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     while (numCommands-- > 0)
     {
@@ -481,11 +544,15 @@ void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offse
 
 void D3D11CommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     context_->Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void D3D11CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->DispatchIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
@@ -506,6 +573,8 @@ void D3D11CommandBuffer::PopDebugGroup()
 
 void D3D11CommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(constantBufferBindings);
+
     /* Set constant buffer resource to all shader stages */
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     auto resource = bufferD3D.GetNative();
@@ -514,6 +583,8 @@ void D3D11CommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, l
 
 void D3D11CommandBuffer::SetSampleBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(sampleBufferBindings);
+
     if (HasBufferResourceViews(buffer))
     {
         /* Set SRVs to specified shader stages */
@@ -525,6 +596,8 @@ void D3D11CommandBuffer::SetSampleBuffer(Buffer& buffer, std::uint32_t slot, lon
 
 void D3D11CommandBuffer::SetRWStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(rwStorageBufferBindings);
+
     if (HasBufferResourceViews(buffer))
     {
         /* Set UAVs to specified shader stages */
@@ -537,6 +610,8 @@ void D3D11CommandBuffer::SetRWStorageBuffer(Buffer& buffer, std::uint32_t slot,
 
 void D3D11CommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(textureBindings);
+
     /* Set texture resource to all shader stages */
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     auto resource = textureD3D.GetSRV();
@@ -545,6 +620,8 @@ void D3D11CommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long s
 
 void D3D11CommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(samplerBindings);
+
     /* Set sampler state object to all shader stages */
     auto& samplerD3D = LLGL_CAST(D3D11Sampler&, sampler);
     auto resource = samplerD3D.GetNative();
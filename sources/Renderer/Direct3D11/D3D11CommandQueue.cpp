@@ -9,6 +9,7 @@
 #include "RenderState/D3D11Fence.h"
 #include "RenderState/D3D11QueryHeap.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 
 
 namespace LLGL
@@ -25,6 +26,8 @@ D3D11CommandQueue::D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceCo
 
 void D3D11CommandQueue::Submit(CommandBuffer& /*commandBuffer*/)
 {
+    LLGL_PROFILE_COUNT(commandBufferSubmittions);
+
     // dummy
 }
 
@@ -46,6 +49,8 @@ bool D3D11CommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQue
 
 void D3D11CommandQueue::Submit(Fence& fence)
 {
+    LLGL_PROFILE_COUNT(fenceSubmissions);
+
     auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
     fenceD3D.Submit(context_.Get());
 }
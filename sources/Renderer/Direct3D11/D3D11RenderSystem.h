@@ -201,7 +201,8 @@ class D3D11RenderSystem final : public RenderSystem
             const Format                format,
             const SrcImageDescriptor*   imageDesc,
             const Extent3D&             extent,
-            std::uint32_t               arrayLayers
+            std::uint32_t               arrayLayers,
+            std::uint32_t               numMipLevels
         );
 
         void InitializeGpuTextureWithImage(
@@ -209,7 +210,8 @@ class D3D11RenderSystem final : public RenderSystem
             const Format        format,
             SrcImageDescriptor  imageDesc,
             const Extent3D&     extent,
-            std::uint32_t       arrayLayers
+            std::uint32_t       arrayLayers,
+            std::uint32_t       numMipLevels
         );
 
         void InitializeGpuTextureWithDefault(
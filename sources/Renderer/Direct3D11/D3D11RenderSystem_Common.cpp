@@ -9,6 +9,7 @@
 #include "D3D11Types.h"
 #include "../DXCommon/DXCore.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../../Core/Vendor.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
@@ -142,12 +143,16 @@ void D3D11RenderSystem::Release(BufferArray& bufferArray)
 
 void D3D11RenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferWrites);
+
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
     dstBufferD3D.UpdateSubresource(context_.Get(), data, static_cast<UINT>(dataSize), static_cast<UINT>(dstOffset));
 }
 
 void* D3D11RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    LLGL_PROFILE_COUNT(bufferMappings);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     mappedBufferCPUAccess_ = access;
     return bufferD3D.Map(context_.Get(), mappedBufferCPUAccess_);
@@ -9,6 +9,7 @@
 #include "D3D11Types.h"
 #include "../DXCommon/DXCore.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
 
@@ -59,6 +60,8 @@ void D3D11RenderSystem::Release(Texture& texture)
 
 void D3D11RenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_PROFILE_COUNT(textureWrites);
+
     if (texture.GetType() == TextureType::Texture3D)
     {
         UpdateGenericTexture(
@@ -157,6 +160,8 @@ void D3D11RenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLev
 
 void D3D11RenderSystem::GenerateMips(Texture& texture)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     /* Generate MIP-maps for the default SRV */
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     if (auto srv = textureD3D.GetSRV())
@@ -173,6 +178,8 @@ void D3D11RenderSystem::GenerateMips(Texture& texture)
 
 void D3D11RenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
 
     if ( baseMipLevel        == 0                              &&
@@ -196,25 +203,34 @@ void D3D11RenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLeve
  * ======= Private: =======
  */
 
+// Returns the number of MIP-map levels the initial image data contains (see MiscFlags::InitialMipChain).
+static std::uint32_t GetInitialMipLevelCount(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
+{
+    if (imageDesc != nullptr && (desc.miscFlags & MiscFlags::InitialMipChain) != 0 && IsMipMappedTexture(desc))
+        return NumMipLevels(desc);
+    else
+        return 1;
+}
+
 void D3D11RenderSystem::CreateAndInitializeGpuTexture1D(D3D11Texture& textureD3D, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
 {
     /* Create native texture and initialize with image data */
     textureD3D.CreateTexture1D(device_.Get(), desc);
-    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, desc.arrayLayers);
+    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, desc.arrayLayers, GetInitialMipLevelCount(desc, imageDesc));
 }
 
 void D3D11RenderSystem::CreateAndInitializeGpuTexture2D(D3D11Texture& textureD3D, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
 {
     /* Create native texture and initialize with image data */
     textureD3D.CreateTexture2D(device_.Get(), desc);
-    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, desc.arrayLayers);
+    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, desc.arrayLayers, GetInitialMipLevelCount(desc, imageDesc));
 }
 
 void D3D11RenderSystem::CreateAndInitializeGpuTexture3D(D3D11Texture& textureD3D, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
 {
     /* Create native texture and initialize with image data */
     textureD3D.CreateTexture3D(device_.Get(), desc);
-    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, 1);
+    InitializeGpuTexture(textureD3D, desc.format, imageDesc, desc.extent, 1, GetInitialMipLevelCount(desc, imageDesc));
 }
 
 void D3D11RenderSystem::CreateAndInitializeGpuTexture2DMS(D3D11Texture& textureD3D, const TextureDescriptor& desc)
@@ -247,12 +263,13 @@ void D3D11RenderSystem::InitializeGpuTexture(
     const Format                format,
     const SrcImageDescriptor*   imageDesc,
     const Extent3D&             extent,
-    std::uint32_t               arrayLayers)
+    std::uint32_t               arrayLayers,
+    std::uint32_t               numMipLevels)
 {
     if (imageDesc)
     {
         /* Initialize texture with specified image descriptor */
-        InitializeGpuTextureWithImage(textureD3D, format, *imageDesc, extent, arrayLayers);
+        InitializeGpuTextureWithImage(textureD3D, format, *imageDesc, extent, arrayLayers, numMipLevels);
     }
     else if (GetConfiguration().imageInitialization.enabled && !IsDepthStencilFormat(format))
     {
@@ -266,38 +283,62 @@ void D3D11RenderSystem::InitializeGpuTextureWithImage(
     const Format        format,
     SrcImageDescriptor  imageDesc,
     const Extent3D&     extent,
-    std::uint32_t       arrayLayers)
+    std::uint32_t       arrayLayers,
+    std::uint32_t       numMipLevels)
 {
-    /* Update only the first MIP-map level for each array layer */
-    const auto bytesPerLayer =
-    (
-        extent.width                        *
-        extent.height                       *
-        extent.depth                        *
-        ImageFormatSize(imageDesc.format)   *
-        DataTypeSize(imageDesc.dataType)
-    );
-
-    /* Remap image data size for a single array layer to update each subresource individually */
-    if (imageDesc.dataSize % arrayLayers != 0)
-        throw std::invalid_argument("image data size is not a multiple of the layer count for D3D11 texture");
+    if (numMipLevels > 1)
+    {
+        /* Validate that image data contains all MIP-map levels of the initial MIP-map chain */
+        if (IsCompressedFormat(format) || IsCompressedFormat(imageDesc.format))
+            throw std::invalid_argument("cannot initialize MIP-map chain of D3D11 texture with compressed format");
+        if (imageDesc.dataSize < MipChainOffset(imageDesc.format, imageDesc.dataType, extent, arrayLayers, numMipLevels))
+            throw std::invalid_argument("image data size is too small for MIP-map chain of D3D11 texture");
+    }
+    else
+    {
+        /* Remap image data size for a single array layer to update each subresource individually */
+        if (imageDesc.dataSize % arrayLayers != 0)
+            throw std::invalid_argument("image data size is not a multiple of the layer count for D3D11 texture");
+    }
 
-    imageDesc.dataSize /= arrayLayers;
+    /* Update all MIP-map levels of the initial image data for each array layer (only the first MIP-map level by default) */
+    const auto layerDataSize = imageDesc.dataSize / arrayLayers;
 
-    for (std::uint32_t layer = 0; layer < arrayLayers; ++layer)
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
     {
-        /* Update subresource of current array layer */
-        textureD3D.UpdateSubresource(
-            context_.Get(),
-            0, // mipLevel
-            layer,
-            CD3D11_BOX(0, 0, 0, extent.width, extent.height, extent.depth),
-            imageDesc,
-            GetConfiguration().threadCount
+        const Extent3D mipExtent
+        {
+            std::max(1u, extent.width  >> mipLevel),
+            std::max(1u, extent.height >> mipLevel),
+            std::max(1u, extent.depth  >> mipLevel),
+        };
+
+        const auto bytesPerLayer =
+        (
+            mipExtent.width                     *
+            mipExtent.height                    *
+            mipExtent.depth                     *
+            ImageFormatSize(imageDesc.format)   *
+            DataTypeSize(imageDesc.dataType)
         );
 
-        /* Move to next region of initial data */
-        imageDesc.data = (reinterpret_cast<const std::int8_t*>(imageDesc.data) + bytesPerLayer);
+        imageDesc.dataSize = (numMipLevels > 1 ? bytesPerLayer : layerDataSize);
+
+        for (std::uint32_t layer = 0; layer < arrayLayers; ++layer)
+        {
+            /* Update subresource of current MIP-map level and array layer */
+            textureD3D.UpdateSubresource(
+                context_.Get(),
+                mipLevel,
+                layer,
+                CD3D11_BOX(0, 0, 0, mipExtent.width, mipExtent.height, mipExtent.depth),
+                imageDesc,
+                GetConfiguration().threadCount
+            );
+
+            /* Move to next region of initial data */
+            imageDesc.data = (reinterpret_cast<const std::int8_t*>(imageDesc.data) + bytesPerLayer);
+        }
     }
 }
 
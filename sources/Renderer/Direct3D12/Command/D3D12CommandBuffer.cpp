@@ -11,6 +11,7 @@
 #include "../D3D12RenderSystem.h"
 #include "../D3D12Types.h"
 #include "../../CheckedCast.h"
+#include "../../ProfileCounters.h"
 #include "../../../Core/Helper.h"
 
 #include "../Buffer/D3D12Buffer.h"
@@ -41,6 +42,8 @@ D3D12CommandBuffer::D3D12CommandBuffer(D3D12RenderSystem& renderSystem, const Co
 
 void D3D12CommandBuffer::Begin()
 {
+    LLGL_PROFILE_COUNT(commandBufferEncodings);
+
     /* Reset command list using the next command allocator */
     NextCommandAllocator();
     auto hr = commandList_->Reset(GetCommandAllocator(), nullptr);
@@ -62,12 +65,16 @@ void D3D12CommandBuffer::End()
 
 void D3D12CommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferUpdates);
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     dstBufferD3D.UpdateDynamicSubresource(commandContext_, data, static_cast<UINT64>(dataSize), dstOffset);
 }
 
 void D3D12CommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
 {
+    LLGL_PROFILE_COUNT(bufferCopies);
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
     commandList_->CopyBufferRegion(dstBufferD3D.GetNative(), dstOffset, srcBufferD3D.GetNative(), srcOffset, size);
@@ -191,6 +198,8 @@ static D3D12_CLEAR_FLAGS GetClearFlagsDSV(long flags)
 
 void D3D12CommandBuffer::Clear(long flags)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     if (rtvDescHandle_.ptr != 0)
     {
         /* Clear color buffers */
@@ -217,6 +226,8 @@ void D3D12CommandBuffer::Clear(long flags)
 
 void D3D12CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     //TODO...
     //CD3DX12_CPU_DESCRIPTOR_HANDLE rtvHandle(rtvDescHandle_, targetIndex, rtvDescHandleSize_);
     //commandList_->ClearRenderTargetView(rtvDescHandle_, clearState_.color.Ptr(), 0, nullptr);
@@ -226,12 +237,16 @@ void D3D12CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const At
 
 void D3D12CommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->IASetVertexBuffers(0, 1, &(bufferD3D.GetVertexBufferView()));
 }
 
 void D3D12CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     auto& bufferArrayD3D = LLGL_CAST(D3D12BufferArray&, bufferArray);
     commandList_->IASetVertexBuffers(
         0,
@@ -242,12 +257,16 @@ void D3D12CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->IASetIndexBuffer(&(bufferD3D.GetIndexBufferView()));
 }
 
 void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     auto indexBufferView = bufferD3D.GetIndexBufferView();
     if (indexBufferView.SizeInBytes > offset)
@@ -264,16 +283,22 @@ void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std
 
 void D3D12CommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     //todo...
 }
 
 void D3D12CommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     //todo...
 }
 
 void D3D12CommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    LLGL_PROFILE_COUNT(streamOutputSections);
+
     // dummy
 }
 
@@ -286,6 +311,8 @@ void D3D12CommandBuffer::EndStreamOutput()
 
 void D3D12CommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
 {
+    LLGL_PROFILE_COUNT(graphicsResourceHeapBindings);
+
     /* Get descriptor heaps */
     auto& resourceHeapD3D = LLGL_CAST(D3D12ResourceHeap&, resourceHeap);
 
@@ -305,6 +332,8 @@ void D3D12CommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std
 
 void D3D12CommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
 {
+    LLGL_PROFILE_COUNT(computeResourceHeapBindings);
+
     //todo...
 }
 
@@ -316,6 +345,8 @@ void D3D12CommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    LLGL_PROFILE_COUNT(renderPassSections);
+
     boundRenderTarget_ = &(renderTarget);
 
     /* Bind render target/context */
@@ -354,6 +385,8 @@ void D3D12CommandBuffer::EndRenderPass()
 
 void D3D12CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_PROFILE_COUNT(graphicsPipelineBindings);
+
     /* Set graphics root signature, graphics pipeline state, and primitive topology */
     auto& graphicsPipelineD3D = LLGL_CAST(D3D12GraphicsPipeline&, graphicsPipeline);
     graphicsPipelineD3D.Bind(commandList_.Get());
@@ -366,6 +399,8 @@ void D3D12CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 
 void D3D12CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_PROFILE_COUNT(computePipelineBindings);
+
     //todo
 }
 
@@ -373,6 +408,8 @@ void D3D12CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 
 void D3D12CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_PROFILE_COUNT(querySections);
+
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
     commandList_->BeginQuery(queryHeapD3D.GetNative(), queryHeapD3D.GetNativeType(), query);
 }
@@ -394,6 +431,8 @@ static D3D12_PREDICATION_OP GetDXPredicateOp(const RenderConditionMode mode)
 
 void D3D12CommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_PROFILE_COUNT(renderConditionSections);
+
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
     commandList_->SetPredication(
         queryHeapD3D.GetResultResource(),
@@ -411,46 +450,64 @@ void D3D12CommandBuffer::EndRenderCondition()
 
 void D3D12CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     commandList_->DrawInstanced(numVertices, 1, firstVertex, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     commandList_->DrawIndexedInstanced(numIndices, 1, firstIndex, 0, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     commandList_->DrawIndexedInstanced(numIndices, 1, firstIndex, vertexOffset, 0);
 }
 
 void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     commandList_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
 }
 
 void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     commandList_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->ExecuteIndirect(
         commandSignaturePool_->GetSignatureDrawIndirect(), 1, bufferD3D.GetNative(), offset, nullptr, 0
@@ -459,6 +516,8 @@ void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 
 void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     while (numCommands-- > 0)
     {
@@ -471,6 +530,8 @@ void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std:
 
 void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->ExecuteIndirect(
         commandSignaturePool_->GetSignatureDrawIndexedIndirect(), 1, bufferD3D.GetNative(), offset, nullptr, 0
@@ -479,6 +540,8 @@ void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offse
 
 void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     while (numCommands-- > 0)
     {
@@ -493,11 +556,15 @@ void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offse
 
 void D3D12CommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     commandList_->Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void D3D12CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->ExecuteIndirect(
         commandSignaturePool_->GetSignatureDispatchIndirect(), 1, bufferD3D.GetNative(), offset, nullptr, 0
@@ -11,6 +11,7 @@
 #include "../RenderState/D3D12Fence.h"
 #include "../RenderState/D3D12QueryHeap.h"
 #include "../../CheckedCast.h"
+#include "../../ProfileCounters.h"
 #include "../../DXCommon/DXCore.h"
 
 
@@ -28,6 +29,8 @@ D3D12CommandQueue::D3D12CommandQueue(ID3D12Device* device, ID3D12CommandQueue* q
 
 void D3D12CommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_PROFILE_COUNT(commandBufferSubmittions);
+
     /* Execute command list */
     auto& commandBufferD3D = LLGL_CAST(D3D12CommandBuffer&, commandBuffer);
     ID3D12CommandList* cmdLists[] = { commandBufferD3D.GetNative() };
@@ -80,6 +83,8 @@ bool D3D12CommandQueue::QueryResult(
 
 void D3D12CommandQueue::Submit(Fence& fence)
 {
+    LLGL_PROFILE_COUNT(fenceSubmissions);
+
     /* Schedule signal command into the queue */
     auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
     auto hr = native_->Signal(fenceD3D.GetNative(), fenceD3D.NextValue());
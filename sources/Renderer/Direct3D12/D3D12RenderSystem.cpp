@@ -9,6 +9,7 @@
 #include "D3D12Types.h"
 #include "../DXCommon/DXCore.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../../Core/Vendor.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
@@ -169,6 +170,8 @@ void D3D12RenderSystem::Release(BufferArray& bufferArray)
 //TODO: execute command list only before the next call to D3D12CommandBuffer::Begin()
 void D3D12RenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferWrites);
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     dstBufferD3D.UpdateDynamicSubresource(commandContext_, data, dataSize, dstOffset);
     ExecuteCommandList();
@@ -176,6 +179,8 @@ void D3D12RenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset,
 
 void* D3D12RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    LLGL_PROFILE_COUNT(bufferMappings);
+
     return nullptr;//todo...
 }
 
@@ -239,6 +244,8 @@ void D3D12RenderSystem::Release(Texture& texture)
 
 void D3D12RenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_PROFILE_COUNT(textureWrites);
+
     //todo...
 }
 
@@ -249,11 +256,15 @@ void D3D12RenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLev
 
 void D3D12RenderSystem::GenerateMips(Texture& texture)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     //todo
 }
 
 void D3D12RenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     //todo
 }
 
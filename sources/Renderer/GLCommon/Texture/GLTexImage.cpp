@@ -955,6 +955,75 @@ void GLTexImage2DMSArray(const TextureDescriptor& desc)
 
 #endif
 
+void GLTexImageMipChain(const TextureDescriptor& desc, const SrcImageDescriptor& imageDesc)
+{
+    if (IsCompressedFormat(desc.format) || IsCompressedFormat(imageDesc.format))
+        throw std::invalid_argument("cannot initialize MIP-map chain of texture with compressed format");
+
+    /* Validate that image data contains all MIP-map levels */
+    const auto numMipLevels     = NumMipLevels(desc);
+    const auto hasHeight        = (desc.type != TextureType::Texture1D && desc.type != TextureType::Texture1DArray);
+    const auto hasDepth         = (desc.type == TextureType::Texture3D);
+    const auto arrayLayers      = (IsArrayTexture(desc.type) || IsCubeTexture(desc.type) ? desc.arrayLayers : 1u);
+
+    const Extent3D baseExtent
+    {
+        desc.extent.width,
+        (hasHeight ? desc.extent.height : 1u),
+        (hasDepth  ? desc.extent.depth  : 1u),
+    };
+
+    if (imageDesc.dataSize < MipChainOffset(imageDesc.format, imageDesc.dataType, baseExtent, arrayLayers, numMipLevels))
+        throw std::invalid_argument("image data size is too small for MIP-map chain of texture");
+
+    /* Upload all MIP-map levels after the base level, which has been uploaded with the texture storage */
+    const auto format   = GLTypes::Map(imageDesc.format);
+    const auto type     = GLTypes::Map(imageDesc.dataType);
+    const auto target   = GLTypes::Map(desc.type);
+    const auto data     = reinterpret_cast<const char*>(imageDesc.data);
+
+    for (std::uint32_t mipLevel = 1; mipLevel < numMipLevels; ++mipLevel)
+    {
+        const auto level    = static_cast<GLint>(mipLevel);
+        const auto sx       = static_cast<GLsizei>(std::max(1u, baseExtent.width  >> mipLevel));
+        const auto sy       = static_cast<GLsizei>(std::max(1u, baseExtent.height >> mipLevel));
+        const auto sz       = static_cast<GLsizei>(std::max(1u, baseExtent.depth  >> mipLevel));
+        const auto layers   = static_cast<GLsizei>(arrayLayers);
+        const auto levelData = data + MipChainOffset(imageDesc.format, imageDesc.dataType, baseExtent, arrayLayers, mipLevel);
+
+        switch (desc.type)
+        {
+            #ifdef LLGL_OPENGL
+            case TextureType::Texture1D:
+                glTexSubImage1D(target, level, 0, sx, format, type, levelData);
+                break;
+            case TextureType::Texture1DArray:
+                glTexSubImage2D(target, level, 0, 0, sx, layers, format, type, levelData);
+                break;
+            #endif
+            case TextureType::Texture2D:
+                glTexSubImage2D(target, level, 0, 0, sx, sy, format, type, levelData);
+                break;
+            case TextureType::TextureCube:
+            {
+                const auto faceSize = static_cast<std::size_t>(ImageDataSize(imageDesc.format, imageDesc.dataType, static_cast<std::uint32_t>(sx * sy)));
+                for (std::uint32_t arrayLayer = 0; arrayLayer < arrayLayers; ++arrayLayer)
+                    glTexSubImage2D(GLTypes::ToTextureCubeMap(arrayLayer), level, 0, 0, sx, sy, format, type, levelData + faceSize * arrayLayer);
+            }
+            break;
+            case TextureType::Texture3D:
+                glTexSubImage3D(target, level, 0, 0, 0, sx, sy, sz, format, type, levelData);
+                break;
+            case TextureType::Texture2DArray:
+            case TextureType::TextureCubeArray:
+                glTexSubImage3D(target, level, 0, 0, 0, sx, sy, layers, format, type, levelData);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
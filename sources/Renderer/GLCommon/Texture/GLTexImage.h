@@ -41,6 +41,9 @@ void GLTexImage2DArray  (const TextureDescriptor& desc, const SrcImageDescriptor
 
 #endif
 
+// Uploads all MIP-map levels after the base level from the specified image data (see MiscFlags::InitialMipChain).
+void GLTexImageMipChain(const TextureDescriptor& desc, const SrcImageDescriptor& imageDesc);
+
 
 } // /namespace LLGL
 
@@ -18,6 +18,7 @@
 #include "Texture/MTRenderTarget.h"
 #include "Shader/MTShaderProgram.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include <algorithm>
 #include <limits.h>
 
@@ -43,6 +44,8 @@ MTCommandBuffer::~MTCommandBuffer()
 
 void MTCommandBuffer::Begin()
 {
+    LLGL_PROFILE_COUNT(commandBufferEncodings);
+
     /* Allocate new command buffer from command queue */
     cmdBuffer_ = [cmdQueue_ commandBuffer];
 
@@ -62,6 +65,8 @@ void MTCommandBuffer::End()
 
 void MTCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferUpdates);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     
     /* Copy data to staging buffer */
@@ -87,6 +92,8 @@ void MTCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, c
 
 void MTCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
 {
+    LLGL_PROFILE_COUNT(bufferCopies);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
 
@@ -167,6 +174,8 @@ void MTCommandBuffer::SetClearStencil(std::uint32_t stencil)
 
 void MTCommandBuffer::Clear(long flags)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     if (encoderScheduler_.GetRenderEncoder() != nil && flags != 0)
     {
         /* Make new render pass descriptor with current clear values */
@@ -222,6 +231,8 @@ static void FillMTRenderPassDesc(MTLRenderPassDescriptor* renderPassDesc, const
 
 void MTCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     if (encoderScheduler_.GetRenderEncoder() != nil && numAttachments > 0)
     {
         /* Make new render pass descriptor with current clear values */
@@ -240,12 +251,16 @@ void MTCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Attac
 
 void MTCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     encoderScheduler_.SetVertexBuffer(bufferMT.GetNative(), 0);
 }
 
 void MTCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     auto& bufferArrayMT = LLGL_CAST(MTBufferArray&, bufferArray);
     encoderScheduler_.SetVertexBuffers(
         bufferArrayMT.GetIDArray().data(),
@@ -256,6 +271,8 @@ void MTCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void MTCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     indexBuffer_        = bufferMT.GetNative();
     indexBufferOffset_  = 0;
@@ -264,6 +281,8 @@ void MTCommandBuffer::SetIndexBuffer(Buffer& buffer)
 
 void MTCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     indexBuffer_        = bufferMT.GetNative();
     indexBufferOffset_  = static_cast<NSUInteger>(offset);
@@ -274,16 +293,22 @@ void MTCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::u
 
 void MTCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     //todo
 }
 
 void MTCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     //todo
 }
 
 void MTCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    LLGL_PROFILE_COUNT(streamOutputSections);
+
     //todo
 }
 
@@ -296,12 +321,16 @@ void MTCommandBuffer::EndStreamOutput()
 
 void MTCommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
 {
+    LLGL_PROFILE_COUNT(graphicsResourceHeapBindings);
+
     auto& resourceHeapMT = LLGL_CAST(MTResourceHeap&, resourceHeap);
     encoderScheduler_.SetGraphicsResourceHeap(&resourceHeapMT);
 }
 
 void MTCommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
 {
+    LLGL_PROFILE_COUNT(computeResourceHeapBindings);
+
     auto& resourceHeapMT = LLGL_CAST(MTResourceHeap&, resourceHeap);
     encoderScheduler_.BindComputeEncoder();
     resourceHeapMT.BindComputeResources(encoderScheduler_.GetComputeEncoder());
@@ -316,6 +345,8 @@ void MTCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    LLGL_PROFILE_COUNT(renderPassSections);
+
     if (renderTarget.IsRenderContext())
     {
         /* Put current drawable into queue */
@@ -344,6 +375,8 @@ void MTCommandBuffer::EndRenderPass()
 
 void MTCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_PROFILE_COUNT(graphicsPipelineBindings);
+
     /* Set graphics pipeline with encoder scheduler */
     auto& graphicsPipelineMT = LLGL_CAST(MTGraphicsPipeline&, graphicsPipeline);
     encoderScheduler_.SetGraphicsPipeline(&graphicsPipelineMT);
@@ -354,6 +387,8 @@ void MTCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 
 void MTCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_PROFILE_COUNT(computePipelineBindings);
+
     /* Set compute pipeline with encoder scheduler */
     auto& computePipelineMT = LLGL_CAST(MTComputePipeline&, computePipeline);
     encoderScheduler_.BindComputeEncoder();
@@ -370,6 +405,8 @@ void MTCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 
 void MTCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_PROFILE_COUNT(querySections);
+
     //todo
 }
 
@@ -380,6 +417,8 @@ void MTCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 
 void MTCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_PROFILE_COUNT(renderConditionSections);
+
     //todo
 }
 
@@ -392,6 +431,8 @@ void MTCommandBuffer::EndRenderCondition()
 
 void MTCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
     {
@@ -417,6 +458,8 @@ void MTCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 
 void MTCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
     {
@@ -446,6 +489,8 @@ void MTCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstI
 
 void MTCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
     {
@@ -478,6 +523,8 @@ void MTCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstI
 
 void MTCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
     {
@@ -505,6 +552,8 @@ void MTCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fir
 
 void MTCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
     {
@@ -532,6 +581,8 @@ void MTCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fir
 
 void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
     {
@@ -564,6 +615,8 @@ void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32
 
 void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
     {
@@ -596,6 +649,8 @@ void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32
 
 void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
     {
@@ -628,6 +683,8 @@ void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32
 
 void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
@@ -652,6 +709,8 @@ void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 
 void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
@@ -684,6 +743,8 @@ void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::ui
 
 void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
@@ -713,6 +774,8 @@ void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 
 void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushRenderPass();
     if (numPatchControlPoints_ > 0)
@@ -752,6 +815,8 @@ void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
 
 void MTCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     encoderScheduler_.BindComputeEncoder();
     MTLSize numGroups = { numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ };
     [encoderScheduler_.GetComputeEncoder()
@@ -762,6 +827,8 @@ void MTCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWo
 
 void MTCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     encoderScheduler_.BindComputeEncoder();
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     [encoderScheduler_.GetComputeEncoder()
@@ -791,6 +858,8 @@ void MTCommandBuffer::PopDebugGroup()
 
 void MTCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(constantBufferBindings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     auto renderEncoder = encoderScheduler_.GetRenderEncoder();
     if ((stageFlags & StageFlags::VertexStage) != 0)
@@ -813,16 +882,22 @@ void MTCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long
 
 void MTCommandBuffer::SetSampleBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(sampleBufferBindings);
+
     //todo
 }
 
 void MTCommandBuffer::SetRWStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(rwStorageBufferBindings);
+
     //todo
 }
 
 void MTCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(textureBindings);
+
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     auto renderEncoder = encoderScheduler_.GetRenderEncoder();
     if ((stageFlags & StageFlags::VertexStage) != 0)
@@ -843,6 +918,8 @@ void MTCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long stag
 
 void MTCommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long stageFlags)
 {
+    LLGL_PROFILE_COUNT(samplerBindings);
+
     /* Get native MTLSamplerState object */
     auto& samplerMT = LLGL_CAST(MTSampler&, sampler);
     
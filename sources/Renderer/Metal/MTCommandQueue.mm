@@ -8,6 +8,7 @@
 #include "MTCommandQueue.h"
 #include "MTCommandBuffer.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 
 
 namespace LLGL
@@ -30,6 +31,9 @@ MTCommandQueue::~MTCommandQueue()
 
 void MTCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_PROFILE_COUNT(commandBufferSubmittions);
+    LLGL_PROFILE_MERGE();
+
     auto& commandBufferMT = LLGL_CAST(MTCommandBuffer&, commandBuffer);
 
     /* Commit command buffer into queue */
@@ -61,6 +65,8 @@ bool MTCommandQueue::QueryResult(
 
 void MTCommandQueue::Submit(Fence& fence)
 {
+    LLGL_PROFILE_COUNT(fenceSubmissions);
+
     //todo
 }
 
@@ -7,6 +7,7 @@
 
 #include "MTRenderSystem.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Vendor.h"
 #include "MTFeatureSet.h"
@@ -91,12 +92,16 @@ void MTRenderSystem::Release(BufferArray& bufferArray)
 
 void MTRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferWrites);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     dstBufferMT.Write(static_cast<NSUInteger>(dstOffset), data, static_cast<NSUInteger>(dataSize));
 }
 
 void* MTRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    LLGL_PROFILE_COUNT(bufferMappings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     return bufferMT.Map(access);
 }
@@ -126,6 +131,8 @@ void MTRenderSystem::Release(Texture& texture)
 
 void MTRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_PROFILE_COUNT(textureWrites);
+
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     textureMT.Write(imageDesc, textureRegion.offset, textureRegion.extent);
 }
@@ -137,6 +144,8 @@ void MTRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel,
 
 void MTRenderSystem::GenerateMips(Texture& texture)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     
     id<MTLCommandBuffer> cmdBuffer = [commandQueue_->GetNative() commandBuffer];
@@ -150,6 +159,8 @@ void MTRenderSystem::GenerateMips(Texture& texture)
 
 void MTRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     //todo
 }
 
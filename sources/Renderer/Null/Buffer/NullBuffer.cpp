@@ -0,0 +1,84 @@
+/*
+ * NullBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullBuffer.h"
+#include "../../../Core/Helper.h"
+#include <stdexcept>
+#include <string>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+NullBuffer::NullBuffer(const BufferDescriptor& desc, const void* initialData) :
+    Buffer       { desc.bindFlags              },
+    data_        { MakeUniqueArray<std::uint8_t>(static_cast<std::size_t>(desc.size)) },
+    size_        { desc.size                   },
+    indexFormat_ { desc.indexBuffer.format     }
+{
+    if (initialData)
+        ::memcpy(data_.get(), initialData, static_cast<std::size_t>(size_));
+    else
+        ::memset(data_.get(), 0, static_cast<std::size_t>(size_));
+}
+
+void NullBuffer::Write(std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
+{
+    AssertRange(dstOffset, dataSize, __FUNCTION__);
+    ::memcpy(data_.get() + dstOffset, data, static_cast<std::size_t>(dataSize));
+}
+
+void NullBuffer::Read(std::uint64_t srcOffset, void* data, std::uint64_t dataSize) const
+{
+    AssertRange(srcOffset, dataSize, __FUNCTION__);
+    ::memcpy(data, data_.get() + srcOffset, static_cast<std::size_t>(dataSize));
+}
+
+void NullBuffer::CopyFrom(std::uint64_t dstOffset, const NullBuffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    AssertRange(dstOffset, size, __FUNCTION__);
+    srcBuffer.AssertRange(srcOffset, size, __FUNCTION__);
+    ::memmove(data_.get() + dstOffset, srcBuffer.data_.get() + srcOffset, static_cast<std::size_t>(size));
+}
+
+void* NullBuffer::Map(const CPUAccess /*access*/)
+{
+    if (mapped_)
+        return nullptr;
+    mapped_ = true;
+    return data_.get();
+}
+
+void NullBuffer::Unmap()
+{
+    mapped_ = false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullBuffer::AssertRange(std::uint64_t offset, std::uint64_t size, const char* funcName) const
+{
+    if (offset + size > size_ || offset + size < offset)
+    {
+        throw std::out_of_range(
+            std::string(funcName) + ": buffer range [" + std::to_string(offset) + ", " + std::to_string(offset + size) +
+            ") exceeds buffer size of " + std::to_string(size_) + " byte(s)"
+        );
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
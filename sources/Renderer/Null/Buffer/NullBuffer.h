@@ -0,0 +1,81 @@
+/*
+ * NullBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_BUFFER_H
+#define LLGL_NULL_BUFFER_H
+
+
+#include <LLGL/Buffer.h>
+#include <LLGL/BufferFlags.h>
+#include <memory>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Buffer that only lives in host memory.
+class NullBuffer final : public Buffer
+{
+
+    public:
+
+        NullBuffer(const BufferDescriptor& desc, const void* initialData = nullptr);
+
+        // Writes the specified data into the buffer at the specified offset.
+        void Write(std::uint64_t dstOffset, const void* data, std::uint64_t dataSize);
+
+        // Reads the buffer content at the specified offset into the output data.
+        void Read(std::uint64_t srcOffset, void* data, std::uint64_t dataSize) const;
+
+        // Copies a region from the source buffer into this buffer (overlapping regions are allowed).
+        void CopyFrom(std::uint64_t dstOffset, const NullBuffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size);
+
+        void* Map(const CPUAccess access);
+        void Unmap();
+
+        // Returns the raw buffer data.
+        inline const std::uint8_t* GetData() const
+        {
+            return data_.get();
+        }
+
+        // Returns the size (in bytes) of this buffer.
+        inline std::uint64_t GetSize() const
+        {
+            return size_;
+        }
+
+        // Returns the index format this buffer was created with.
+        inline Format GetIndexFormat() const
+        {
+            return indexFormat_;
+        }
+
+    private:
+
+        void AssertRange(std::uint64_t offset, std::uint64_t size, const char* funcName) const;
+
+    private:
+
+        std::unique_ptr<std::uint8_t[]> data_;
+        std::uint64_t                   size_           = 0;
+        Format                          indexFormat_    = Format::Undefined;
+        bool                            mapped_         = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,114 @@
+/*
+ * NullCommand.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_COMMAND_H
+#define LLGL_NULL_COMMAND_H
+
+
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/GraphicsPipelineFlags.h>
+#include <LLGL/Types.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class NullBuffer;
+class NullQueryHeap;
+class NullRenderTarget;
+class NullRenderPass;
+class NullCommandBuffer;
+
+
+struct NullCmdUpdateBuffer
+{
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+    std::uint64_t   size;
+//  std::int8_t     data[size];
+};
+
+struct NullCmdCopyBuffer
+{
+    NullBuffer*     dstBuffer;
+    std::uint64_t   dstOffset;
+    NullBuffer*     srcBuffer;
+    std::uint64_t   srcOffset;
+    std::uint64_t   size;
+};
+
+struct NullCmdExecute
+{
+    const NullCommandBuffer* commandBuffer;
+};
+
+struct NullCmdBeginRenderPass
+{
+    NullRenderTarget*       renderTarget; // Null if a render context is bound
+    const NullRenderPass*   renderPass;
+    std::uint32_t           numClearValues;
+//  ClearValue              clearValues[numClearValues];
+};
+
+struct NullCmdClear
+{
+    long        flags;
+    ClearValue  clearValue;
+};
+
+struct NullCmdClearAttachments
+{
+    std::uint32_t   numAttachments;
+//  AttachmentClear attachments[numAttachments];
+};
+
+struct NullCmdQuery
+{
+    NullQueryHeap*  queryHeap;
+    std::uint32_t   query;
+};
+
+struct NullCmdDraw
+{
+    PrimitiveTopology   topology;
+    std::uint32_t       numVertices;
+    std::uint32_t       numInstances;
+};
+
+struct NullCmdDrawIndirect
+{
+    PrimitiveTopology   topology;
+    const NullBuffer*   buffer;
+    std::uint64_t       offset;
+    std::uint32_t       numCommands;
+    std::uint32_t       stride;
+};
+
+struct NullCmdDispatch
+{
+    Extent3D        workGroupSize;
+    std::uint32_t   numWorkGroups[3];
+};
+
+struct NullCmdDispatchIndirect
+{
+    Extent3D            workGroupSize;
+    const NullBuffer*   buffer;
+    std::uint64_t       offset;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,547 @@
+/*
+ * NullCommandBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullCommandBuffer.h"
+#include "NullCommand.h"
+#include "../../CheckedCast.h"
+#include "../../ProfileCounters.h"
+
+#include "../Buffer/NullBuffer.h"
+
+#include "../Shader/NullShaderProgram.h"
+
+#include "../Texture/NullRenderTarget.h"
+
+#include "../RenderState/NullGraphicsPipeline.h"
+#include "../RenderState/NullComputePipeline.h"
+#include "../RenderState/NullRenderPass.h"
+#include "../RenderState/NullQueryHeap.h"
+
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
+    flags_ { desc.flags }
+{
+}
+
+/* ----- Encoding ----- */
+
+void NullCommandBuffer::Begin()
+{
+    LLGL_PROFILE_COUNT(commandBufferEncodings);
+
+    /* Reset internal command buffer */
+    buffer_.clear();
+}
+
+void NullCommandBuffer::End()
+{
+    // dummy
+}
+
+void NullCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize)
+{
+    LLGL_PROFILE_COUNT(bufferUpdates);
+
+    auto cmd = AllocCommand<NullCmdUpdateBuffer>(NullOpcodeUpdateBuffer, dataSize);
+    {
+        cmd->buffer = LLGL_CAST(NullBuffer*, &dstBuffer);
+        cmd->offset = dstOffset;
+        cmd->size   = dataSize;
+        ::memcpy(cmd + 1, data, dataSize);
+    }
+}
+
+void NullCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    LLGL_PROFILE_COUNT(bufferCopies);
+
+    auto cmd = AllocCommand<NullCmdCopyBuffer>(NullOpcodeCopyBuffer);
+    {
+        cmd->dstBuffer  = LLGL_CAST(NullBuffer*, &dstBuffer);
+        cmd->dstOffset  = dstOffset;
+        cmd->srcBuffer  = LLGL_CAST(NullBuffer*, &srcBuffer);
+        cmd->srcOffset  = srcOffset;
+        cmd->size       = size;
+    }
+}
+
+void NullCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    if (IsPrimary())
+    {
+        /* Is this a secondary command buffer? */
+        auto& cmdBufferNull = LLGL_CAST(const NullCommandBuffer&, deferredCommandBuffer);
+        if (!cmdBufferNull.IsPrimary())
+        {
+            auto cmd = AllocCommand<NullCmdExecute>(NullOpcodeExecute);
+            cmd->commandBuffer = &cmdBufferNull;
+        }
+    }
+}
+
+/* ----- Configuration ----- */
+
+void NullCommandBuffer::SetGraphicsAPIDependentState(const void* /*stateDesc*/, std::size_t /*stateDescSize*/)
+{
+    // dummy
+}
+
+/* ----- Viewport and Scissor ----- */
+
+void NullCommandBuffer::SetViewport(const Viewport& /*viewport*/)
+{
+    // dummy
+}
+
+void NullCommandBuffer::SetViewports(std::uint32_t /*numViewports*/, const Viewport* /*viewports*/)
+{
+    // dummy
+}
+
+void NullCommandBuffer::SetScissor(const Scissor& /*scissor*/)
+{
+    // dummy
+}
+
+void NullCommandBuffer::SetScissors(std::uint32_t /*numScissors*/, const Scissor* /*scissors*/)
+{
+    // dummy
+}
+
+/* ----- Clear ----- */
+
+void NullCommandBuffer::SetClearColor(const ColorRGBAf& color)
+{
+    clearValue_.color = color;
+}
+
+void NullCommandBuffer::SetClearDepth(float depth)
+{
+    clearValue_.depth = depth;
+}
+
+void NullCommandBuffer::SetClearStencil(std::uint32_t stencil)
+{
+    clearValue_.stencil = stencil;
+}
+
+void NullCommandBuffer::Clear(long flags)
+{
+    LLGL_PROFILE_COUNT(attachmentClears);
+
+    auto cmd = AllocCommand<NullCmdClear>(NullOpcodeClear);
+    {
+        cmd->flags      = flags;
+        cmd->clearValue = clearValue_;
+    }
+}
+
+void NullCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    LLGL_PROFILE_COUNT(attachmentClears);
+
+    auto cmd = AllocCommand<NullCmdClearAttachments>(NullOpcodeClearAttachments, sizeof(AttachmentClear)*numAttachments);
+    {
+        cmd->numAttachments = numAttachments;
+        if (numAttachments > 0)
+            ::memcpy(cmd + 1, attachments, sizeof(AttachmentClear)*numAttachments);
+    }
+}
+
+/* ----- Input Assembly ------ */
+
+void NullCommandBuffer::SetVertexBuffer(Buffer& /*buffer*/)
+{
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetVertexBufferArray(BufferArray& /*bufferArray*/)
+{
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetIndexBuffer(Buffer& /*buffer*/)
+{
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetIndexBuffer(Buffer& /*buffer*/, const Format /*format*/, std::uint64_t /*offset*/)
+{
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
+    // dummy
+}
+
+/* ----- Stream Output Buffers ------ */
+
+void NullCommandBuffer::SetStreamOutputBuffer(Buffer& /*buffer*/)
+{
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetStreamOutputBufferArray(BufferArray& /*bufferArray*/)
+{
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::BeginStreamOutput(const PrimitiveType /*primitiveType*/)
+{
+    LLGL_PROFILE_COUNT(streamOutputSections);
+
+    // dummy
+}
+
+void NullCommandBuffer::EndStreamOutput()
+{
+    // dummy
+}
+
+/* ----- Resource Heaps ----- */
+
+void NullCommandBuffer::SetGraphicsResourceHeap(ResourceHeap& /*resourceHeap*/, std::uint32_t /*startSlot*/)
+{
+    LLGL_PROFILE_COUNT(graphicsResourceHeapBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetComputeResourceHeap(ResourceHeap& /*resourceHeap*/, std::uint32_t /*startSlot*/)
+{
+    LLGL_PROFILE_COUNT(computeResourceHeapBindings);
+
+    // dummy
+}
+
+/* ----- Render Passes ----- */
+
+void NullCommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    LLGL_PROFILE_COUNT(renderPassSections);
+
+    auto cmd = AllocCommand<NullCmdBeginRenderPass>(NullOpcodeBeginRenderPass, sizeof(ClearValue)*numClearValues);
+    {
+        /* Render contexts have no host memory attachments */
+        if (renderTarget.IsRenderContext())
+            cmd->renderTarget = nullptr;
+        else
+            cmd->renderTarget = LLGL_CAST(NullRenderTarget*, &renderTarget);
+
+        cmd->renderPass     = LLGL_CAST(const NullRenderPass*, renderPass);
+        cmd->numClearValues = numClearValues;
+
+        if (numClearValues > 0)
+            ::memcpy(cmd + 1, clearValues, sizeof(ClearValue)*numClearValues);
+    }
+}
+
+void NullCommandBuffer::EndRenderPass()
+{
+    AllocOpCode(NullOpcodeEndRenderPass);
+}
+
+/* ----- Pipeline States ----- */
+
+void NullCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
+{
+    LLGL_PROFILE_COUNT(graphicsPipelineBindings);
+
+    auto& graphicsPipelineNull = LLGL_CAST(NullGraphicsPipeline&, graphicsPipeline);
+    topology_ = graphicsPipelineNull.GetDesc().primitiveTopology;
+}
+
+void NullCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
+{
+    LLGL_PROFILE_COUNT(computePipelineBindings);
+
+    auto& computePipelineNull = LLGL_CAST(NullComputePipeline&, computePipeline);
+    if (auto shaderProgram = computePipelineNull.GetDesc().shaderProgram)
+        shaderProgram->GetWorkGroupSize(workGroupSize_);
+}
+
+/* ----- Queries ----- */
+
+void NullCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    LLGL_PROFILE_COUNT(querySections);
+
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeBeginQuery);
+    {
+        cmd->queryHeap  = LLGL_CAST(NullQueryHeap*, &queryHeap);
+        cmd->query      = query;
+    }
+}
+
+void NullCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeEndQuery);
+    {
+        cmd->queryHeap  = LLGL_CAST(NullQueryHeap*, &queryHeap);
+        cmd->query      = query;
+    }
+}
+
+void NullCommandBuffer::BeginRenderCondition(QueryHeap& /*queryHeap*/, std::uint32_t /*query*/, const RenderConditionMode /*mode*/)
+{
+    LLGL_PROFILE_COUNT(renderConditionSections);
+
+    // dummy
+}
+
+void NullCommandBuffer::EndRenderCondition()
+{
+    // dummy
+}
+
+/* ----- Drawing ----- */
+
+void NullCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t /*firstVertex*/)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDraw(numVertices, 1);
+}
+
+void NullCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t /*firstIndex*/)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDraw(numIndices, 1);
+}
+
+void NullCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t /*firstIndex*/, std::int32_t /*vertexOffset*/)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDraw(numIndices, 1);
+}
+
+void NullCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t /*firstVertex*/, std::uint32_t numInstances)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDraw(numVertices, numInstances);
+}
+
+void NullCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t /*firstVertex*/, std::uint32_t numInstances, std::uint32_t /*firstInstance*/)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDraw(numVertices, numInstances);
+}
+
+void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t /*firstIndex*/)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDraw(numIndices, numInstances);
+}
+
+void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t /*firstIndex*/, std::int32_t /*vertexOffset*/)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDraw(numIndices, numInstances);
+}
+
+void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t /*firstIndex*/, std::int32_t /*vertexOffset*/, std::uint32_t /*firstInstance*/)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDraw(numIndices, numInstances);
+}
+
+void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDrawIndirect(buffer, offset, 1, 0);
+}
+
+void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDrawIndirect(buffer, offset, numCommands, stride);
+}
+
+void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDrawIndirect(buffer, offset, 1, 0);
+}
+
+void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_PROFILE_COUNT(drawCommands);
+
+    RecordDrawIndirect(buffer, offset, numCommands, stride);
+}
+
+/* ----- Compute ----- */
+
+void NullCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
+    auto cmd = AllocCommand<NullCmdDispatch>(NullOpcodeDispatch);
+    {
+        cmd->workGroupSize      = workGroupSize_;
+        cmd->numWorkGroups[0]   = numWorkGroupsX;
+        cmd->numWorkGroups[1]   = numWorkGroupsY;
+        cmd->numWorkGroups[2]   = numWorkGroupsZ;
+    }
+}
+
+void NullCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
+    auto cmd = AllocCommand<NullCmdDispatchIndirect>(NullOpcodeDispatchIndirect);
+    {
+        cmd->workGroupSize  = workGroupSize_;
+        cmd->buffer         = LLGL_CAST(const NullBuffer*, &buffer);
+        cmd->offset         = offset;
+    }
+}
+
+/* ----- Debugging ----- */
+
+void NullCommandBuffer::PushDebugGroup(const char* /*name*/)
+{
+    // dummy
+}
+
+void NullCommandBuffer::PopDebugGroup()
+{
+    // dummy
+}
+
+/* ----- Direct Resource Access ------ */
+
+void NullCommandBuffer::SetConstantBuffer(Buffer& /*buffer*/, std::uint32_t /*slot*/, long /*stageFlags*/)
+{
+    LLGL_PROFILE_COUNT(constantBufferBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetSampleBuffer(Buffer& /*buffer*/, std::uint32_t /*slot*/, long /*stageFlags*/)
+{
+    LLGL_PROFILE_COUNT(sampleBufferBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetRWStorageBuffer(Buffer& /*buffer*/, std::uint32_t /*slot*/, long /*stageFlags*/)
+{
+    LLGL_PROFILE_COUNT(rwStorageBufferBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetTexture(Texture& /*texture*/, std::uint32_t /*layer*/, long /*stageFlags*/)
+{
+    LLGL_PROFILE_COUNT(textureBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::SetSampler(Sampler& /*sampler*/, std::uint32_t /*layer*/, long /*stageFlags*/)
+{
+    LLGL_PROFILE_COUNT(samplerBindings);
+
+    // dummy
+}
+
+void NullCommandBuffer::ResetResourceSlots(
+    const ResourceType  /*resourceType*/,
+    std::uint32_t       /*firstSlot*/,
+    std::uint32_t       /*numSlots*/,
+    long                /*bindFlags*/,
+    long                /*stageFlags*/)
+{
+    // dummy
+}
+
+/* ----- Extended functions ----- */
+
+bool NullCommandBuffer::IsPrimary() const
+{
+    return ((GetFlags() & CommandBufferFlags::DeferredSubmit) == 0);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullCommandBuffer::RecordDraw(std::uint32_t numVertices, std::uint32_t numInstances)
+{
+    auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw);
+    {
+        cmd->topology       = topology_;
+        cmd->numVertices    = numVertices;
+        cmd->numInstances   = numInstances;
+    }
+}
+
+void NullCommandBuffer::RecordDrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    auto cmd = AllocCommand<NullCmdDrawIndirect>(NullOpcodeDrawIndirect);
+    {
+        cmd->topology       = topology_;
+        cmd->buffer         = LLGL_CAST(const NullBuffer*, &buffer);
+        cmd->offset         = offset;
+        cmd->numCommands    = numCommands;
+        cmd->stride         = stride;
+    }
+}
+
+void NullCommandBuffer::AllocOpCode(const NullOpcode opcode)
+{
+    buffer_.push_back(opcode);
+}
+
+template <typename T>
+T* NullCommandBuffer::AllocCommand(const NullOpcode opcode, std::size_t extraSize)
+{
+    /* Resize internal buffer for opcode, command structure, and extra size */
+    auto offset = buffer_.size();
+    {
+        buffer_.resize(offset + sizeof(opcode) + sizeof(T) + extraSize);
+        buffer_[offset] = opcode;
+    }
+    return reinterpret_cast<T*>(&(buffer_[offset + sizeof(opcode)]));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,204 @@
+/*
+ * NullCommandBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_COMMAND_BUFFER_H
+#define LLGL_NULL_COMMAND_BUFFER_H
+
+
+#include <LLGL/CommandBufferExt.h>
+#include <LLGL/GraphicsPipelineFlags.h>
+#include "NullCommandOpcode.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Command buffer that records all commands with an observable effect in host memory (e.g. buffer updates, clear operations, queries)
+into a byte stream that is executed by the command queue. All other commands are discarded, since there is no device they could affect.
+*/
+class NullCommandBuffer final : public CommandBufferExt
+{
+
+    public:
+
+        NullCommandBuffer(const CommandBufferDescriptor& desc);
+
+        /* ----- Encoding ----- */
+
+        void Begin() override;
+        void End() override;
+
+        void UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize) override;
+        void CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+
+        void Execute(CommandBuffer& deferredCommandBuffer) override;
+
+        /* ----- Configuration ----- */
+
+        void SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize) override;
+
+        /* ----- Viewport and Scissor ----- */
+
+        void SetViewport(const Viewport& viewport) override;
+        void SetViewports(std::uint32_t numViewports, const Viewport* viewports) override;
+
+        void SetScissor(const Scissor& scissor) override;
+        void SetScissors(std::uint32_t numScissors, const Scissor* scissors) override;
+
+        /* ----- Clear ----- */
+
+        void SetClearColor(const ColorRGBAf& color) override;
+        void SetClearDepth(float depth) override;
+        void SetClearStencil(std::uint32_t stencil) override;
+
+        void Clear(long flags) override;
+        void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
+
+        /* ----- Input Assembly ------ */
+
+        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBufferArray(BufferArray& bufferArray) override;
+
+        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset = 0) override;
+
+        /* ----- Stream Output Buffers ------ */
+
+        void SetStreamOutputBuffer(Buffer& buffer) override;
+        void SetStreamOutputBufferArray(BufferArray& bufferArray) override;
+
+        void BeginStreamOutput(const PrimitiveType primitiveType) override;
+        void EndStreamOutput() override;
+
+        /* ----- Resource Heaps ----- */
+
+        void SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t startSlot) override;
+        void SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t startSlot) override;
+
+        /* ----- Render Passes ----- */
+
+        void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void EndRenderPass() override;
+
+        /* ----- Pipeline States ----- */
+
+        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
+        void SetComputePipeline(ComputePipeline& computePipeline) override;
+
+        /* ----- Queries ----- */
+
+        void BeginQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
+        void EndQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
+
+        void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query = 0, const RenderConditionMode mode = RenderConditionMode::Wait) override;
+        void EndRenderCondition() override;
+
+        /* ----- Drawing ----- */
+
+        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) override;
+
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) override;
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
+
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) override;
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) override;
+
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) override;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) override;
+
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        /* ----- Compute ----- */
+
+        void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
+        void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
+
+        /* ----- Debugging ----- */
+
+        void PushDebugGroup(const char* name) override;
+        void PopDebugGroup() override;
+
+        /* ----- Direct Resource Access ------ */
+
+        void SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+        void SetSampleBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+        void SetRWStorageBuffer(Buffer& buffer, std::uint32_t slot, long stageFlags = StageFlags::AllStages) override;
+        void SetTexture(Texture& texture, std::uint32_t layer, long stageFlags = StageFlags::AllStages) override;
+        void SetSampler(Sampler& sampler, std::uint32_t layer, long stageFlags = StageFlags::AllStages) override;
+
+        void ResetResourceSlots(
+            const ResourceType  resourceType,
+            std::uint32_t       firstSlot,
+            std::uint32_t       numSlots,
+            long                bindFlags,
+            long                stageFlags      = StageFlags::AllStages
+        ) override;
+
+    public:
+
+        // Returns true if this is a primary command buffer, i.e. it can be submitted directly to the command queue.
+        bool IsPrimary() const;
+
+        // Returns the internal command buffer as raw byte buffer.
+        inline const std::vector<std::uint8_t>& GetRawBuffer() const
+        {
+            return buffer_;
+        }
+
+        // Returns the flags this command buffer was created with (see CommandBufferDescriptor::flags).
+        inline long GetFlags() const
+        {
+            return flags_;
+        }
+
+    private:
+
+        void RecordDraw(std::uint32_t numVertices, std::uint32_t numInstances);
+        void RecordDrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride);
+
+        /* Allocates only an opcode for empty commands */
+        void AllocOpCode(const NullOpcode opcode);
+
+        /* Allocates a new command and stores the specified opcode */
+        template <typename T>
+        T* AllocCommand(const NullOpcode opcode, std::size_t extraSize = 0);
+
+    private:
+
+        long                        flags_              = 0;
+        std::vector<std::uint8_t>   buffer_;
+
+        ClearValue                  clearValue_;
+        PrimitiveTopology           topology_           = PrimitiveTopology::TriangleList;
+        Extent3D                    workGroupSize_      = { 1, 1, 1 };
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,372 @@
+/*
+ * NullCommandExecutor.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullCommandExecutor.h"
+#include "NullCommand.h"
+#include "NullCommandBuffer.h"
+
+#include "../Buffer/NullBuffer.h"
+
+#include "../Texture/NullTexture.h"
+#include "../Texture/NullRenderTarget.h"
+
+#include "../RenderState/NullRenderPass.h"
+#include "../RenderState/NullQueryHeap.h"
+
+#include <LLGL/IndirectArguments.h>
+#include <algorithm>
+#include <chrono>
+
+
+namespace LLGL
+{
+
+
+/* ----- Clear ----- */
+
+// Clears the specified attachment with the clear value, if the clear flags match the attachment type.
+static void ClearNullAttachment(const NullAttachment& attachment, long flags, const ClearValue& clearValue)
+{
+    switch (attachment.type)
+    {
+        case AttachmentType::Color:
+            if ((flags & ClearFlags::Color) != 0)
+                attachment.texture->FillColor(attachment.region, clearValue.color.Cast<double>());
+            break;
+
+        case AttachmentType::Depth:
+        case AttachmentType::DepthStencil:
+        case AttachmentType::Stencil:
+            /* Depth-stencil texels are always cleared entirely, i.e. with both the depth and stencil values */
+            if ((flags & ClearFlags::DepthStencil) != 0)
+            {
+                attachment.texture->FillColor(
+                    attachment.region,
+                    ColorRGBAd{ static_cast<double>(clearValue.depth), static_cast<double>(clearValue.stencil), 0.0, 0.0 }
+                );
+            }
+            break;
+    }
+}
+
+static void ClearNullRenderTarget(const NullRenderTarget& renderTarget, long flags, const ClearValue& clearValue)
+{
+    for (const auto& attachment : renderTarget.GetAttachments())
+        ClearNullAttachment(attachment, flags, clearValue);
+}
+
+static void ClearNullRenderTargetWithRenderPass(
+    const NullRenderTarget& renderTarget,
+    const NullRenderPass&   renderPass,
+    std::uint32_t           numClearValues,
+    const ClearValue*       clearValues)
+{
+    const auto& renderPassDesc = renderPass.GetDesc();
+
+    std::uint32_t colorIndex = 0, clearValueIndex = 0;
+
+    /* Clear color attachments with their respective clear values */
+    for (const auto& attachment : renderTarget.GetAttachments())
+    {
+        if (attachment.type != AttachmentType::Color)
+            continue;
+
+        const auto index = colorIndex++;
+        if (index < renderPassDesc.colorAttachments.size() && renderPassDesc.colorAttachments[index].loadOp == AttachmentLoadOp::Clear)
+        {
+            const ClearValue clearValue = (clearValueIndex < numClearValues ? clearValues[clearValueIndex] : ClearValue{});
+            ++clearValueIndex;
+            ClearNullAttachment(attachment, ClearFlags::Color, clearValue);
+        }
+    }
+
+    /* Clear depth-stencil attachment with the next clear value */
+    if (renderPassDesc.depthAttachment.loadOp == AttachmentLoadOp::Clear || renderPassDesc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
+    {
+        const ClearValue clearValue = (clearValueIndex < numClearValues ? clearValues[clearValueIndex] : ClearValue{});
+        for (const auto& attachment : renderTarget.GetAttachments())
+        {
+            if (attachment.type != AttachmentType::Color)
+                ClearNullAttachment(attachment, ClearFlags::DepthStencil, clearValue);
+        }
+    }
+}
+
+static void ClearNullAttachments(const NullRenderTarget& renderTarget, std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    for (; numAttachments-- > 0; ++attachments)
+    {
+        if ((attachments->flags & ClearFlags::Color) != 0)
+        {
+            /* Find color attachment by its index */
+            std::uint32_t colorIndex = 0;
+            for (const auto& attachment : renderTarget.GetAttachments())
+            {
+                if (attachment.type == AttachmentType::Color)
+                {
+                    if (colorIndex++ == attachments->colorAttachment)
+                    {
+                        ClearNullAttachment(attachment, ClearFlags::Color, attachments->clearValue);
+                        break;
+                    }
+                }
+            }
+        }
+        else
+        {
+            /* Clear depth-stencil attachment */
+            for (const auto& attachment : renderTarget.GetAttachments())
+            {
+                if (attachment.type != AttachmentType::Color)
+                    ClearNullAttachment(attachment, attachments->flags, attachments->clearValue);
+            }
+        }
+    }
+}
+
+/* ----- Queries ----- */
+
+static std::uint64_t GetTimestampNanoseconds()
+{
+    using namespace std::chrono;
+    return static_cast<std::uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+static void BeginNullQuery(NullExecutionState& state, NullQueryHeap& queryHeap, std::uint32_t query)
+{
+    queryHeap.Begin(query);
+
+    if (queryHeap.GetType() == QueryType::TimeElapsed)
+    {
+        /* Store start time in query result until the query ends */
+        *queryHeap.GetResult(query) = GetTimestampNanoseconds();
+    }
+    else if (queryHeap.GetType() == QueryType::PipelineStatistics)
+    {
+        /* Add query to the list of active queries that accumulate pipeline statistics */
+        state.activeQueries.push_back({ &queryHeap, query });
+    }
+}
+
+static void EndNullQuery(NullExecutionState& state, NullQueryHeap& queryHeap, std::uint32_t query)
+{
+    if (queryHeap.GetType() == QueryType::TimeElapsed)
+    {
+        /* Replace start time with elapsed time */
+        auto result = queryHeap.GetResult(query);
+        *result = GetTimestampNanoseconds() - *result;
+    }
+    else if (queryHeap.GetType() == QueryType::PipelineStatistics)
+    {
+        /* Remove query from the list of active queries */
+        auto it = std::find_if(
+            state.activeQueries.begin(),
+            state.activeQueries.end(),
+            [&queryHeap, query](const NullActiveQuery& entry)
+            {
+                return (entry.queryHeap == &queryHeap && entry.query == query);
+            }
+        );
+        if (it != state.activeQueries.end())
+            state.activeQueries.erase(it);
+    }
+
+    queryHeap.End(query);
+}
+
+static QueryPipelineStatistics& GetPipelineStatistics(const NullActiveQuery& activeQuery)
+{
+    return *reinterpret_cast<QueryPipelineStatistics*>(activeQuery.queryHeap->GetResult(activeQuery.query));
+}
+
+static std::uint64_t GetNumPrimitives(const PrimitiveTopology topology, std::uint64_t numVertices)
+{
+    switch (topology)
+    {
+        case PrimitiveTopology::PointList:              return numVertices;
+        case PrimitiveTopology::LineList:               return numVertices / 2;
+        case PrimitiveTopology::LineStrip:              return (numVertices >= 2 ? numVertices - 1 : 0);
+        case PrimitiveTopology::LineLoop:               return (numVertices >= 2 ? numVertices : 0);
+        case PrimitiveTopology::LineListAdjacency:      return numVertices / 4;
+        case PrimitiveTopology::LineStripAdjacency:     return (numVertices >= 4 ? numVertices - 3 : 0);
+        case PrimitiveTopology::TriangleList:           return numVertices / 3;
+        case PrimitiveTopology::TriangleStrip:          return (numVertices >= 3 ? numVertices - 2 : 0);
+        case PrimitiveTopology::TriangleFan:            return (numVertices >= 3 ? numVertices - 2 : 0);
+        case PrimitiveTopology::TriangleListAdjacency:  return numVertices / 6;
+        case PrimitiveTopology::TriangleStripAdjacency: return (numVertices >= 6 ? (numVertices - 4) / 2 : 0);
+        default:                                        break;
+    }
+
+    /* Patches: one primitive for each set of control points */
+    if (IsPrimitiveTopologyPatches(topology))
+        return numVertices / std::max(1u, GetPrimitiveTopologyPatchSize(topology));
+
+    return 0;
+}
+
+static void AccumulateDrawStatistics(NullExecutionState& state, const PrimitiveTopology topology, std::uint64_t numVertices, std::uint64_t numInstances)
+{
+    const auto numPrimitives = GetNumPrimitives(topology, numVertices) * numInstances;
+    numVertices *= numInstances;
+
+    for (const auto& activeQuery : state.activeQueries)
+    {
+        auto& stats = GetPipelineStatistics(activeQuery);
+        stats.inputAssemblyVertices     += numVertices;
+        stats.inputAssemblyPrimitives   += numPrimitives;
+        stats.vertexShaderInvocations   += numVertices;
+    }
+}
+
+static void AccumulateDispatchStatistics(NullExecutionState& state, const Extent3D& workGroupSize, const std::uint32_t (&numWorkGroups)[3])
+{
+    const std::uint64_t numInvocations =
+    (
+        static_cast<std::uint64_t>(workGroupSize.width) * workGroupSize.height * workGroupSize.depth *
+        numWorkGroups[0] * numWorkGroups[1] * numWorkGroups[2]
+    );
+
+    for (const auto& activeQuery : state.activeQueries)
+        GetPipelineStatistics(activeQuery).computeShaderInvocations += numInvocations;
+}
+
+/* ----- Commands ----- */
+
+static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc, NullExecutionState& state)
+{
+    switch (opcode)
+    {
+        case NullOpcodeUpdateBuffer:
+        {
+            auto cmd = reinterpret_cast<const NullCmdUpdateBuffer*>(pc);
+            cmd->buffer->Write(cmd->offset, cmd + 1, cmd->size);
+            return (sizeof(*cmd) + static_cast<std::size_t>(cmd->size));
+        }
+        case NullOpcodeCopyBuffer:
+        {
+            auto cmd = reinterpret_cast<const NullCmdCopyBuffer*>(pc);
+            cmd->dstBuffer->CopyFrom(cmd->dstOffset, *(cmd->srcBuffer), cmd->srcOffset, cmd->size);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeExecute:
+        {
+            auto cmd = reinterpret_cast<const NullCmdExecute*>(pc);
+            ExecuteNullCommandBuffer(*(cmd->commandBuffer), state);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeBeginRenderPass:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginRenderPass*>(pc);
+            state.renderTarget = cmd->renderTarget;
+            if (cmd->renderTarget != nullptr && cmd->renderPass != nullptr)
+            {
+                ClearNullRenderTargetWithRenderPass(
+                    *(cmd->renderTarget),
+                    *(cmd->renderPass),
+                    cmd->numClearValues,
+                    reinterpret_cast<const ClearValue*>(cmd + 1)
+                );
+            }
+            return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
+        }
+        case NullOpcodeEndRenderPass:
+        {
+            state.renderTarget = nullptr;
+            return 0;
+        }
+        case NullOpcodeClear:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClear*>(pc);
+            if (state.renderTarget != nullptr)
+                ClearNullRenderTarget(*(state.renderTarget), cmd->flags, cmd->clearValue);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeClearAttachments:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClearAttachments*>(pc);
+            if (state.renderTarget != nullptr)
+                ClearNullAttachments(*(state.renderTarget), cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
+            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
+        }
+        case NullOpcodeBeginQuery:
+        {
+            auto cmd = reinterpret_cast<const NullCmdQuery*>(pc);
+            BeginNullQuery(state, *(cmd->queryHeap), cmd->query);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeEndQuery:
+        {
+            auto cmd = reinterpret_cast<const NullCmdQuery*>(pc);
+            EndNullQuery(state, *(cmd->queryHeap), cmd->query);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDraw:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDraw*>(pc);
+            AccumulateDrawStatistics(state, cmd->topology, cmd->numVertices, cmd->numInstances);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDrawIndirect:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDrawIndirect*>(pc);
+            auto offset = cmd->offset;
+            for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
+            {
+                /* Indexed and non-indexed arguments share the first two fields (number of vertices/indices and instances) */
+                DrawIndirectArguments args;
+                cmd->buffer->Read(offset, &args, sizeof(std::uint32_t) * 2);
+                AccumulateDrawStatistics(state, cmd->topology, args.numVertices, args.numInstances);
+                offset += cmd->stride;
+            }
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDispatch:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDispatch*>(pc);
+            AccumulateDispatchStatistics(state, cmd->workGroupSize, cmd->numWorkGroups);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDispatchIndirect:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDispatchIndirect*>(pc);
+            DispatchIndirectArguments args;
+            cmd->buffer->Read(cmd->offset, &args, sizeof(args));
+            AccumulateDispatchStatistics(state, cmd->workGroupSize, args.numThreadGroups);
+            return sizeof(*cmd);
+        }
+        default:
+            return 0;
+    }
+}
+
+void ExecuteNullCommandBuffer(const NullCommandBuffer& cmdBuffer, NullExecutionState& state)
+{
+    /* Initialize program counter to execute virtual Null commands */
+    const auto& rawBuffer = cmdBuffer.GetRawBuffer();
+
+    auto pc     = rawBuffer.data();
+    auto pcEnd  = rawBuffer.data() + rawBuffer.size();
+
+    NullOpcode opcode;
+
+    while (pc < pcEnd)
+    {
+        /* Read opcode */
+        opcode = *reinterpret_cast<const NullOpcode*>(pc);
+        pc += sizeof(NullOpcode);
+
+        /* Execute command and increment program counter */
+        pc += ExecuteNullCommand(opcode, pc, state);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,49 @@
+/*
+ * NullCommandExecutor.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_COMMAND_EXECUTOR_H
+#define LLGL_NULL_COMMAND_EXECUTOR_H
+
+
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class NullCommandBuffer;
+class NullQueryHeap;
+class NullRenderTarget;
+
+// Query that has been started with BeginQuery but not yet finished with EndQuery.
+struct NullActiveQuery
+{
+    NullQueryHeap*  queryHeap;
+    std::uint32_t   query;
+};
+
+// State of the command execution that persists across multiple command buffer submissions.
+struct NullExecutionState
+{
+    NullRenderTarget*               renderTarget    = nullptr;
+    std::vector<NullActiveQuery>    activeQueries;
+};
+
+// Executes the specified Null command buffer.
+void ExecuteNullCommandBuffer(const NullCommandBuffer& cmdBuffer, NullExecutionState& state);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,44 @@
+/*
+ * NullCommandOpcode.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_COMMAND_OPCODE_H
+#define LLGL_NULL_COMMAND_OPCODE_H
+
+
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+enum NullOpcode : std::uint8_t
+{
+    NullOpcodeUpdateBuffer = 1,
+    NullOpcodeCopyBuffer,
+    NullOpcodeExecute,
+    NullOpcodeBeginRenderPass,
+    NullOpcodeEndRenderPass,
+    NullOpcodeClear,
+    NullOpcodeClearAttachments,
+    NullOpcodeBeginQuery,
+    NullOpcodeEndQuery,
+    NullOpcodeDraw,
+    NullOpcodeDrawIndirect,
+    NullOpcodeDispatch,
+    NullOpcodeDispatchIndirect,
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
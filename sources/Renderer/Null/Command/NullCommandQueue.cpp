@@ -0,0 +1,67 @@
+/*
+ * NullCommandQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullCommandQueue.h"
+#include "NullCommandBuffer.h"
+#include "../RenderState/NullFence.h"
+#include "../RenderState/NullQueryHeap.h"
+#include "../../CheckedCast.h"
+#include "../../ProfileCounters.h"
+
+
+namespace LLGL
+{
+
+
+/* ----- Command Buffers ----- */
+
+void NullCommandQueue::Submit(CommandBuffer& commandBuffer)
+{
+    LLGL_PROFILE_COUNT(commandBufferSubmittions);
+
+    /* Secondary command buffers can only be submitted via CommandBuffer::Execute */
+    auto& cmdBufferNull = LLGL_CAST(const NullCommandBuffer&, commandBuffer);
+    if (cmdBufferNull.IsPrimary())
+        ExecuteNullCommandBuffer(cmdBufferNull, state_);
+}
+
+/* ----- Queries ----- */
+
+bool NullCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
+{
+    auto& queryHeapNull = LLGL_CAST(const NullQueryHeap&, queryHeap);
+    return queryHeapNull.ReadResults(firstQuery, numQueries, data, dataSize);
+}
+
+/* ----- Fences ----- */
+
+void NullCommandQueue::Submit(Fence& fence)
+{
+    LLGL_PROFILE_COUNT(fenceSubmissions);
+
+    /* All previously submitted commands have already been executed */
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    fenceNull.Signal(true);
+}
+
+bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t /*timeout*/)
+{
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    return fenceNull.IsSignaled();
+}
+
+void NullCommandQueue::WaitIdle()
+{
+    // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
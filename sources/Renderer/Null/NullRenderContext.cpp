@@ -0,0 +1,92 @@
+/*
+ * NullRenderContext.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullRenderContext.h"
+#include "NullSurface.h"
+
+
+namespace LLGL
+{
+
+
+static Format GetDepthStencilFormat(int depthBits, int stencilBits)
+{
+    if (stencilBits > 0)
+        return Format::D24UNormS8UInt;
+    if (depthBits > 24)
+        return Format::D32Float;
+    if (depthBits > 16)
+        return Format::D24UNormS8UInt;
+    if (depthBits > 0)
+        return Format::D16UNorm;
+    return Format::Undefined;
+}
+
+NullRenderContext::NullRenderContext(RenderContextDescriptor desc, const std::shared_ptr<Surface>& surface) :
+    colorFormat_        { Format::RGBA8UNorm                                                         },
+    depthStencilFormat_ { GetDepthStencilFormat(desc.videoMode.depthBits, desc.videoMode.stencilBits) }
+{
+    /* Never switch the display into fullscreen mode */
+    desc.videoMode.fullscreen = false;
+
+    if (surface)
+        SetOrCreateSurface(surface, desc.videoMode, nullptr);
+    else
+    {
+        /* Use a surface without a native window */
+        WindowDescriptor windowDesc;
+        {
+            windowDesc.size = desc.videoMode.resolution;
+        }
+        SetOrCreateSurface(std::make_shared<NullSurface>(windowDesc), desc.videoMode, nullptr);
+    }
+
+    SetVsync(desc.vsync);
+}
+
+void NullRenderContext::Present()
+{
+    // dummy
+}
+
+Format NullRenderContext::QueryColorFormat() const
+{
+    return colorFormat_;
+}
+
+Format NullRenderContext::QueryDepthStencilFormat() const
+{
+    return depthStencilFormat_;
+}
+
+const RenderPass* NullRenderContext::GetRenderPass() const
+{
+    return nullptr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool NullRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
+{
+    depthStencilFormat_ = GetDepthStencilFormat(videoModeDesc.depthBits, videoModeDesc.stencilBits);
+    return true;
+}
+
+bool NullRenderContext::OnSetVsync(const VsyncDescriptor& /*vsyncDesc*/)
+{
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,54 @@
+/*
+ * NullRenderContext.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_RENDER_CONTEXT_H
+#define LLGL_NULL_RENDER_CONTEXT_H
+
+
+#include <LLGL/RenderContext.h>
+
+
+namespace LLGL
+{
+
+
+// Render context without a swap-chain. If no surface is specified, a NullSurface is used instead of a native window.
+class NullRenderContext final : public RenderContext
+{
+
+    public:
+
+        NullRenderContext(RenderContextDescriptor desc, const std::shared_ptr<Surface>& surface);
+
+        void Present() override;
+
+        Format QueryColorFormat() const override;
+        Format QueryDepthStencilFormat() const override;
+
+        const RenderPass* GetRenderPass() const override;
+
+    private:
+
+        bool OnSetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
+        bool OnSetVsync(const VsyncDescriptor& vsyncDesc) override;
+
+    private:
+
+        Format colorFormat_         = Format::RGBA8UNorm;
+        Format depthStencilFormat_  = Format::Undefined;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
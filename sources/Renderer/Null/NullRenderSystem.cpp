@@ -0,0 +1,476 @@
+/*
+ * NullRenderSystem.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullRenderSystem.h"
+#include "../CheckedCast.h"
+#include "../ProfileCounters.h"
+#include "../StaticLimits.h"
+#include "../../Core/Helper.h"
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Format.h>
+#include <algorithm>
+#include <limits>
+
+
+namespace LLGL
+{
+
+
+/* ----- Common ----- */
+
+NullRenderSystem::NullRenderSystem() :
+    commandQueue_ { MakeUnique<NullCommandQueue>() }
+{
+    QueryRendererInfo();
+    QueryRenderingCaps();
+}
+
+/* ----- Render Context ----- */
+
+RenderContext* NullRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
+{
+    return TakeOwnership(renderContexts_, MakeUnique<NullRenderContext>(desc, surface));
+}
+
+void NullRenderSystem::Release(RenderContext& renderContext)
+{
+    RemoveFromUniqueSet(renderContexts_, &renderContext);
+}
+
+/* ----- Command queues ----- */
+
+CommandQueue* NullRenderSystem::GetCommandQueue()
+{
+    return commandQueue_.get();
+}
+
+/* ----- Command buffers ----- */
+
+CommandBuffer* NullRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
+{
+    return TakeOwnership(commandBuffers_, MakeUnique<NullCommandBuffer>(desc));
+}
+
+CommandBufferExt* NullRenderSystem::CreateCommandBufferExt(const CommandBufferDescriptor& desc)
+{
+    return TakeOwnership(commandBuffers_, MakeUnique<NullCommandBuffer>(desc));
+}
+
+void NullRenderSystem::Release(CommandBuffer& commandBuffer)
+{
+    RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
+}
+
+/* ----- Buffers ------ */
+
+Buffer* NullRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
+{
+    AssertCreateBuffer(desc, GetRenderingCaps().limits.maxBufferSize);
+    return TakeOwnership(buffers_, MakeUnique<NullBuffer>(desc, initialData));
+}
+
+BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+{
+    AssertCreateBufferArray(numBuffers, bufferArray);
+    return TakeOwnership(bufferArrays_, MakeUnique<NullBufferArray>(bufferArray[0]->GetBindFlags(), numBuffers, bufferArray));
+}
+
+void NullRenderSystem::Release(Buffer& buffer)
+{
+    RemoveFromUniqueSet(buffers_, &buffer);
+}
+
+void NullRenderSystem::Release(BufferArray& bufferArray)
+{
+    RemoveFromUniqueSet(bufferArrays_, &bufferArray);
+}
+
+void NullRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
+{
+    LLGL_PROFILE_COUNT(bufferWrites);
+
+    auto& dstBufferNull = LLGL_CAST(NullBuffer&, dstBuffer);
+    dstBufferNull.Write(dstOffset, data, dataSize);
+}
+
+void* NullRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
+{
+    LLGL_PROFILE_COUNT(bufferMappings);
+
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    return bufferNull.Map(access);
+}
+
+void NullRenderSystem::UnmapBuffer(Buffer& buffer)
+{
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    bufferNull.Unmap();
+}
+
+/* ----- Textures ----- */
+
+Texture* NullRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
+{
+    auto textureNull = MakeUnique<NullTexture>(textureDesc);
+
+    if (imageDesc)
+    {
+        /* Write initial image data into the entire first MIP-map */
+        TextureRegion textureRegion;
+        {
+            textureRegion.mipLevel  = 0;
+            textureRegion.offset    = { 0, 0, 0 };
+            textureRegion.extent    = textureNull->QueryMipExtent(0);
+        }
+        WriteTextureRegion(*textureNull, textureRegion, *imageDesc);
+    }
+    else if (GetConfiguration().imageInitialization.enabled)
+    {
+        /* Initialize all MIP-maps with the default clear value */
+        InitializeTexture(*textureNull);
+    }
+
+    return TakeOwnership(textures_, std::move(textureNull));
+}
+
+void NullRenderSystem::Release(Texture& texture)
+{
+    RemoveFromUniqueSet(textures_, &texture);
+}
+
+void NullRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
+{
+    LLGL_PROFILE_COUNT(textureWrites);
+
+    auto& textureNull = LLGL_CAST(NullTexture&, texture);
+    WriteTextureRegion(textureNull, textureRegion, imageDesc);
+}
+
+void NullRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc)
+{
+    auto& textureNull = LLGL_CAST(const NullTexture&, texture);
+
+    /* Read entire MIP-map in the storage format of the texture */
+    const auto srcImageSize = textureNull.GetMipLevelSize(mipLevel);
+
+    if (textureNull.HasImageFormat() && (textureNull.GetImageFormat() != imageDesc.format || textureNull.GetDataType() != imageDesc.dataType))
+    {
+        /* Determine destination image size */
+        const auto extent       = textureNull.QueryMipExtent(mipLevel);
+        const auto numTexels    = static_cast<std::size_t>(extent.width) * extent.height * extent.depth;
+        const auto dstImageSize = numTexels * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType);
+
+        /* Validate output size */
+        AssertImageDataSize(imageDesc.dataSize, dstImageSize);
+
+        /* Convert texture data into requested format */
+        std::vector<char> srcData(srcImageSize);
+        textureNull.Read(mipLevel, srcData.data());
+
+        ConvertImageBuffer(
+            SrcImageDescriptor { textureNull.GetImageFormat(), textureNull.GetDataType(), srcData.data(), srcImageSize },
+            DstImageDescriptor { imageDesc.format, imageDesc.dataType, imageDesc.data, dstImageSize },
+            GetConfiguration().threadCount
+        );
+    }
+    else
+    {
+        /* Validate output size */
+        AssertImageDataSize(imageDesc.dataSize, srcImageSize);
+
+        /* Read texture data directly into output buffer */
+        textureNull.Read(mipLevel, imageDesc.data);
+    }
+}
+
+void NullRenderSystem::GenerateMips(Texture& texture)
+{
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
+    auto& textureNull = LLGL_CAST(NullTexture&, texture);
+    const auto numArrayLayers = textureNull.QueryDesc().arrayLayers;
+    textureNull.GenerateMips(0, textureNull.GetNumMipLevels(), 0, std::max(1u, numArrayLayers));
+}
+
+void NullRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
+{
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
+    auto& textureNull = LLGL_CAST(NullTexture&, texture);
+    textureNull.GenerateMips(baseMipLevel, numMipLevels, baseArrayLayer, numArrayLayers);
+}
+
+/* ----- Sampler States ---- */
+
+Sampler* NullRenderSystem::CreateSampler(const SamplerDescriptor& desc)
+{
+    return TakeOwnership(samplers_, MakeUnique<NullSampler>(desc));
+}
+
+void NullRenderSystem::Release(Sampler& sampler)
+{
+    RemoveFromUniqueSet(samplers_, &sampler);
+}
+
+/* ----- Resource Heaps ----- */
+
+ResourceHeap* NullRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    return TakeOwnership(resourceHeaps_, MakeUnique<NullResourceHeap>(desc));
+}
+
+void NullRenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+}
+
+/* ----- Render Passes ----- */
+
+RenderPass* NullRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
+{
+    AssertCreateRenderPass(desc);
+    return TakeOwnership(renderPasses_, MakeUnique<NullRenderPass>(desc));
+}
+
+void NullRenderSystem::Release(RenderPass& renderPass)
+{
+    RemoveFromUniqueSet(renderPasses_, &renderPass);
+}
+
+/* ----- Render Targets ----- */
+
+RenderTarget* NullRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
+{
+    AssertCreateRenderTarget(desc);
+    return TakeOwnership(renderTargets_, MakeUnique<NullRenderTarget>(desc));
+}
+
+void NullRenderSystem::Release(RenderTarget& renderTarget)
+{
+    RemoveFromUniqueSet(renderTargets_, &renderTarget);
+}
+
+/* ----- Shader ----- */
+
+Shader* NullRenderSystem::CreateShader(const ShaderDescriptor& desc)
+{
+    AssertCreateShader(desc);
+    return TakeOwnership(shaders_, MakeUnique<NullShader>(desc));
+}
+
+ShaderProgram* NullRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
+{
+    AssertCreateShaderProgram(desc);
+    return TakeOwnership(shaderPrograms_, MakeUnique<NullShaderProgram>(desc));
+}
+
+void NullRenderSystem::Release(Shader& shader)
+{
+    RemoveFromUniqueSet(shaders_, &shader);
+}
+
+void NullRenderSystem::Release(ShaderProgram& shaderProgram)
+{
+    RemoveFromUniqueSet(shaderPrograms_, &shaderProgram);
+}
+
+/* ----- Pipeline Layouts ----- */
+
+PipelineLayout* NullRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& desc)
+{
+    return TakeOwnership(pipelineLayouts_, MakeUnique<NullPipelineLayout>(desc));
+}
+
+void NullRenderSystem::Release(PipelineLayout& pipelineLayout)
+{
+    RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
+}
+
+/* ----- Pipeline States ----- */
+
+GraphicsPipeline* NullRenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
+{
+    return TakeOwnership(graphicsPipelines_, MakeUnique<NullGraphicsPipeline>(desc));
+}
+
+ComputePipeline* NullRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
+{
+    return TakeOwnership(computePipelines_, MakeUnique<NullComputePipeline>(desc));
+}
+
+void NullRenderSystem::Release(GraphicsPipeline& graphicsPipeline)
+{
+    RemoveFromUniqueSet(graphicsPipelines_, &graphicsPipeline);
+}
+
+void NullRenderSystem::Release(ComputePipeline& computePipeline)
+{
+    RemoveFromUniqueSet(computePipelines_, &computePipeline);
+}
+
+/* ----- Queries ----- */
+
+QueryHeap* NullRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
+{
+    return TakeOwnership(queryHeaps_, MakeUnique<NullQueryHeap>(desc));
+}
+
+void NullRenderSystem::Release(QueryHeap& queryHeap)
+{
+    RemoveFromUniqueSet(queryHeaps_, &queryHeap);
+}
+
+/* ----- Fences ----- */
+
+Fence* NullRenderSystem::CreateFence()
+{
+    return TakeOwnership(fences_, MakeUnique<NullFence>());
+}
+
+void NullRenderSystem::Release(Fence& fence)
+{
+    RemoveFromUniqueSet(fences_, &fence);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullRenderSystem::QueryRendererInfo()
+{
+    RendererInfo info;
+    {
+        info.rendererName           = "Null";
+        info.deviceName             = "Null Device";
+        info.vendorName             = "LLGL";
+        info.shadingLanguageName    = "None";
+    }
+    SetRendererInfo(info);
+}
+
+void NullRenderSystem::QueryRenderingCaps()
+{
+    RenderingCapabilities caps;
+    {
+        /* Query common attributes */
+        caps.screenOrigin                               = ScreenOrigin::UpperLeft;
+        caps.clippingRange                              = ClippingRange::ZeroToOne;
+
+        /* Shaders are never compiled, so any shading language is accepted */
+        caps.shadingLanguages                           = { ShadingLanguage::GLSL, ShadingLanguage::ESSL, ShadingLanguage::HLSL, ShadingLanguage::Metal, ShadingLanguage::SPIRV };
+
+        /* All texture formats can be stored in host memory */
+        for (auto format = static_cast<int>(Format::R8UNorm); format <= static_cast<int>(Format::BC3RGBA); ++format)
+            caps.textureFormats.push_back(static_cast<Format>(format));
+
+        /* Query features */
+        caps.features.hasCommandBufferExt               = true;
+        caps.features.hasRenderTargets                  = true;
+        caps.features.has3DTextures                     = true;
+        caps.features.hasCubeTextures                   = true;
+        caps.features.hasArrayTextures                  = true;
+        caps.features.hasCubeArrayTextures              = true;
+        caps.features.hasMultiSampleTextures            = true;
+        caps.features.hasSamplers                       = true;
+        caps.features.hasConstantBuffers                = true;
+        caps.features.hasStorageBuffers                 = true;
+        caps.features.hasUniforms                       = true;
+        caps.features.hasGeometryShaders                = true;
+        caps.features.hasTessellationShaders            = true;
+        caps.features.hasComputeShaders                 = true;
+        caps.features.hasInstancing                     = true;
+        caps.features.hasOffsetInstancing               = true;
+        caps.features.hasIndirectDrawing                = true;
+        caps.features.hasViewportArrays                 = true;
+        caps.features.hasConservativeRasterization      = true;
+        caps.features.hasStreamOutputs                  = true;
+        caps.features.hasLogicOp                        = true;
+        caps.features.hasPipelineStatistics             = true;
+        caps.features.hasRenderCondition                = true;
+
+        /* Query limits */
+        caps.limits.lineWidthRange[0]                   = 1.0f;
+        caps.limits.lineWidthRange[1]                   = 1.0f;
+        caps.limits.maxTextureArrayLayers               = 2048u;
+        caps.limits.maxColorAttachments                 = LLGL_MAX_NUM_COLOR_ATTACHMENTS;
+        caps.limits.maxPatchVertices                    = 32u;
+        caps.limits.max1DTextureSize                    = 16384u;
+        caps.limits.max2DTextureSize                    = 16384u;
+        caps.limits.max3DTextureSize                    = 2048u;
+        caps.limits.maxCubeTextureSize                  = 16384u;
+        caps.limits.maxAnisotropy                       = 16u;
+        caps.limits.maxComputeShaderWorkGroups[0]       = 65535u;
+        caps.limits.maxComputeShaderWorkGroups[1]       = 65535u;
+        caps.limits.maxComputeShaderWorkGroups[2]       = 65535u;
+        caps.limits.maxComputeShaderWorkGroupSize[0]    = 1024u;
+        caps.limits.maxComputeShaderWorkGroupSize[1]    = 1024u;
+        caps.limits.maxComputeShaderWorkGroupSize[2]    = 64u;
+        caps.limits.maxViewports                        = 16u;
+        caps.limits.maxViewportSize[0]                  = 16384u;
+        caps.limits.maxViewportSize[1]                  = 16384u;
+        caps.limits.maxBufferSize                       = std::numeric_limits<std::size_t>::max();
+        caps.limits.maxConstantBufferSize               = 65536u;
+    }
+    SetRenderingCaps(caps);
+}
+
+void NullRenderSystem::WriteTextureRegion(NullTexture& textureNull, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
+{
+    const auto& extent = textureRegion.extent;
+
+    /* Check if image data must be converted (will be null if no conversion is necessary) */
+    ByteBuffer tempImageBuffer;
+
+    if (textureNull.HasImageFormat())
+        tempImageBuffer = ConvertImageBuffer(imageDesc, textureNull.GetImageFormat(), textureNull.GetDataType(), GetConfiguration().threadCount);
+
+    if (tempImageBuffer)
+    {
+        /* Validate that source image data was large enough so conversion is valid */
+        const auto numTexels = static_cast<std::size_t>(extent.width) * extent.height * extent.depth;
+        AssertImageDataSize(imageDesc.dataSize, numTexels * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType));
+        textureNull.Write(textureRegion, tempImageBuffer.get());
+    }
+    else
+    {
+        /* Validate that image data is large enough */
+        AssertImageDataSize(imageDesc.dataSize, textureNull.GetRegionSize(extent));
+        textureNull.Write(textureRegion, imageDesc.data);
+    }
+}
+
+void NullRenderSystem::InitializeTexture(NullTexture& textureNull)
+{
+    const auto& clearValue = GetConfiguration().imageInitialization.clearValue;
+
+    /* Depth-stencil formats are initialized with the depth and stencil clear values */
+    const ColorRGBAd fillColor =
+    (
+        IsDepthStencilFormat(textureNull.GetFormat())
+            ? ColorRGBAd{ static_cast<double>(clearValue.depth), static_cast<double>(clearValue.stencil), 0.0, 0.0 }
+            : clearValue.color.Cast<double>()
+    );
+
+    for (std::uint32_t mipLevel = 0; mipLevel < textureNull.GetNumMipLevels(); ++mipLevel)
+    {
+        TextureRegion textureRegion;
+        {
+            textureRegion.mipLevel  = mipLevel;
+            textureRegion.offset    = { 0, 0, 0 };
+            textureRegion.extent    = textureNull.QueryMipExtent(mipLevel);
+        }
+        textureNull.FillColor(textureRegion, fillColor);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
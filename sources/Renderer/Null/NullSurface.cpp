@@ -0,0 +1,100 @@
+/*
+ * NullSurface.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullSurface.h"
+
+
+namespace LLGL
+{
+
+
+NullSurface::NullSurface(const WindowDescriptor& desc) :
+    desc_ { desc }
+{
+}
+
+void NullSurface::GetNativeHandle(void* /*nativeHandle*/) const
+{
+    // dummy
+}
+
+Extent2D NullSurface::GetContentSize() const
+{
+    return desc_.size;
+}
+
+void NullSurface::ResetPixelFormat()
+{
+    // dummy
+}
+
+void NullSurface::SetPosition(const Offset2D& position)
+{
+    desc_.position = position;
+}
+
+Offset2D NullSurface::GetPosition() const
+{
+    return desc_.position;
+}
+
+void NullSurface::SetSize(const Extent2D& size, bool /*useClientArea*/)
+{
+    desc_.size = size;
+}
+
+Extent2D NullSurface::GetSize(bool /*useClientArea*/) const
+{
+    return desc_.size;
+}
+
+void NullSurface::SetTitle(const std::wstring& title)
+{
+    desc_.title = title;
+}
+
+std::wstring NullSurface::GetTitle() const
+{
+    return desc_.title;
+}
+
+void NullSurface::Show(bool show)
+{
+    desc_.visible = show;
+}
+
+bool NullSurface::IsShown() const
+{
+    return desc_.visible;
+}
+
+void NullSurface::SetDesc(const WindowDescriptor& desc)
+{
+    desc_ = desc;
+}
+
+WindowDescriptor NullSurface::GetDesc() const
+{
+    return desc_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullSurface::OnProcessEvents()
+{
+    // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
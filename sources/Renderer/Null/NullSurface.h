@@ -0,0 +1,66 @@
+/*
+ * NullSurface.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_SURFACE_H
+#define LLGL_NULL_SURFACE_H
+
+
+#include <LLGL/Window.h>
+
+
+namespace LLGL
+{
+
+
+// Window that is never shown on any display. It only keeps track of its attributes.
+class NullSurface final : public Window
+{
+
+    public:
+
+        NullSurface(const WindowDescriptor& desc);
+
+        void GetNativeHandle(void* nativeHandle) const override;
+
+        Extent2D GetContentSize() const override;
+
+        void ResetPixelFormat() override;
+
+        void SetPosition(const Offset2D& position) override;
+        Offset2D GetPosition() const override;
+
+        void SetSize(const Extent2D& size, bool useClientArea = true) override;
+        Extent2D GetSize(bool useClientArea = true) const override;
+
+        void SetTitle(const std::wstring& title) override;
+        std::wstring GetTitle() const override;
+
+        void Show(bool show = true) override;
+        bool IsShown() const override;
+
+        void SetDesc(const WindowDescriptor& desc) override;
+        WindowDescriptor GetDesc() const override;
+
+    private:
+
+        void OnProcessEvents() override;
+
+    private:
+
+        WindowDescriptor desc_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
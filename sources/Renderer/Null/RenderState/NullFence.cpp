@@ -0,0 +1,25 @@
+/*
+ * NullFence.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullFence.h"
+
+
+namespace LLGL
+{
+
+
+void NullFence::Signal(bool signaled)
+{
+    signaled_ = signaled;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,48 @@
+/*
+ * NullFence.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_FENCE_H
+#define LLGL_NULL_FENCE_H
+
+
+#include <LLGL/Fence.h>
+
+
+namespace LLGL
+{
+
+
+// Fence that is signaled as soon as it has been submitted, since there is no device to wait for.
+class NullFence final : public Fence
+{
+
+    public:
+
+        // Sets the signaled state of this fence.
+        void Signal(bool signaled);
+
+        // Returns true if this fence has been signaled.
+        inline bool IsSignaled() const
+        {
+            return signaled_;
+        }
+
+    private:
+
+        bool signaled_ = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,25 @@
+/*
+ * NullGraphicsPipeline.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullGraphicsPipeline.h"
+
+
+namespace LLGL
+{
+
+
+NullGraphicsPipeline::NullGraphicsPipeline(const GraphicsPipelineDescriptor& desc) :
+    desc_ { desc }
+{
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,47 @@
+/*
+ * NullGraphicsPipeline.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_GRAPHICS_PIPELINE_H
+#define LLGL_NULL_GRAPHICS_PIPELINE_H
+
+
+#include <LLGL/GraphicsPipeline.h>
+#include <LLGL/GraphicsPipelineFlags.h>
+
+
+namespace LLGL
+{
+
+
+class NullGraphicsPipeline final : public GraphicsPipeline
+{
+
+    public:
+
+        NullGraphicsPipeline(const GraphicsPipelineDescriptor& desc);
+
+        // Returns the descriptor this graphics pipeline was created with.
+        inline const GraphicsPipelineDescriptor& GetDesc() const
+        {
+            return desc_;
+        }
+
+    private:
+
+        GraphicsPipelineDescriptor desc_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,29 @@
+/*
+ * NullPipelineLayout.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_PIPELINE_LAYOUT_H
+#define LLGL_NULL_PIPELINE_LAYOUT_H
+
+
+#include "../../BasicPipelineLayout.h"
+
+
+namespace LLGL
+{
+
+
+using NullPipelineLayout = BasicPipelineLayout;
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
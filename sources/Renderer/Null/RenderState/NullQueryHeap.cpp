@@ -0,0 +1,91 @@
+/*
+ * NullQueryHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullQueryHeap.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+static std::uint32_t GetQueryResultStride(const QueryType type)
+{
+    if (type == QueryType::PipelineStatistics)
+        return static_cast<std::uint32_t>(sizeof(QueryPipelineStatistics) / sizeof(std::uint64_t));
+    else
+        return 1u;
+}
+
+NullQueryHeap::NullQueryHeap(const QueryHeapDescriptor& desc) :
+    QueryHeap   { desc.type                       },
+    stride_     { GetQueryResultStride(desc.type) },
+    numQueries_ { desc.numQueries                 }
+{
+    results_.resize(stride_ * numQueries_, 0);
+    active_.resize(numQueries_, false);
+}
+
+void NullQueryHeap::Begin(std::uint32_t query)
+{
+    auto result = GetResult(query);
+    std::fill(result, result + stride_, 0);
+    active_[query] = true;
+}
+
+void NullQueryHeap::End(std::uint32_t query)
+{
+    if (query >= numQueries_)
+        throw std::out_of_range("query index out of range for Null query heap");
+    active_[query] = false;
+}
+
+std::uint64_t* NullQueryHeap::GetResult(std::uint32_t query)
+{
+    if (query >= numQueries_)
+        throw std::out_of_range("query index out of range for Null query heap");
+    return &(results_[query * stride_]);
+}
+
+bool NullQueryHeap::ReadResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize) const
+{
+    if (firstQuery + numQueries > numQueries_)
+        return false;
+
+    for (std::uint32_t i = firstQuery; i < firstQuery + numQueries; ++i)
+    {
+        if (active_[i])
+            return false;
+    }
+
+    const std::size_t stride = sizeof(std::uint64_t) * stride_;
+    if (dataSize == numQueries * stride)
+    {
+        /* Copy 64-bit query results */
+        ::memcpy(data, &(results_[firstQuery * stride_]), dataSize);
+        return true;
+    }
+    else if (stride_ == 1 && dataSize == numQueries * sizeof(std::uint32_t))
+    {
+        /* Copy 32-bit query results */
+        auto dst = reinterpret_cast<std::uint32_t*>(data);
+        for (std::uint32_t i = 0; i < numQueries; ++i)
+            dst[i] = static_cast<std::uint32_t>(results_[firstQuery + i]);
+        return true;
+    }
+
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
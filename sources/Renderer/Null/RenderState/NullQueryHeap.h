@@ -0,0 +1,71 @@
+/*
+ * NullQueryHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_QUERY_HEAP_H
+#define LLGL_NULL_QUERY_HEAP_H
+
+
+#include <LLGL/QueryHeap.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Query heap that stores its results in host memory. Each query occupies a range of 64-bit values.
+class NullQueryHeap final : public QueryHeap
+{
+
+    public:
+
+        NullQueryHeap(const QueryHeapDescriptor& desc);
+
+        // Resets the result of the specified query and marks it as active.
+        void Begin(std::uint32_t query);
+
+        // Marks the specified query as finished.
+        void End(std::uint32_t query);
+
+        // Returns a pointer to the results of the specified query.
+        std::uint64_t* GetResult(std::uint32_t query);
+
+        // Copies the results of the specified queries into the output data. Returns false if the data size does not match.
+        bool ReadResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize) const;
+
+        // Returns the number of 64-bit values for each query.
+        inline std::uint32_t GetResultStride() const
+        {
+            return stride_;
+        }
+
+        // Returns the number of queries in this heap.
+        inline std::uint32_t GetNumQueries() const
+        {
+            return numQueries_;
+        }
+
+    private:
+
+        std::vector<std::uint64_t>  results_;
+        std::vector<bool>           active_;
+        std::uint32_t               stride_     = 1;
+        std::uint32_t               numQueries_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,41 @@
+/*
+ * NullShader.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullShader.h"
+
+
+namespace LLGL
+{
+
+
+NullShader::NullShader(const ShaderDescriptor& desc) :
+    Shader              { desc.type                },
+    streamOutputFormat_ { desc.streamOutput.format }
+{
+}
+
+bool NullShader::HasErrors() const
+{
+    return false;
+}
+
+std::string NullShader::Disassemble(int /*flags*/)
+{
+    return "";
+}
+
+std::string NullShader::QueryInfoLog()
+{
+    return "";
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
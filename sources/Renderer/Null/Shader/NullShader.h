@@ -0,0 +1,56 @@
+/*
+ * NullShader.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_SHADER_H
+#define LLGL_NULL_SHADER_H
+
+
+#include <LLGL/Shader.h>
+#include <LLGL/ShaderFlags.h>
+
+
+namespace LLGL
+{
+
+
+// Shader that is never compiled. It only keeps the stream-output format for the shader reflection.
+class NullShader final : public Shader
+{
+
+    public:
+
+        NullShader(const ShaderDescriptor& desc);
+
+        bool HasErrors() const override;
+
+        std::string Disassemble(int flags = 0) override;
+
+        std::string QueryInfoLog() override;
+
+    public:
+
+        // Returns the stream-output format this shader was created with.
+        inline const StreamOutputFormat& GetStreamOutputFormat() const
+        {
+            return streamOutputFormat_;
+        }
+
+    private:
+
+        StreamOutputFormat streamOutputFormat_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
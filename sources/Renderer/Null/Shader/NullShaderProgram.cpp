@@ -0,0 +1,93 @@
+/*
+ * NullShaderProgram.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullShaderProgram.h"
+#include "NullShader.h"
+#include "../../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+NullShaderProgram::NullShaderProgram(const ShaderProgramDescriptor& desc)
+{
+    /* Reflect vertex attributes from the vertex formats */
+    for (const auto& vertexFormat : desc.vertexFormats)
+    {
+        reflection_.vertexAttributes.insert(
+            reflection_.vertexAttributes.end(),
+            vertexFormat.attributes.begin(),
+            vertexFormat.attributes.end()
+        );
+    }
+
+    /* Reflect stream-output attributes from the last shader stage before rasterization */
+    for (auto shader : { desc.geometryShader, desc.tessEvaluationShader, desc.vertexShader })
+    {
+        if (shader != nullptr)
+        {
+            auto shaderNull = LLGL_CAST(const NullShader*, shader);
+            reflection_.streamOutputAttributes = shaderNull->GetStreamOutputFormat().attributes;
+            break;
+        }
+    }
+}
+
+bool NullShaderProgram::HasErrors() const
+{
+    return false;
+}
+
+std::string NullShaderProgram::QueryInfoLog()
+{
+    return "";
+}
+
+ShaderReflectionDescriptor NullShaderProgram::QueryReflectionDesc() const
+{
+    return reflection_;
+}
+
+void NullShaderProgram::BindConstantBuffer(const std::string& /*name*/, std::uint32_t /*bindingIndex*/)
+{
+    // dummy
+}
+
+void NullShaderProgram::BindStorageBuffer(const std::string& /*name*/, std::uint32_t /*bindingIndex*/)
+{
+    // dummy
+}
+
+ShaderUniform* NullShaderProgram::LockShaderUniform()
+{
+    return nullptr;
+}
+
+void NullShaderProgram::UnlockShaderUniform()
+{
+    // dummy
+}
+
+bool NullShaderProgram::SetWorkGroupSize(const Extent3D& workGroupSize)
+{
+    workGroupSize_ = workGroupSize;
+    return true;
+}
+
+bool NullShaderProgram::GetWorkGroupSize(Extent3D& workGroupSize) const
+{
+    workGroupSize = workGroupSize_;
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
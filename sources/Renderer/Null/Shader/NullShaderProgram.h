@@ -0,0 +1,59 @@
+/*
+ * NullShaderProgram.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_SHADER_PROGRAM_H
+#define LLGL_NULL_SHADER_PROGRAM_H
+
+
+#include <LLGL/ShaderProgram.h>
+#include <LLGL/ShaderProgramFlags.h>
+
+
+namespace LLGL
+{
+
+
+class NullShader;
+
+class NullShaderProgram final : public ShaderProgram
+{
+
+    public:
+
+        NullShaderProgram(const ShaderProgramDescriptor& desc);
+
+        bool HasErrors() const override;
+
+        std::string QueryInfoLog() override;
+
+        ShaderReflectionDescriptor QueryReflectionDesc() const override;
+
+        void BindConstantBuffer(const std::string& name, std::uint32_t bindingIndex) override;
+        void BindStorageBuffer(const std::string& name, std::uint32_t bindingIndex) override;
+
+        ShaderUniform* LockShaderUniform() override;
+        void UnlockShaderUniform() override;
+
+        bool SetWorkGroupSize(const Extent3D& workGroupSize) override;
+        bool GetWorkGroupSize(Extent3D& workGroupSize) const override;
+
+    private:
+
+        ShaderReflectionDescriptor  reflection_;
+        Extent3D                    workGroupSize_  = { 1, 1, 1 };
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
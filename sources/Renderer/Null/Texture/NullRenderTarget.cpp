@@ -0,0 +1,159 @@
+/*
+ * NullRenderTarget.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullRenderTarget.h"
+#include "NullTexture.h"
+#include "../../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+static Format GetAttachmentFormat(const AttachmentDescriptor& attachmentDesc)
+{
+    if (auto texture = attachmentDesc.texture)
+        return LLGL_CAST(const NullTexture*, texture)->GetFormat();
+    switch (attachmentDesc.type)
+    {
+        case AttachmentType::Color:         return Format::RGBA8UNorm;
+        case AttachmentType::Depth:         return Format::D32Float;
+        case AttachmentType::DepthStencil:  return Format::D24UNormS8UInt;
+        case AttachmentType::Stencil:       return Format::D24UNormS8UInt;
+    }
+    return Format::Undefined;
+}
+
+static RenderPassDescriptor MakeDefaultRenderPassDesc(const RenderTargetDescriptor& desc)
+{
+    RenderPassDescriptor renderPassDesc;
+
+    for (const auto& attachment : desc.attachments)
+    {
+        const auto format = GetAttachmentFormat(attachment);
+        switch (attachment.type)
+        {
+            case AttachmentType::Color:
+                renderPassDesc.colorAttachments.push_back(AttachmentFormatDescriptor{ format });
+                break;
+            case AttachmentType::Depth:
+                renderPassDesc.depthAttachment = AttachmentFormatDescriptor{ format };
+                break;
+            case AttachmentType::DepthStencil:
+                renderPassDesc.depthAttachment   = AttachmentFormatDescriptor{ format };
+                renderPassDesc.stencilAttachment = AttachmentFormatDescriptor{ format };
+                break;
+            case AttachmentType::Stencil:
+                renderPassDesc.stencilAttachment = AttachmentFormatDescriptor{ format };
+                break;
+        }
+    }
+
+    return renderPassDesc;
+}
+
+// Returns the texture region of the MIP-map and array layer that is attached to a render target.
+static TextureRegion GetAttachmentRegion(const Texture& texture, const AttachmentDescriptor& attachmentDesc)
+{
+    TextureRegion region;
+
+    region.mipLevel = (IsMultiSampleTexture(texture.GetType()) ? 0u : attachmentDesc.mipLevel);
+    region.extent   = texture.QueryMipExtent(region.mipLevel);
+
+    const auto layer = attachmentDesc.arrayLayer;
+
+    switch (texture.GetType())
+    {
+        case TextureType::Texture1DArray:
+            region.offset.y         = static_cast<std::int32_t>(layer);
+            region.extent.height    = 1;
+            break;
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+        case TextureType::Texture3D:
+            region.offset.z         = static_cast<std::int32_t>(layer);
+            region.extent.depth     = 1;
+            break;
+        default:
+            break;
+    }
+
+    return region;
+}
+
+NullRenderTarget::NullRenderTarget(const RenderTargetDescriptor& desc) :
+    resolution_        { desc.resolution                  },
+    defaultRenderPass_ { MakeDefaultRenderPassDesc(desc) }
+{
+    renderPass_ = (desc.renderPass != nullptr ? desc.renderPass : &defaultRenderPass_);
+
+    for (const auto& attachment : desc.attachments)
+    {
+        switch (attachment.type)
+        {
+            case AttachmentType::Color:
+                ++numColorAttachments_;
+                break;
+            case AttachmentType::Depth:
+                hasDepthAttachment_ = true;
+                break;
+            case AttachmentType::DepthStencil:
+                hasDepthAttachment_     = true;
+                hasStencilAttachment_   = true;
+                break;
+            case AttachmentType::Stencil:
+                hasStencilAttachment_ = true;
+                break;
+        }
+
+        if (auto texture = attachment.texture)
+        {
+            attachments_.push_back(
+                NullAttachment
+                {
+                    attachment.type,
+                    LLGL_CAST(NullTexture*, texture),
+                    GetAttachmentRegion(*texture, attachment)
+                }
+            );
+        }
+    }
+}
+
+Extent2D NullRenderTarget::GetResolution() const
+{
+    return resolution_;
+}
+
+std::uint32_t NullRenderTarget::GetNumColorAttachments() const
+{
+    return numColorAttachments_;
+}
+
+bool NullRenderTarget::HasDepthAttachment() const
+{
+    return hasDepthAttachment_;
+}
+
+bool NullRenderTarget::HasStencilAttachment() const
+{
+    return hasStencilAttachment_;
+}
+
+const RenderPass* NullRenderTarget::GetRenderPass() const
+{
+    return renderPass_;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
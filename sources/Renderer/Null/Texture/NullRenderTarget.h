@@ -0,0 +1,77 @@
+/*
+ * NullRenderTarget.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_RENDER_TARGET_H
+#define LLGL_NULL_RENDER_TARGET_H
+
+
+#include <LLGL/RenderTarget.h>
+#include <LLGL/RenderTargetFlags.h>
+#include <LLGL/TextureFlags.h>
+#include "../RenderState/NullRenderPass.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class NullTexture;
+
+// Render target attachment that refers to a texture region (i.e. a MIP-map and array layer) of a Null texture.
+struct NullAttachment
+{
+    AttachmentType  type;
+    NullTexture*    texture;
+    TextureRegion   region;
+};
+
+class NullRenderTarget final : public RenderTarget
+{
+
+    public:
+
+        NullRenderTarget(const RenderTargetDescriptor& desc);
+
+        Extent2D GetResolution() const override;
+
+        std::uint32_t GetNumColorAttachments() const override;
+
+        bool HasDepthAttachment() const override;
+        bool HasStencilAttachment() const override;
+
+        const RenderPass* GetRenderPass() const override;
+
+    public:
+
+        // Returns the list of attachments that refer to a texture.
+        inline const std::vector<NullAttachment>& GetAttachments() const
+        {
+            return attachments_;
+        }
+
+    private:
+
+        Extent2D                    resolution_;
+        std::vector<NullAttachment> attachments_;
+        std::uint32_t               numColorAttachments_    = 0;
+        bool                        hasDepthAttachment_     = false;
+        bool                        hasStencilAttachment_   = false;
+        NullRenderPass              defaultRenderPass_;
+        const RenderPass*           renderPass_             = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,414 @@
+/*
+ * NullTexture.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullTexture.h"
+#include <LLGL/Format.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+static std::uint32_t GetNumArrayLayers(const TextureDescriptor& desc)
+{
+    switch (desc.type)
+    {
+        case TextureType::Texture1DArray:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+            return std::max(1u, desc.arrayLayers);
+        default:
+            return 1u;
+    }
+}
+
+NullTexture::NullTexture(const TextureDescriptor& desc) :
+    Texture       { desc.type         },
+    desc_         { desc              },
+    numMipLevels_ { NumMipLevels(desc) }
+{
+    desc_.mipLevels = numMipLevels_;
+
+    /* Determine storage format */
+    if (!IsCompressedFormat(desc.format))
+    {
+        if (FindSuitableImageFormat(desc.format, imageFormat_, dataType_))
+        {
+            hasImageFormat_ = true;
+            texelSize_      = ImageFormatSize(imageFormat_) * DataTypeSize(dataType_);
+        }
+        else
+            texelSize_ = std::max(1u, FormatBitSize(desc.format) / 8);
+    }
+
+    /* Allocate contiguous storage for all MIP-maps */
+    std::size_t totalSize = 0;
+
+    mipOffsets_.reserve(numMipLevels_);
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels_; ++mipLevel)
+    {
+        mipOffsets_.push_back(totalSize);
+        totalSize += GetMipLevelSize(mipLevel);
+    }
+
+    data_.resize(totalSize, 0);
+}
+
+TextureDescriptor NullTexture::QueryDesc() const
+{
+    return desc_;
+}
+
+Extent3D NullTexture::QueryMipExtent(std::uint32_t mipLevel) const
+{
+    const auto& extent      = desc_.extent;
+    const auto  arrayLayers = GetNumArrayLayers(desc_);
+
+    switch (GetType())
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            return
+            {
+                std::max(1u, extent.width  >> mipLevel),
+                arrayLayers,
+                1u
+            };
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMS:
+        case TextureType::Texture2DMSArray:
+            return
+            {
+                std::max(1u, extent.width  >> mipLevel),
+                std::max(1u, extent.height >> mipLevel),
+                arrayLayers
+            };
+        case TextureType::Texture3D:
+            return
+            {
+                std::max(1u, extent.width  >> mipLevel),
+                std::max(1u, extent.height >> mipLevel),
+                std::max(1u, extent.depth  >> mipLevel)
+            };
+    }
+    return { 0u, 0u, 0u };
+}
+
+static bool IsRegionInsideExtent(const Offset3D& offset, const Extent3D& extent, const Extent3D& bounds)
+{
+    return
+    (
+        offset.x >= 0 && static_cast<std::uint32_t>(offset.x) + extent.width  <= bounds.width  &&
+        offset.y >= 0 && static_cast<std::uint32_t>(offset.y) + extent.height <= bounds.height &&
+        offset.z >= 0 && static_cast<std::uint32_t>(offset.z) + extent.depth  <= bounds.depth
+    );
+}
+
+void NullTexture::Write(const TextureRegion& textureRegion, const void* data)
+{
+    AssertRegion(textureRegion);
+
+    const auto& offset      = textureRegion.offset;
+    const auto& extent      = textureRegion.extent;
+    const auto  mipExtent   = QueryMipExtent(textureRegion.mipLevel);
+
+    auto dst = &(data_[mipOffsets_[textureRegion.mipLevel]]);
+    auto src = reinterpret_cast<const std::uint8_t*>(data);
+
+    if (texelSize_ == 0)
+    {
+        /* Compressed texel blocks can only be written for the entire MIP-map */
+        if (offset.x != 0 || offset.y != 0 || offset.z != 0 || extent != mipExtent)
+            throw std::invalid_argument("cannot write sub-region of compressed Null texture");
+        ::memcpy(dst, src, GetMipLevelSize(textureRegion.mipLevel));
+    }
+    else
+    {
+        /* Copy texel rows into sub-region */
+        const std::size_t srcRowSize = extent.width * texelSize_;
+
+        for (std::uint32_t z = 0; z < extent.depth; ++z)
+        {
+            for (std::uint32_t y = 0; y < extent.height; ++y)
+            {
+                const std::size_t dstTexel =
+                (
+                    (static_cast<std::size_t>(offset.z + z) * mipExtent.height + static_cast<std::size_t>(offset.y + y)) * mipExtent.width +
+                    static_cast<std::size_t>(offset.x)
+                );
+                ::memcpy(dst + dstTexel * texelSize_, src, srcRowSize);
+                src += srcRowSize;
+            }
+        }
+    }
+}
+
+void NullTexture::Read(std::uint32_t mipLevel, void* data) const
+{
+    AssertMipLevel(mipLevel);
+    ::memcpy(data, &(data_[mipOffsets_[mipLevel]]), GetMipLevelSize(mipLevel));
+}
+
+void NullTexture::Fill(const TextureRegion& textureRegion, const void* texelData)
+{
+    AssertRegion(textureRegion);
+
+    /* Compressed textures cannot be filled with a single texel */
+    if (texelSize_ == 0)
+        return;
+
+    const auto& offset      = textureRegion.offset;
+    const auto& extent      = textureRegion.extent;
+    const auto  mipExtent   = QueryMipExtent(textureRegion.mipLevel);
+
+    auto dst = &(data_[mipOffsets_[textureRegion.mipLevel]]);
+
+    for (std::uint32_t z = 0; z < extent.depth; ++z)
+    {
+        for (std::uint32_t y = 0; y < extent.height; ++y)
+        {
+            const std::size_t dstTexel =
+            (
+                (static_cast<std::size_t>(offset.z + z) * mipExtent.height + static_cast<std::size_t>(offset.y + y)) * mipExtent.width +
+                static_cast<std::size_t>(offset.x)
+            );
+            for (std::uint32_t x = 0; x < extent.width; ++x)
+                ::memcpy(dst + (dstTexel + x) * texelSize_, texelData, texelSize_);
+        }
+    }
+}
+
+void NullTexture::FillColor(const TextureRegion& textureRegion, const ColorRGBAd& color)
+{
+    /* Only textures with an image format can be filled with a color */
+    if (!hasImageFormat_)
+        return;
+
+    /* Depth-stencil image formats are filled with the same number of components as their color counterparts */
+    auto imageFormat = imageFormat_;
+
+    if (imageFormat == ImageFormat::Depth)
+        imageFormat = ImageFormat::R;
+    else if (imageFormat == ImageFormat::DepthStencil)
+        imageFormat = ImageFormat::RG;
+
+    auto texel = GenerateImageBuffer(imageFormat, dataType_, 1, color);
+    Fill(textureRegion, texel.get());
+}
+
+void NullTexture::GenerateMips(std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
+{
+    /* Compressed textures cannot be filtered on the host */
+    if (texelSize_ == 0)
+        return;
+
+    const auto lastMipLevel = std::min(baseMipLevel + numMipLevels, numMipLevels_);
+
+    for (auto mipLevel = baseMipLevel; mipLevel + 1 < lastMipLevel; ++mipLevel)
+    {
+        if (hasImageFormat_ && !IsDepthStencilFormat(imageFormat_))
+            GenerateNextMipBoxFilter(mipLevel, baseArrayLayer, numArrayLayers);
+        else
+            GenerateNextMipNearest(mipLevel, baseArrayLayer, numArrayLayers);
+    }
+}
+
+std::size_t NullTexture::GetMipLevelSize(std::uint32_t mipLevel) const
+{
+    return GetRegionSize(QueryMipExtent(mipLevel));
+}
+
+std::size_t NullTexture::GetRegionSize(const Extent3D& extent) const
+{
+    if (texelSize_ > 0)
+        return (static_cast<std::size_t>(extent.width) * extent.height * extent.depth * texelSize_);
+
+    /* Compressed formats are stored in 4x4 texel blocks */
+    const std::size_t numBlocks = ((extent.width + 3) / 4) * ((extent.height + 3) / 4) * extent.depth;
+    return (numBlocks * FormatBitSize(desc_.format) * 16 / 8);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullTexture::AssertMipLevel(std::uint32_t mipLevel) const
+{
+    if (mipLevel >= numMipLevels_)
+        throw std::out_of_range("MIP-map level out of range for Null texture");
+}
+
+void NullTexture::AssertRegion(const TextureRegion& textureRegion) const
+{
+    AssertMipLevel(textureRegion.mipLevel);
+    if (!IsRegionInsideExtent(textureRegion.offset, textureRegion.extent, QueryMipExtent(textureRegion.mipLevel)))
+        throw std::out_of_range("texture region exceeds MIP-map extent of Null texture");
+}
+
+void NullTexture::GetLayerRegion(std::uint32_t mipLevel, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers, Offset3D& offset, Extent3D& extent) const
+{
+    offset = { 0, 0, 0 };
+    extent = QueryMipExtent(mipLevel);
+
+    auto ClampLayers = [baseArrayLayer, numArrayLayers](std::int32_t& layerOffset, std::uint32_t& layerExtent)
+    {
+        const auto first = std::min(baseArrayLayer, layerExtent);
+        layerOffset = static_cast<std::int32_t>(first);
+        layerExtent = std::min(numArrayLayers, layerExtent - first);
+    };
+
+    switch (GetType())
+    {
+        case TextureType::Texture1DArray:
+            ClampLayers(offset.y, extent.height);
+            break;
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+            ClampLayers(offset.z, extent.depth);
+            break;
+        default:
+            break;
+    }
+}
+
+// Returns the first source coordinate that maps to the specified destination coordinate.
+static std::uint32_t MapToSrcCoord(std::uint32_t dst, std::uint32_t dstSize, std::uint32_t srcSize)
+{
+    return static_cast<std::uint32_t>(static_cast<std::uint64_t>(dst) * srcSize / dstSize);
+}
+
+void NullTexture::GenerateNextMipNearest(std::uint32_t srcMipLevel, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
+{
+    const auto  srcExtent   = QueryMipExtent(srcMipLevel);
+    const auto  dstExtent   = QueryMipExtent(srcMipLevel + 1);
+    const auto  src         = &(data_[mipOffsets_[srcMipLevel]]);
+    auto        dst         = &(data_[mipOffsets_[srcMipLevel + 1]]);
+
+    Offset3D offset;
+    Extent3D extent;
+    GetLayerRegion(srcMipLevel + 1, baseArrayLayer, numArrayLayers, offset, extent);
+
+    for (auto z = static_cast<std::uint32_t>(offset.z); z < offset.z + extent.depth; ++z)
+    {
+        const auto srcZ = MapToSrcCoord(z, dstExtent.depth, srcExtent.depth);
+        for (auto y = static_cast<std::uint32_t>(offset.y); y < offset.y + extent.height; ++y)
+        {
+            const auto srcY = MapToSrcCoord(y, dstExtent.height, srcExtent.height);
+            for (std::uint32_t x = 0; x < extent.width; ++x)
+            {
+                const auto          srcX        = MapToSrcCoord(x, dstExtent.width, srcExtent.width);
+                const std::size_t   srcTexel    = (static_cast<std::size_t>(srcZ) * srcExtent.height + srcY) * srcExtent.width + srcX;
+                const std::size_t   dstTexel    = (static_cast<std::size_t>(z) * dstExtent.height + y) * dstExtent.width + x;
+                ::memcpy(dst + dstTexel * texelSize_, src + srcTexel * texelSize_, texelSize_);
+            }
+        }
+    }
+}
+
+void NullTexture::GenerateNextMipBoxFilter(std::uint32_t srcMipLevel, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
+{
+    const auto srcExtent    = QueryMipExtent(srcMipLevel);
+    const auto dstExtent    = QueryMipExtent(srcMipLevel + 1);
+    const auto components   = ImageFormatSize(imageFormat_);
+
+    /* Convert source MIP-map into double precision (will be null if no conversion is necessary) */
+    const SrcImageDescriptor srcImageDesc
+    {
+        imageFormat_,
+        dataType_,
+        &(data_[mipOffsets_[srcMipLevel]]),
+        GetMipLevelSize(srcMipLevel)
+    };
+
+    auto srcImageBuffer = ConvertImageBuffer(srcImageDesc, imageFormat_, DataType::Float64);
+    auto src = (srcImageBuffer ? reinterpret_cast<const double*>(srcImageBuffer.get()) : reinterpret_cast<const double*>(srcImageDesc.data));
+
+    /* Average all source texels that map to each destination texel */
+    TextureRegion dstRegion;
+    dstRegion.mipLevel = srcMipLevel + 1;
+    GetLayerRegion(dstRegion.mipLevel, baseArrayLayer, numArrayLayers, dstRegion.offset, dstRegion.extent);
+
+    std::vector<double> dstImage(
+        static_cast<std::size_t>(dstRegion.extent.width) * dstRegion.extent.height * dstRegion.extent.depth * components
+    );
+
+    auto dst = dstImage.data();
+
+    for (std::uint32_t z = 0; z < dstRegion.extent.depth; ++z)
+    {
+        const auto dstZ     = dstRegion.offset.z + z;
+        const auto srcZ0    = MapToSrcCoord(dstZ, dstExtent.depth, srcExtent.depth);
+        const auto srcZ1    = std::max(srcZ0 + 1, MapToSrcCoord(dstZ + 1, dstExtent.depth, srcExtent.depth));
+
+        for (std::uint32_t y = 0; y < dstRegion.extent.height; ++y)
+        {
+            const auto dstY     = dstRegion.offset.y + y;
+            const auto srcY0    = MapToSrcCoord(dstY, dstExtent.height, srcExtent.height);
+            const auto srcY1    = std::max(srcY0 + 1, MapToSrcCoord(dstY + 1, dstExtent.height, srcExtent.height));
+
+            for (std::uint32_t x = 0; x < dstRegion.extent.width; ++x)
+            {
+                const auto srcX0 = MapToSrcCoord(x, dstExtent.width, srcExtent.width);
+                const auto srcX1 = std::max(srcX0 + 1, MapToSrcCoord(x + 1, dstExtent.width, srcExtent.width));
+
+                for (std::uint32_t c = 0; c < components; ++c)
+                    dst[c] = 0.0;
+
+                for (auto sz = srcZ0; sz < srcZ1; ++sz)
+                {
+                    for (auto sy = srcY0; sy < srcY1; ++sy)
+                    {
+                        for (auto sx = srcX0; sx < srcX1; ++sx)
+                        {
+                            auto texel = src + ((static_cast<std::size_t>(sz) * srcExtent.height + sy) * srcExtent.width + sx) * components;
+                            for (std::uint32_t c = 0; c < components; ++c)
+                                dst[c] += texel[c];
+                        }
+                    }
+                }
+
+                const double scale = 1.0 / static_cast<double>((srcX1 - srcX0) * (srcY1 - srcY0) * (srcZ1 - srcZ0));
+                for (std::uint32_t c = 0; c < components; ++c)
+                    dst[c] *= scale;
+
+                dst += components;
+            }
+        }
+    }
+
+    /* Convert filtered texels back into storage format and write them into the next MIP-map */
+    const SrcImageDescriptor dstImageDesc
+    {
+        imageFormat_,
+        DataType::Float64,
+        dstImage.data(),
+        dstImage.size() * sizeof(double)
+    };
+
+    if (auto dstImageBuffer = ConvertImageBuffer(dstImageDesc, imageFormat_, dataType_))
+        Write(dstRegion, dstImageBuffer.get());
+    else
+        Write(dstRegion, dstImage.data());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
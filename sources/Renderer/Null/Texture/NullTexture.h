@@ -0,0 +1,126 @@
+/*
+ * NullTexture.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_TEXTURE_H
+#define LLGL_NULL_TEXTURE_H
+
+
+#include <LLGL/Texture.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/ColorRGBA.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Texture that only lives in host memory.
+All MIP-maps are stored in a single contiguous buffer. If the texture format has a suitable image format,
+the texels are stored in that image format (see FindSuitableImageFormat), otherwise they are stored as raw texel blocks.
+*/
+class NullTexture final : public Texture
+{
+
+    public:
+
+        NullTexture(const TextureDescriptor& desc);
+
+        TextureDescriptor QueryDesc() const override;
+        Extent3D QueryMipExtent(std::uint32_t mipLevel) const override;
+
+    public:
+
+        // Writes the source data into the specified texture region. The data must be given in the storage format of this texture.
+        void Write(const TextureRegion& textureRegion, const void* data);
+
+        // Reads the entire MIP-map into the output data. The data will be given in the storage format of this texture.
+        void Read(std::uint32_t mipLevel, void* data) const;
+
+        // Fills the specified texture region with the data of a single texel (given in the storage format of this texture).
+        void Fill(const TextureRegion& textureRegion, const void* texelData);
+
+        // Fills the specified texture region with a color. For depth-stencil formats, the depth and stencil values are taken from the R and G components.
+        void FillColor(const TextureRegion& textureRegion, const ColorRGBAd& color);
+
+        // Generates the MIP-maps (baseMipLevel + 1) to (baseMipLevel + numMipLevels - 1) from the base MIP-map.
+        void GenerateMips(std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers);
+
+        // Returns the size (in bytes) of the specified MIP-map.
+        std::size_t GetMipLevelSize(std::uint32_t mipLevel) const;
+
+        // Returns the size (in bytes) the specified region requires in the storage format of this texture.
+        std::size_t GetRegionSize(const Extent3D& extent) const;
+
+        // Returns true if this texture is stored in the image format returned by 'GetImageFormat' and 'GetDataType'.
+        inline bool HasImageFormat() const
+        {
+            return hasImageFormat_;
+        }
+
+        // Returns the image format this texture is stored in.
+        inline ImageFormat GetImageFormat() const
+        {
+            return imageFormat_;
+        }
+
+        // Returns the data type this texture is stored in.
+        inline DataType GetDataType() const
+        {
+            return dataType_;
+        }
+
+        // Returns the hardware texture format.
+        inline Format GetFormat() const
+        {
+            return desc_.format;
+        }
+
+        // Returns the number of MIP-map levels.
+        inline std::uint32_t GetNumMipLevels() const
+        {
+            return numMipLevels_;
+        }
+
+    private:
+
+        void AssertMipLevel(std::uint32_t mipLevel) const;
+        void AssertRegion(const TextureRegion& textureRegion) const;
+
+        // Returns the sub-region of the specified MIP-map that covers the specified array layers.
+        void GetLayerRegion(std::uint32_t mipLevel, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers, Offset3D& offset, Extent3D& extent) const;
+
+        void GenerateNextMipNearest(std::uint32_t srcMipLevel, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers);
+        void GenerateNextMipBoxFilter(std::uint32_t srcMipLevel, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers);
+
+    private:
+
+        TextureDescriptor           desc_;
+        std::uint32_t               numMipLevels_   = 1;
+
+        bool                        hasImageFormat_ = false;
+        ImageFormat                 imageFormat_    = ImageFormat::RGBA;
+        DataType                    dataType_       = DataType::UInt8;
+        std::uint32_t               texelSize_      = 0; // Texel size (in bytes), or 0 for compressed formats
+
+        std::vector<std::size_t>    mipOffsets_;
+        std::vector<std::uint8_t>   data_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
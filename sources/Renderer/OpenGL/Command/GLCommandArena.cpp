@@ -0,0 +1,198 @@
+/*
+ * GLCommandArena.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandArena.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal page pool
+ */
+
+// Maximum number of free pages that are kept in the pool of each thread.
+static const std::size_t g_maxNumPooledPages = 256;
+
+// Lifetime state of the page pool of each thread. This is trivially destructible, so it remains valid while thread-local objects are destroyed.
+enum class GLCommandPagePoolState
+{
+    Uninitialized,
+    Alive,
+    Destroyed,
+};
+
+static thread_local GLCommandPagePoolState g_pagePoolState = GLCommandPagePoolState::Uninitialized;
+
+// Pool of free pages with the default page size. Each thread has its own pool, so no synchronization is required.
+class GLCommandPagePool
+{
+
+    public:
+
+        GLCommandPagePool()
+        {
+            g_pagePoolState = GLCommandPagePoolState::Alive;
+        }
+
+        ~GLCommandPagePool()
+        {
+            for (auto page : pages_)
+                delete [] page;
+            g_pagePoolState = GLCommandPagePoolState::Destroyed;
+        }
+
+        std::uint8_t* Acquire()
+        {
+            if (pages_.empty())
+                return new std::uint8_t[GLCommandArena::pageSize];
+
+            auto page = pages_.back();
+            pages_.pop_back();
+            return page;
+        }
+
+        void Release(std::uint8_t* page)
+        {
+            if (pages_.size() < g_maxNumPooledPages)
+                pages_.push_back(page);
+            else
+                delete [] page;
+        }
+
+    private:
+
+        std::vector<std::uint8_t*> pages_;
+
+};
+
+// Returns the page pool of the calling thread, which is created on first use.
+static GLCommandPagePool& GetPagePool()
+{
+    static thread_local GLCommandPagePool pagePool;
+    return pagePool;
+}
+
+static std::uint8_t* AcquirePoolPage()
+{
+    /* Don't recreate the pool once it has been destroyed during thread exit */
+    if (g_pagePoolState == GLCommandPagePoolState::Destroyed)
+        return new std::uint8_t[GLCommandArena::pageSize];
+    return GetPagePool().Acquire();
+}
+
+static void ReleasePoolPage(std::uint8_t* page)
+{
+    /*
+    Free the page directly if the pool of this thread is not alive,
+    e.g. when an arena is destroyed after the thread-local objects of the calling thread (such as during static destruction)
+    */
+    if (g_pagePoolState == GLCommandPagePoolState::Alive)
+        GetPagePool().Release(page);
+    else
+        delete [] page;
+}
+
+
+/*
+ * GLCommandArena class
+ */
+
+const std::size_t GLCommandArena::pageSize;
+
+GLCommandArena::~GLCommandArena()
+{
+    Clear();
+}
+
+std::uint8_t* GLCommandArena::Alloc(std::size_t size)
+{
+    /* Find next page with enough free memory */
+    while (currentPage_ < pages_.size())
+    {
+        auto& page = pages_[currentPage_];
+        if (page.capacity - page.size >= size)
+        {
+            auto ptr = page.data + page.size;
+            page.size += size;
+            return ptr;
+        }
+        ++currentPage_;
+    }
+
+    /* Acquire new page (large allocations get their own page) */
+    AcquirePage(std::max(size, pageSize));
+
+    auto& page = pages_.back();
+    page.size = size;
+
+    return page.data;
+}
+
+void GLCommandArena::Reserve(std::size_t size)
+{
+    /* Determine free memory of remaining pages */
+    std::size_t freeSize = 0;
+    for (auto i = currentPage_; i < pages_.size(); ++i)
+        freeSize += (pages_[i].capacity - pages_[i].size);
+
+    /* Acquire pages until the requested size is available */
+    while (freeSize < size)
+    {
+        AcquirePage(pageSize);
+        freeSize += pageSize;
+    }
+}
+
+void GLCommandArena::Clear()
+{
+    /* Return pages with default size to the pool and release all others */
+    for (const auto& page : pages_)
+    {
+        if (page.capacity == pageSize)
+            ReleasePoolPage(page.data);
+        else
+            delete [] page.data;
+    }
+    pages_.clear();
+    currentPage_ = 0;
+}
+
+bool GLCommandArena::IsEmpty() const
+{
+    for (const auto& page : pages_)
+    {
+        if (page.size > 0)
+            return false;
+    }
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLCommandArena::AcquirePage(std::size_t capacity)
+{
+    GLCommandPage page;
+    {
+        page.data       = (capacity == pageSize ? AcquirePoolPage() : new std::uint8_t[capacity]);
+        page.size       = 0;
+        page.capacity   = capacity;
+    }
+    pages_.push_back(page);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
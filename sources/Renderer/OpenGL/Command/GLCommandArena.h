@@ -0,0 +1,92 @@
+/*
+ * GLCommandArena.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_ARENA_H
+#define LLGL_GL_COMMAND_ARENA_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Single page of recorded GL commands. Commands never cross page boundaries.
+struct GLCommandPage
+{
+    std::uint8_t*   data;
+    std::size_t     size;       // Number of bytes in use
+    std::size_t     capacity;   // Total number of bytes of this page
+};
+
+/*
+Chunked storage for recorded GL commands.
+Memory is allocated in fixed-size pages from a pool of the calling thread, so commands are never moved once they have been written.
+All pages are returned to the pool of the calling thread when the arena is cleared, which does not need to be the thread that allocated them.
+If the pool of the calling thread has already been destroyed (e.g. during thread exit or static destruction), the pages are freed instead.
+*/
+class GLCommandArena : public NonCopyable
+{
+
+    public:
+
+        // Default size (in bytes) of each page. Larger allocations get their own page, which is not recycled.
+        static const std::size_t pageSize = 65536;
+
+    public:
+
+        GLCommandArena() = default;
+        ~GLCommandArena();
+
+        // Allocates a contiguous block of memory with the specified size (in bytes) at the end of this arena.
+        std::uint8_t* Alloc(std::size_t size);
+
+        // Acquires enough pages to allocate the specified amount of bytes without acquiring further pages.
+        void Reserve(std::size_t size);
+
+        // Returns all pages to the pool of the calling thread, or frees them if that pool is no longer alive.
+        void Clear();
+
+        // Returns true if no commands have been allocated.
+        bool IsEmpty() const;
+
+        // Returns the list of pages.
+        inline const std::vector<GLCommandPage>& GetPages() const
+        {
+            return pages_;
+        }
+
+        // Returns the list of pages, e.g. to compact the commands within each page.
+        inline std::vector<GLCommandPage>& GetPages()
+        {
+            return pages_;
+        }
+
+    private:
+
+        void AcquirePage(std::size_t capacity);
+
+    private:
+
+        std::vector<GLCommandPage>  pages_;
+        std::size_t                 currentPage_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
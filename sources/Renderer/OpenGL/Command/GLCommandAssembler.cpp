@@ -45,11 +45,36 @@ namespace LLGL
 {
 
 
-static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITCompiler& compiler)
+using GLStateOffsets = GLStateManager::JITStateOffsets;
+
+// Index of variadic argument of entry point for the GL state manager
+static const JITVarArg g_stateMngrArg{ 0 };
+
+// Encodes an inline comparison with the bound shader program, and only binds the specified program if it has changed
+static void AssembleBindShaderProgram(JITCompiler& compiler, const GLStateOffsets& offsets, GLuint program)
+{
+    compiler.BeginIfNotEqual(g_stateMngrArg, offsets.boundProgram, program);
+    {
+        compiler.StoreDWord(g_stateMngrArg, offsets.boundProgram, program);
+        compiler.Call(glUseProgram, program);
+    }
+    compiler.EndIf();
+}
+
+// Encodes an inline comparison with the bound buffer of the specified target, and only binds the specified buffer if it has changed
+static void AssembleBindBuffer(JITCompiler& compiler, const GLStateOffsets& offsets, GLBufferTarget target, GLuint buffer)
+{
+    const auto offset = offsets.boundBuffers + static_cast<std::int32_t>(sizeof(GLuint) * static_cast<std::size_t>(target));
+    compiler.BeginIfNotEqual(g_stateMngrArg, offset, buffer);
+    {
+        compiler.StoreDWord(g_stateMngrArg, offset, buffer);
+        compiler.Call(glBindBuffer, GLStateManager::ToGLBufferTarget(target), buffer);
+    }
+    compiler.EndIf();
+}
+
+static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITCompiler& compiler, const GLStateOffsets& offsets)
 {
-    /* Declare index of variadic argument of entry point */
-    static const JITVarArg g_stateMngrArg{ 0 };
-    
     /* Generate native CPU opcodes for emulated GLOpcode */
     switch (opcode)
     {
@@ -81,10 +106,10 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         {
             auto cmd = reinterpret_cast<const GLCmdViewport*>(pc);
             {
-                compiler.Call(::memcpy, JITStackPtr{ 0 }, &(cmd->viewport), sizeof(GLViewport));
+                /* Viewport is copied onto the stack, since it might be adjusted by the state manager */
+                compiler.StoreStack(JITStackPtr{ 0 }, &(cmd->viewport), sizeof(GLViewport));
                 compiler.CallMember(&GLStateManager::SetViewport, g_stateMngrArg, JITStackPtr{ 0 });
-                compiler.Call(::memcpy, JITStackPtr{ 0 }, &(cmd->depthRange), sizeof(GLDepthRange));
-                compiler.CallMember(&GLStateManager::SetDepthRange, g_stateMngrArg, JITStackPtr{ 0 });
+                compiler.Call(glDepthRange, cmd->depthRange.minDepth, cmd->depthRange.maxDepth);
             }
             return sizeof(*cmd);
         }
@@ -93,10 +118,9 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
             auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
             {
-                compiler.Call(::memcpy, JITStackPtr{ 0 }, cmdData, sizeof(GLViewport)*cmd->count);
+                compiler.StoreStack(JITStackPtr{ 0 }, cmdData, sizeof(GLViewport)*cmd->count);
                 compiler.CallMember(&GLStateManager::SetViewportArray, g_stateMngrArg, cmd->first, cmd->count, JITStackPtr{ 0 });
-                compiler.Call(::memcpy, JITStackPtr{ 0 }, cmdData + sizeof(GLViewport)*cmd->count, sizeof(GLDepthRange));
-                compiler.CallMember(&GLStateManager::SetDepthRangeArray, g_stateMngrArg, cmd->first, cmd->count, JITStackPtr{ 0 });
+                compiler.CallMember(&GLStateManager::SetDepthRangeArray, g_stateMngrArg, cmd->first, cmd->count, cmdData + sizeof(GLViewport)*cmd->count);
             }
             return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
         }
@@ -104,7 +128,7 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         {
             auto cmd = reinterpret_cast<const GLCmdScissor*>(pc);
             {
-                compiler.Call(::memcpy, JITStackPtr{ 0 }, &(cmd->scissor), sizeof(GLScissor));
+                compiler.StoreStack(JITStackPtr{ 0 }, &(cmd->scissor), sizeof(GLScissor));
                 compiler.CallMember(&GLStateManager::SetScissor, g_stateMngrArg, JITStackPtr{ 0 });
             }
             return sizeof(*cmd);
@@ -114,7 +138,7 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
             auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
             {
-                compiler.Call(::memcpy, JITStackPtr{ 0 }, cmdData, sizeof(GLScissor)*cmd->count);
+                compiler.StoreStack(JITStackPtr{ 0 }, cmdData, sizeof(GLScissor)*cmd->count);
                 compiler.CallMember(&GLStateManager::SetScissorArray, g_stateMngrArg, cmd->first, cmd->count, JITStackPtr{ 0 });
             }
             return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
@@ -147,12 +171,16 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         {
             auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
             compiler.CallMember(&GLStateManager::ClearBuffers, g_stateMngrArg, cmd->numAttachments, (cmd + 1));
-            return sizeof(*cmd);
+            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
         }
         case GLOpcodeBindVertexArray:
         {
             auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
-            compiler.CallMember(&GLStateManager::BindVertexArray, g_stateMngrArg, cmd->vao);
+            compiler.BeginIfNotEqual(g_stateMngrArg, offsets.boundVertexArray, cmd->vao);
+            {
+                compiler.CallMember(&GLStateManager::BindVertexArray, g_stateMngrArg, cmd->vao);
+            }
+            compiler.EndIf();
             return sizeof(*cmd);
         }
         case GLOpcodeBindGL2XVertexArray:
@@ -220,13 +248,14 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeBindGraphicsPipeline:
         {
             auto cmd = reinterpret_cast<const GLCmdBindGraphicsPipeline*>(pc);
-            compiler.CallMember(&GLGraphicsPipeline::Bind, cmd->graphicsPipeline, g_stateMngrArg);
+            AssembleBindShaderProgram(compiler, offsets, cmd->graphicsPipeline->GetShaderProgram()->GetID());
+            compiler.CallMember(&GLGraphicsPipeline::BindRenderStates, cmd->graphicsPipeline, g_stateMngrArg);
             return sizeof(*cmd);
         }
         case GLOpcodeBindComputePipeline:
         {
             auto cmd = reinterpret_cast<const GLCmdBindComputePipeline*>(pc);
-            compiler.CallMember(&GLComputePipeline::Bind, cmd->computePipeline, g_stateMngrArg);
+            AssembleBindShaderProgram(compiler, offsets, cmd->computePipeline->GetShaderProgram()->GetID());
             return sizeof(*cmd);
         }
         case GLOpcodeBeginQuery:
@@ -276,7 +305,7 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         {
             //TODO: generate loop in ASM
             auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
-            compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+            AssembleBindBuffer(compiler, offsets, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             GLintptr offset = cmd->indirect;
             for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
             {
@@ -322,7 +351,7 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
             {
                 //TODO: generate loop in ASM
-                compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+                AssembleBindBuffer(compiler, offsets, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
                 GLintptr offset = cmd->indirect;
                 for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
                 {
@@ -336,14 +365,14 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeMultiDrawArraysIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
-            compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+            AssembleBindBuffer(compiler, offsets, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glMultiDrawArraysIndirect, cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
             return sizeof(*cmd);
         }
         case GLOpcodeMultiDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
-            compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+            AssembleBindBuffer(compiler, offsets, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glMultiDrawElementsIndirect, cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
             return sizeof(*cmd);
         }
@@ -358,7 +387,7 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeDispatchComputeIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
-            compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
+            AssembleBindBuffer(compiler, offsets, GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glDispatchComputeIndirect, cmd->indirect);
             return sizeof(*cmd);
         }
@@ -405,8 +434,8 @@ static std::size_t RequiredLocalStackSize(const GLDeferredCommandBuffer& cmdBuff
 {
     std::size_t maxSize = 0;
     
+    /* Depth ranges are passed directly, only viewports and scissors are copied onto the stack */
     maxSize = cmdBuffer.GetMaxNumViewports() * sizeof(GLViewport);
-    maxSize = std::max(maxSize, cmdBuffer.GetMaxNumViewports() * sizeof(GLDepthRange));
     maxSize = std::max(maxSize, cmdBuffer.GetMaxNumScissors() * sizeof(GLScissor));
 
     return maxSize;
@@ -414,15 +443,15 @@ static std::size_t RequiredLocalStackSize(const GLDeferredCommandBuffer& cmdBuff
 
 std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer)
 {
+    /* Cached states of the state manager are compared inline, which requires an active GL context */
+    if (!GLStateManager::active)
+        return nullptr;
+    
+    const auto offsets = GLStateManager::active->GetJITStateOffsets();
+    
     /* Try to create a JIT-compiler for the active architecture (if supported) */
     if (auto compiler = JITCompiler::Create())
     {
-        /* Initialize program counter to execute virtual GL commands */
-        const auto& rawBuffer = cmdBuffer.GetRawBuffer();
-        
-        auto pc     = rawBuffer.data();
-        auto pcEnd  = rawBuffer.data() + rawBuffer.size();
-
         GLOpcode opcode;
         
         /* Declare variadic arguments for entry point of JIT program */
@@ -436,14 +465,21 @@ std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredComm
         /* Assemble GL commands into JIT program */
         compiler->Begin();
         
-        while (pc < pcEnd)
+        for (const auto& page : cmdBuffer.GetCommandArena().GetPages())
         {
-            /* Read opcode */
-            opcode = *reinterpret_cast<const GLOpcode*>(pc);
-            pc += sizeof(GLOpcode);
+            /* Initialize program counter to execute virtual GL commands of this page */
+            const std::uint8_t* pc      = page.data;
+            const std::uint8_t* pcEnd   = page.data + page.size;
 
-            /* Execute command and increment program counter */
-            pc += AssembleGLCommand(opcode, pc, *compiler);
+            while (pc < pcEnd)
+            {
+                /* Read opcode */
+                opcode = *reinterpret_cast<const GLOpcode*>(pc);
+                pc += sizeof(GLOpcode);
+
+                /* Execute command and increment program counter */
+                pc += AssembleGLCommand(opcode, pc, *compiler, offsets);
+            }
         }
         
         compiler->End();
@@ -46,307 +46,629 @@ namespace LLGL
 {
 
 
-static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager& stateMngr)
+/* ----- GL command handlers ----- */
+
+static void ExecuteGLCmdUpdateBuffer(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdUpdateBuffer*>(pc);
+    cmd->buffer->BufferSubData(cmd->offset, cmd->size, cmd + 1);
+}
+
+static void ExecuteGLCmdCopyBuffer(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdCopyBuffer*>(pc);
+    cmd->writeBuffer->CopyBufferSubData(*(cmd->readBuffer), cmd->readOffset, cmd->writeOffset, cmd->size);
+}
+
+static void ExecuteGLCmdExecute(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdExecute*>(pc);
+    ExecuteGLDeferredCommandBuffer(*(cmd->commandBuffer), stateMngr);
+}
+
+static void ExecuteGLCmdSetAPIDepState(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdSetAPIDepState*>(pc);
+    stateMngr.SetGraphicsAPIDependentState(cmd->desc);
+}
+
+static void ExecuteGLCmdViewport(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdViewport*>(pc);
+    {
+        GLViewport viewport = cmd->viewport;
+        stateMngr.SetViewport(viewport);
+
+        GLDepthRange depthRange = cmd->depthRange;
+        stateMngr.SetDepthRange(depthRange);
+    }
+}
+
+static void ExecuteGLCmdViewportArray(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
+    auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
+    {
+        union
+        {
+            GLViewport viewports[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+            GLDepthRange depthRanges[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+        };
+
+        ::memcpy(viewports, cmdData, sizeof(GLViewport)*cmd->count);
+        stateMngr.SetViewportArray(cmd->first, cmd->count, viewports);
+
+        ::memcpy(depthRanges, cmdData + sizeof(GLViewport)*cmd->count, sizeof(GLDepthRange)*cmd->count);
+        stateMngr.SetDepthRangeArray(cmd->first, cmd->count, depthRanges);
+    }
+}
+
+static void ExecuteGLCmdScissor(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdScissor*>(pc);
+    {
+        GLScissor scissor = cmd->scissor;
+        stateMngr.SetScissor(scissor);
+    }
+}
+
+static void ExecuteGLCmdScissorArray(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
+    auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
+    {
+        GLScissor scissors[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+        ::memcpy(scissors, cmdData, sizeof(GLScissor)*cmd->count);
+        stateMngr.SetScissorArray(cmd->first, cmd->count, scissors);
+    }
+}
+
+static void ExecuteGLCmdClearColor(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearColor*>(pc);
+    glClearColor(cmd->color[0], cmd->color[1], cmd->color[2], cmd->color[3]);
+}
+
+static void ExecuteGLCmdClearDepth(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearDepth*>(pc);
+    glClearDepth(cmd->depth);
+}
+
+static void ExecuteGLCmdClearStencil(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearStencil*>(pc);
+    glClearStencil(cmd->stencil);
+}
+
+static void ExecuteGLCmdClear(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdClear*>(pc);
+    stateMngr.Clear(cmd->flags);
+}
+
+static void ExecuteGLCmdClearBuffers(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
+    stateMngr.ClearBuffers(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
+}
+
+static void ExecuteGLCmdBindVertexArray(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
+    stateMngr.BindVertexArray(cmd->vao);
+}
+
+static void ExecuteGLCmdBindGL2XVertexArray(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindGL2XVertexArray*>(pc);
+    cmd->vertexArrayGL2X->Bind(stateMngr);
+}
+
+static void ExecuteGLCmdBindElementArrayBufferToVAO(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
+    stateMngr.BindElementArrayBufferToVAO(cmd->id);
+}
+
+static void ExecuteGLCmdBindBufferBase(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(pc);
+    stateMngr.BindBufferBase(cmd->target, cmd->index, cmd->id);
+}
+
+static void ExecuteGLCmdBindBuffersBase(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
+    stateMngr.BindBuffersBase(cmd->target, cmd->first, cmd->count, reinterpret_cast<const GLuint*>(cmd + 1));
+}
+
+static void ExecuteGLCmdBeginTransformFeedback(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedback*>(pc);
+    glBeginTransformFeedback(cmd->primitiveMove);
+}
+
+#ifdef GL_NV_transform_feedback
+
+static void ExecuteGLCmdBeginTransformFeedbackNV(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
+    glBeginTransformFeedbackNV(cmd->primitiveMove);
+}
+
+#endif // /GL_NV_transform_feedback
+
+static void ExecuteGLCmdEndTransformFeedback(const void* /*pc*/, GLStateManager& /*stateMngr*/)
+{
+    glEndTransformFeedback();
+}
+
+#ifdef GL_NV_transform_feedback
+
+static void ExecuteGLCmdEndTransformFeedbackNV(const void* /*pc*/, GLStateManager& /*stateMngr*/)
+{
+    glEndTransformFeedbackNV();
+}
+
+#endif // /GL_NV_transform_feedback
+
+static void ExecuteGLCmdBindResourceHeap(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
+    cmd->resourceHeap->Bind(stateMngr);
+}
+
+static void ExecuteGLCmdBindRenderPass(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindRenderPass*>(pc);
+    stateMngr.BindRenderPass(*(cmd->renderTarget), cmd->renderPass, cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1), cmd->defaultClearValue);
+}
+
+static void ExecuteGLCmdBindGraphicsPipeline(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindGraphicsPipeline*>(pc);
+    cmd->graphicsPipeline->Bind(stateMngr);
+}
+
+static void ExecuteGLCmdBindComputePipeline(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindComputePipeline*>(pc);
+    cmd->computePipeline->Bind(stateMngr);
+}
+
+static void ExecuteGLCmdBeginQuery(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
+    cmd->queryHeap->Begin(cmd->query);
+}
+
+static void ExecuteGLCmdEndQuery(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdEndQuery*>(pc);
+    cmd->queryHeap->End(cmd->query);
+}
+
+static void ExecuteGLCmdBeginConditionalRender(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBeginConditionalRender*>(pc);
+    glBeginConditionalRender(cmd->id, cmd->mode);
+}
+
+static void ExecuteGLCmdEndConditionalRender(const void* /*pc*/, GLStateManager& /*stateMngr*/)
+{
+    glEndConditionalRender();
+}
+
+static void ExecuteGLCmdDrawArrays(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
+    glDrawArrays(cmd->mode, cmd->first, cmd->count);
+}
+
+static void ExecuteGLCmdDrawArraysInstanced(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
+    glDrawArraysInstanced(cmd->mode, cmd->first, cmd->count, cmd->instancecount);
+}
+
+#ifdef GL_ARB_base_instance
+
+static void ExecuteGLCmdDrawArraysInstancedBaseInstance(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
+    glDrawArraysInstancedBaseInstance(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+}
+
+#endif // /GL_ARB_base_instance
+
+static void ExecuteGLCmdDrawArraysIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
+    stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+    GLintptr offset = cmd->indirect;
+    for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
+    {
+        glDrawArraysIndirect(cmd->mode, reinterpret_cast<const GLvoid*>(offset));
+        offset += cmd->stride;
+    }
+}
+
+static void ExecuteGLCmdDrawElements(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
+    glDrawElements(cmd->mode, cmd->count, cmd->type, cmd->indices);
+}
+
+static void ExecuteGLCmdDrawElementsBaseVertex(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
+    glDrawElementsBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
+}
+
+static void ExecuteGLCmdDrawElementsInstanced(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
+    glDrawElementsInstanced(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
+}
+
+static void ExecuteGLCmdDrawElementsInstancedBaseVertex(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
+    glDrawElementsInstancedBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
+}
+
+#ifdef GL_ARB_base_instance
+
+static void ExecuteGLCmdDrawElementsInstancedBaseVertexBaseInstance(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
+    glDrawElementsInstancedBaseVertexBaseInstance(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+}
+
+#endif // /GL_ARB_base_instance
+
+static void ExecuteGLCmdDrawElementsIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
+    stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+    GLintptr offset = cmd->indirect;
+    for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
+    {
+        glDrawElementsIndirect(cmd->mode, cmd->type, reinterpret_cast<const GLvoid*>(offset));
+        offset += cmd->stride;
+    }
+}
+
+#ifdef GL_ARB_multi_draw_indirect
+
+static void ExecuteGLCmdMultiDrawArraysIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
+    stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+    glMultiDrawArraysIndirect(cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
+}
+
+static void ExecuteGLCmdMultiDrawElementsIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
+    stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+    glMultiDrawElementsIndirect(cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
+}
+
+#endif // /GL_ARB_multi_draw_indirect
+
+#ifdef GL_ARB_compute_shader
+
+static void ExecuteGLCmdDispatchCompute(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
+    glDispatchCompute(cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
+}
+
+static void ExecuteGLCmdDispatchComputeIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
+    stateMngr.BindBuffer(GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
+    glDispatchComputeIndirect(cmd->indirect);
+}
+
+#endif // /GL_ARB_compute_shader
+
+static void ExecuteGLCmdBindTexture(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
+    stateMngr.ActiveTexture(cmd->slot);
+    stateMngr.BindGLTexture(*(cmd->texture));
+}
+
+static void ExecuteGLCmdBindSampler(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindSampler*>(pc);
+    stateMngr.BindSampler(cmd->slot, cmd->sampler);
+}
+
+static void ExecuteGLCmdUnbindResources(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdUnbindResources*>(pc);
+    if (cmd->resetUBO)
+        stateMngr.UnbindBuffersBase(GLBufferTarget::UNIFORM_BUFFER, cmd->first, cmd->count);
+    if (cmd->resetSSAO)
+        stateMngr.UnbindBuffersBase(GLBufferTarget::SHADER_STORAGE_BUFFER, cmd->first, cmd->count);
+    if (cmd->resetTransformFeedback)
+        stateMngr.UnbindBuffersBase(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, cmd->first, cmd->count);
+    if (cmd->resetTextures)
+        stateMngr.UnbindTextures(cmd->first, cmd->count);
+    #if 0//TODO
+    if (cmd->resetImages)
+        stateMngr.UnbindImages(cmd->first, cmd->count);
+    #endif
+    if (cmd->resetSamplers)
+        stateMngr.UnbindSamplers(cmd->first, cmd->count);
+}
+
+/* ----- GL command decoding ----- */
+
+std::size_t DecodeGLCommand(const GLOpcode opcode, const void* pc, GLCommandFunc& func)
 {
     switch (opcode)
     {
         case GLOpcodeUpdateBuffer:
         {
             auto cmd = reinterpret_cast<const GLCmdUpdateBuffer*>(pc);
-            cmd->buffer->BufferSubData(cmd->offset, cmd->size, cmd + 1);
+            func = ExecuteGLCmdUpdateBuffer;
             return sizeof(*cmd) + cmd->size;
         }
         case GLOpcodeCopyBuffer:
         {
             auto cmd = reinterpret_cast<const GLCmdCopyBuffer*>(pc);
-            cmd->writeBuffer->CopyBufferSubData(*(cmd->readBuffer), cmd->readOffset, cmd->writeOffset, cmd->size);
+            func = ExecuteGLCmdCopyBuffer;
             return sizeof(*cmd);
         }
         case GLOpcodeExecute:
         {
             auto cmd = reinterpret_cast<const GLCmdExecute*>(pc);
-            ExecuteGLDeferredCommandBuffer(*(cmd->commandBuffer), stateMngr);
+            func = ExecuteGLCmdExecute;
             return sizeof(*cmd);
         }
         case GLOpcodeSetAPIDepState:
         {
             auto cmd = reinterpret_cast<const GLCmdSetAPIDepState*>(pc);
-            stateMngr.SetGraphicsAPIDependentState(cmd->desc);
+            func = ExecuteGLCmdSetAPIDepState;
             return sizeof(*cmd);
         }
         case GLOpcodeViewport:
         {
             auto cmd = reinterpret_cast<const GLCmdViewport*>(pc);
-            {
-                GLViewport viewport = cmd->viewport;
-                stateMngr.SetViewport(viewport);
-
-                GLDepthRange depthRange = cmd->depthRange;
-                stateMngr.SetDepthRange(depthRange);
-            }
+            func = ExecuteGLCmdViewport;
             return sizeof(*cmd);
         }
         case GLOpcodeViewportArray:
         {
             auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
-            auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
-            {
-                union
-                {
-                    GLViewport viewports[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
-                    GLDepthRange depthRanges[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
-                };
-
-                ::memcpy(viewports, cmdData, sizeof(GLViewport)*cmd->count);
-                stateMngr.SetViewportArray(cmd->first, cmd->count, viewports);
-
-                ::memcpy(depthRanges, cmdData + sizeof(GLViewport)*cmd->count, sizeof(GLDepthRange)*cmd->count);
-                stateMngr.SetDepthRangeArray(cmd->first, cmd->count, depthRanges);
-            }
+            func = ExecuteGLCmdViewportArray;
             return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
         }
         case GLOpcodeScissor:
         {
             auto cmd = reinterpret_cast<const GLCmdScissor*>(pc);
-            {
-                GLScissor scissor = cmd->scissor;
-                stateMngr.SetScissor(scissor);
-            }
+            func = ExecuteGLCmdScissor;
             return sizeof(*cmd);
         }
         case GLOpcodeScissorArray:
         {
             auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
-            auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
-            {
-                GLScissor scissors[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
-                ::memcpy(scissors, cmdData, sizeof(GLScissor)*cmd->count);
-                stateMngr.SetScissorArray(cmd->first, cmd->count, scissors);
-            }
+            func = ExecuteGLCmdScissorArray;
             return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
         }
         case GLOpcodeClearColor:
         {
             auto cmd = reinterpret_cast<const GLCmdClearColor*>(pc);
-            glClearColor(cmd->color[0], cmd->color[1], cmd->color[2], cmd->color[3]);
+            func = ExecuteGLCmdClearColor;
             return sizeof(*cmd);
         }
         case GLOpcodeClearDepth:
         {
             auto cmd = reinterpret_cast<const GLCmdClearDepth*>(pc);
-            glClearDepth(cmd->depth);
+            func = ExecuteGLCmdClearDepth;
             return sizeof(*cmd);
         }
         case GLOpcodeClearStencil:
         {
             auto cmd = reinterpret_cast<const GLCmdClearStencil*>(pc);
-            glClearStencil(cmd->stencil);
+            func = ExecuteGLCmdClearStencil;
             return sizeof(*cmd);
         }
         case GLOpcodeClear:
         {
             auto cmd = reinterpret_cast<const GLCmdClear*>(pc);
-            stateMngr.Clear(cmd->flags);
+            func = ExecuteGLCmdClear;
             return sizeof(*cmd);
         }
         case GLOpcodeClearBuffers:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
-            stateMngr.ClearBuffers(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
-            return sizeof(*cmd);
+            func = ExecuteGLCmdClearBuffers;
+            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
         }
         case GLOpcodeBindVertexArray:
         {
             auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
-            stateMngr.BindVertexArray(cmd->vao);
+            func = ExecuteGLCmdBindVertexArray;
             return sizeof(*cmd);
         }
         case GLOpcodeBindGL2XVertexArray:
         {
             auto cmd = reinterpret_cast<const GLCmdBindGL2XVertexArray*>(pc);
-            cmd->vertexArrayGL2X->Bind(stateMngr);
+            func = ExecuteGLCmdBindGL2XVertexArray;
             return sizeof(*cmd);
         }
         case GLOpcodeBindElementArrayBufferToVAO:
         {
             auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
-            stateMngr.BindElementArrayBufferToVAO(cmd->id);
+            func = ExecuteGLCmdBindElementArrayBufferToVAO;
             return sizeof(*cmd);
         }
         case GLOpcodeBindBufferBase:
         {
             auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(pc);
-            stateMngr.BindBufferBase(cmd->target, cmd->index, cmd->id);
+            func = ExecuteGLCmdBindBufferBase;
             return sizeof(*cmd);
         }
         case GLOpcodeBindBuffersBase:
         {
             auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
-            stateMngr.BindBuffersBase(cmd->target, cmd->first, cmd->count, reinterpret_cast<const GLuint*>(cmd + 1));
+            func = ExecuteGLCmdBindBuffersBase;
             return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
         }
         case GLOpcodeBeginTransformFeedback:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedback*>(pc);
-            glBeginTransformFeedback(cmd->primitiveMove);
+            func = ExecuteGLCmdBeginTransformFeedback;
             return sizeof(*cmd);
         }
         #ifdef GL_NV_transform_feedback
         case GLOpcodeBeginTransformFeedbackNV:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
-            glBeginTransformFeedbackNV(cmd->primitiveMove);
+            func = ExecuteGLCmdBeginTransformFeedbackNV;
             return sizeof(*cmd);
         }
         #endif // /GL_NV_transform_feedback
         case GLOpcodeEndTransformFeedback:
         {
-            glEndTransformFeedback();
+            func = ExecuteGLCmdEndTransformFeedback;
             return 0;
         }
         #ifdef GL_NV_transform_feedback
         case GLOpcodeEndTransformFeedbackNV:
         {
-            glEndTransformFeedbackNV();
+            func = ExecuteGLCmdEndTransformFeedbackNV;
             return 0;
         }
         #endif // /GL_NV_transform_feedback
         case GLOpcodeBindResourceHeap:
         {
             auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
-            cmd->resourceHeap->Bind(stateMngr);
+            func = ExecuteGLCmdBindResourceHeap;
             return sizeof(*cmd);
         }
         case GLOpcodeBindRenderPass:
         {
             auto cmd = reinterpret_cast<const GLCmdBindRenderPass*>(pc);
-            stateMngr.BindRenderPass(*(cmd->renderTarget), cmd->renderPass, cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1), cmd->defaultClearValue);
+            func = ExecuteGLCmdBindRenderPass;
             return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
         }
         case GLOpcodeBindGraphicsPipeline:
         {
             auto cmd = reinterpret_cast<const GLCmdBindGraphicsPipeline*>(pc);
-            cmd->graphicsPipeline->Bind(stateMngr);
+            func = ExecuteGLCmdBindGraphicsPipeline;
             return sizeof(*cmd);
         }
         case GLOpcodeBindComputePipeline:
         {
             auto cmd = reinterpret_cast<const GLCmdBindComputePipeline*>(pc);
-            cmd->computePipeline->Bind(stateMngr);
+            func = ExecuteGLCmdBindComputePipeline;
             return sizeof(*cmd);
         }
         case GLOpcodeBeginQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
-            cmd->queryHeap->Begin(cmd->query);
+            func = ExecuteGLCmdBeginQuery;
             return sizeof(*cmd);
         }
         case GLOpcodeEndQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdEndQuery*>(pc);
-            cmd->queryHeap->End(cmd->query);
+            func = ExecuteGLCmdEndQuery;
             return sizeof(*cmd);
         }
         case GLOpcodeBeginConditionalRender:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginConditionalRender*>(pc);
-            glBeginConditionalRender(cmd->id, cmd->mode);
+            func = ExecuteGLCmdBeginConditionalRender;
             return sizeof(*cmd);
         }
         case GLOpcodeEndConditionalRender:
         {
-            glEndConditionalRender();
+            func = ExecuteGLCmdEndConditionalRender;
             return 0;
         }
         case GLOpcodeDrawArrays:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
-            glDrawArrays(cmd->mode, cmd->first, cmd->count);
+            func = ExecuteGLCmdDrawArrays;
             return sizeof(*cmd);
         }
         case GLOpcodeDrawArraysInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
-            glDrawArraysInstanced(cmd->mode, cmd->first, cmd->count, cmd->instancecount);
+            func = ExecuteGLCmdDrawArraysInstanced;
             return sizeof(*cmd);
         }
         #ifdef GL_ARB_base_instance
         case GLOpcodeDrawArraysInstancedBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
-            glDrawArraysInstancedBaseInstance(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+            func = ExecuteGLCmdDrawArraysInstancedBaseInstance;
             return sizeof(*cmd);
         }
         #endif // /GL_ARB_base_instance
         case GLOpcodeDrawArraysIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
-            stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
-            GLintptr offset = cmd->indirect;
-            for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
-            {
-                glDrawArraysIndirect(cmd->mode, reinterpret_cast<const GLvoid*>(offset));
-                offset += cmd->stride;
-            }
+            func = ExecuteGLCmdDrawArraysIndirect;
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElements:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
-            glDrawElements(cmd->mode, cmd->count, cmd->type, cmd->indices);
+            func = ExecuteGLCmdDrawElements;
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
-            glDrawElementsBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
+            func = ExecuteGLCmdDrawElementsBaseVertex;
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
-            glDrawElementsInstanced(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
+            func = ExecuteGLCmdDrawElementsInstanced;
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstancedBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
-            glDrawElementsInstancedBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
+            func = ExecuteGLCmdDrawElementsInstancedBaseVertex;
             return sizeof(*cmd);
         }
         #ifdef GL_ARB_base_instance
         case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
-            glDrawElementsInstancedBaseVertexBaseInstance(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+            func = ExecuteGLCmdDrawElementsInstancedBaseVertexBaseInstance;
             return sizeof(*cmd);
         }
         #endif // /GL_ARB_base_instance
         case GLOpcodeDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
-            stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
-            GLintptr offset = cmd->indirect;
-            for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
-            {
-                glDrawElementsIndirect(cmd->mode, cmd->type, reinterpret_cast<const GLvoid*>(offset));
-                offset += cmd->stride;
-            }
+            func = ExecuteGLCmdDrawElementsIndirect;
             return sizeof(*cmd);
         }
         #ifdef GL_ARB_multi_draw_indirect
         case GLOpcodeMultiDrawArraysIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
-            stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
-            glMultiDrawArraysIndirect(cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
+            func = ExecuteGLCmdMultiDrawArraysIndirect;
             return sizeof(*cmd);
         }
         case GLOpcodeMultiDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
-            stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
-            glMultiDrawElementsIndirect(cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
+            func = ExecuteGLCmdMultiDrawElementsIndirect;
             return sizeof(*cmd);
         }
         #endif // /GL_ARB_multi_draw_indirect
@@ -354,73 +676,73 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
         case GLOpcodeDispatchCompute:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
-            glDispatchCompute(cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
+            func = ExecuteGLCmdDispatchCompute;
             return sizeof(*cmd);
         }
         case GLOpcodeDispatchComputeIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
-            stateMngr.BindBuffer(GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
-            glDispatchComputeIndirect(cmd->indirect);
+            func = ExecuteGLCmdDispatchComputeIndirect;
             return sizeof(*cmd);
         }
         #endif // /GL_ARB_compute_shader
         case GLOpcodeBindTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
-            stateMngr.ActiveTexture(cmd->slot);
-            stateMngr.BindGLTexture(*(cmd->texture));
+            func = ExecuteGLCmdBindTexture;
             return sizeof(*cmd);
         }
         case GLOpcodeBindSampler:
         {
             auto cmd = reinterpret_cast<const GLCmdBindSampler*>(pc);
-            stateMngr.BindSampler(cmd->slot, cmd->sampler);
+            func = ExecuteGLCmdBindSampler;
             return sizeof(*cmd);
         }
         case GLOpcodeUnbindResources:
         {
             auto cmd = reinterpret_cast<const GLCmdUnbindResources*>(pc);
-            if (cmd->resetUBO)
-                stateMngr.UnbindBuffersBase(GLBufferTarget::UNIFORM_BUFFER, cmd->first, cmd->count);
-            if (cmd->resetSSAO)
-                stateMngr.UnbindBuffersBase(GLBufferTarget::SHADER_STORAGE_BUFFER, cmd->first, cmd->count);
-            if (cmd->resetTransformFeedback)
-                stateMngr.UnbindBuffersBase(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, cmd->first, cmd->count);
-            if (cmd->resetTextures)
-                stateMngr.UnbindTextures(cmd->first, cmd->count);
-            #if 0//TODO
-            if (cmd->resetImages)
-                stateMngr.UnbindImages(cmd->first, cmd->count);
-            #endif
-            if (cmd->resetSamplers)
-                stateMngr.UnbindSamplers(cmd->first, cmd->count);
+            func = ExecuteGLCmdUnbindResources;
             return sizeof(*cmd);
         }
         default:
+            func = nullptr;
             return 0;
     }
 }
 
-static void ExecuteGLCommandsEmulated(const std::vector<std::uint8_t>& rawBuffer, GLStateManager& stateMngr)
+static void ExecuteGLCommandsEmulated(const GLCommandArena& arena, GLStateManager& stateMngr)
 {
-    /* Initialize program counter to execute virtual GL commands */
-    auto pc     = rawBuffer.data();
-    auto pcEnd  = rawBuffer.data() + rawBuffer.size();
-
-    GLOpcode opcode;
+    GLOpcode        opcode;
+    GLCommandFunc   func;
 
-    while (pc < pcEnd)
+    for (const auto& page : arena.GetPages())
     {
-        /* Read opcode */
-        opcode = *reinterpret_cast<const GLOpcode*>(pc);
-        pc += sizeof(GLOpcode);
+        /* Initialize program counter to execute virtual GL commands of this page */
+        auto pc     = page.data;
+        auto pcEnd  = page.data + page.size;
 
-        /* Execute command and increment program counter */
-        pc += ExecuteGLCommand(opcode, pc, stateMngr);
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            opcode = *reinterpret_cast<const GLOpcode*>(pc);
+            pc += sizeof(GLOpcode);
+
+            /* Decode and execute command, then increment program counter */
+            auto size = DecodeGLCommand(opcode, pc, func);
+            if (func != nullptr)
+                func(pc, stateMngr);
+            pc += size;
+        }
     }
 }
 
+static void ExecuteGLCommandsDecoded(const std::vector<GLDecodedCommand>& decodedCommands, GLStateManager& stateMngr)
+{
+    /* Execute pre-decoded GL commands without any further opcode decoding */
+    for (const auto& cmd : decodedCommands)
+        cmd.func(cmd.args, stateMngr);
+}
+
 #ifdef LLGL_ENABLE_JIT_COMPILER
 
 static void ExecuteGLCommandsNatively(const JITProgram& exec, GLStateManager& stateMngr)
@@ -431,6 +753,90 @@ static void ExecuteGLCommandsNatively(const JITProgram& exec, GLStateManager& st
 
 #endif // /LLGL_ENABLE_JIT_COMPILER
 
+void DecodeGLCommandBuffer(const GLCommandArena& arena, std::vector<GLDecodedCommand>& decodedCommands)
+{
+    GLOpcode        opcode;
+    GLCommandFunc   func;
+
+    decodedCommands.clear();
+
+    for (const auto& page : arena.GetPages())
+    {
+        /* Initialize program counter to decode virtual GL commands of this page */
+        auto pc     = page.data;
+        auto pcEnd  = page.data + page.size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            opcode = *reinterpret_cast<const GLOpcode*>(pc);
+            pc += sizeof(GLOpcode);
+
+            /* Store handler and arguments of command, then increment program counter */
+            auto size = DecodeGLCommand(opcode, pc, func);
+            if (func != nullptr)
+                decodedCommands.push_back({ func, pc });
+            pc += size;
+        }
+    }
+}
+
+void StitchGLSecondaryCommandBuffers(std::vector<GLDecodedCommand>& decodedCommands, std::vector<GLStitchedCommandBuffer>& stitchedCmdBuffers)
+{
+    stitchedCmdBuffers.clear();
+
+    /* Find first 'Execute' command */
+    auto it = std::find_if(
+        decodedCommands.begin(), decodedCommands.end(),
+        [](const GLDecodedCommand& cmd)
+        {
+            return (cmd.func == ExecuteGLCmdExecute);
+        }
+    );
+
+    if (it == decodedCommands.end())
+        return;
+
+    std::vector<GLDecodedCommand> stitchedCommands;
+    stitchedCommands.reserve(decodedCommands.size());
+    stitchedCommands.insert(stitchedCommands.end(), decodedCommands.begin(), it);
+
+    for (; it != decodedCommands.end(); ++it)
+    {
+        if (it->func == ExecuteGLCmdExecute)
+        {
+            auto cmd = reinterpret_cast<const GLCmdExecute*>(it->args);
+            auto secondaryCmdBuffer = cmd->commandBuffer;
+
+            /* Secondary command buffers are sealed with an even generation, so they must not be stitched while they are still being recorded */
+            const auto generation = secondaryCmdBuffer->GetRecordGeneration();
+            const auto& secondaryCommands = secondaryCmdBuffer->GetDecodedCommands();
+
+            if ((generation & 1u) == 0 && !secondaryCommands.empty())
+            {
+                /* Append references to the commands of the secondary command buffer */
+                stitchedCommands.insert(stitchedCommands.end(), secondaryCommands.begin(), secondaryCommands.end());
+                stitchedCmdBuffers.push_back({ secondaryCmdBuffer, generation });
+                continue;
+            }
+        }
+        stitchedCommands.push_back(*it);
+    }
+
+    decodedCommands = std::move(stitchedCommands);
+}
+
+// Returns true if none of the stitched secondary command buffers has been recorded again since they have been stitched.
+static bool AreStitchedCommandBuffersValid(const std::vector<GLStitchedCommandBuffer>& stitchedCmdBuffers)
+{
+    for (const auto& stitched : stitchedCmdBuffers)
+    {
+        if (stitched.commandBuffer->GetRecordGeneration() != stitched.generation)
+            return false;
+    }
+    return true;
+}
+
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
 {
     #ifdef LLGL_ENABLE_JIT_COMPILER
@@ -441,9 +847,15 @@ void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GL
     }
     else
     #endif // /LLGL_ENABLE_JIT_COMPILER
+    if (!cmdBuffer.GetDecodedCommands().empty() && AreStitchedCommandBuffersValid(cmdBuffer.GetStitchedCommandBuffers()))
+    {
+        /* Execute GL commands with pre-decoded handlers */
+        ExecuteGLCommandsDecoded(cmdBuffer.GetDecodedCommands(), stateMngr);
+    }
+    else
     {
         /* Emulate execution of GL commands */
-        ExecuteGLCommandsEmulated(cmdBuffer.GetRawBuffer(), stateMngr);
+        ExecuteGLCommandsEmulated(cmdBuffer.GetCommandArena(), stateMngr);
     }
 }
 
@@ -9,6 +9,12 @@
 #define LLGL_GL_COMMAND_EXECUTOR_H
 
 
+#include "GLCommandOpcode.h"
+#include "GLCommandArena.h"
+#include <vector>
+#include <cstdint>
+
+
 namespace LLGL
 {
 
@@ -17,6 +23,39 @@ class GLStateManager;
 class GLCommandBuffer;
 class GLDeferredCommandBuffer;
 
+// Function pointer type of the handler for a single GL command.
+using GLCommandFunc = void (*)(const void* args, GLStateManager& stateMngr);
+
+// Pre-decoded GL command with direct handler and pointer to its arguments inside the raw command buffer.
+struct GLDecodedCommand
+{
+    GLCommandFunc   func;
+    const void*     args;
+};
+
+/*
+Reference to a secondary command buffer whose pre-decoded commands have been stitched into a primary command buffer.
+The generation denotes the recording of the secondary command buffer at the time it was stitched (see GLDeferredCommandBuffer::GetRecordGeneration).
+*/
+struct GLStitchedCommandBuffer
+{
+    const GLDeferredCommandBuffer*  commandBuffer;
+    std::uint32_t                   generation;
+};
+
+// Returns the handler and size (in bytes) of the specified GL command, or zero if the opcode is unknown.
+std::size_t DecodeGLCommand(const GLOpcode opcode, const void* pc, GLCommandFunc& func);
+
+// Decodes the command arena into a list of direct handlers, so the commands can be executed without opcode decoding (threaded code).
+void DecodeGLCommandBuffer(const GLCommandArena& arena, std::vector<GLDecodedCommand>& decodedCommands);
+
+/*
+Replaces all pre-decoded 'Execute' commands by the pre-decoded commands of their secondary command buffers.
+The arguments of the stitched commands still refer to the command arenas of the secondary command buffers, i.e. no command data is copied.
+Secondary command buffers that are still being recorded or have no pre-decoded commands are executed as before.
+*/
+void StitchGLSecondaryCommandBuffers(std::vector<GLDecodedCommand>& decodedCommands, std::vector<GLStitchedCommandBuffer>& stitchedCmdBuffers);
+
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdbuffer, GLStateManager& stateMngr);
 void ExecuteGLCommandBuffer(const GLCommandBuffer& cmdbuffer, GLStateManager& stateMngr);
 
@@ -0,0 +1,321 @@
+/*
+ * GLCommandOptimizer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandOptimizer.h"
+#include "GLCommandExecutor.h"
+#include "GLCommand.h"
+#include "../RenderState/GLGraphicsPipeline.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// State slots that are tracked by the optimizer.
+enum GLStateSlot
+{
+    GLStateSlotViewport = 0,
+    GLStateSlotScissor,
+    GLStateSlotClearColor,
+    GLStateSlotClearDepth,
+    GLStateSlotClearStencil,
+    GLStateSlotPipeline,
+    GLStateSlotResourceHeap,
+    GLStateSlotVertexArray,
+
+    GLStateSlotCount,
+};
+
+// Reference to a single command inside a page of the command arena.
+struct GLCommandRef
+{
+    GLOpcode        opcode;
+    std::uint8_t*   pc;         // Pointer to the opcode of this command
+    std::size_t     size;       // Size (in bytes) of the command arguments
+    std::size_t     page;       // Index of the page that contains this command
+    bool            removed;
+};
+
+struct GLCommandOptimizerState
+{
+    const GLCommandRef* lastCommands[GLStateSlotCount]          = {};   // Last command that was kept per state slot
+    GLCommandRef*       pendingCommands[GLStateSlotCount]       = {};   // Last command per state slot that has not been used yet
+};
+
+// Returns the state slot the specified command writes to, or GLStateSlotCount if the command is not tracked.
+static GLStateSlot GetStateSlot(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        case GLOpcodeViewport:              return GLStateSlotViewport;
+        case GLOpcodeScissor:               return GLStateSlotScissor;
+        case GLOpcodeClearColor:            return GLStateSlotClearColor;
+        case GLOpcodeClearDepth:            return GLStateSlotClearDepth;
+        case GLOpcodeClearStencil:          return GLStateSlotClearStencil;
+        case GLOpcodeBindGraphicsPipeline:  return GLStateSlotPipeline;
+        case GLOpcodeBindComputePipeline:   return GLStateSlotPipeline;
+        case GLOpcodeBindResourceHeap:      return GLStateSlotResourceHeap;
+        case GLOpcodeBindVertexArray:       return GLStateSlotVertexArray;
+        default:                            return GLStateSlotCount;
+    }
+}
+
+// Returns true if the specified state slot is entirely overwritten by the next command of the same kind.
+static bool IsOverwritableStateSlot(const GLStateSlot slot)
+{
+    switch (slot)
+    {
+        case GLStateSlotViewport:
+        case GLStateSlotScissor:
+        case GLStateSlotClearColor:
+        case GLStateSlotClearDepth:
+        case GLStateSlotClearStencil:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns true if the specified command does not depend on viewports, scissors, or clear values.
+static bool IsIndependentOfOverwritableStates(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        case GLOpcodeViewport:
+        case GLOpcodeScissor:
+        case GLOpcodeClearColor:
+        case GLOpcodeClearDepth:
+        case GLOpcodeClearStencil:
+        case GLOpcodeBindVertexArray:
+        case GLOpcodeBindElementArrayBufferToVAO:
+        case GLOpcodeBindBufferBase:
+        case GLOpcodeBindBuffersBase:
+        case GLOpcodeBindResourceHeap:
+        case GLOpcodeBindGraphicsPipeline:
+        case GLOpcodeBindComputePipeline:
+        case GLOpcodeBindTexture:
+        case GLOpcodeBindSampler:
+        case GLOpcodeUnbindResources:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+const T& GetCommandArgs(const GLCommandRef& cmd)
+{
+    return *reinterpret_cast<const T*>(cmd.pc + sizeof(GLOpcode));
+}
+
+// Returns true if the specified command has the same opcode and arguments as the last command of the same state slot.
+static bool IsRedundantCommand(const GLCommandOptimizerState& state, const GLCommandRef& cmd, const GLStateSlot slot)
+{
+    if (auto lastCmd = state.lastCommands[slot])
+    {
+        return
+        (
+            lastCmd->opcode == cmd.opcode &&
+            lastCmd->size   == cmd.size   &&
+            ::memcmp(lastCmd->pc + sizeof(GLOpcode), cmd.pc + sizeof(GLOpcode), cmd.size) == 0
+        );
+    }
+    return false;
+}
+
+// Returns true if the last bound pipeline sets static viewports or scissors.
+static bool HasLastPipelineStaticViewportsOrScissors(const GLCommandOptimizerState& state)
+{
+    if (auto lastCmd = state.lastCommands[GLStateSlotPipeline])
+    {
+        if (lastCmd->opcode == GLOpcodeBindGraphicsPipeline)
+            return GetCommandArgs<GLCmdBindGraphicsPipeline>(*lastCmd).graphicsPipeline->HasStaticViewportsOrScissors();
+    }
+    return false;
+}
+
+// Invalidates all state slots that might have been modified by the specified command.
+static void InvalidateStateSlots(GLCommandOptimizerState& state, const GLCommandRef& cmd)
+{
+    switch (cmd.opcode)
+    {
+        case GLOpcodeViewport:
+        case GLOpcodeViewportArray:
+        case GLOpcodeScissor:
+        case GLOpcodeScissorArray:
+        {
+            /* Static viewports and scissors of the last pipeline are overwritten */
+            if (HasLastPipelineStaticViewportsOrScissors(state))
+                state.lastCommands[GLStateSlotPipeline] = nullptr;
+            if (cmd.opcode == GLOpcodeViewportArray)
+                state.lastCommands[GLStateSlotViewport] = nullptr;
+            else if (cmd.opcode == GLOpcodeScissorArray)
+                state.lastCommands[GLStateSlotScissor] = nullptr;
+        }
+        break;
+
+        case GLOpcodeBindGraphicsPipeline:
+        {
+            /* Static viewports and scissors of this pipeline overwrite the previous ones */
+            if (GetCommandArgs<GLCmdBindGraphicsPipeline>(cmd).graphicsPipeline->HasStaticViewportsOrScissors())
+            {
+                state.lastCommands[GLStateSlotViewport] = nullptr;
+                state.lastCommands[GLStateSlotScissor]  = nullptr;
+            }
+        }
+        break;
+
+        case GLOpcodeBindBufferBase:
+        case GLOpcodeBindBuffersBase:
+        case GLOpcodeBindTexture:
+        case GLOpcodeBindSampler:
+        case GLOpcodeUnbindResources:
+        {
+            /* Individual resource bindings overwrite those of the last resource heap */
+            state.lastCommands[GLStateSlotResourceHeap] = nullptr;
+        }
+        break;
+
+        case GLOpcodeBindGL2XVertexArray:
+        case GLOpcodeUpdateBuffer:
+        case GLOpcodeCopyBuffer:
+        {
+            /* Buffer bindings might modify the current vertex array */
+            state.lastCommands[GLStateSlotVertexArray] = nullptr;
+        }
+        break;
+
+        case GLOpcodeExecute:
+        case GLOpcodeSetAPIDepState:
+        case GLOpcodeBindRenderPass:
+        {
+            /* Secondary command buffers, API dependent states, and render passes can modify any state */
+            for (auto& lastCmd : state.lastCommands)
+                lastCmd = nullptr;
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+static void RemoveCommand(GLCommandRef& cmd, GLCommandOptimizerStats& stats)
+{
+    cmd.removed = true;
+    stats.numRemovedCommandsTotal++;
+}
+
+static void ReadCommandRefs(std::vector<GLCommandPage>& pages, std::vector<GLCommandRef>& cmdRefs)
+{
+    GLCommandFunc func;
+
+    for (std::size_t i = 0; i < pages.size(); ++i)
+    {
+        auto pc     = pages[i].data;
+        auto pcEnd  = pages[i].data + pages[i].size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode and determine size of command arguments */
+            const auto opcode = static_cast<GLOpcode>(*pc);
+            const auto size = DecodeGLCommand(opcode, pc + sizeof(GLOpcode), func);
+            cmdRefs.push_back({ opcode, pc, size, i, false });
+
+            pc += sizeof(GLOpcode) + size;
+        }
+    }
+}
+
+// Moves all remaining commands to the front of their page
+static void CompactCommandPages(std::vector<GLCommandPage>& pages, const std::vector<GLCommandRef>& cmdRefs)
+{
+    std::size_t     page    = 0;
+    std::uint8_t*   dst     = pages[0].data;
+
+    for (const auto& cmd : cmdRefs)
+    {
+        if (cmd.page != page)
+        {
+            /* Update size of previous page and continue with next one */
+            pages[page].size = static_cast<std::size_t>(dst - pages[page].data);
+            page = cmd.page;
+            dst = pages[page].data;
+        }
+
+        if (!cmd.removed)
+        {
+            const auto size = sizeof(GLOpcode) + cmd.size;
+            if (dst != cmd.pc)
+                ::memmove(dst, cmd.pc, size);
+            dst += size;
+        }
+    }
+
+    pages[page].size = static_cast<std::size_t>(dst - pages[page].data);
+}
+
+void OptimizeGLCommandBuffer(GLCommandArena& arena, GLCommandOptimizerStats& stats)
+{
+    /* Gather all commands of the command arena */
+    std::vector<GLCommandRef> cmdRefs;
+    ReadCommandRefs(arena.GetPages(), cmdRefs);
+
+    GLCommandOptimizerState state;
+
+    bool anyRemoved = false;
+
+    for (auto& cmd : cmdRefs)
+    {
+        const auto slot = GetStateSlot(cmd.opcode);
+
+        if (slot != GLStateSlotCount)
+        {
+            /* Remove command if it sets the same state as before */
+            if (IsRedundantCommand(state, cmd, slot))
+            {
+                RemoveCommand(cmd, stats);
+                anyRemoved = true;
+                continue;
+            }
+
+            if (IsOverwritableStateSlot(slot))
+            {
+                /* Remove previous command of this slot if its state has not been used yet */
+                if (auto pendingCmd = state.pendingCommands[slot])
+                {
+                    RemoveCommand(*pendingCmd, stats);
+                    anyRemoved = true;
+                }
+                state.pendingCommands[slot] = &cmd;
+            }
+
+            state.lastCommands[slot] = &cmd;
+        }
+
+        /* Commands that might use the overwritable states consume all pending commands */
+        if (!IsIndependentOfOverwritableStates(cmd.opcode))
+        {
+            for (auto& pendingCmd : state.pendingCommands)
+                pendingCmd = nullptr;
+        }
+
+        InvalidateStateSlots(state, cmd);
+    }
+
+    /* Remove commands from their pages in place (commands never move across pages) */
+    if (anyRemoved)
+        CompactCommandPages(arena.GetPages(), cmdRefs);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
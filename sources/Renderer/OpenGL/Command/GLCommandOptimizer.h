@@ -0,0 +1,43 @@
+/*
+ * GLCommandOptimizer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_OPTIMIZER_H
+#define LLGL_GL_COMMAND_OPTIMIZER_H
+
+
+#include "GLCommandOpcode.h"
+#include "GLCommandArena.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Statistics of the redundant state elimination for a single command buffer.
+struct GLCommandOptimizerStats
+{
+    // Total number of removed commands.
+    std::uint32_t numRemovedCommandsTotal = 0;
+};
+
+/*
+Removes redundant state commands from the command arena:
+- Commands that set the same state as the previous command of the same kind, with no other command in between that could have modified that state.
+- Commands whose state is overwritten by another command of the same kind before any draw, dispatch, or clear command can use it.
+*/
+void OptimizeGLCommandBuffer(GLCommandArena& arena, GLCommandOptimizerStats& stats);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -13,6 +13,7 @@
 #include "../RenderState/GLQueryHeap.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../CheckedCast.h"
+#include "../../ProfileCounters.h"
 #include "../../GLCommon/GLExtensionRegistry.h"
 #include <algorithm>
 
@@ -30,6 +31,8 @@ GLCommandQueue::GLCommandQueue(const std::shared_ptr<GLStateManager>& stateManag
 
 void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_PROFILE_COUNT(commandBufferSubmittions);
+
     /*
     Only deferred command buffers can be submitted multiple times (via GLDeferredCommandBuffer),
     otherwise the commands must be submitted immediately (via GLImmediateCommandBuffer).
@@ -182,6 +185,8 @@ bool GLCommandQueue::QueryResult(
 
 void GLCommandQueue::Submit(Fence& fence)
 {
+    LLGL_PROFILE_COUNT(fenceSubmissions);
+
     auto& fenceGL = LLGL_CAST(GLFence&, fence);
     fenceGL.Submit();
 }
@@ -14,6 +14,7 @@
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionLoader.h"
 #include "../../CheckedCast.h"
+#include "../../ProfileCounters.h"
 #include "../../StaticLimits.h"
 #include "../../../Core/Assertion.h"
 
@@ -48,7 +49,7 @@ namespace LLGL
 GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t reservedSize) :
     flags_ { flags }
 {
-    buffer_.reserve(reservedSize);
+    arena_.Reserve(reservedSize);
 }
 
 bool GLDeferredCommandBuffer::IsImmediateCmdBuffer() const
@@ -60,8 +61,19 @@ bool GLDeferredCommandBuffer::IsImmediateCmdBuffer() const
 
 void GLDeferredCommandBuffer::Begin()
 {
-    /* Reset internal command buffer */
-    buffer_.clear();
+    LLGL_PROFILE_COUNT(commandBufferEncodings);
+
+    /* Mark command buffer as being recorded, which invalidates all primary command buffers it has been stitched into */
+    recordGeneration_.fetch_or(1u, std::memory_order_acq_rel);
+
+    /* Reset internal command buffer and return its pages to the page pool */
+    arena_.Clear();
+    decodedCommands_.clear();
+    stitchedCmdBuffers_.clear();
+
+    #ifdef LLGL_GL_ENABLE_CMDBUFFER_OPTIMIZER
+    optimizerStats_ = {};
+    #endif // /LLGL_GL_ENABLE_CMDBUFFER_OPTIMIZER
     
     #ifdef LLGL_ENABLE_JIT_COMPILER
     
@@ -75,17 +87,45 @@ void GLDeferredCommandBuffer::Begin()
 
 void GLDeferredCommandBuffer::End()
 {
-    #ifdef LLGL_ENABLE_JIT_COMPILER
-    
-    /* Generate native assembly only if command buffer will be submitted multiple times */
+    /* Pre-decode or assemble commands only if command buffer will be submitted multiple times */
     if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
+    {
+        #ifdef LLGL_GL_ENABLE_CMDBUFFER_OPTIMIZER
+
+        /* Remove redundant state changes before the commands are pre-decoded or assembled */
+        OptimizeGLCommandBuffer(arena_, optimizerStats_);
+
+        /* Always count removed commands in the thread-local profile counters, so the debug layer can report them in builds without LLGL_ENABLE_PROFILE_COUNTERS */
+        IncrementProfileCounter(LLGL_PROFILE_COUNTER_INDEX(redundantStateEliminations), optimizerStats_.numRemovedCommandsTotal);
+
+        #endif // /LLGL_GL_ENABLE_CMDBUFFER_OPTIMIZER
+
+        #ifdef LLGL_ENABLE_JIT_COMPILER
+        
+        /* Generate native assembly */
         executable_ = AssembleGLDeferredCommandBuffer(*this);
-    
-    #endif // /LLGL_ENABLE_JIT_COMPILER
+        if (!executable_)
+        
+        #endif // /LLGL_ENABLE_JIT_COMPILER
+        {
+            /* Decode commands into list of direct handlers */
+            DecodeGLCommandBuffer(arena_, decodedCommands_);
+
+            /* Replace secondary command buffers by their pre-decoded commands */
+            if (IsPrimary())
+                StitchGLSecondaryCommandBuffers(decodedCommands_, stitchedCmdBuffers_);
+        }
+    }
+
+    /* Seal recording, so this command buffer can be stitched into primary command buffers on other threads */
+    const auto generation = recordGeneration_.load(std::memory_order_relaxed);
+    recordGeneration_.store((generation | 1u) + 1u, std::memory_order_release);
 }
 
 void GLDeferredCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferUpdates);
+
     auto cmd = AllocCommand<GLCmdUpdateBuffer>(GLOpcodeUpdateBuffer, dataSize);
     {
         cmd->buffer = LLGL_CAST(GLBuffer*, &dstBuffer);
@@ -97,6 +137,8 @@ void GLDeferredCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstO
 
 void GLDeferredCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
 {
+    LLGL_PROFILE_COUNT(bufferCopies);
+
     auto cmd = AllocCommand<GLCmdCopyBuffer>(GLOpcodeCopyBuffer);
     {
         cmd->writeBuffer    = LLGL_CAST(GLBuffer*, &dstBuffer);
@@ -162,7 +204,7 @@ void GLDeferredCommandBuffer::SetViewports(std::uint32_t numViewports, const Vie
     #endif // /LLGL_ENABLE_JIT_COMPILER
     
     /* Encode GL command */
-    auto cmd = AllocCommand<GLCmdViewportArray>(GLOpcodeViewportArray, sizeof(GLViewport)*numViewports);
+    auto cmd = AllocCommand<GLCmdViewportArray>(GLOpcodeViewportArray, (sizeof(GLViewport) + sizeof(GLDepthRange))*numViewports);
     {
         cmd->first = 0;
         cmd->count = static_cast<GLsizei>(numViewports);
@@ -263,12 +305,16 @@ void GLDeferredCommandBuffer::SetClearStencil(std::uint32_t stencil)
 
 void GLDeferredCommandBuffer::Clear(long flags)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     auto cmd = AllocCommand<GLCmdClear>(GLOpcodeClear);
     cmd->flags = flags;
 }
 
 void GLDeferredCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     auto cmd = AllocCommand<GLCmdClearBuffers>(GLOpcodeClearBuffers, sizeof(AttachmentClear)*numAttachments);
     {
         cmd->numAttachments = numAttachments;
@@ -280,6 +326,8 @@ void GLDeferredCommandBuffer::ClearAttachments(std::uint32_t numAttachments, con
 
 void GLDeferredCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     if ((buffer.GetBindFlags() & BindFlags::VertexBuffer) != 0)
     {
         auto& bufferWithVAO = LLGL_CAST(const GLBufferWithVAO&, buffer);
@@ -300,6 +348,8 @@ void GLDeferredCommandBuffer::SetVertexBuffer(Buffer& buffer)
 
 void GLDeferredCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     if ((bufferArray.GetBindFlags() & BindFlags::VertexBuffer) != 0)
     {
         auto& bufferArrayWithVAO = LLGL_CAST(const GLBufferArrayWithVAO&, bufferArray);
@@ -320,6 +370,8 @@ void GLDeferredCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     auto cmd = AllocCommand<GLCmdBindElementArrayBufferToVAO>(GLOpcodeBindElementArrayBufferToVAO);
     cmd->id = bufferGL.GetID();
@@ -328,6 +380,8 @@ void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer)
 
 void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     auto cmd = AllocCommand<GLCmdBindElementArrayBufferToVAO>(GLOpcodeBindElementArrayBufferToVAO);
     cmd->id = bufferGL.GetID();
@@ -338,11 +392,15 @@ void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format
 
 void GLDeferredCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     SetGenericBuffer(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, buffer, 0);
 }
 
 void GLDeferredCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     SetGenericBufferArray(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, bufferArray, 0);
 }
 
@@ -358,6 +416,8 @@ static void ErrTransformFeedbackNotSupported(const char* funcName)
 
 void GLDeferredCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    LLGL_PROFILE_COUNT(streamOutputSections);
+
     #ifdef __APPLE__
     auto cmd = AllocCommand<GLCmdBeginTransformFeedback>(GLOpcodeBeginTransformFeedback);
     cmd->primitiveMove = GLTypes::Map(primitiveType);
@@ -395,11 +455,15 @@ void GLDeferredCommandBuffer::EndStreamOutput()
 
 void GLDeferredCommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*startSlot*/)
 {
+    LLGL_PROFILE_COUNT(graphicsResourceHeapBindings);
+
     SetResourceHeap(resourceHeap);
 }
 
 void GLDeferredCommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*startSlot*/)
 {
+    LLGL_PROFILE_COUNT(computeResourceHeapBindings);
+
     SetResourceHeap(resourceHeap);
 }
 
@@ -411,6 +475,8 @@ void GLDeferredCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    LLGL_PROFILE_COUNT(renderPassSections);
+
     auto cmd = AllocCommand<GLCmdBindRenderPass>(GLOpcodeBindRenderPass, sizeof(ClearValue)*numClearValues);
     {
         cmd->renderTarget       = &renderTarget;
@@ -430,6 +496,8 @@ void GLDeferredCommandBuffer::EndRenderPass()
 
 void GLDeferredCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_PROFILE_COUNT(graphicsPipelineBindings);
+
     auto cmd = AllocCommand<GLCmdBindGraphicsPipeline>(GLOpcodeBindGraphicsPipeline);
     cmd->graphicsPipeline = LLGL_CAST(GLGraphicsPipeline*, &graphicsPipeline);
     renderState_.drawMode = cmd->graphicsPipeline->GetDrawMode();
@@ -437,6 +505,8 @@ void GLDeferredCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipe
 
 void GLDeferredCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_PROFILE_COUNT(computePipelineBindings);
+
     auto cmd = AllocCommand<GLCmdBindComputePipeline>(GLOpcodeBindComputePipeline);
     cmd->computePipeline = LLGL_CAST(GLComputePipeline*, &computePipeline);
 }
@@ -445,6 +515,8 @@ void GLDeferredCommandBuffer::SetComputePipeline(ComputePipeline& computePipelin
 
 void GLDeferredCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_PROFILE_COUNT(querySections);
+
     auto cmd = AllocCommand<GLCmdBeginQuery>(GLOpcodeBeginQuery);
     {
         cmd->queryHeap  = LLGL_CAST(GLQueryHeap*, &queryHeap);
@@ -463,6 +535,8 @@ void GLDeferredCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query
 
 void GLDeferredCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_PROFILE_COUNT(renderConditionSections);
+
     auto cmd = AllocCommand<GLCmdBeginConditionalRender>(GLOpcodeBeginConditionalRender);
     {
         cmd->id     = LLGL_CAST(const GLQueryHeap&, queryHeap).GetFirstID(query);
@@ -485,6 +559,8 @@ The indices actually store the index start offset, but must be passed to GL as a
 
 void GLDeferredCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto cmd = AllocCommand<GLCmdDrawArrays>(GLOpcodeDrawArrays);
     {
         cmd->mode   = renderState_.drawMode;
@@ -495,6 +571,8 @@ void GLDeferredCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firs
 
 void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     auto cmd = AllocCommand<GLCmdDrawElements>(GLOpcodeDrawElements);
     {
@@ -507,6 +585,8 @@ void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_
 
 void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     auto cmd = AllocCommand<GLCmdDrawElementsBaseVertex>(GLOpcodeDrawElementsBaseVertex);
     {
@@ -520,6 +600,8 @@ void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_
 
 void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto cmd = AllocCommand<GLCmdDrawArraysInstanced>(GLOpcodeDrawArraysInstanced);
     {
         cmd->mode           = renderState_.drawMode;
@@ -531,6 +613,8 @@ void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint
 
 void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     #ifndef __APPLE__
     auto cmd = AllocCommand<GLCmdDrawArraysInstancedBaseInstance>(GLOpcodeDrawArraysInstancedBaseInstance);
     {
@@ -547,6 +631,8 @@ void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     auto cmd = AllocCommand<GLCmdDrawElementsInstanced>(GLOpcodeDrawElementsInstanced);
     {
@@ -560,6 +646,8 @@ void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     auto cmd = AllocCommand<GLCmdDrawElementsInstancedBaseVertex>(GLOpcodeDrawElementsInstancedBaseVertex);
     {
@@ -574,6 +662,8 @@ void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     #ifndef __APPLE__
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     auto cmd = AllocCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
@@ -593,6 +683,8 @@ void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std
 
 void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto cmd = AllocCommand<GLCmdDrawArraysIndirect>(GLOpcodeDrawArraysIndirect);
     {
         cmd->id             = LLGL_CAST(GLBuffer&, buffer).GetID();
@@ -605,6 +697,8 @@ void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 
 void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     #ifndef __APPLE__
     if (HasExtension(GLExt::ARB_multi_draw_indirect))
     {
@@ -634,6 +728,8 @@ void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset,
 
 void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto cmd = AllocCommand<GLCmdDrawElementsIndirect>(GLOpcodeDrawElementsIndirect);
     {
         cmd->id             = LLGL_CAST(GLBuffer&, buffer).GetID();
@@ -647,6 +743,8 @@ void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
 
 void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     #ifndef __APPLE__
     if (HasExtension(GLExt::ARB_multi_draw_indirect))
     {
@@ -680,6 +778,8 @@ void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
 
 void GLDeferredCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     #ifndef __APPLE__
     auto cmd = AllocCommand<GLCmdDispatchCompute>(GLOpcodeDispatchCompute);
     {
@@ -694,6 +794,8 @@ void GLDeferredCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32
 
 void GLDeferredCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     #ifndef __APPLE__
     auto cmd = AllocCommand<GLCmdDispatchComputeIndirect>(GLOpcodeDispatchComputeIndirect);
     {
@@ -721,21 +823,29 @@ void GLDeferredCommandBuffer::PopDebugGroup()
 
 void GLDeferredCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(constantBufferBindings);
+
     SetGenericBuffer(GLBufferTarget::UNIFORM_BUFFER, buffer, slot);
 }
 
 void GLDeferredCommandBuffer::SetSampleBuffer(Buffer& buffer, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(sampleBufferBindings);
+
     SetGenericBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, buffer, slot);
 }
 
 void GLDeferredCommandBuffer::SetRWStorageBuffer(Buffer& buffer, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(rwStorageBufferBindings);
+
     SetGenericBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, buffer, slot);
 }
 
 void GLDeferredCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(textureBindings);
+
     auto cmd = AllocCommand<GLCmdBindTexture>(GLOpcodeBindTexture);
     {
         cmd->slot       = slot;
@@ -745,6 +855,8 @@ void GLDeferredCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, l
 
 void GLDeferredCommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(samplerBindings);
+
     auto& samplerGL = LLGL_CAST(GLSampler&, sampler);
     auto cmd = AllocCommand<GLCmdBindSampler>(GLOpcodeBindSampler);
     {
@@ -849,19 +961,20 @@ void GLDeferredCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap)
 
 void GLDeferredCommandBuffer::AllocOpCode(const GLOpcode opcode)
 {
-    buffer_.push_back(opcode);
+    *arena_.Alloc(sizeof(opcode)) = opcode;
 }
 
 template <typename T>
 T* GLDeferredCommandBuffer::AllocCommand(const GLOpcode opcode, std::size_t extraSize)
 {
-    /* Resize internal buffer for opcode, command structure, and extra size */
-    auto offset = buffer_.size();
+    /* Allocate zero-initialized memory for opcode, command structure, and extra size (never moved afterwards) */
+    const auto size = sizeof(opcode) + sizeof(T) + extraSize;
+    auto ptr = arena_.Alloc(size);
     {
-        buffer_.resize(offset + sizeof(opcode) + sizeof(T) + extraSize);
-        buffer_[offset] = opcode;
+        ::memset(ptr, 0, size);
+        *ptr = opcode;
     }
-    return reinterpret_cast<T*>(&(buffer_[offset + sizeof(opcode)]));
+    return reinterpret_cast<T*>(ptr + sizeof(opcode));
 }
 
 
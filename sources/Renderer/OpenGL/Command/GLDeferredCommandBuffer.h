@@ -11,15 +11,22 @@
 
 #include "GLCommandBuffer.h"
 #include "GLCommandOpcode.h"
+#include "GLCommandExecutor.h"
+#include "GLCommandArena.h"
 #include "../RenderState/GLState.h"
 #include "../OpenGL.h"
 #include <memory>
 #include <vector>
+#include <atomic>
 
 #ifdef LLGL_ENABLE_JIT_COMPILER
 #   include "../../../JIT/JITProgram.h"
 #endif
 
+#ifdef LLGL_GL_ENABLE_CMDBUFFER_OPTIMIZER
+#   include "GLCommandOptimizer.h"
+#endif
+
 
 namespace LLGL
 {
@@ -30,6 +37,12 @@ class GLRenderContext;
 class GLStateManager;
 class GLRenderPass;
 
+/*
+Command buffer that records GL commands for later execution.
+Secondary command buffers (see CommandBufferFlags::DeferredSubmit) can be recorded on multiple threads simultaneously, one thread per command buffer,
+since each command buffer allocates its pages from the page pool of the recording thread (see GLCommandArena).
+Once they have been recorded, a primary command buffer with the MultiSubmit flag stitches their pre-decoded commands by reference (see StitchGLSecondaryCommandBuffers).
+*/
 class GLDeferredCommandBuffer final : public GLCommandBuffer
 {
 
@@ -168,10 +181,10 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         // Returns true if this is a primary command buffer.
         bool IsPrimary() const;
 
-        // Returns the internal command buffer as raw byte buffer.
-        inline const std::vector<std::uint8_t>& GetRawBuffer() const
+        // Returns the internal command arena that stores the recorded commands in pages.
+        inline const GLCommandArena& GetCommandArena() const
         {
-            return buffer_;
+            return arena_;
         }
     
         // Returns the flags this command buffer was created with (see CommandBufferDescriptor::flags).
@@ -180,6 +193,27 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
             return flags_;
         }
 
+        // Returns the pre-decoded commands for fast replay, or an empty list if not available (see CommandBufferFlags::MultiSubmit).
+        inline const std::vector<GLDecodedCommand>& GetDecodedCommands() const
+        {
+            return decodedCommands_;
+        }
+
+        // Returns the secondary command buffers whose pre-decoded commands have been stitched into this command buffer.
+        inline const std::vector<GLStitchedCommandBuffer>& GetStitchedCommandBuffers() const
+        {
+            return stitchedCmdBuffers_;
+        }
+
+        /*
+        Returns the generation of the current recording. This is odd while the command buffer is being recorded, and even once it has been ended.
+        The generation is published with release semantics, so a command buffer with an even generation can be stitched without any lock.
+        */
+        inline std::uint32_t GetRecordGeneration() const
+        {
+            return recordGeneration_.load(std::memory_order_acquire);
+        }
+
         #ifdef LLGL_ENABLE_JIT_COMPILER
     
         // Returns the just-in-time compiled command buffer that can be executed natively, or null if not available.
@@ -217,16 +251,23 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
 
     private:
 
-        GLRenderState               renderState_;
-        GLClearValue                clearValue_;
+        GLRenderState                           renderState_;
+        GLClearValue                            clearValue_;
+
+        long                                    flags_              = 0;
+        GLCommandArena                          arena_;
+        std::vector<GLDecodedCommand>           decodedCommands_;
+        std::vector<GLStitchedCommandBuffer>    stitchedCmdBuffers_;
+        std::atomic<std::uint32_t>              recordGeneration_   { 0 };
 
-        long                        flags_              = 0;
-        std::vector<std::uint8_t>   buffer_;
+        #ifdef LLGL_GL_ENABLE_CMDBUFFER_OPTIMIZER
+        GLCommandOptimizerStats                 optimizerStats_;
+        #endif // /LLGL_GL_ENABLE_CMDBUFFER_OPTIMIZER
     
         #ifdef LLGL_ENABLE_JIT_COMPILER
-        std::unique_ptr<JITProgram> executable_;
-        std::uint32_t               maxNumViewports_    = 0;
-        std::uint32_t               maxNumScissors_     = 0;
+        std::unique_ptr<JITProgram>             executable_;
+        std::uint32_t                           maxNumViewports_    = 0;
+        std::uint32_t                           maxNumScissors_     = 0;
         #endif // /LLGL_ENABLE_JIT_COMPILER
 
 };
@@ -15,6 +15,7 @@
 #include "../../GLCommon/GLTypes.h"
 #include "../../GLCommon/GLCore.h"
 #include "../../CheckedCast.h"
+#include "../../ProfileCounters.h"
 #include "../../StaticLimits.h"
 #include "../../../Core/Assertion.h"
 
@@ -53,6 +54,8 @@ bool GLImmediateCommandBuffer::IsImmediateCmdBuffer() const
 
 void GLImmediateCommandBuffer::Begin()
 {
+    LLGL_PROFILE_COUNT(commandBufferEncodings);
+
     // dummy
 }
 
@@ -63,12 +66,16 @@ void GLImmediateCommandBuffer::End()
 
 void GLImmediateCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferUpdates);
+
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     dstBufferGL.BufferSubData(static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(dataSize), data);
 }
 
 void GLImmediateCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
 {
+    LLGL_PROFILE_COUNT(bufferCopies);
+
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     auto& srcBufferGL = LLGL_CAST(GLBuffer&, srcBuffer);
     dstBufferGL.CopyBufferSubData(
@@ -197,11 +204,15 @@ void GLImmediateCommandBuffer::SetClearStencil(std::uint32_t stencil)
 
 void GLImmediateCommandBuffer::Clear(long flags)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     stateMngr_->Clear(flags);
 }
 
 void GLImmediateCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     stateMngr_->ClearBuffers(numAttachments, attachments);
 }
 
@@ -209,6 +220,8 @@ void GLImmediateCommandBuffer::ClearAttachments(std::uint32_t numAttachments, co
 
 void GLImmediateCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     if ((buffer.GetBindFlags() & BindFlags::VertexBuffer) != 0)
     {
         /* Bind vertex buffer */
@@ -231,6 +244,8 @@ void GLImmediateCommandBuffer::SetVertexBuffer(Buffer& buffer)
 
 void GLImmediateCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     if ((bufferArray.GetBindFlags() & BindFlags::VertexBuffer) != 0)
     {
         /* Bind vertex buffer */
@@ -253,6 +268,8 @@ void GLImmediateCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     /* Bind index buffer deferred (can only be bound to the active VAO) */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindElementArrayBufferToVAO(bufferGL.GetID());
@@ -261,6 +278,8 @@ void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer)
 
 void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     /* Bind index buffer deferred (can only be bound to the active VAO) */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindElementArrayBufferToVAO(bufferGL.GetID());
@@ -271,11 +290,15 @@ void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format forma
 
 void GLImmediateCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     SetGenericBuffer(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, buffer, 0);
 }
 
 void GLImmediateCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     SetGenericBufferArray(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, bufferArray, 0);
 }
 
@@ -291,6 +314,8 @@ static void ErrTransformFeedbackNotSupported(const char* funcName)
 
 void GLImmediateCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    LLGL_PROFILE_COUNT(streamOutputSections);
+
     #ifdef __APPLE__
     glBeginTransformFeedback(GLTypes::Map(primitiveType));
     #else
@@ -321,11 +346,15 @@ void GLImmediateCommandBuffer::EndStreamOutput()
 
 void GLImmediateCommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*startSlot*/)
 {
+    LLGL_PROFILE_COUNT(graphicsResourceHeapBindings);
+
     SetResourceHeap(resourceHeap);
 }
 
 void GLImmediateCommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t /*startSlot*/)
 {
+    LLGL_PROFILE_COUNT(computeResourceHeapBindings);
+
     SetResourceHeap(resourceHeap);
 }
 
@@ -337,6 +366,8 @@ void GLImmediateCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    LLGL_PROFILE_COUNT(renderPassSections);
+
     stateMngr_->BindRenderPass(renderTarget, renderPass, numClearValues, clearValues, clearValue_);
 }
 
@@ -349,6 +380,8 @@ void GLImmediateCommandBuffer::EndRenderPass()
 
 void GLImmediateCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_PROFILE_COUNT(graphicsPipelineBindings);
+
     /* Bind graphics pipeline render states */
     auto& graphicsPipelineGL = LLGL_CAST(GLGraphicsPipeline&, graphicsPipeline);
     graphicsPipelineGL.Bind(*stateMngr_);
@@ -359,6 +392,8 @@ void GLImmediateCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPip
 
 void GLImmediateCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_PROFILE_COUNT(computePipelineBindings);
+
     auto& computePipelineGL = LLGL_CAST(GLComputePipeline&, computePipeline);
     computePipelineGL.Bind(*stateMngr_);
 }
@@ -367,6 +402,8 @@ void GLImmediateCommandBuffer::SetComputePipeline(ComputePipeline& computePipeli
 
 void GLImmediateCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_PROFILE_COUNT(querySections);
+
     /* Begin query with internal target */
     auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
     queryHeapGL.Begin(query);
@@ -381,6 +418,8 @@ void GLImmediateCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t quer
 
 void GLImmediateCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_PROFILE_COUNT(renderConditionSections);
+
     auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
     glBeginConditionalRender(queryHeapGL.GetFirstID(query), GLTypes::Map(mode));
 }
@@ -400,6 +439,8 @@ The indices actually store the index start offset, but must be passed to GL as a
 
 void GLImmediateCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     glDrawArrays(
         renderState_.drawMode,
         static_cast<GLint>(firstVertex),
@@ -409,6 +450,8 @@ void GLImmediateCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t fir
 
 void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElements(
         renderState_.drawMode,
@@ -420,6 +463,8 @@ void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32
 
 void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElementsBaseVertex(
         renderState_.drawMode,
@@ -432,6 +477,8 @@ void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32
 
 void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     glDrawArraysInstanced(
         renderState_.drawMode,
         static_cast<GLint>(firstVertex),
@@ -442,6 +489,8 @@ void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uin
 
 void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     #ifndef __APPLE__
     glDrawArraysInstancedBaseInstance(
         renderState_.drawMode,
@@ -457,6 +506,8 @@ void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uin
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElementsInstanced(
         renderState_.drawMode,
@@ -469,6 +520,8 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElementsInstancedBaseVertex(
         renderState_.drawMode,
@@ -482,6 +535,8 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     #ifndef __APPLE__
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElementsInstancedBaseVertexBaseInstance(
@@ -500,6 +555,8 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
 
@@ -512,6 +569,8 @@ void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset
 
 void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     /* Bind indirect argument buffer */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
@@ -545,6 +604,8 @@ void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset
 
 void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
 
@@ -558,6 +619,8 @@ void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
 
 void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     /* Bind indirect argument buffer */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
@@ -595,6 +658,8 @@ void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
 
 void GLImmediateCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     #ifndef __APPLE__
     glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
     #else
@@ -604,6 +669,8 @@ void GLImmediateCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint3
 
 void GLImmediateCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     #ifndef __APPLE__
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DISPATCH_INDIRECT_BUFFER, bufferGL.GetID());
@@ -629,21 +696,29 @@ void GLImmediateCommandBuffer::PopDebugGroup()
 
 void GLImmediateCommandBuffer::SetConstantBuffer(Buffer& buffer, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(constantBufferBindings);
+
     SetGenericBuffer(GLBufferTarget::UNIFORM_BUFFER, buffer, slot);
 }
 
 void GLImmediateCommandBuffer::SetSampleBuffer(Buffer& buffer, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(sampleBufferBindings);
+
     SetGenericBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, buffer, slot);
 }
 
 void GLImmediateCommandBuffer::SetRWStorageBuffer(Buffer& buffer, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(rwStorageBufferBindings);
+
     SetGenericBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, buffer, slot);
 }
 
 void GLImmediateCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(textureBindings);
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     stateMngr_->ActiveTexture(slot);
     stateMngr_->BindGLTexture(textureGL);
@@ -651,6 +726,8 @@ void GLImmediateCommandBuffer::SetTexture(Texture& texture, std::uint32_t slot,
 
 void GLImmediateCommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long /*stageFlags*/)
 {
+    LLGL_PROFILE_COUNT(samplerBindings);
+
     auto& samplerGL = LLGL_CAST(GLSampler&, sampler);
     stateMngr_->BindSampler(slot, samplerGL.GetID());
 }
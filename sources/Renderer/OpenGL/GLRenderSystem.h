@@ -22,6 +22,7 @@
 
 #include "Shader/GLShader.h"
 #include "Shader/GLShaderProgram.h"
+#include "Shader/GLProgramBinaryCache.h"
 
 #include "Texture/GLTexture.h"
 #include "Texture/GLSampler.h"
@@ -55,11 +56,13 @@ class GLRenderSystem final : public RenderSystem
 
         /* ----- Common ----- */
 
-        GLRenderSystem() = default;
+        GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~GLRenderSystem();
 
         void SetConfiguration(const RenderSystemConfiguration& config) override;
 
+        bool QueryPipelineCache(std::vector<char>& data) override;
+
         /* ----- Render Context ----- */
 
         RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
@@ -182,6 +185,9 @@ class GLRenderSystem final : public RenderSystem
         void GenerateSubMipsWithFBO(GLTexture& textureGL, const Extent3D& extent, GLint baseMipLevel, GLint numMipLevels, GLint baseArrayLayer, GLint numArrayLayers);
         void GenerateSubMipsWithTextureView(GLTexture& textureGL, GLuint baseMipLevel, GLuint numMipLevels, GLuint baseArrayLayer, GLuint numArrayLayers);
 
+        void CreateProgramBinaryCache(const OpenGLRendererConfiguration& rendererConfigGL);
+        void StoreProgramBinaryCache();
+
     private:
     
         #ifdef LLGL_ENABLE_CUSTOM_SUB_MIPGEN
@@ -220,6 +226,9 @@ class GLRenderSystem final : public RenderSystem
 
         DebugCallback                           debugCallback_;
 
+        std::unique_ptr<GLProgramBinaryCache>   programBinaryCache_;
+        std::string                             programBinaryCacheFilename_;
+
         #ifdef LLGL_ENABLE_CUSTOM_SUB_MIPGEN
         MipGenerationFBOPair                    mipGenerationFBOPair_;
         #endif // /LLGL_ENABLE_CUSTOM_SUB_MIPGEN
@@ -8,6 +8,7 @@
 #include "GLRenderSystem.h"
 #include "Ext/GLExtensions.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../../Core/Helper.h"
 #include "../GLCommon/GLTypes.h"
 #include "Buffer/GLBufferWithVAO.h"
@@ -124,12 +125,16 @@ void GLRenderSystem::Release(BufferArray& bufferArray)
 
 void GLRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferWrites);
+
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     dstBufferGL.BufferSubData(static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(dataSize), data);
 }
 
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    LLGL_PROFILE_COUNT(bufferMappings);
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     return bufferGL.MapBuffer(GLTypes::Map(access));
 }
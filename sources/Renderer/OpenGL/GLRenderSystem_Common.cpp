@@ -17,6 +17,8 @@
 #include "GLRenderingCaps.h"
 #include "Command/GLImmediateCommandBuffer.h"
 #include "Command/GLDeferredCommandBuffer.h"
+#include <fstream>
+#include <iterator>
 
 
 namespace LLGL
@@ -25,8 +27,26 @@ namespace LLGL
 
 /* ----- Common ----- */
 
+GLRenderSystem::GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
+{
+    /* Extract optional renderer configuartion */
+    if (renderSystemDesc.rendererConfig != nullptr && renderSystemDesc.rendererConfigSize > 0)
+    {
+        if (renderSystemDesc.rendererConfigSize == sizeof(OpenGLRendererConfiguration))
+        {
+            auto rendererConfigGL = reinterpret_cast<const OpenGLRendererConfiguration*>(renderSystemDesc.rendererConfig);
+            if (rendererConfigGL->programBinaryCache)
+                CreateProgramBinaryCache(*rendererConfigGL);
+        }
+        else
+            throw std::invalid_argument("invalid renderer configuration structure (expected size of 'OpenGLRendererConfiguration' structure)");
+    }
+}
+
 GLRenderSystem::~GLRenderSystem()
 {
+    StoreProgramBinaryCache();
+
     /* Clear all render state containers first, the rest will be deleted automatically */
     GLStatePool::Instance().Clear();
 }
@@ -37,6 +57,16 @@ void GLRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
     GLTexImageInitialization(config.imageInitialization);
 }
 
+bool GLRenderSystem::QueryPipelineCache(std::vector<char>& data)
+{
+    if (programBinaryCache_)
+    {
+        programBinaryCache_->GetData(data);
+        return true;
+    }
+    return RenderSystem::QueryPipelineCache(data);
+}
+
 /* ----- Render Context ----- */
 
 // private
@@ -192,7 +222,7 @@ Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& desc)
 ShaderProgram* GLRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
 {
     AssertCreateShaderProgram(desc);
-    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(desc));
+    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(desc, programBinaryCache_.get()));
 }
 
 void GLRenderSystem::Release(Shader& shader)
@@ -357,6 +387,50 @@ void GLRenderSystem::SetDebugCallback(const DebugCallback& debugCallback)
     #endif
 }
 
+void GLRenderSystem::CreateProgramBinaryCache(const OpenGLRendererConfiguration& rendererConfigGL)
+{
+    programBinaryCacheFilename_ = rendererConfigGL.programBinaryCacheFilename;
+
+    if (rendererConfigGL.programBinaryCacheData != nullptr)
+    {
+        /* Use initial data from renderer configuration */
+        programBinaryCache_ = MakeUnique<GLProgramBinaryCache>(
+            rendererConfigGL.programBinaryCacheData,
+            rendererConfigGL.programBinaryCacheDataSize
+        );
+    }
+    else if (!programBinaryCacheFilename_.empty())
+    {
+        /* Read initial data from file, if it exists */
+        std::vector<char> fileBuffer;
+
+        std::ifstream file { programBinaryCacheFilename_, std::ios_base::binary };
+        if (file.good())
+            fileBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        programBinaryCache_ = MakeUnique<GLProgramBinaryCache>(fileBuffer.data(), fileBuffer.size());
+    }
+    else
+        programBinaryCache_ = MakeUnique<GLProgramBinaryCache>();
+}
+
+void GLRenderSystem::StoreProgramBinaryCache()
+{
+    if (!programBinaryCache_ || programBinaryCacheFilename_.empty())
+        return;
+
+    /* Write program binary cache data to file */
+    std::vector<char> data;
+    programBinaryCache_->GetData(data);
+
+    if (!data.empty())
+    {
+        std::ofstream file { programBinaryCacheFilename_, std::ios_base::binary };
+        if (file.good())
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+}
+
 static std::string GLGetString(GLenum name)
 {
     auto bytes = glGetString(name);
@@ -11,6 +11,7 @@
 #include "../GLCommon/Texture/GLTexSubImage.h"
 #include "Ext/GLExtensions.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
 
@@ -93,6 +94,10 @@ Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
             break;
     }
 
+    /* Upload remaining MIP-map levels of initial MIP-map chain */
+    if (imageDesc != nullptr && (textureDesc.miscFlags & MiscFlags::InitialMipChain) != 0 && IsMipMappedTexture(textureDesc))
+        GLTexImageMipChain(textureDesc, *imageDesc);
+
     return TakeOwnership(textures_, std::move(texture));
 }
 
@@ -105,6 +110,8 @@ void GLRenderSystem::Release(Texture& texture)
 
 void GLRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_PROFILE_COUNT(textureWrites);
+
     /* Bind texture and write texture sub data */
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     GLStateManager::active->BindGLTexture(textureGL);
@@ -186,12 +193,16 @@ void GLRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel,
 
 void GLRenderSystem::GenerateMips(Texture& texture)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     GenerateMipsPrimary(textureGL.GetID(), textureGL.GetType());
 }
 
 void GLRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     if (numMipLevels > 0 && numArrayLayers > 0)
     {
         #ifdef LLGL_ENABLE_CUSTOM_SUB_MIPGEN
@@ -81,6 +81,12 @@ void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
     /* Bind shader program and discard rasterizer if there is no fragment shader */
     stateMngr.BindShaderProgram(shaderProgram_->GetID());
 
+    /* Bind remaining states */
+    BindRenderStates(stateMngr);
+}
+
+void GLGraphicsPipeline::BindRenderStates(GLStateManager& stateMngr)
+{
     /* Set input-assembler state */
     if (patchVertices_ > 0)
         stateMngr.SetPatchVertices(patchVertices_);
@@ -38,12 +38,27 @@ class GLGraphicsPipeline final : public GraphicsPipeline
         // Binds this graphics pipeline state with the specified GL state manager.
         void Bind(GLStateManager& stateMngr);
 
+        // Binds all states of this graphics pipeline except the shader program.
+        void BindRenderStates(GLStateManager& stateMngr);
+
+        // Returns the shader program of this graphics pipeline.
+        inline const GLShaderProgram* GetShaderProgram() const
+        {
+            return shaderProgram_;
+        }
+
         // Returns the GL mode for drawing commands (GL_TRIANGLES, GL_TRIANGLE_STRIP, etc.).
         inline GLenum GetDrawMode() const
         {
             return drawMode_;
         }
 
+        // Returns true if this graphics pipeline sets static viewports or scissors when it is bound.
+        inline bool HasStaticViewportsOrScissors() const
+        {
+            return (staticStateBuffer_ != nullptr);
+        }
+
     private:
 
         void BuildStaticStateBuffer(const GraphicsPipelineDescriptor& desc);
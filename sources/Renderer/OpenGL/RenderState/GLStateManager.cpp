@@ -1220,6 +1220,29 @@ void GLStateManager::ClearBuffers(std::uint32_t numAttachments, const Attachment
         PopColorMask();
 }
 
+#ifdef LLGL_ENABLE_JIT_COMPILER
+
+/* ----- JIT compiler ----- */
+
+// Returns the byte offset of the specified member within the state manager
+static std::int32_t GetMemberOffset(const GLStateManager* stateMngr, const void* member)
+{
+    return static_cast<std::int32_t>(reinterpret_cast<const char*>(member) - reinterpret_cast<const char*>(stateMngr));
+}
+
+GLStateManager::JITStateOffsets GLStateManager::GetJITStateOffsets() const
+{
+    JITStateOffsets offsets;
+    {
+        offsets.boundBuffers        = GetMemberOffset(this, bufferState_.boundBuffers.data());
+        offsets.boundVertexArray    = GetMemberOffset(this, &(vertexArrayState_.boundVertexArray));
+        offsets.boundProgram        = GetMemberOffset(this, &(shaderState_.boundProgram));
+    }
+    return offsets;
+}
+
+#endif // /LLGL_ENABLE_JIT_COMPILER
+
 
 /*
  * ======= Private: =======
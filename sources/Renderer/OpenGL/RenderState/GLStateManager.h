@@ -228,6 +228,23 @@ class GLStateManager
         void Clear(long flags);
         void ClearBuffers(std::uint32_t numAttachments, const AttachmentClear* attachments);
 
+        #ifdef LLGL_ENABLE_JIT_COMPILER
+
+        /* ----- JIT compiler ----- */
+
+        // Byte offsets of cached states within a state manager, which are compared inline by the GL command assembler.
+        struct JITStateOffsets
+        {
+            std::int32_t boundBuffers;      // Offset of the bound buffer for each GLBufferTarget (array of GLuint).
+            std::int32_t boundVertexArray;  // Offset of the bound vertex array object (GLuint).
+            std::int32_t boundProgram;      // Offset of the bound shader program (GLuint).
+        };
+
+        // Returns the byte offsets of the cached states. These offsets are equal for all state manager instances.
+        JITStateOffsets GetJITStateOffsets() const;
+
+        #endif // /LLGL_ENABLE_JIT_COMPILER
+
     private:
 
         void AdjustViewport(GLViewport& viewport);
@@ -0,0 +1,282 @@
+/*
+ * GLProgramBinaryCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLProgramBinaryCache.h"
+#include "GLShader.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionLoader.h"
+#include "../../CheckedCast.h"
+#include <LLGL/ShaderProgramFlags.h>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Magic number and version of the serialized cache data
+static const std::uint32_t g_cacheMagic     = 0x4250474C; // "LGPB"
+static const std::uint32_t g_cacheVersion   = 1;
+
+template <typename T>
+static void WriteValue(std::vector<char>& data, const T& value)
+{
+    const auto bytes = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+static bool ReadValue(const std::vector<char>& data, std::size_t& offset, T& value)
+{
+    if (offset + sizeof(T) > data.size())
+        return false;
+    ::memcpy(&value, &data[offset], sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+static std::uint64_t HashString(const GLubyte* str, std::uint64_t hash)
+{
+    if (str != nullptr)
+    {
+        auto s = reinterpret_cast<const char*>(str);
+        hash = GLProgramBinaryCache::HashData(s, std::strlen(s) + 1, hash);
+    }
+    return hash;
+}
+
+
+/* ----- GLProgramBinaryCache class ----- */
+
+GLProgramBinaryCache::GLProgramBinaryCache(const void* initialData, std::size_t initialDataSize)
+{
+    if (initialData != nullptr && initialDataSize > 0)
+    {
+        auto bytes = reinterpret_cast<const char*>(initialData);
+        initialData_.assign(bytes, bytes + initialDataSize);
+    }
+}
+
+bool GLProgramBinaryCache::IsSupported()
+{
+    Initialize();
+    return supported_;
+}
+
+std::uint64_t GLProgramBinaryCache::MakeKey(const ShaderProgramDescriptor& desc)
+{
+    Initialize();
+
+    /* Hash driver identity and all shaders with their pipeline stages */
+    auto key = driverHash_;
+
+    const Shader* shaders[] =
+    {
+        desc.vertexShader,
+        desc.tessControlShader,
+        desc.tessEvaluationShader,
+        desc.geometryShader,
+        desc.fragmentShader,
+        desc.computeShader,
+    };
+
+    for (std::uint32_t i = 0; i < sizeof(shaders)/sizeof(shaders[0]); ++i)
+    {
+        if (shaders[i] != nullptr)
+        {
+            auto shaderGL = LLGL_CAST(const GLShader*, shaders[i]);
+            auto sourceHash = shaderGL->GetSourceHash();
+            key = HashData(&i, sizeof(i), key);
+            key = HashData(&sourceHash, sizeof(sourceHash), key);
+        }
+    }
+
+    /* Hash vertex attributes in the order their locations are bound (see GLShaderProgram::BuildInputLayout) */
+    for (const auto& vertexFormat : desc.vertexFormats)
+    {
+        for (const auto& attrib : vertexFormat.attributes)
+        {
+            key = HashData(attrib.name.c_str(), attrib.name.size() + 1, key);
+            key = HashData(&(attrib.semanticIndex), sizeof(attrib.semanticIndex), key);
+        }
+    }
+
+    return key;
+}
+
+bool GLProgramBinaryCache::LoadProgram(GLuint program, std::uint64_t key)
+{
+    #ifdef GL_ARB_get_program_binary
+    if (IsSupported())
+    {
+        auto it = entries_.find(key);
+        if (it != entries_.end())
+        {
+            /* Load program binary, and drop the entry if the driver rejects it */
+            const auto& entry = it->second;
+            glProgramBinary(program, entry.format, entry.data.data(), static_cast<GLsizei>(entry.data.size()));
+
+            GLint status = 0;
+            glGetProgramiv(program, GL_LINK_STATUS, &status);
+            if (status != GL_FALSE)
+                return true;
+
+            entries_.erase(it);
+        }
+    }
+    #endif // /GL_ARB_get_program_binary
+    return false;
+}
+
+void GLProgramBinaryCache::StoreProgram(GLuint program, std::uint64_t key)
+{
+    #ifdef GL_ARB_get_program_binary
+    if (IsSupported())
+    {
+        /* Query program binary length */
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        /* Retrieve program binary */
+        Entry entry;
+        entry.format = 0;
+        entry.data.resize(static_cast<std::size_t>(length));
+
+        GLsizei bytesWritten = 0;
+        glGetProgramBinary(program, length, &bytesWritten, &(entry.format), entry.data.data());
+        if (bytesWritten <= 0)
+            return;
+
+        entry.data.resize(static_cast<std::size_t>(bytesWritten));
+        entries_[key] = std::move(entry);
+    }
+    #endif // /GL_ARB_get_program_binary
+}
+
+void GLProgramBinaryCache::GetData(std::vector<char>& data) const
+{
+    /* Keep initial data as is, if the cache has never been used */
+    if (!initialized_)
+    {
+        data = initialData_;
+        return;
+    }
+
+    data.clear();
+
+    /* Write header */
+    WriteValue(data, g_cacheMagic);
+    WriteValue(data, g_cacheVersion);
+    WriteValue(data, driverHash_);
+    WriteValue(data, static_cast<std::uint32_t>(entries_.size()));
+
+    /* Write entries */
+    for (const auto& it : entries_)
+    {
+        WriteValue(data, it.first);
+        WriteValue(data, static_cast<std::uint32_t>(it.second.format));
+        WriteValue(data, static_cast<std::uint32_t>(it.second.data.size()));
+        data.insert(data.end(), it.second.data.begin(), it.second.data.end());
+    }
+}
+
+std::uint64_t GLProgramBinaryCache::HashData(const void* data, std::size_t dataSize, std::uint64_t hash)
+{
+    auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < dataSize; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLProgramBinaryCache::Initialize()
+{
+    if (initialized_)
+        return;
+
+    initialized_ = true;
+
+    #ifdef GL_ARB_get_program_binary
+    /* Program binaries are only supported if the driver provides at least one binary format */
+    if (HasExtension(GLExt::ARB_get_program_binary))
+    {
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        supported_ = (numFormats > 0);
+    }
+    #endif // /GL_ARB_get_program_binary
+
+    /* Determine driver identity */
+    driverHash_ = HashString(glGetString(GL_VENDOR), driverHash_);
+    driverHash_ = HashString(glGetString(GL_RENDERER), driverHash_);
+    driverHash_ = HashString(glGetString(GL_VERSION), driverHash_);
+
+    /* Decode initial data; malformed data or data from another driver is discarded */
+    if (supported_ && !initialData_.empty())
+    {
+        if (!DecodeData(initialData_))
+            entries_.clear();
+    }
+
+    initialData_.clear();
+}
+
+bool GLProgramBinaryCache::DecodeData(const std::vector<char>& data)
+{
+    std::size_t offset = 0;
+
+    /* Read and validate header */
+    std::uint32_t magic = 0, version = 0, numEntries = 0;
+    std::uint64_t driverHash = 0;
+
+    if (!ReadValue(data, offset, magic)         || magic        != g_cacheMagic     ||
+        !ReadValue(data, offset, version)       || version      != g_cacheVersion   ||
+        !ReadValue(data, offset, driverHash)    || driverHash   != driverHash_      ||
+        !ReadValue(data, offset, numEntries))
+    {
+        return false;
+    }
+
+    /* Read entries */
+    for (std::uint32_t i = 0; i < numEntries; ++i)
+    {
+        std::uint64_t key = 0;
+        std::uint32_t format = 0, size = 0;
+
+        if (!ReadValue(data, offset, key) || !ReadValue(data, offset, format) || !ReadValue(data, offset, size))
+            return false;
+        if (offset + size > data.size())
+            return false;
+
+        Entry entry;
+        entry.format = static_cast<GLenum>(format);
+        entry.data.assign(data.begin() + offset, data.begin() + offset + size);
+        entries_[key] = std::move(entry);
+
+        offset += size;
+    }
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
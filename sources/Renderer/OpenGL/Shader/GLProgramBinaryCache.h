@@ -0,0 +1,95 @@
+/*
+ * GLProgramBinaryCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PROGRAM_BINARY_CACHE_H
+#define LLGL_GL_PROGRAM_BINARY_CACHE_H
+
+
+#include "../OpenGL.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <map>
+
+
+namespace LLGL
+{
+
+
+struct ShaderProgramDescriptor;
+
+/*
+Cache for program binaries (GL_ARB_get_program_binary), keyed by a hash of the attached shaders, the vertex formats, and the driver identity.
+The initial data is only decoded on first use, since the driver identity (GL_VENDOR, GL_RENDERER, GL_VERSION) requires an active GL context.
+Data that has been generated by another driver is discarded as a whole.
+*/
+class GLProgramBinaryCache
+{
+
+    public:
+
+        GLProgramBinaryCache(const void* initialData = nullptr, std::size_t initialDataSize = 0);
+
+        GLProgramBinaryCache(const GLProgramBinaryCache&) = delete;
+        GLProgramBinaryCache& operator = (const GLProgramBinaryCache&) = delete;
+
+        // Returns true if the GL context supports program binaries. This must only be called with an active GL context.
+        bool IsSupported();
+
+        // Returns the cache key for the specified shader program descriptor.
+        std::uint64_t MakeKey(const ShaderProgramDescriptor& desc);
+
+        // Loads the program binary with the specified key into the program. Returns false if there is no such entry or the driver rejected the binary.
+        bool LoadProgram(GLuint program, std::uint64_t key);
+
+        // Stores the binary of the specified linked program with the specified key.
+        void StoreProgram(GLuint program, std::uint64_t key);
+
+        // Serializes all entries of this cache into the output buffer.
+        void GetData(std::vector<char>& data) const;
+
+    public:
+
+        // Returns the 64-bit FNV-1a hash of the specified data, continued from the specified hash value.
+        static std::uint64_t HashData(const void* data, std::size_t dataSize, std::uint64_t hash = 0xcbf29ce484222325ull);
+
+    private:
+
+        struct Entry
+        {
+            GLenum              format;
+            std::vector<char>   data;
+        };
+
+    private:
+
+        // Determines the driver identity and decodes the initial data on first use.
+        void Initialize();
+
+        // Decodes the specified cache data. Returns false if the data is malformed or has been generated by another driver.
+        bool DecodeData(const std::vector<char>& data);
+
+    private:
+
+        std::vector<char>               initialData_;
+        bool                            initialized_    = false;
+        bool                            supported_      = false;
+
+        std::uint64_t                   driverHash_     = 0;
+        std::map<std::uint64_t, Entry>  entries_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,6 +6,7 @@
  */
 
 #include "GLShader.h"
+#include "GLProgramBinaryCache.h"
 #include "../Ext/GLExtensions.h"
 #include "../../GLCommon/GLExtensionRegistry.h"
 #include "../../GLCommon/GLTypes.h"
@@ -14,12 +15,19 @@
 #include <vector>
 #include <sstream>
 #include <stdexcept>
+#include <cstring>
 
 
 namespace LLGL
 {
 
 
+static std::uint64_t HashShaderSource(const ShaderType type, const void* data, std::size_t dataSize)
+{
+    auto hash = GLProgramBinaryCache::HashData(&type, sizeof(type));
+    return GLProgramBinaryCache::HashData(data, dataSize, hash);
+}
+
 GLShader::GLShader(const ShaderDescriptor& desc) :
     Shader { desc.type }
 {
@@ -111,6 +119,9 @@ void GLShader::CompileSource(const ShaderDescriptor& shaderDesc)
         strings[0] = shaderDesc.source;
     }
 
+    /* Store hash of shader source code for the program binary cache */
+    sourceHash_ = HashShaderSource(GetType(), strings[0], std::strlen(strings[0]));
+
     /* Load shader source code, then compile shader */
     glShaderSource(id_, 1, strings, nullptr);
     glCompileShader(id_);
@@ -150,6 +161,10 @@ void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
         const char* entryPoint = (shaderDesc.entryPoint == nullptr || *shaderDesc.entryPoint == '\0' ? "main" : shaderDesc.entryPoint);
         glSpecializeShader(id_, entryPoint, 0, nullptr, nullptr);
 
+        /* Store hash of shader binary and entry point for the program binary cache */
+        sourceHash_ = HashShaderSource(GetType(), binaryBuffer, static_cast<std::size_t>(binaryLength));
+        sourceHash_ = GLProgramBinaryCache::HashData(entryPoint, std::strlen(entryPoint) + 1, sourceHash_);
+
         /* Store stream-output format */
         streamOutputFormat_ = shaderDesc.streamOutput.format;
     }
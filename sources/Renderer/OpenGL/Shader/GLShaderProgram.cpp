@@ -7,6 +7,7 @@
 
 #include "GLShaderProgram.h"
 #include "GLShader.h"
+#include "GLProgramBinaryCache.h"
 #include "../RenderState/GLStateManager.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionLoader.h"
@@ -23,7 +24,7 @@ namespace LLGL
 {
 
 
-GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
+GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc, GLProgramBinaryCache* binaryCache) :
     id_      { glCreateProgram() },
     uniform_ { id_               }
 {
@@ -34,7 +35,12 @@ GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
     Attach(desc.fragmentShader);
     Attach(desc.computeShader);
     BuildInputLayout(desc.vertexFormats.size(), desc.vertexFormats.data());
-    Link();
+
+    /* Programs with stream-output are never cached, since their varyings might be specified after linking */
+    if (binaryCache != nullptr && streamOutputFormat_.attributes.empty())
+        LinkWithBinaryCache(*binaryCache, desc);
+    else
+        Link();
 }
 
 GLShaderProgram::~GLShaderProgram()
@@ -237,6 +243,27 @@ void GLShaderProgram::Link()
     glLinkProgram(id_);
 }
 
+void GLShaderProgram::LinkWithBinaryCache(GLProgramBinaryCache& binaryCache, const ShaderProgramDescriptor& desc)
+{
+    #ifdef GL_ARB_get_program_binary
+    if (binaryCache.IsSupported())
+    {
+        /* Load program binary from cache; if there is no entry or the driver rejects it, link from the attached shaders */
+        auto key = binaryCache.MakeKey(desc);
+        if (!binaryCache.LoadProgram(id_, key))
+        {
+            glProgramParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            Link();
+            if (!HasErrors())
+                binaryCache.StoreProgram(id_, key);
+        }
+        return;
+    }
+    #endif // /GL_ARB_get_program_binary
+
+    Link();
+}
+
 bool GLShaderProgram::QueryActiveAttribs(
     GLenum attribCountType, GLenum attribNameLengthType,
     GLint& numAttribs, GLint& maxNameLength, std::vector<char>& nameBuffer) const
@@ -18,12 +18,14 @@ namespace LLGL
 {
 
 
+class GLProgramBinaryCache;
+
 class GLShaderProgram final : public ShaderProgram
 {
 
     public:
 
-        GLShaderProgram(const ShaderProgramDescriptor& desc);
+        GLShaderProgram(const ShaderProgramDescriptor& desc, GLProgramBinaryCache* binaryCache = nullptr);
         ~GLShaderProgram();
 
         bool HasErrors() const override;
@@ -54,6 +56,7 @@ class GLShaderProgram final : public ShaderProgram
         void Attach(Shader* shader);
         void BuildInputLayout(std::size_t numVertexFormats, const VertexFormat* vertexFormats);
         void Link();
+        void LinkWithBinaryCache(GLProgramBinaryCache& binaryCache, const ShaderProgramDescriptor& desc);
 
         bool QueryActiveAttribs(
             GLenum attribCountType, GLenum attribNameLengthType,
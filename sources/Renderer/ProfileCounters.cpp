@@ -0,0 +1,133 @@
+/*
+ * ProfileCounters.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ProfileCounters.h"
+#include "../Core/Helper.h"
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+struct ProfileCounterRegistry
+{
+    std::mutex                          mutex;
+    std::vector<ProfileCounterBlock*>   blocks;
+    std::uint32_t                       retiredValues[g_numProfileCounters] = {};
+    RenderingProfiler*                  profiler                            = nullptr;
+};
+
+static ProfileCounterRegistry& GetProfileCounterRegistry()
+{
+    static ProfileCounterRegistry registry;
+    return registry;
+}
+
+// Profile counter block that is registered for the lifetime of its thread.
+struct ThreadProfileCounters
+{
+    ThreadProfileCounters()
+    {
+        for (std::size_t i = 0; i < g_numProfileCounters; ++i)
+        {
+            block.values[i].store(0, std::memory_order_relaxed);
+            block.mergedValues[i] = 0;
+        }
+
+        auto& registry = GetProfileCounterRegistry();
+        std::lock_guard<std::mutex> guard { registry.mutex };
+        registry.blocks.push_back(&block);
+    }
+
+    ~ThreadProfileCounters()
+    {
+        /* Keep counts that have not been merged yet for the next merge */
+        auto& registry = GetProfileCounterRegistry();
+        std::lock_guard<std::mutex> guard { registry.mutex };
+
+        for (std::size_t i = 0; i < g_numProfileCounters; ++i)
+            registry.retiredValues[i] += block.values[i].load(std::memory_order_relaxed) - block.mergedValues[i];
+
+        RemoveFromList(registry.blocks, &block);
+    }
+
+    ProfileCounterBlock block;
+};
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT ProfileCounterBlock& GetThreadProfileCounters()
+{
+    static thread_local ThreadProfileCounters counters;
+    return counters.block;
+}
+
+LLGL_EXPORT void AttachProfileCounters(RenderingProfiler* profiler)
+{
+    auto& registry = GetProfileCounterRegistry();
+    std::lock_guard<std::mutex> guard { registry.mutex };
+
+    /* Discard all counts so far */
+    for (auto block : registry.blocks)
+    {
+        for (std::size_t i = 0; i < g_numProfileCounters; ++i)
+            block->mergedValues[i] = block->values[i].load(std::memory_order_relaxed);
+    }
+
+    Fill(registry.retiredValues, 0u);
+
+    registry.profiler = profiler;
+}
+
+LLGL_EXPORT void DetachProfileCounters(RenderingProfiler* profiler)
+{
+    auto& registry = GetProfileCounterRegistry();
+    std::lock_guard<std::mutex> guard { registry.mutex };
+
+    if (registry.profiler == profiler)
+        registry.profiler = nullptr;
+}
+
+LLGL_EXPORT void MergeProfileCounters(RenderingProfiler& profiler)
+{
+    auto& registry = GetProfileCounterRegistry();
+    std::lock_guard<std::mutex> guard { registry.mutex };
+
+    if (registry.profiler == &profiler)
+    {
+        auto& values = profiler.frameProfile.values;
+
+        /* Accumulate difference to previously merged values of each thread */
+        for (auto block : registry.blocks)
+        {
+            for (std::size_t i = 0; i < g_numProfileCounters; ++i)
+            {
+                const auto value = block->values[i].load(std::memory_order_relaxed);
+                values[i] += value - block->mergedValues[i];
+                block->mergedValues[i] = value;
+            }
+        }
+
+        /* Accumulate counts of threads that have already terminated */
+        for (std::size_t i = 0; i < g_numProfileCounters; ++i)
+            values[i] += registry.retiredValues[i];
+
+        Fill(registry.retiredValues, 0u);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,91 @@
+/*
+ * ProfileCounters.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PROFILE_COUNTERS_H
+#define LLGL_PROFILE_COUNTERS_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/RenderingProfiler.h>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Number of counter values in a frame profile.
+static const std::size_t g_numProfileCounters = (sizeof(FrameProfile::values) / sizeof(FrameProfile::values[0]));
+
+/*
+Block of profile counters of a single thread.
+Counters are only written by their owning thread and only ever increase,
+so any other thread can merge them by accumulating the difference to the previously merged values.
+*/
+struct ProfileCounterBlock
+{
+    std::atomic<std::uint32_t>  values[g_numProfileCounters];
+    std::uint32_t               mergedValues[g_numProfileCounters];
+};
+
+// Returns the profile counter block of the calling thread, which is registered on first use.
+LLGL_EXPORT ProfileCounterBlock& GetThreadProfileCounters();
+
+// Sets the profiler that the profile counters of all threads are merged into. Counts prior to this call are discarded.
+LLGL_EXPORT void AttachProfileCounters(RenderingProfiler* profiler);
+
+// Stops merging the profile counters into the specified profiler, if it is currently attached.
+LLGL_EXPORT void DetachProfileCounters(RenderingProfiler* profiler);
+
+// Merges the profile counters of all threads into the specified profiler if it is attached. This is only called by RenderingProfiler::NextProfile, so the frame profile is never written by another thread.
+LLGL_EXPORT void MergeProfileCounters(RenderingProfiler& profiler);
+
+// Returns the index of the frame profile counter with the specified name (see FrameProfile).
+#define LLGL_PROFILE_COUNTER_INDEX(NAME) \
+    (offsetof(LLGL::FrameProfile, NAME) / sizeof(std::uint32_t))
+
+// Returns the current value of a counter of the calling thread.
+inline std::uint32_t ReadProfileCounter(std::size_t index)
+{
+    return GetThreadProfileCounters().values[index].load(std::memory_order_relaxed);
+}
+
+// Adds the specified value to a counter of the calling thread without any synchronization.
+inline void IncrementProfileCounter(std::size_t index, std::uint32_t value = 1)
+{
+    static thread_local ProfileCounterBlock* block = nullptr;
+    if (block == nullptr)
+        block = &(GetThreadProfileCounters());
+
+    auto& counter = block->values[index];
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+
+#ifdef LLGL_ENABLE_PROFILE_COUNTERS
+
+// Increments the frame profile counter with the specified name (see FrameProfile) in the thread-local storage.
+#define LLGL_PROFILE_COUNT(NAME) \
+    LLGL::IncrementProfileCounter(LLGL_PROFILE_COUNTER_INDEX(NAME))
+
+#else
+
+#define LLGL_PROFILE_COUNT(NAME)
+
+#endif // /LLGL_ENABLE_PROFILE_COUNTERS
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,7 @@
 
 #include "../Platform/Module.h"
 #include "../Core/Helper.h"
+#include "../Core/ThreadPool.h"
 #include <LLGL/Platform/Platform.h>
 #include <LLGL/Log.h>
 #include "BuildID.h"
@@ -20,6 +21,10 @@
 #   include "DebugLayer/DbgRenderSystem.h"
 #endif
 
+#ifdef LLGL_ENABLE_PROFILE_COUNTERS
+#   include "ProfileCounters.h"
+#endif
+
 #ifdef LLGL_BUILD_STATIC_LIB
 #   include "ModuleInterface.h"
 #endif
@@ -54,6 +59,10 @@ std::vector<std::string> RenderSystem::FindModules()
         "Direct3D11",
         "Direct3D12",
         #endif
+
+        #ifdef LLGL_BUILD_RENDERER_NULL
+        "Null",
+        #endif
     };
 
     std::vector<std::string> modules;
@@ -136,6 +145,17 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
         reinterpret_cast<RenderSystem*>(LLGL_RenderSystem_Alloc(&renderSystemDesc))
     );
 
+    #ifdef LLGL_ENABLE_PROFILE_COUNTERS
+
+    /* Merge thread-local profile counters into the profiler, if the debug layer is not required */
+    if (profiler != nullptr && debugger == nullptr)
+    {
+        AttachProfileCounters(profiler);
+        profiler = nullptr;
+    }
+
+    #endif // /LLGL_ENABLE_PROFILE_COUNTERS
+
     if (profiler != nullptr || debugger != nullptr)
     {
         #ifdef LLGL_ENABLE_DEBUG_LAYER
@@ -174,6 +194,17 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
         /* Allocate render system */
         auto renderSystem = std::unique_ptr<RenderSystem>(LoadRenderSystem(*module, moduleFilename, renderSystemDesc));
 
+        #ifdef LLGL_ENABLE_PROFILE_COUNTERS
+
+        /* Merge thread-local profile counters into the profiler, if the debug layer is not required */
+        if (profiler != nullptr && debugger == nullptr)
+        {
+            AttachProfileCounters(profiler);
+            profiler = nullptr;
+        }
+
+        #endif // /LLGL_ENABLE_PROFILE_COUNTERS
+
         if (profiler != nullptr || debugger != nullptr)
         {
             #ifdef LLGL_ENABLE_DEBUG_LAYER
@@ -206,6 +237,16 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
     #endif // /LLGL_BUILD_STATIC_LIB
 }
 
+RenderSystem::RenderSystem()
+{
+    ThreadPool::RetainShared();
+}
+
+RenderSystem::~RenderSystem()
+{
+    ThreadPool::ReleaseShared();
+}
+
 void RenderSystem::Unload(std::unique_ptr<RenderSystem>&& renderSystem)
 {
     auto it = g_renderSystemModules.find(renderSystem.get());
@@ -219,6 +260,35 @@ void RenderSystem::Unload(std::unique_ptr<RenderSystem>&& renderSystem)
 void RenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
 {
     config_ = config;
+    ThreadPool::SetSharedThreadCount(config.threadCount);
+}
+
+bool RenderSystem::QueryMemoryHeapStatistics(std::vector<MemoryHeapStatistics>& heapStatistics)
+{
+    heapStatistics.clear();
+    return false;
+}
+
+bool RenderSystem::QueryPipelineCache(std::vector<char>& data)
+{
+    data.clear();
+    return false;
+}
+
+void RenderSystem::ReadTextureAsync(
+    const Texture&              texture,
+    const TextureRegion&        textureRegion,
+    const DstImageDescriptor&   imageDesc,
+    const ReadTextureCallback&  callback)
+{
+    /* Fall back to synchronous read, which only supports entire MIP-map levels */
+    if (textureRegion.offset != Offset3D{ 0, 0, 0 } || textureRegion.extent != texture.QueryMipExtent(textureRegion.mipLevel))
+        throw std::runtime_error("renderer does not support reading a partial MIP-map level of a texture");
+
+    ReadTexture(texture, textureRegion.mipLevel, imageDesc);
+
+    if (callback)
+        callback(imageDesc);
 }
 
 
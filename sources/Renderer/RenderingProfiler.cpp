@@ -6,21 +6,144 @@
  */
 
 #include <LLGL/RenderingProfiler.h>
+#include "ProfileCounters.h"
 #include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <map>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
 
 
 namespace LLGL
 {
 
 
+/* ----- Internal structures ----- */
+
+// Sink for trace events in the Chrome trace event format; events are buffered up to 'maxBufferSize' bytes before they are written to the file.
+struct RenderingProfiler::TraceSink
+{
+    std::ofstream                               file;
+    std::string                                 buffer;
+    std::size_t                                 maxBufferSize   = 0;
+    bool                                        firstEvent      = true;
+    std::chrono::steady_clock::time_point       startTime;
+    std::map<std::thread::id, std::uint32_t>    threadIDs;
+    std::mutex                                  mutex;
+
+    void Flush()
+    {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+    // Returns a unique and consecutive ID for the calling thread.
+    std::uint32_t GetThreadID()
+    {
+        auto it = threadIDs.find(std::this_thread::get_id());
+        if (it == threadIDs.end())
+            it = threadIDs.insert({ std::this_thread::get_id(), static_cast<std::uint32_t>(threadIDs.size() + 1) }).first;
+        return it->second;
+    }
+
+    // Appends the specified string as JSON string content, i.e. with escaped quotes and backslashes, and without control characters.
+    void AppendEscaped(const char* s)
+    {
+        for (; *s != '\0'; ++s)
+        {
+            if (*s == '"' || *s == '\\')
+                buffer += '\\';
+            if (static_cast<unsigned char>(*s) >= 0x20)
+                buffer += *s;
+        }
+    }
+};
+
+
+/* ----- Internal functions ----- */
+
+static void IncreaseMemoryUsage(MemoryUsage& usage, std::uint64_t size)
+{
+    usage.numResources++;
+    usage.liveSize += size;
+    usage.peakSize = std::max(usage.peakSize, usage.liveSize);
+}
+
+static void DecreaseMemoryUsage(MemoryUsage& usage, std::uint64_t size)
+{
+    usage.numResources--;
+    usage.liveSize -= size;
+}
+
+// Calls the specified function for each individual binding flag, or once with zero if there are no binding flags.
+template <typename TFunc>
+static void ForEachBindFlag(long bindFlags, TFunc func)
+{
+    if (bindFlags == 0)
+        func(0l);
+    for (long flag = 1; flag != 0 && flag <= bindFlags; flag <<= 1)
+    {
+        if ((bindFlags & flag) != 0)
+            func(flag);
+    }
+}
+
+
+/* ----- RenderingProfiler class ----- */
+
+RenderingProfiler::RenderingProfiler() :
+    frameStartTime_ { std::chrono::steady_clock::now() }
+{
+}
+
+RenderingProfiler::~RenderingProfiler()
+{
+    DetachProfileCounters(this);
+    StopTrace();
+}
+
+
 void RenderingProfiler::NextProfile(FrameProfile* outputProfile)
 {
+    /* Merge thread-local profile counters of the renderer (if attached) */
+    MergeProfileCounters(*this);
+
     /* Copy current counters to the output profile (if set) */
     if (outputProfile)
         *outputProfile = frameProfile;
 
+    /* Measure time since the previous frame */
+    const auto currentTime  = std::chrono::steady_clock::now();
+    const auto frameTime    = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - frameStartTime_).count()
+    );
+    frameStartTime_ = currentTime;
+
+    RecordHistoryFrame(frameTime);
+
+    if (frameBudget_ > 0 && frameTime > frameBudget_ && frameBudgetCallback_)
+        frameBudgetCallback_(currentFrame_, frameTime, frameProfile);
+
     /* Clear values */
     frameProfile.Clear();
+
+    /* Move on to next frame */
+    ++currentFrame_;
+}
+
+bool RenderingProfiler::NextTimings(FrameTimings& outputTimings)
+{
+    if (!frameTimings_.empty())
+    {
+        outputTimings = std::move(frameTimings_.front());
+        frameTimings_.pop_front();
+        return true;
+    }
+    return false;
 }
 
 void RenderingProfiler::Accumulate(const FrameProfile& profile)
@@ -28,6 +151,365 @@ void RenderingProfiler::Accumulate(const FrameProfile& profile)
     frameProfile.Accumulate(profile);
 }
 
+void RenderingProfiler::PostTimings(FrameTimings&& timings)
+{
+    RecordHistoryTimings(timings);
+
+    /* Discard oldest timings that have not been retrieved */
+    while (!frameTimings_.empty() && frameTimings_.size() >= std::max(maxFrameTimings, std::size_t(1)))
+        frameTimings_.pop_front();
+
+    frameTimings_.push_back(std::move(timings));
+}
+
+void RenderingProfiler::StartTrace(const std::string& filename, std::size_t maxBufferSize)
+{
+    StopTrace();
+
+    std::unique_ptr<TraceSink> sink { new TraceSink() };
+
+    sink->file.open(filename, std::ios_base::out | std::ios_base::binary);
+    if (!sink->file.good())
+        throw std::runtime_error("failed to open trace file: " + filename);
+
+    sink->maxBufferSize = maxBufferSize;
+    sink->startTime     = std::chrono::steady_clock::now();
+    sink->buffer.reserve(maxBufferSize);
+    sink->buffer        = "{\"traceEvents\":[\n";
+
+    traceSink_ = std::move(sink);
+}
+
+void RenderingProfiler::StopTrace()
+{
+    if (traceSink_)
+    {
+        /* Close JSON array and write remaining events */
+        traceSink_->buffer += "\n]}\n";
+        traceSink_->Flush();
+        traceSink_.reset();
+    }
+}
+
+std::uint64_t RenderingProfiler::GetTraceTime() const
+{
+    if (traceSink_)
+    {
+        const auto elapsedTime = std::chrono::steady_clock::now() - traceSink_->startTime;
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsedTime).count());
+    }
+    return 0;
+}
+
+void RenderingProfiler::TraceEvent(const char* category, const char* name, std::uint64_t startTime, std::uint64_t duration, std::uint64_t size)
+{
+    if (!traceSink_)
+        return;
+
+    auto& sink = *traceSink_;
+    std::lock_guard<std::mutex> guard { sink.mutex };
+
+    /* Append complete event ("X") with timestamps in microseconds */
+    if (!sink.firstEvent)
+        sink.buffer += ",\n";
+    sink.firstEvent = false;
+
+    sink.buffer += "{\"name\":\"";
+    sink.AppendEscaped(name);
+    sink.buffer += "\",\"cat\":\"";
+    sink.AppendEscaped(category);
+
+    char str[128];
+    std::snprintf(
+        str, sizeof(str), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u",
+        static_cast<double>(startTime) / 1000.0, static_cast<double>(duration) / 1000.0, sink.GetThreadID()
+    );
+    sink.buffer += str;
+
+    if (size > 0)
+    {
+        std::snprintf(str, sizeof(str), ",\"args\":{\"size\":%llu}", static_cast<unsigned long long>(size));
+        sink.buffer += str;
+    }
+
+    sink.buffer += "}";
+
+    /* Write buffered events to file to keep memory bounded */
+    if (sink.buffer.size() >= sink.maxBufferSize)
+        sink.Flush();
+}
+
+void RenderingProfiler::SetHistorySize(std::size_t numFrames, std::size_t maxScopes)
+{
+    maxScopes = std::min(maxScopes, std::size_t(64));
+
+    /* Allocate all storage of the history up front */
+    history_.clear();
+    history_.resize(numFrames);
+    historyMaxScopes_ = maxScopes;
+
+    historyScopeNames_.clear();
+    historyScopeNames_.reserve(maxScopes);
+
+    historyScopeTimes_.clear();
+    historyScopeTimes_.resize(numFrames * maxScopes * 2, 0);
+
+    historySamples_.clear();
+    historySamples_.reserve(numFrames);
+}
+
+void RenderingProfiler::SetFrameBudget(std::uint64_t frameTime, const FrameBudgetCallback& callback)
+{
+    frameBudget_            = frameTime;
+    frameBudgetCallback_    = callback;
+}
+
+bool RenderingProfiler::QueryCounterStatistics(std::size_t index, ProfileStatistics& statistics) const
+{
+    if (index >= sizeof(FrameProfile::values) / sizeof(FrameProfile::values[0]))
+        return false;
+
+    historySamples_.clear();
+    for (const auto& entry : history_)
+    {
+        if (entry.valid)
+            historySamples_.push_back(static_cast<double>(entry.profile.values[index]));
+    }
+
+    return ComputeStatistics(historySamples_.size(), statistics);
+}
+
+bool RenderingProfiler::QueryScopeStatistics(const std::string& name, bool gpuTime, ProfileStatistics& statistics) const
+{
+    const auto scope = FindHistoryScope(name);
+    if (scope == historyScopeNames_.size())
+        return false;
+
+    /* Gather scope times of all resolved frames that contain this scope */
+    const auto scopeBit = (std::uint64_t(1) << scope);
+
+    historySamples_.clear();
+    for (std::size_t i = 0; i < history_.size(); ++i)
+    {
+        if (history_[i].resolved && (history_[i].scopeMask & scopeBit) != 0)
+        {
+            const auto timeIndex = (i * historyMaxScopes_ + scope) * 2 + (gpuTime ? 1 : 0);
+            historySamples_.push_back(static_cast<double>(historyScopeTimes_[timeIndex]));
+        }
+    }
+
+    return ComputeStatistics(historySamples_.size(), statistics);
+}
+
+bool RenderingProfiler::QueryFrameTimeStatistics(ProfileStatistics& statistics) const
+{
+    historySamples_.clear();
+    for (const auto& entry : history_)
+    {
+        if (entry.valid)
+            historySamples_.push_back(static_cast<double>(entry.frameTime));
+    }
+
+    return ComputeStatistics(historySamples_.size(), statistics);
+}
+
+void RenderingProfiler::SetMemoryTag(const std::string& tag)
+{
+    memoryTag_ = tag;
+}
+
+std::uint64_t RenderingProfiler::TrackAllocation(const MemoryResourceType type, long bindFlags, std::uint64_t size)
+{
+    auto& allocation = memoryAllocations_[memoryNextID_];
+    {
+        allocation.id           = memoryNextID_++;
+        allocation.frame        = currentFrame_;
+        allocation.type         = type;
+        allocation.bindFlags    = bindFlags;
+        allocation.size         = size;
+        allocation.tag          = memoryTag_;
+    }
+    AddMemoryUsage(allocation);
+    return allocation.id;
+}
+
+void RenderingProfiler::TrackRelease(std::uint64_t id)
+{
+    auto it = memoryAllocations_.find(id);
+    if (it != memoryAllocations_.end())
+    {
+        SubtractMemoryUsage(it->second);
+        memoryAllocations_.erase(it);
+    }
+}
+
+void RenderingProfiler::TakeMemorySnapshot(MemorySnapshot& snapshot, bool withAllocations) const
+{
+    snapshot.frame      = currentFrame_;
+    snapshot.total      = memoryTotal_;
+    snapshot.bindFlags  = memoryBindFlags_;
+    snapshot.tags       = memoryTags_;
+
+    std::copy(std::begin(memoryTypes_), std::end(memoryTypes_), std::begin(snapshot.resourceTypes));
+
+    /* Copy live allocations; the map is ordered by ID, so the output is sorted as well */
+    snapshot.allocations.clear();
+    if (withAllocations)
+    {
+        snapshot.allocations.reserve(memoryAllocations_.size());
+        for (const auto& it : memoryAllocations_)
+            snapshot.allocations.push_back(it.second);
+    }
+}
+
+void RenderingProfiler::DiffMemorySnapshots(const MemorySnapshot& first, const MemorySnapshot& second, MemorySnapshotDiff& diff)
+{
+    diff.sizeDelta = static_cast<std::int64_t>(second.total.liveSize) - static_cast<std::int64_t>(first.total.liveSize);
+    diff.allocated.clear();
+    diff.released.clear();
+
+    /* Merge both allocation lists, which are sorted by ID */
+    auto a = first.allocations.begin(), aEnd = first.allocations.end();
+    auto b = second.allocations.begin(), bEnd = second.allocations.end();
+
+    while (a != aEnd || b != bEnd)
+    {
+        if (b == bEnd || (a != aEnd && a->id < b->id))
+            diff.released.push_back(*a++);
+        else if (a == aEnd || b->id < a->id)
+            diff.allocated.push_back(*b++);
+        else
+        {
+            ++a;
+            ++b;
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void RenderingProfiler::RecordHistoryFrame(std::uint64_t frameTime)
+{
+    if (history_.empty())
+        return;
+
+    /* Overwrite oldest frame in the ring buffer */
+    const auto index = static_cast<std::size_t>(currentFrame_ % history_.size());
+
+    auto& entry = history_[index];
+    {
+        entry.frame     = currentFrame_;
+        entry.frameTime = frameTime;
+        entry.scopeMask = 0;
+        entry.valid     = true;
+        entry.resolved  = false;
+        entry.profile   = frameProfile;
+    }
+}
+
+void RenderingProfiler::RecordHistoryTimings(const FrameTimings& timings)
+{
+    if (history_.empty())
+        return;
+
+    /* Ignore timings of frames that are no longer in the history */
+    const auto index = static_cast<std::size_t>(timings.frame % history_.size());
+
+    auto& entry = history_[index];
+    if (!entry.valid || entry.frame != timings.frame)
+        return;
+
+    /* Sum up times of all scopes with the same name */
+    auto scopeTimes = &historyScopeTimes_[index * historyMaxScopes_ * 2];
+    std::fill(scopeTimes, scopeTimes + historyMaxScopes_ * 2, 0);
+
+    for (const auto& scope : timings.scopes)
+    {
+        auto slot = FindHistoryScope(scope.name);
+        if (slot == historyScopeNames_.size())
+        {
+            /* Register new scope name, unless the maximum number of scopes is reached */
+            if (slot == historyMaxScopes_)
+                continue;
+            historyScopeNames_.push_back(scope.name);
+        }
+
+        scopeTimes[slot * 2    ] += scope.cpuTime;
+        scopeTimes[slot * 2 + 1] += scope.gpuTime;
+        entry.scopeMask |= (std::uint64_t(1) << slot);
+    }
+
+    entry.resolved = true;
+}
+
+std::size_t RenderingProfiler::FindHistoryScope(const std::string& name) const
+{
+    return static_cast<std::size_t>(
+        std::find(historyScopeNames_.begin(), historyScopeNames_.end(), name) - historyScopeNames_.begin()
+    );
+}
+
+bool RenderingProfiler::ComputeStatistics(std::size_t numSamples, ProfileStatistics& statistics) const
+{
+    if (numSamples == 0)
+        return false;
+
+    /* Sort samples in place to determine percentiles */
+    std::sort(historySamples_.begin(), historySamples_.end());
+
+    double sum = 0.0;
+    for (auto sample : historySamples_)
+        sum += sample;
+
+    auto Percentile = [&](double p) -> double
+    {
+        /* Nearest-rank method */
+        auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(numSamples)));
+        return historySamples_[std::max(rank, std::size_t(1)) - 1];
+    };
+
+    statistics.numSamples   = static_cast<std::uint32_t>(numSamples);
+    statistics.min          = historySamples_.front();
+    statistics.max          = historySamples_.back();
+    statistics.mean         = sum / static_cast<double>(numSamples);
+    statistics.p50          = Percentile(0.50);
+    statistics.p95          = Percentile(0.95);
+    statistics.p99          = Percentile(0.99);
+
+    return true;
+}
+
+void RenderingProfiler::AddMemoryUsage(const MemoryAllocation& allocation)
+{
+    IncreaseMemoryUsage(memoryTotal_, allocation.size);
+    IncreaseMemoryUsage(memoryTypes_[static_cast<std::size_t>(allocation.type)], allocation.size);
+    IncreaseMemoryUsage(memoryTags_[allocation.tag], allocation.size);
+    ForEachBindFlag(
+        allocation.bindFlags,
+        [&](long flag)
+        {
+            IncreaseMemoryUsage(memoryBindFlags_[flag], allocation.size);
+        }
+    );
+}
+
+void RenderingProfiler::SubtractMemoryUsage(const MemoryAllocation& allocation)
+{
+    DecreaseMemoryUsage(memoryTotal_, allocation.size);
+    DecreaseMemoryUsage(memoryTypes_[static_cast<std::size_t>(allocation.type)], allocation.size);
+    DecreaseMemoryUsage(memoryTags_[allocation.tag], allocation.size);
+    ForEachBindFlag(
+        allocation.bindFlags,
+        [&](long flag)
+        {
+            DecreaseMemoryUsage(memoryBindFlags_[flag], allocation.size);
+        }
+    );
+}
+
 
 } // /namespace LLGL
 
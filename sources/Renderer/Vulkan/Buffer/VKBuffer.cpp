@@ -37,10 +37,8 @@ static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
         throw std::runtime_error("stream output buffer not supported by Vulkan renderer");
     #endif
 
-    if ((desc.cpuAccessFlags & CPUAccessFlags::Read) != 0)
-        flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    else
-        flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    /* Buffers are always a valid copy source, for CPU read access and for relocation during device memory defragmentation */
+    flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 
     return flags;
 }
@@ -50,6 +48,7 @@ VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc)
     bufferObj_        { device                                          },
     bufferObjStaging_ { device                                          },
     size_             { desc.size                                       },
+    usageFlags_       { GetVkBufferUsageFlags(desc)                     },
     indexType_        { VKTypes::ToVkIndexType(desc.indexBuffer.format) }
 {
     VkBufferCreateInfo createInfo;
@@ -58,7 +57,7 @@ VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc)
         createInfo.pNext                    = nullptr;
         createInfo.flags                    = 0;
         createInfo.size                     = desc.size;
-        createInfo.usage                    = GetVkBufferUsageFlags(desc);
+        createInfo.usage                    = usageFlags_;
         createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
         createInfo.queueFamilyIndexCount    = 0;
         createInfo.pQueueFamilyIndices      = nullptr;
@@ -76,6 +75,13 @@ void VKBuffer::TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer)
     bufferObjStaging_ = std::move(deviceBuffer);
 }
 
+VKDeviceBuffer VKBuffer::ReplaceDeviceBuffer(VKDeviceBuffer&& deviceBuffer)
+{
+    auto prevBufferObj = std::move(bufferObj_);
+    bufferObj_ = std::move(deviceBuffer);
+    return prevBufferObj;
+}
+
 void* VKBuffer::Map(VkDevice device, const CPUAccess access)
 {
     mappedCPUAccess_ = access;
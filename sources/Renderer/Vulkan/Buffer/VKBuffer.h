@@ -28,6 +28,9 @@ class VKBuffer : public Buffer
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
         void TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer);
 
+        // Replaces the device buffer object, e.g. after it has been relocated into another device memory region, and returns the previous one.
+        VKDeviceBuffer ReplaceDeviceBuffer(VKDeviceBuffer&& deviceBuffer);
+
         void* Map(VkDevice device, const CPUAccess access);
         void Unmap(VkDevice device);
 
@@ -61,6 +64,12 @@ class VKBuffer : public Buffer
             return size_;
         }
 
+        // Returns the usage flags the hardware buffer object was created with.
+        inline VkBufferUsageFlags GetUsageFlags() const
+        {
+            return usageFlags_;
+        }
+
         // Returns the CPU access previously set when "Map" was called.
         inline CPUAccess GetMappedCPUAccess() const
         {
@@ -73,15 +82,30 @@ class VKBuffer : public Buffer
             return indexType_;
         }
 
+        // Sets the ticket of the last upload batch that writes to this buffer (see VKUploadQueue).
+        inline void SetUploadTicket(std::uint64_t ticket)
+        {
+            uploadTicket_ = ticket;
+        }
+
+        // Returns the ticket of the last upload batch that writes to this buffer.
+        inline std::uint64_t GetUploadTicket() const
+        {
+            return uploadTicket_;
+        }
+
     private:
 
-        VKDeviceBuffer  bufferObj_;
-        VKDeviceBuffer  bufferObjStaging_;
+        VKDeviceBuffer      bufferObj_;
+        VKDeviceBuffer      bufferObjStaging_;
+
+        VkDeviceSize        size_               = 0;
+        VkBufferUsageFlags  usageFlags_         = 0;
+        CPUAccess           mappedCPUAccess_    = CPUAccess::ReadOnly;
 
-        VkDeviceSize    size_               = 0;
-        CPUAccess       mappedCPUAccess_    = CPUAccess::ReadOnly;
+        VkIndexType         indexType_          = VK_INDEX_TYPE_UINT32;
 
-        VkIndexType     indexType_          = VK_INDEX_TYPE_UINT32;
+        std::uint64_t       uploadTicket_       = 0;
 
 };
 
@@ -0,0 +1,94 @@
+/*
+ * VKStagingRingBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKStagingRingBuffer.h"
+#include "../VKCore.h"
+#include "../VKInitializers.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+static VkBufferCreateInfo GetStagingRingBufferCreateInfo(VkDeviceSize size)
+{
+    VkBufferCreateInfo createInfo;
+    BuildVkBufferCreateInfo(createInfo, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    return createInfo;
+}
+
+VKStagingRingBuffer::VKStagingRingBuffer(
+    const VKPtr<VkDevice>&                  device,
+    const VkPhysicalDeviceMemoryProperties& memoryProperties,
+    VkDeviceSize                            size) :
+        bufferObj_
+        {
+            device,
+            GetStagingRingBufferCreateInfo(size)
+        },
+        deviceMemory_
+        {
+            device,
+            bufferObj_.GetRequirements().size,
+            VKFindMemoryType(
+                memoryProperties,
+                bufferObj_.GetRequirements().memoryTypeBits,
+                (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+            )
+        },
+        size_ { size }
+{
+    /* Bind buffer to its own device memory, since it stays mapped for its entire lifetime */
+    auto result = vkBindBufferMemory(device, bufferObj_.GetVkBuffer(), deviceMemory_.GetVkDeviceMemory(), 0);
+    VKThrowIfFailed(result, "failed to bind Vulkan staging ring buffer to device memory");
+
+    mappedData_ = reinterpret_cast<char*>(deviceMemory_.Map(device, 0, VK_WHOLE_SIZE));
+}
+
+bool VKStagingRingBuffer::Allocate(VkDeviceSize size, VkDeviceSize alignment, VKStagingRegion& region)
+{
+    if (size == 0 || size > size_)
+        return false;
+
+    alignment = std::max(alignment, VkDeviceSize(1));
+
+    /* Align current position, or wrap around to the beginning if the region does not fit before the end */
+    const auto position = head_ % size_;
+    auto offset         = (position + alignment - 1) / alignment * alignment;
+    auto nextHead       = head_ + (offset - position) + size;
+
+    if (offset + size > size_)
+    {
+        offset      = 0;
+        nextHead    = head_ + (size_ - position) + size;
+    }
+
+    /* Check if the region would overlap with allocations that have not been released yet */
+    if (nextHead - tail_ > size_)
+        return false;
+
+    head_ = nextHead;
+
+    region.buffer   = bufferObj_.GetVkBuffer();
+    region.offset   = offset;
+    region.data     = mappedData_ + offset;
+
+    return true;
+}
+
+void VKStagingRingBuffer::Release(VkDeviceSize marker)
+{
+    tail_ = std::max(tail_, std::min(marker, head_));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
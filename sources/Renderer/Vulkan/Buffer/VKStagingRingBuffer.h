@@ -0,0 +1,83 @@
+/*
+ * VKStagingRingBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_STAGING_RING_BUFFER_H
+#define LLGL_VK_STAGING_RING_BUFFER_H
+
+
+#include "VKDeviceBuffer.h"
+#include "../Memory/VKDeviceMemory.h"
+
+
+namespace LLGL
+{
+
+
+// Region of host visible staging memory that can be used as source for transfer commands.
+struct VKStagingRegion
+{
+    VkBuffer        buffer  = VK_NULL_HANDLE;
+    VkDeviceSize    offset  = 0;
+    void*           data    = nullptr;
+};
+
+/*
+Persistently mapped staging buffer that is sub-allocated in a circular manner.
+Allocations are released in the same order they were made, by passing the marker that was returned from 'GetHead' after the last allocation to be released.
+*/
+class VKStagingRingBuffer
+{
+
+    public:
+
+        VKStagingRingBuffer(
+            const VKPtr<VkDevice>&                  device,
+            const VkPhysicalDeviceMemoryProperties& memoryProperties,
+            VkDeviceSize                            size
+        );
+
+        VKStagingRingBuffer(const VKStagingRingBuffer&) = delete;
+        VKStagingRingBuffer& operator = (const VKStagingRingBuffer&) = delete;
+
+        // Tries to allocate a region of the specified size and alignment, and returns false if there is not enough contiguous space left.
+        bool Allocate(VkDeviceSize size, VkDeviceSize alignment, VKStagingRegion& region);
+
+        // Releases all allocations up to the specified marker (see GetHead).
+        void Release(VkDeviceSize marker);
+
+        // Returns the marker for the end of the last allocation. This is a monotonically increasing value.
+        inline VkDeviceSize GetHead() const
+        {
+            return head_;
+        }
+
+        // Returns the size of the entire ring buffer.
+        inline VkDeviceSize GetSize() const
+        {
+            return size_;
+        }
+
+    private:
+
+        VKDeviceBuffer  bufferObj_;
+        VKDeviceMemory  deviceMemory_;
+        char*           mappedData_ = nullptr;
+        VkDeviceSize    size_       = 0;
+        VkDeviceSize    head_       = 0;
+        VkDeviceSize    tail_       = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
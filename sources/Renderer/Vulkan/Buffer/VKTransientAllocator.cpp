@@ -0,0 +1,131 @@
+/*
+ * VKTransientAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKTransientAllocator.h"
+#include "../VKCore.h"
+#include "../VKInitializers.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+VKTransientAllocator::VKTransientAllocator(
+    const VKPtr<VkDevice>&  device,
+    VKDeviceMemoryManager&  deviceMemoryMngr,
+    VkDeviceSize            pageSize,
+    std::uint32_t           maxIdleResets) :
+        device_           { device           },
+        deviceMemoryMngr_ { deviceMemoryMngr },
+        pageSize_         { pageSize         },
+        maxIdleResets_    { maxIdleResets    }
+{
+}
+
+VKTransientAllocator::~VKTransientAllocator()
+{
+    while (!pages_.empty())
+        ReleaseLastPage();
+}
+
+VKStagingRegion VKTransientAllocator::Allocate(const void* data, VkDeviceSize dataSize, VkDeviceSize alignment)
+{
+    /* Find page with enough space left, starting with the current page */
+    for (; pageIndex_ < pages_.size(); ++pageIndex_, offset_ = 0)
+    {
+        if (GetAlignedSize(offset_, alignment) + dataSize <= pages_[pageIndex_].size)
+            break;
+    }
+
+    if (pageIndex_ == pages_.size())
+        CreatePage(std::max(pageSize_, dataSize));
+
+    /* Bump offset within current page */
+    auto& page = pages_[pageIndex_];
+
+    VKStagingRegion region;
+    {
+        region.buffer   = page.bufferObj.GetVkBuffer();
+        region.offset   = GetAlignedSize(offset_, alignment);
+        region.data     = page.mappedData + region.offset;
+    }
+    ::memcpy(region.data, data, static_cast<std::size_t>(dataSize));
+
+    offset_ = region.offset + dataSize;
+
+    return region;
+}
+
+void VKTransientAllocator::Reset()
+{
+    /* Pages are always used in order, so all pages before the current one and the current one (if it has any allocation) have been used */
+    const auto numUsedPages = (offset_ > 0 ? pageIndex_ + 1 : pageIndex_);
+
+    for (std::size_t i = 0; i < pages_.size(); ++i)
+    {
+        if (i < numUsedPages)
+            pages_[i].idleResets = 0;
+        else
+            pages_[i].idleResets++;
+    }
+
+    /* Release idle pages from the back, since later pages have always been idle at least as long as earlier ones */
+    while (!pages_.empty() && pages_.back().idleResets >= maxIdleResets_)
+        ReleaseLastPage();
+
+    pageIndex_  = 0;
+    offset_     = 0;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKTransientAllocator::CreatePage(VkDeviceSize size)
+{
+    VkBufferCreateInfo createInfo;
+    BuildVkBufferCreateInfo(createInfo, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+    VKDeviceBuffer bufferObj { device_, createInfo };
+
+    /* Pages are persistently mapped, so they must not share their device memory chunk with other allocations */
+    auto memoryRegion = deviceMemoryMngr_.Allocate(
+        bufferObj.GetRequirements(),
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        true
+    );
+
+    if (memoryRegion == nullptr)
+        throw std::runtime_error("failed to allocate " + std::to_string(size) + " byte(s) of device memory for Vulkan transient buffer");
+
+    bufferObj.BindMemoryRegion(device_, memoryRegion);
+
+    auto mappedData = reinterpret_cast<char*>(bufferObj.Map(device_));
+
+    Page page { std::move(bufferObj), size, mappedData, 0 };
+    pages_.push_back(std::move(page));
+}
+
+void VKTransientAllocator::ReleaseLastPage()
+{
+    auto& page = pages_.back();
+    page.bufferObj.Unmap(device_);
+    page.bufferObj.ReleaseMemoryRegion(deviceMemoryMngr_);
+    pages_.pop_back();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,91 @@
+/*
+ * VKTransientAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_TRANSIENT_ALLOCATOR_H
+#define LLGL_VK_TRANSIENT_ALLOCATOR_H
+
+
+#include "VKDeviceBuffer.h"
+#include "VKStagingRingBuffer.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class VKDeviceMemoryManager;
+
+/*
+Linear allocator for transient data that is only referenced by a single command buffer recording, e.g. constant buffer updates.
+Each allocation is a pointer bump into a persistently mapped host visible page; when a page is exhausted, the next page is used or a new one is created.
+All pages are reused at once after 'Reset' has been called, which must not happen before the referencing command buffer has been completed.
+Pages that have not been used for a number of consecutive recordings are released in 'Reset', so peak usage does not keep its memory forever.
+*/
+class VKTransientAllocator
+{
+
+    public:
+
+        VKTransientAllocator(
+            const VKPtr<VkDevice>&  device,
+            VKDeviceMemoryManager&  deviceMemoryMngr,
+            VkDeviceSize            pageSize,
+            std::uint32_t           maxIdleResets
+        );
+        ~VKTransientAllocator();
+
+        VKTransientAllocator(const VKTransientAllocator&) = delete;
+        VKTransientAllocator& operator = (const VKTransientAllocator&) = delete;
+
+        // Copies the data into transient memory with the specified alignment and returns its region.
+        VKStagingRegion Allocate(const void* data, VkDeviceSize dataSize, VkDeviceSize alignment = 1);
+
+        // Makes all pages available for new allocations, and releases the pages that have not been used since the last 'maxIdleResets' calls.
+        void Reset();
+
+    private:
+
+        struct Page
+        {
+            VKDeviceBuffer  bufferObj;
+            VkDeviceSize    size;
+            char*           mappedData;
+            std::uint32_t   idleResets;     // Number of consecutive resets this page has not been used before
+        };
+
+    private:
+
+        // Creates a new page with at least the specified size.
+        void CreatePage(VkDeviceSize size);
+
+        // Unmaps and releases the last page.
+        void ReleaseLastPage();
+
+    private:
+
+        const VKPtr<VkDevice>&  device_;
+        VKDeviceMemoryManager&  deviceMemoryMngr_;
+        VkDeviceSize            pageSize_       = 0;
+        std::uint32_t           maxIdleResets_  = 0;
+
+        std::vector<Page>       pages_;
+        std::size_t             pageIndex_      = 0;
+        VkDeviceSize            offset_         = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
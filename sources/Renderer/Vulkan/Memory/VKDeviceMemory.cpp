@@ -14,11 +14,76 @@ namespace LLGL
 {
 
 
-VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex) :
+/*
+ * Internal functions
+ */
+
+// Returns the index of the most significant bit; the input must not be zero.
+static std::uint32_t BitScanReverse(std::uint64_t x)
+{
+    std::uint32_t i = 0;
+    while (x >>= 1)
+        ++i;
+    return i;
+}
+
+// Returns the index of the least significant bit; the input must not be zero.
+static std::uint32_t BitScanForward(std::uint64_t x)
+{
+    std::uint32_t i = 0;
+    while ((x & 1) == 0)
+    {
+        x >>= 1;
+        ++i;
+    }
+    return i;
+}
+
+/*
+Maps the specified size to its free-list indices: the first level is the power of two of the size,
+and the second level linearly subdivides this range. Sizes below the number of second levels are all mapped to the first level 0.
+*/
+static void MapSizeToFreeList(VkDeviceSize size, std::uint32_t secondLevelBits, std::uint32_t& firstLevel, std::uint32_t& secondLevel)
+{
+    const VkDeviceSize numSecondLevels = (VkDeviceSize(1) << secondLevelBits);
+    if (size < numSecondLevels)
+    {
+        firstLevel  = 0;
+        secondLevel = static_cast<std::uint32_t>(size);
+    }
+    else
+    {
+        const auto msb = BitScanReverse(size);
+        firstLevel  = msb - secondLevelBits + 1;
+        secondLevel = static_cast<std::uint32_t>((size >> (msb - secondLevelBits)) & (numSecondLevels - 1));
+    }
+}
+
+// Rounds the specified size up to the next size class, so that each block in the respective free-list is large enough.
+static VkDeviceSize RoundUpToSizeClass(VkDeviceSize size, std::uint32_t secondLevelBits)
+{
+    if (size >= (VkDeviceSize(1) << secondLevelBits))
+        size += (VkDeviceSize(1) << (BitScanReverse(size) - secondLevelBits)) - 1;
+    return size;
+}
+
+// Returns true if a block of the specified size and alignment fits into the specified region.
+static bool FitsIntoBlock(const VKDeviceMemoryRegion& region, VkDeviceSize alignedSize, VkDeviceSize alignment)
+{
+    const auto alignedOffset = GetAlignedSize(region.GetOffset(), alignment);
+    return (alignedOffset - region.GetOffset() + alignedSize <= region.GetSize());
+}
+
+
+/*
+ * VKDeviceMemory class
+ */
+
+VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex, bool dedicated) :
     deviceMemory_    { device, vkFreeMemory },
     size_            { size                 },
     memoryTypeIndex_ { memoryTypeIndex      },
-    maxNewBlockSize_ { size                 }
+    dedicated_       { dedicated            }
 {
     /* Allocate device memory */
     VkMemoryAllocateInfo allocInfo;
@@ -35,6 +100,11 @@ VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size,
         std::string info = "failed to allocate Vulkan device memory of " + std::to_string(size) + " bytes";
         VKThrowIfFailed(result, info.c_str());
     }
+
+    /* Initialize a single free block that spans the entire chunk */
+    firstBlock_ = MakeBlock(size, 0);
+    lastBlock_  = firstBlock_;
+    InsertFreeBlock(firstBlock_);
 }
 
 void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size)
@@ -52,33 +122,29 @@ void VKDeviceMemory::Unmap(VkDevice device)
     vkUnmapMemory(device, deviceMemory_);
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation)
+VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment)
 {
     if (size > 0 && alignment > 0)
     {
-        /* Adjust size and offset by alignment */
-        auto alignedSize    = GetAlignedSize(size, alignment);
-        auto alignedOffset  = GetAlignedSize(GetNextOffset(), alignment);
+        const auto alignedSize = GetAlignedSize(size, alignment);
 
-        if (reduceFragmentation)
+        if (auto block = FindFreeBlock(alignedSize, alignment))
         {
-            /* Reuse fragmented block */
-            if (alignedSize <= maxFragmentedBlockSize_)
-                return FindReusableBlock(alignedSize, alignment);
+            RemoveFreeBlock(block);
 
-            /* Allocate block with aligned size and offset */
-            if (alignedSize + alignedOffset <= GetSize())
-                return AllocAndAppendBlock(alignedSize, alignedOffset);
-        }
-        else
-        {
-            /* Allocate block with aligned size and offset */
-            if (alignedSize + alignedOffset <= GetSize())
-                return AllocAndAppendBlock(alignedSize, alignedOffset);
+            /* Split off padding in front of the aligned offset as new free block */
+            const auto alignedOffset = GetAlignedSize(block->GetOffset(), alignment);
+            if (alignedOffset > block->GetOffset())
+                SplitBlock(block, alignedOffset - block->GetOffset(), true);
 
-            /* Reuse fragmented block */
-            if (alignedSize <= maxFragmentedBlockSize_)
-                return FindReusableBlock(alignedSize, alignment);
+            /* Split off remaining space behind the allocated block as new free block */
+            if (block->GetSize() > alignedSize)
+                SplitBlock(block, alignedSize, false);
+
+            ++numBlocks_;
+            usedSize_ += block->GetSize();
+
+            return block;
         }
     }
     return nullptr;
@@ -86,44 +152,92 @@ VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize a
 
 void VKDeviceMemory::Release(VKDeviceMemoryRegion* region)
 {
-    if (region)
+    if (region != nullptr && region->GetParentChunk() == this && !region->IsFree())
     {
-        /* Increase maximal size of fragmented blocks */
-        maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, region->GetSize());
+        --numBlocks_;
+        usedSize_ -= region->GetSize();
 
-        auto it = std::find_if(
-            blocks_.begin(), blocks_.end(),
-            [region](const std::unique_ptr<VKDeviceMemoryRegion>& entry)
+        /* Merge block with its lower neighbour: [LOWER][BLOCK] --> [+++LOWER++++] */
+        if (auto lower = region->prevPhysical_)
+        {
+            if (lower->IsFree())
             {
-                return (entry.get() == region);
+                RemoveFreeBlock(lower);
+                lower->MergeWith(*region);
+                RecycleBlock(region);
+                region = lower;
             }
-        );
+        }
 
-        if (it != blocks_.end())
+        /* Merge upper neighbour into block: [BLOCK][UPPER] --> [+++BLOCK++++] */
+        if (auto upper = region->nextPhysical_)
         {
-            InsertBlockToFragmentsSorted(std::move(*it));
-            blocks_.erase(it);
+            if (upper->IsFree())
+            {
+                RemoveFreeBlock(upper);
+                region->MergeWith(*upper);
+                RecycleBlock(upper);
+            }
         }
+
+        InsertFreeBlock(region);
     }
 }
 
 bool VKDeviceMemory::IsEmpty() const
 {
-    return blocks_.empty();
+    return (numBlocks_ == 0);
+}
+
+bool VKDeviceMemory::CanAllocate(VkDeviceSize size, VkDeviceSize alignment) const
+{
+    if (size > 0 && alignment > 0)
+    {
+        const auto alignedSize = GetAlignedSize(size, alignment);
+        return (FindFreeBlock(alignedSize, alignment) != nullptr);
+    }
+    return false;
 }
 
 VkDeviceSize VKDeviceMemory::GetMaxAllocationSize() const
 {
-    return std::max(maxNewBlockSize_, maxFragmentedBlockSize_);
+    VkDeviceSize maxSize = 0;
+
+    if (firstLevelBitmap_ != 0)
+    {
+        /* Only the free-list of the highest size class must be searched for the largest block */
+        const auto firstLevel   = BitScanReverse(firstLevelBitmap_);
+        const auto secondLevel  = BitScanReverse(secondLevelBitmaps_[firstLevel]);
+
+        for (auto block = freeLists_[firstLevel][secondLevel]; block != nullptr; block = block->nextFree_)
+            maxSize = std::max(maxSize, block->GetSize());
+    }
+
+    return maxSize;
 }
 
 void VKDeviceMemory::AccumDetails(VKDeviceMemoryDetails& details) const
 {
-    details.numChunks               += 1;
-    details.numBlocks               += blocks_.size();
-    details.numFragments            += fragmentedBlocks_.size();
-    details.maxNewBlockSize         = std::max(details.maxNewBlockSize, maxNewBlockSize_);
-    details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, maxFragmentedBlockSize_);
+    details.numChunks   += 1;
+    details.numBlocks   += numBlocks_;
+    details.totalSize   += GetSize();
+    details.usedSize    += GetUsedSize();
+
+    /* Free block at the end of the chunk counts as new block, all others as fragments */
+    for (auto block = firstBlock_; block != nullptr; block = block->nextPhysical_)
+    {
+        if (block->IsFree())
+        {
+            if (block == lastBlock_)
+                details.maxNewBlockSize = std::max(details.maxNewBlockSize, block->GetSize());
+            else
+            {
+                details.numFragments            += 1;
+                details.fragmentedSize          += block->GetSize();
+                details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, block->GetSize());
+            }
+        }
+    }
 }
 
 #ifdef LLGL_DEBUG
@@ -179,20 +293,26 @@ static void PrintDeviceMemoryRegion(std::ostream& s, VKDeviceMemoryRegion& regio
 void VKDeviceMemory::PrintBlocks(std::ostream& s) const
 {
     VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : blocks_)
+    for (auto block = firstBlock_; block != nullptr; block = block->nextPhysical_)
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        if (!block->IsFree())
+        {
+            PrintDeviceMemoryRegion(s, *block, prevBlock);
+            prevBlock = block;
+        }
     }
 }
 
 void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
 {
     VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : fragmentedBlocks_)
+    for (auto block = firstBlock_; block != nullptr && block != lastBlock_; block = block->nextPhysical_)
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        if (block->IsFree())
+        {
+            PrintDeviceMemoryRegion(s, *block, prevBlock);
+            prevBlock = block;
+        }
     }
 }
 
@@ -203,238 +323,181 @@ void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
  * ======= Private: =======
  */
 
-VkDeviceSize VKDeviceMemory::GetNextOffset() const
+VKDeviceMemoryRegion* VKDeviceMemory::FindFreeBlockInSizeClass(VkDeviceSize size) const
 {
-    if (blocks_.empty())
-        return 0;
-    else
-        return blocks_.back()->GetOffsetWithSize();
-}
+    std::uint32_t firstLevel = 0, secondLevel = 0;
+    MapSizeToFreeList(RoundUpToSizeClass(size, secondLevelBits), secondLevelBits, firstLevel, secondLevel);
 
-std::unique_ptr<VKDeviceMemoryRegion> VKDeviceMemory::MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
-{
-    return MakeUnique<VKDeviceMemoryRegion>(this, alignedSize, alignedOffset, memoryTypeIndex_);
-}
+    if (firstLevel >= numFirstLevels)
+        return nullptr;
 
-VKDeviceMemoryRegion* VKDeviceMemory::AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
-{
-    /* Update maximal free block size */
-    maxNewBlockSize_ = GetSize() - (alignedSize + alignedOffset);
+    /* Search for non-empty free-list in the same first level, starting at the requested size class */
+    auto secondLevelBitmap = (secondLevelBitmaps_[firstLevel] & (~0u << secondLevel));
+    if (secondLevelBitmap == 0)
+    {
+        /* Search for non-empty free-list in the next higher first levels */
+        if (firstLevel + 1 >= numFirstLevels)
+            return nullptr;
 
-    /* Check if the aligned offset results in a new fragment */
-    const auto nextOffset = GetNextOffset();
+        const auto firstLevelBitmap = (firstLevelBitmap_ & (~std::uint64_t(0) << (firstLevel + 1)));
+        if (firstLevelBitmap == 0)
+            return nullptr;
 
-    if (nextOffset < alignedOffset)
-    {
-        /*
-        Check if new fragment can be immediately merged with previous fragment:
-        Before: blocks:    [++]........[++++]
-                fragments: ....[++++]
-        After:  blocks:    [++]........[++++]
-                fragments: ....[++++++]
-        */
-        if (!fragmentedBlocks_.empty() && fragmentedBlocks_.back()->GetOffset() == nextOffset)
-        {
-            /* Resize last fragmented block */
-            fragmentedBlocks_.back()->MoveAt(alignedOffset - nextOffset, nextOffset);
-        }
-        else
-        {
-            /* Append new fragmented block at the end */
-            fragmentedBlocks_.push_back(MakeUniqueBlock(alignedOffset - nextOffset, nextOffset));
-        }
-    }
-    else
-    {
-        /* Check if last fragmented block can be replaced by new block */
-        if (!fragmentedBlocks_.empty() && fragmentedBlocks_.back()->GetOffset() == nextOffset)
-        {
-            /* Move fragmented block into main blocks and resize it */
-            auto block = TakeOwnership(blocks_, std::move(fragmentedBlocks_.back()));
-            block->MoveAt(alignedSize, alignedOffset);
-            fragmentedBlocks_.pop_back();
-            return block;
-        }
+        firstLevel          = BitScanForward(firstLevelBitmap);
+        secondLevelBitmap   = secondLevelBitmaps_[firstLevel];
     }
 
-    /* Allocate new block */
-    return TakeOwnership(blocks_, MakeUniqueBlock(alignedSize, alignedOffset));
+    return freeLists_[firstLevel][BitScanForward(secondLevelBitmap)];
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region)
+VKDeviceMemoryRegion* VKDeviceMemory::FindFreeBlock(VkDeviceSize alignedSize, VkDeviceSize alignment) const
 {
-    auto regionRef = region.get();
-
-    /* Add block by insertion sort */
-    if (!blocks_.empty())
+    /* Find free block in constant time; if its offset is misaligned, search again with enough space for the worst-case padding */
+    if (auto block = FindFreeBlockInSizeClass(alignedSize))
     {
-        for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it)
-        {
-            if ((*it)->GetOffset() < region->GetOffset())
-            {
-                blocks_.insert(it.base(), std::move(region));
-                break;
-            }
-        }
+        if (FitsIntoBlock(*block, alignedSize, alignment))
+            return block;
     }
-    else
-        blocks_.emplace_back(std::move(region));
-
-    return regionRef;
-}
-
-VKDeviceMemoryRegion* VKDeviceMemory::FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment)
-{
-    VKDeviceMemoryRegion* prevBlock = nullptr;
-    VKDeviceMemoryRegion* nextBlock = nullptr;
 
-    /* Search for fragmented block that fits the requirement */
-    for (auto it = fragmentedBlocks_.begin(); it != fragmentedBlocks_.end(); ++it)
+    if (alignment > 1)
     {
-        auto block = it->get();
-
-        /* Check if required size plus the additional aligned offset fits into the current block */
-        const auto alignedOffset = GetAlignedSize(block->GetOffset(), alignment);
-        if (alignedSize + alignedOffset - block->GetOffset() <= block->GetSize())
-        {
-            /* If this block has the maximum fragmented block size, this value must be updated */
-            const bool mustUpdateMaxSize = (block->GetSize() == maxFragmentedBlockSize_);
-
-            /* If block can be reused with its entire size, it can be removed from the fragmented blocks */
-            InsertBlock(std::move(*it));
-
-            it = fragmentedBlocks_.erase(it);
-            if (it != fragmentedBlocks_.end())
-                nextBlock = it->get();
-
-            /* Check if block must be split up at the lower part */
-            if (block->GetOffset() < alignedOffset)
-            {
-                /* Allocate fragmented lower block (left to the current block) */
-                auto blockLower = MakeUniqueBlock(alignedOffset - block->GetOffset(), block->GetOffset());
-
-                if (!prevBlock || !MergeFragmentedBlockWith(*prevBlock, *blockLower))
-                {
-                    it = fragmentedBlocks_.insert(it, std::move(blockLower));
-                    ++it;
-                }
-            }
-
-            /* Check if block must be split up at the upper part */
-            auto alignedSizeWithOffset = alignedSize + alignedOffset - block->GetOffset();
-            if (alignedSizeWithOffset < block->GetSize())
-            {
-                /* Allocate fragmented upper block (right to the current block) */
-                auto blockUpperSize = block->GetSize() - alignedSizeWithOffset;
-                auto blockUpper     = MakeUniqueBlock(blockUpperSize, block->GetOffsetWithSize() - blockUpperSize);
-
-                if (!nextBlock || !MergeFragmentedBlockWith(*blockUpper, *nextBlock))
-                    fragmentedBlocks_.insert(it, std::move(blockUpper));
-            }
-
-            /* Move reused block to new offset and size */
-            block->MoveAt(alignedSize, alignedOffset);
+        if (auto block = FindFreeBlockInSizeClass(alignedSize + alignment - 1))
+            return block;
+    }
 
-            if (mustUpdateMaxSize)
-                UpdateMaxFragmentedBlockSize();
+    /*
+    Size classes are rounded up, so a block that fits exactly is only found in the free-list of the requested size itself,
+    e.g. for a chunk that is dedicated to a single allocation
+    */
+    std::uint32_t firstLevel = 0, secondLevel = 0;
+    MapSizeToFreeList(alignedSize, secondLevelBits, firstLevel, secondLevel);
 
-            /* Reuse current block */
+    for (auto block = freeLists_[firstLevel][secondLevel]; block != nullptr; block = block->nextFree_)
+    {
+        if (FitsIntoBlock(*block, alignedSize, alignment))
             return block;
-        }
-
-        prevBlock = block;
     }
 
-    /* No reusable block found */
     return nullptr;
 }
 
-void VKDeviceMemory::UpdateMaxFragmentedBlockSize()
+void VKDeviceMemory::InsertFreeBlock(VKDeviceMemoryRegion* region)
 {
-    maxFragmentedBlockSize_ = 0;
-    for (const auto& block : fragmentedBlocks_)
-        maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, block->GetSize());
+    std::uint32_t firstLevel = 0, secondLevel = 0;
+    MapSizeToFreeList(region->GetSize(), secondLevelBits, firstLevel, secondLevel);
+
+    /* Insert block at the front of its free-list */
+    auto& head = freeLists_[firstLevel][secondLevel];
+    {
+        region->free_       = true;
+        region->prevFree_   = nullptr;
+        region->nextFree_   = head;
+        if (head != nullptr)
+            head->prevFree_ = region;
+    }
+    head = region;
+
+    firstLevelBitmap_                   |= (std::uint64_t(1) << firstLevel);
+    secondLevelBitmaps_[firstLevel]     |= (1u << secondLevel);
 }
 
-void VKDeviceMemory::InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region)
+void VKDeviceMemory::RemoveFreeBlock(VKDeviceMemoryRegion* region)
 {
-    auto offset = region->GetOffset();
-    auto count  = fragmentedBlocks_.size();
+    std::uint32_t firstLevel = 0, secondLevel = 0;
+    MapSizeToFreeList(region->GetSize(), secondLevelBits, firstLevel, secondLevel);
 
-    /* Start serach in half-open range [begin, end) */
-    decltype(count) begin = 0, end = count;
+    /* Unlink block from its free-list */
+    if (region->prevFree_ != nullptr)
+        region->prevFree_->nextFree_ = region->nextFree_;
+    else
+        freeLists_[firstLevel][secondLevel] = region->nextFree_;
 
-    while (begin + 2 < end)
-    {
-        /* Check if region's offset is before or after the middle's element */
-        auto center = (begin + end) / 2;
+    if (region->nextFree_ != nullptr)
+        region->nextFree_->prevFree_ = region->prevFree_;
 
-        if (offset < fragmentedBlocks_[center]->GetOffset())
-        {
-            /* Restrict search to lower half */
-            end = center + 1;
-        }
-        else
-        {
-            /* Restrict search to upper half */
-            begin = center;
-        }
-    }
+    region->free_       = false;
+    region->prevFree_   = nullptr;
+    region->nextFree_   = nullptr;
 
-    /* Insert region by insertion-sort of the remaining half-open range [begin, begin + 2) */
-    if (begin < count && offset < fragmentedBlocks_[begin]->GetOffset())
-        InsertBlockToFragmentsAt(std::move(region), begin);
-    else if (begin + 1 < count)
+    /* Clear bitmap entries if the free-list has become empty */
+    if (freeLists_[firstLevel][secondLevel] == nullptr)
     {
-        if (offset < fragmentedBlocks_[begin + 1]->GetOffset())
-            InsertBlockToFragmentsAt(std::move(region), begin + 1);
-        else
-            InsertBlockToFragmentsAt(std::move(region), begin + 2);
+        secondLevelBitmaps_[firstLevel] &= ~(1u << secondLevel);
+        if (secondLevelBitmaps_[firstLevel] == 0)
+            firstLevelBitmap_ &= ~(std::uint64_t(1) << firstLevel);
     }
-    else
-        InsertBlockToFragmentsAt(std::move(region), count);
 }
 
-void VKDeviceMemory::InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position)
+void VKDeviceMemory::SplitBlock(VKDeviceMemoryRegion* region, VkDeviceSize relativeOffset, bool lowerPartIsFree)
 {
-    auto count = fragmentedBlocks_.size();
+    const auto offset   = region->GetOffset();
+    const auto size     = region->GetSize();
 
-    /* Try to merge region into lower part: [LOWER][BLOCK] --> [+++LOWER++++] */
-    if (position > 0 && MergeFragmentedBlockWith(*fragmentedBlocks_[position - 1], *region))
+    if (lowerPartIsFree)
     {
-        /* Try to merge upper part into lower part: [+++LOWER++++][UPPER] --> [+++++++LOWER+++++++] */
-        if (position < count && MergeFragmentedBlockWith(*fragmentedBlocks_[position - 1], *fragmentedBlocks_[position]))
+        /* Insert new free block in front of the specified block: [BLOCK] --> [LOWER][BLOCK] */
+        auto lower = MakeBlock(relativeOffset, offset);
         {
-            /* Remove previous upper part after two-phase-merge */
-            fragmentedBlocks_.erase(fragmentedBlocks_.begin() + position);
+            lower->prevPhysical_ = region->prevPhysical_;
+            lower->nextPhysical_ = region;
+            if (region->prevPhysical_ != nullptr)
+                region->prevPhysical_->nextPhysical_ = lower;
+            else
+                firstBlock_ = lower;
+            region->prevPhysical_ = lower;
         }
+        region->MoveAt(size - relativeOffset, offset + relativeOffset);
+        InsertFreeBlock(lower);
     }
-    /* Try to merge region into upper part: [BLOCK][UPPER] --> [+++UPPER++++] */
-    else if (position >= count || !MergeFragmentedBlockWith(*fragmentedBlocks_[position], *region))
+    else
     {
-        /* Insert new fragmented block: [LOWER]..[BLOCK]..[UPPER] */
-        fragmentedBlocks_.insert(fragmentedBlocks_.begin() + position, std::move(region));
+        /* Insert new free block behind the specified block: [BLOCK] --> [BLOCK][UPPER] */
+        auto upper = MakeBlock(size - relativeOffset, offset + relativeOffset);
+        {
+            upper->prevPhysical_ = region;
+            upper->nextPhysical_ = region->nextPhysical_;
+            if (region->nextPhysical_ != nullptr)
+                region->nextPhysical_->prevPhysical_ = upper;
+            else
+                lastBlock_ = upper;
+            region->nextPhysical_ = upper;
+        }
+        region->MoveAt(relativeOffset, offset);
+        InsertFreeBlock(upper);
     }
 }
 
-bool VKDeviceMemory::MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion)
+VKDeviceMemoryRegion* VKDeviceMemory::MakeBlock(VkDeviceSize size, VkDeviceSize offset)
 {
-    if (region.MergeWith(appendixRegion))
+    if (!unusedBlocks_.empty())
     {
-        IncMaxFragmentedBlockSize(region.GetSize());
-        return true;
+        /* Reuse block object that has been merged into another block */
+        auto block = unusedBlocks_.back();
+        unusedBlocks_.pop_back();
+        block->MoveAt(size, offset);
+        return block;
     }
-    return false;
+    return TakeOwnership(blockPool_, MakeUnique<VKDeviceMemoryRegion>(this, size, offset, memoryTypeIndex_));
 }
 
-VkDeviceSize VKDeviceMemory::GetFragmentBlockOffsetEnd(std::size_t position) const
+void VKDeviceMemory::RecycleBlock(VKDeviceMemoryRegion* region)
 {
-    return fragmentedBlocks_[position]->GetOffsetWithSize();
-}
+    /* Unlink block from physical block list */
+    if (region->prevPhysical_ != nullptr)
+        region->prevPhysical_->nextPhysical_ = region->nextPhysical_;
+    else
+        firstBlock_ = region->nextPhysical_;
 
-void VKDeviceMemory::IncMaxFragmentedBlockSize(VkDeviceSize size)
-{
-    maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, size);
+    if (region->nextPhysical_ != nullptr)
+        region->nextPhysical_->prevPhysical_ = region->prevPhysical_;
+    else
+        lastBlock_ = region->prevPhysical_;
+
+    region->prevPhysical_   = nullptr;
+    region->nextPhysical_   = nullptr;
+    region->free_           = false;
+
+    unusedBlocks_.push_back(region);
 }
 
 
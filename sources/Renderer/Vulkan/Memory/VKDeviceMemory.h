@@ -33,27 +33,32 @@ struct VKDeviceMemoryDetails
     std::size_t     numFragments            = 0;
     VkDeviceSize    maxNewBlockSize         = 0;
     VkDeviceSize    maxFragmentedBlockSize  = 0;
+    VkDeviceSize    totalSize               = 0;
+    VkDeviceSize    usedSize                = 0;
+    VkDeviceSize    fragmentedSize          = 0;
 };
 
-// An instance of this class holds a single VkDeviceMemory allocation chunk.
+/*
+An instance of this class holds a single VkDeviceMemory allocation chunk.
+Sub-regions are managed by a two-level segregated fit (TLSF) allocator:
+free blocks are kept in size-segregated free-lists indexed by two bitmaps, so allocation and release run in constant time.
+Released blocks are immediately merged with their physically adjacent free blocks.
+*/
 class VKDeviceMemory
 {
 
     public:
 
-        VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex);
+        VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex, bool dedicated = false);
 
         VKDeviceMemory(const VKDeviceMemory&) = delete;
         VKDeviceMemory& operator = (const VKDeviceMemory&) = delete;
 
-        VKDeviceMemory(VKDeviceMemory&&) = default;
-        VKDeviceMemory& operator = (VKDeviceMemory&&) = default;
-
         void* Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size);
         void Unmap(VkDevice device);
 
         // Tries to allocate a new block within this device memory chunk, and returns null of failure.
-        VKDeviceMemoryRegion* Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation = false);
+        VKDeviceMemoryRegion* Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
         // Releases the specified block within this device memory chunk.
         void Release(VKDeviceMemoryRegion* region);
@@ -61,6 +66,9 @@ class VKDeviceMemory
         // Returns true if this device memory has no more blocks.
         bool IsEmpty() const;
 
+        // Returns true if a block of the specified size and alignment can be allocated within this device memory chunk.
+        bool CanAllocate(VkDeviceSize size, VkDeviceSize alignment) const;
+
         // Returns the maximal size that can be allocated for a device memory region within this device memory chunk.
         VkDeviceSize GetMaxAllocationSize() const;
 
@@ -92,50 +100,69 @@ class VKDeviceMemory
             return memoryTypeIndex_;
         }
 
-    private:
+        // Returns the accumulated size of all allocated blocks.
+        inline VkDeviceSize GetUsedSize() const
+        {
+            return usedSize_;
+        }
+
+        // Returns the number of allocated blocks.
+        inline std::size_t GetNumBlocks() const
+        {
+            return numBlocks_;
+        }
 
-        // Returns the next offset after the last block.
-        VkDeviceSize GetNextOffset() const;
+        // Returns true if this device memory chunk is dedicated to a single resource, i.e. it is never shared with other allocations.
+        inline bool IsDedicated() const
+        {
+            return dedicated_;
+        }
 
-        // Makes a new device memory block.
-        std::unique_ptr<VKDeviceMemoryRegion> MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+    private:
 
-        // Allocates a new block.
-        VKDeviceMemoryRegion* AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+        static const std::uint32_t secondLevelBits      = 4;
+        static const std::uint32_t numSecondLevels      = (1u << secondLevelBits);
+        static const std::uint32_t numFirstLevels       = 64;
 
-        // Inserts the specified region into the main block list by insertion-sort.
-        VKDeviceMemoryRegion* InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region);
+    private:
 
-        // Tries to find a fragmented block that can be reused.
-        VKDeviceMemoryRegion* FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment);
+        // Returns the first free block whose size class is large enough for the specified size, or null if there is none.
+        VKDeviceMemoryRegion* FindFreeBlockInSizeClass(VkDeviceSize size) const;
 
-        // Updates the maximal size of fragmanted blocks.
-        void UpdateMaxFragmentedBlockSize();
+        // Returns a free block that can hold the specified aligned size with the specified alignment, or null if there is none.
+        VKDeviceMemoryRegion* FindFreeBlock(VkDeviceSize alignedSize, VkDeviceSize alignment) const;
 
-        // Inserts the specified region into the fragmented block list by insertion-sort.
-        void InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region);
+        // Inserts the specified block into the free-list that corresponds to its size.
+        void InsertFreeBlock(VKDeviceMemoryRegion* region);
 
-        // Inserts the specified region into the fragmented block list at the specified position and merges it with surrounding blocks if possible.
-        void InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position);
+        // Removes the specified block from its free-list.
+        void RemoveFreeBlock(VKDeviceMemoryRegion* region);
 
-        // Merges the two fragmented blocks and records the maximal fragmented block size.
-        bool MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion);
+        // Splits off a new free block from the specified block, which starts at the specified offset relative to the block's offset.
+        void SplitBlock(VKDeviceMemoryRegion* region, VkDeviceSize relativeOffset, bool lowerPartIsFree);
 
-        // Returns the offset after the specified fragmented block.
-        VkDeviceSize GetFragmentBlockOffsetEnd(std::size_t position) const;
+        // Returns a recycled or new block object that is not linked yet.
+        VKDeviceMemoryRegion* MakeBlock(VkDeviceSize size, VkDeviceSize offset);
 
-        // Increases the maximal fragmented block size.
-        void IncMaxFragmentedBlockSize(VkDeviceSize size);
+        // Unlinks the specified block from the physical block list and stores it for later reuse.
+        void RecycleBlock(VKDeviceMemoryRegion* region);
 
         VKPtr<VkDeviceMemory>                               deviceMemory_;
-        VkDeviceSize                                        size_                   = 0;
-        std::uint32_t                                       memoryTypeIndex_        = 0;
+        VkDeviceSize                                        size_                                       = 0;
+        std::uint32_t                                       memoryTypeIndex_                            = 0;
+        bool                                                dedicated_                                  = false;
+
+        VKDeviceMemoryRegion*                               firstBlock_                                 = nullptr;
+        VKDeviceMemoryRegion*                               lastBlock_                                  = nullptr;
+        std::size_t                                         numBlocks_                                  = 0;
+        VkDeviceSize                                        usedSize_                                   = 0;
 
-        VkDeviceSize                                        maxNewBlockSize_        = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  blocks_;
+        std::uint64_t                                       firstLevelBitmap_                           = 0;
+        std::uint32_t                                       secondLevelBitmaps_[numFirstLevels]         = {};
+        VKDeviceMemoryRegion*                               freeLists_[numFirstLevels][numSecondLevels] = {};
 
-        VkDeviceSize                                        maxFragmentedBlockSize_ = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  fragmentedBlocks_;
+        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  blockPool_;
+        std::vector<VKDeviceMemoryRegion*>                  unusedBlocks_;
 
 };
 
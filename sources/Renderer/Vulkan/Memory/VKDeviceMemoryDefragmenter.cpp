@@ -0,0 +1,172 @@
+/*
+ * VKDeviceMemoryDefragmenter.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDeviceMemoryDefragmenter.h"
+#include "VKDeviceMemoryManager.h"
+#include "../VKDevice.h"
+#include "../VKUploadQueue.h"
+#include "../VKInitializers.h"
+#include "../Buffer/VKBuffer.h"
+
+
+namespace LLGL
+{
+
+
+VKDeviceMemoryDefragmenter::VKDeviceMemoryDefragmenter(
+    VKDevice&               device,
+    VKDeviceMemoryManager&  deviceMemoryMngr,
+    VKUploadQueue&          uploadQueue,
+    VkDeviceSize            budget) :
+        device_           { device           },
+        deviceMemoryMngr_ { deviceMemoryMngr },
+        uploadQueue_      { uploadQueue      },
+        budget_           { budget           }
+{
+}
+
+void VKDeviceMemoryDefragmenter::AddBuffer(VKBuffer& buffer)
+{
+    /* Buffers with other binding flags might be referenced by descriptor sets, which are not updated on relocation */
+    const long relocatableBindFlags = (BindFlags::VertexBuffer | BindFlags::IndexBuffer);
+    if (buffer.GetBindFlags() != 0 && (buffer.GetBindFlags() & ~relocatableBindFlags) == 0)
+        buffers_.insert(&buffer);
+}
+
+void VKDeviceMemoryDefragmenter::RemoveBuffer(VKBuffer& buffer)
+{
+    if (lastBuffer_ == &buffer)
+        lastBuffer_ = nullptr;
+    buffers_.erase(&buffer);
+}
+
+void VKDeviceMemoryDefragmenter::BeginEncoding(const VKCommandBuffer& commandBuffer, bool multiSubmit)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto& entry = commandBuffers_[&commandBuffer];
+    {
+        entry.generation    = generation_;
+        entry.multiSubmit   = multiSubmit;
+    }
+}
+
+void VKDeviceMemoryDefragmenter::NotifySubmit(const VKCommandBuffer& commandBuffer)
+{
+    /* Single-submit command buffers must be encoded again before they can be submitted again */
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto it = commandBuffers_.find(&commandBuffer);
+    if (it != commandBuffers_.end() && !it->second.multiSubmit)
+        commandBuffers_.erase(it);
+}
+
+void VKDeviceMemoryDefragmenter::RemoveCommandBuffer(const VKCommandBuffer& commandBuffer)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    commandBuffers_.erase(&commandBuffer);
+}
+
+void VKDeviceMemoryDefragmenter::Step()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Only start a new generation when all previous buffers have been released, so at most one budget of memory is retained */
+    if (retiredBuffers_.empty())
+    {
+        if (RelocateBuffers())
+            ++generation_;
+    }
+
+    ReleaseRetiredBuffers();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool VKDeviceMemoryDefragmenter::RelocateBuffers()
+{
+    if (budget_ == 0 || buffers_.empty())
+        return false;
+
+    /* Skip this step if no device memory has been released since the last step that found nothing to relocate */
+    const auto releaseCounter = deviceMemoryMngr_.GetReleaseCounter();
+    if (releaseCounter == idleReleaseCounter_)
+        return false;
+
+    /* Continue with the successor of the last examined buffer, and examine each buffer at most once */
+    VkDeviceSize relocatedSize = 0;
+
+    auto it = buffers_.upper_bound(lastBuffer_);
+    for (std::size_t i = 0, n = buffers_.size(); i < n && relocatedSize < budget_; ++i, ++it)
+    {
+        if (it == buffers_.end())
+            it = buffers_.begin();
+
+        lastBuffer_ = *it;
+        if (RelocateBuffer(**it))
+            relocatedSize += (*it)->GetSize();
+    }
+
+    if (relocatedSize == 0)
+        idleReleaseCounter_ = releaseCounter;
+
+    return (relocatedSize > 0);
+}
+
+bool VKDeviceMemoryDefragmenter::RelocateBuffer(VKBuffer& buffer)
+{
+    auto& bufferObj = buffer.GetDeviceBuffer();
+
+    auto region = bufferObj.GetMemoryRegion();
+    if (region == nullptr)
+        return false;
+
+    /* Allocate better device memory region for this buffer */
+    auto newRegion = deviceMemoryMngr_.AllocateForRelocation(region, bufferObj.GetRequirements().alignment);
+    if (newRegion == nullptr)
+        return false;
+
+    /* Create new buffer with the same attributes and bind it to the new region */
+    VkBufferCreateInfo createInfo;
+    BuildVkBufferCreateInfo(createInfo, buffer.GetSize(), buffer.GetUsageFlags());
+
+    VKDeviceBuffer newBufferObj { device_, createInfo };
+    newBufferObj.BindMemoryRegion(device_, newRegion);
+
+    /* Copy buffer content via upload queue, then retain the previous buffer until no command buffer can refer to it anymore */
+    buffer.SetUploadTicket(uploadQueue_.CopyBuffer(bufferObj.GetVkBuffer(), newBufferObj.GetVkBuffer(), buffer.GetSize()));
+    retiredBuffers_.push_back(buffer.ReplaceDeviceBuffer(std::move(newBufferObj)));
+
+    return true;
+}
+
+void VKDeviceMemoryDefragmenter::ReleaseRetiredBuffers()
+{
+    if (retiredBuffers_.empty())
+        return;
+
+    /* Retain previous buffers while any command buffer that has been encoded before the current generation can still be submitted */
+    for (const auto& entry : commandBuffers_)
+    {
+        if (entry.second.generation < generation_)
+            return;
+    }
+
+    /* Release previous buffers after the current upload batch, which is submitted after all previously submitted command buffers */
+    for (auto& buffer : retiredBuffers_)
+        uploadQueue_.ReleaseAfterBatch(std::move(buffer));
+
+    retiredBuffers_.clear();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
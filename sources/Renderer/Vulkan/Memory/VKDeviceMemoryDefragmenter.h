@@ -0,0 +1,124 @@
+/*
+ * VKDeviceMemoryDefragmenter.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DEVICE_MEMORY_DEFRAGMENTER_H
+#define LLGL_VK_DEVICE_MEMORY_DEFRAGMENTER_H
+
+
+#include <vulkan/vulkan.h>
+#include "../Buffer/VKDeviceBuffer.h"
+#include <cstdint>
+#include <set>
+#include <map>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKDeviceMemoryManager;
+class VKUploadQueue;
+class VKBuffer;
+class VKCommandBuffer;
+
+/*
+Incrementally relocates buffers into better device memory regions to reduce fragmentation (see VKDeviceMemoryManager::AllocateForRelocation).
+Only buffers that are exclusively bound as vertex or index buffers are relocated, since their native handles are queried when commands are recorded.
+The data is copied via the upload queue.
+Each step that relocates buffers starts a new generation, and command buffers are stamped with the generation they have been encoded in.
+The previous buffers of a generation are retained until no command buffer that has been encoded before can be submitted anymore,
+and then released once the upload batch after all previously submitted command buffers has been completed.
+*/
+class VKDeviceMemoryDefragmenter
+{
+
+    public:
+
+        VKDeviceMemoryDefragmenter(
+            VKDevice&               device,
+            VKDeviceMemoryManager&  deviceMemoryMngr,
+            VKUploadQueue&          uploadQueue,
+            VkDeviceSize            budget
+        );
+
+        VKDeviceMemoryDefragmenter(const VKDeviceMemoryDefragmenter&) = delete;
+        VKDeviceMemoryDefragmenter& operator = (const VKDeviceMemoryDefragmenter&) = delete;
+
+        // Registers the specified buffer for relocation, if it is exclusively bound as vertex or index buffer.
+        void AddBuffer(VKBuffer& buffer);
+
+        // Unregisters the specified buffer, so it will never be relocated.
+        void RemoveBuffer(VKBuffer& buffer);
+
+        /*
+        Stamps the specified command buffer with the current generation when its encoding begins.
+        If 'multiSubmit' is true, the command buffer can be submitted multiple times and refers to the buffers of this generation until it is encoded again.
+        */
+        void BeginEncoding(const VKCommandBuffer& commandBuffer, bool multiSubmit);
+
+        // Notifies that the specified command buffer has been submitted, so a single-submit command buffer no longer refers to the buffers of its generation.
+        void NotifySubmit(const VKCommandBuffer& commandBuffer);
+
+        // Unregisters the specified command buffer when it is destroyed.
+        void RemoveCommandBuffer(const VKCommandBuffer& commandBuffer);
+
+        /*
+        Relocates the registered buffers until the budget is exhausted or each buffer has been examined once,
+        and releases the previous buffers that can no longer be referenced by any command buffer.
+        This must be called after a command buffer has been submitted, so the copies are not submitted before it.
+        */
+        void Step();
+
+    private:
+
+        struct EncodedCommandBuffer
+        {
+            std::uint64_t   generation  = 0;
+            bool            multiSubmit = false;
+        };
+
+    private:
+
+        // Relocates the registered buffers until the budget is exhausted, and returns true if any buffer has been relocated.
+        bool RelocateBuffers();
+
+        // Tries to relocate the specified buffer, and returns true on success.
+        bool RelocateBuffer(VKBuffer& buffer);
+
+        // Releases the previous buffers if no command buffer that has been encoded before their generation can be submitted anymore.
+        void ReleaseRetiredBuffers();
+
+    private:
+
+        VKDevice&               device_;
+        VKDeviceMemoryManager&  deviceMemoryMngr_;
+        VKUploadQueue&          uploadQueue_;
+        VkDeviceSize            budget_                 = 0;
+
+        std::set<VKBuffer*>     buffers_;
+        VKBuffer*               lastBuffer_             = nullptr;  // Last examined buffer, to continue with its successor in the next step
+        std::uint64_t           idleReleaseCounter_     = ~0ull;    // Release counter of the memory manager when a step relocated no buffer
+
+        std::mutex                                              mutex_;             // Guards the generation and command buffers, since encoding can begin on other threads
+        std::uint64_t                                           generation_ = 0;
+        std::map<const VKCommandBuffer*, EncodedCommandBuffer>  commandBuffers_;    // Command buffers that can still be submitted with the buffers of their generation
+        std::vector<VKDeviceBuffer>                             retiredBuffers_;    // Previous buffers of the current generation
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
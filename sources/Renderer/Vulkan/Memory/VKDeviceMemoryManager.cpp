@@ -8,6 +8,7 @@
 #include "VKDeviceMemoryManager.h"
 #include "../VKCore.h"
 #include "../../../Core/Helper.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -27,27 +28,44 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     VkDeviceSize            size,
     VkDeviceSize            alignment,
     std::uint32_t           memoryTypeBits,
-    VkMemoryPropertyFlags   properties)
+    VkMemoryPropertyFlags   properties,
+    bool                    dedicated)
 {
     const auto alignedSize      = GetAlignedSize(size, alignment);
     const auto memoryTypeIndex  = FindMemoryType(memoryTypeBits, properties);
-    const auto allocationSize   = std::max(minAllocationSize_, alignedSize);
 
-    if (auto chunk = FindOrAllocChunk(allocationSize, memoryTypeIndex, alignedSize))
-        return chunk->Allocate(size, alignment);
-    else
-        return nullptr;
+    /* Large blocks get their own chunk, since they would leave most of a shared chunk unused once they are released */
+    if (dedicated || alignedSize > minAllocationSize_ / 2)
+        return AllocChunk(alignedSize, memoryTypeIndex, true)->Allocate(size, alignment);
+
+    /* Allocate block in a suitable chunk */
+    if (auto chunk = FindChunk(memoryTypeIndex, size, alignment))
+    {
+        if (auto region = chunk->Allocate(size, alignment))
+            return region;
+    }
+
+    /* Allocate new chunk, but only reserve the required size if the heap budget would be exceeded otherwise */
+    auto allocationSize = minAllocationSize_;
+
+    const auto heapIndex = memoryProperties_.memoryTypes[memoryTypeIndex].heapIndex;
+    if (heapReservedSizes_[heapIndex] + allocationSize > GetHeapBudget(heapIndex))
+        allocationSize = alignedSize;
+
+    return AllocChunk(allocationSize, memoryTypeIndex, false)->Allocate(size, alignment);
 }
 
 VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     const VkMemoryRequirements& requirements,
-    VkMemoryPropertyFlags       properties)
+    VkMemoryPropertyFlags       properties,
+    bool                        dedicated)
 {
     return Allocate(
         requirements.size,
         requirements.alignment,
         requirements.memoryTypeBits,
-        properties
+        properties,
+        dedicated
     );
 }
 
@@ -59,20 +77,46 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
         {
             /* Release block in chunk */
             chunk->Release(region);
+            ++releaseCounter_;
 
             /* Release chunk if it's empty */
             if (chunk->IsEmpty())
-            {
-                RemoveFromListIf(
-                    chunks_,
-                    [chunk](std::unique_ptr<VKDeviceMemory>& entry)
-                    {
-                        return (entry.get() == chunk);
-                    }
-                );
-            }
+                ReleaseChunk(chunk);
+        }
+    }
+}
+
+VKDeviceMemoryRegion* VKDeviceMemoryManager::AllocateForRelocation(const VKDeviceMemoryRegion* region, VkDeviceSize alignment)
+{
+    auto srcChunk = region->GetParentChunk();
+    if (srcChunk == nullptr || srcChunk->IsDedicated())
+        return nullptr;
+
+    const auto size = region->GetSize();
+
+    /* Find the most densely used chunk that has more allocated memory than the source chunk */
+    VKDeviceMemory* dstChunk = nullptr;
+    for (auto chunk : chunksByType_[region->GetMemoryTypeIndex()])
+    {
+        if (chunk != srcChunk && chunk->GetUsedSize() > srcChunk->GetUsedSize())
+        {
+            if ((dstChunk == nullptr || chunk->GetUsedSize() > dstChunk->GetUsedSize()) && chunk->CanAllocate(size, alignment))
+                dstChunk = chunk;
         }
     }
+
+    if (dstChunk != nullptr)
+        return dstChunk->Allocate(size, alignment);
+
+    /* Otherwise, try to move block to a lower offset within the same chunk */
+    if (auto newRegion = srcChunk->Allocate(size, alignment))
+    {
+        if (newRegion->GetOffset() < region->GetOffset())
+            return newRegion;
+        srcChunk->Release(newRegion);
+    }
+
+    return nullptr;
 }
 
 VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
@@ -85,6 +129,36 @@ VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
     return details;
 }
 
+void VKDeviceMemoryManager::QueryHeapStatistics(std::vector<MemoryHeapStatistics>& heapStatistics) const
+{
+    heapStatistics.clear();
+    heapStatistics.resize(memoryProperties_.memoryHeapCount);
+
+    for (std::uint32_t i = 0; i < memoryProperties_.memoryHeapCount; ++i)
+    {
+        auto& stats = heapStatistics[i];
+        const auto& heap = memoryProperties_.memoryHeaps[i];
+        stats.heapSize      = heap.size;
+        stats.budget        = GetHeapBudget(i);
+        stats.deviceLocal   = ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0);
+    }
+
+    for (const auto& chunk : chunks_)
+    {
+        auto& stats = heapStatistics[memoryProperties_.memoryTypes[chunk->GetMemoryTypeIndex()].heapIndex];
+
+        stats.numAllocations    += static_cast<std::uint32_t>(chunk->GetNumBlocks());
+        stats.numMemoryBlocks   += 1;
+        stats.usedSize          += chunk->GetUsedSize();
+        stats.reservedSize      += chunk->GetSize();
+
+        if (chunk->IsDedicated())
+            stats.numDedicatedAllocations += static_cast<std::uint32_t>(chunk->GetNumBlocks());
+        else
+            stats.largestFreeBlockSize = std::max(stats.largestFreeBlockSize, static_cast<std::uint64_t>(chunk->GetMaxAllocationSize()));
+    }
+}
+
 #ifdef LLGL_DEBUG
 
 void VKDeviceMemoryManager::PrintBlocks(std::ostream& s, const std::string& title) const
@@ -123,22 +197,63 @@ std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits
     return VKFindMemoryType(memoryProperties_, memoryTypeBits, properties);
 }
 
-VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex)
+VkDeviceSize VKDeviceMemoryManager::GetHeapBudget(std::uint32_t heapIndex) const
 {
-    return TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
+    return (memoryProperties_.memoryHeaps[heapIndex].size / 5 * 4);
 }
 
-VKDeviceMemory* VKDeviceMemoryManager::FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize)
+VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex, bool dedicated)
 {
-    /* Search for a suitable chunk */
-    for (const auto& chunk : chunks_)
+    auto chunk = TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex, dedicated));
+
+    /* Dedicated chunks are never shared with other allocations */
+    if (!dedicated)
+        chunksByType_[memoryTypeIndex].push_back(chunk);
+
+    heapReservedSizes_[memoryProperties_.memoryTypes[memoryTypeIndex].heapIndex] += size;
+
+    return chunk;
+}
+
+VKDeviceMemory* VKDeviceMemoryManager::FindChunk(std::uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceSize alignment) const
+{
+    VKDeviceMemory* bestChunk = nullptr;
+
+    /* Each chunk answers whether a block fits in constant time, so only chunks of the requested memory type are examined */
+    for (auto chunk : chunksByType_[memoryTypeIndex])
     {
-        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize && chunk->GetMemoryTypeIndex() == memoryTypeIndex)
-            return chunk.get();
+        if (chunk->CanAllocate(size, alignment))
+        {
+            /* Take first chunk that fits, or the most densely used one to keep fragmentation low */
+            if (!reduceFragmentation_)
+                return chunk;
+            if (bestChunk == nullptr || chunk->GetUsedSize() > bestChunk->GetUsedSize())
+                bestChunk = chunk;
+        }
     }
 
-    /* Allocate new chunk */
-    return AllocChunk(allocationSize, memoryTypeIndex);
+    return bestChunk;
+}
+
+void VKDeviceMemoryManager::ReleaseChunk(VKDeviceMemory* chunk)
+{
+    const auto memoryTypeIndex = chunk->GetMemoryTypeIndex();
+
+    if (!chunk->IsDedicated())
+    {
+        auto& chunksOfType = chunksByType_[memoryTypeIndex];
+        chunksOfType.erase(std::find(chunksOfType.begin(), chunksOfType.end(), chunk));
+    }
+
+    heapReservedSizes_[memoryProperties_.memoryTypes[memoryTypeIndex].heapIndex] -= chunk->GetSize();
+
+    RemoveFromListIf(
+        chunks_,
+        [chunk](std::unique_ptr<VKDeviceMemory>& entry)
+        {
+            return (entry.get() == chunk);
+        }
+    );
 }
 
 
@@ -11,6 +11,7 @@
 
 //#include "../Vulkan.h"
 #include <vulkan/vulkan.h>
+#include <LLGL/RenderSystemFlags.h>
 #include "../VKPtr.h"
 #include "VKDeviceMemory.h"
 #include "VKDeviceMemoryRegion.h"
@@ -43,32 +44,53 @@ class VKDeviceMemoryManager
         VKDeviceMemoryManager(const VKDeviceMemoryManager&) = delete;
         VKDeviceMemoryManager& operator = (const VKDeviceMemoryManager&) = delete;
 
-        // Allocates a new device memory block of the specified size and with the specified attributes.
+        /*
+        Allocates a new device memory block of the specified size and with the specified attributes.
+        If 'dedicated' is true or the size exceeds half the minimal allocation size, the block gets its own VkDeviceMemory chunk.
+        */
         VKDeviceMemoryRegion* Allocate(
             VkDeviceSize            size,
             VkDeviceSize            alignment,
             std::uint32_t           memoryTypeBits,
-            VkMemoryPropertyFlags   properties
+            VkMemoryPropertyFlags   properties,
+            bool                    dedicated   = false
         );
 
         // Allocates a new device memory block with the specified memory requirements.
         VKDeviceMemoryRegion* Allocate(
             const VkMemoryRequirements& requirements,
-            VkMemoryPropertyFlags       properties
+            VkMemoryPropertyFlags       properties,
+            bool                        dedicated   = false
         );
 
         // Releases the specified device memory block.
         void Release(VKDeviceMemoryRegion* region);
 
+        /*
+        Allocates a new device memory block to relocate the specified block, or returns null if there is no better place for it.
+        A better place is either a chunk of the same memory type with more allocated memory, so sparsely used chunks can be drained and released,
+        or a lower offset within the same chunk, so free space is gathered at the end of the chunk.
+        */
+        VKDeviceMemoryRegion* AllocateForRelocation(const VKDeviceMemoryRegion* region, VkDeviceSize alignment);
+
         // Queries the memory details of all chunks.
         VKDeviceMemoryDetails QueryDetails() const;
 
+        // Queries the memory statistics of all memory heaps.
+        void QueryHeapStatistics(std::vector<MemoryHeapStatistics>& heapStatistics) const;
+
         #ifdef LLGL_DEBUG
 
         void PrintBlocks(std::ostream& s, const std::string& title = "") const;
 
         #endif
 
+        // Returns the number of device memory blocks that have been released, which is used to detect new opportunities for defragmentation.
+        inline std::uint64_t GetReleaseCounter() const
+        {
+            return releaseCounter_;
+        }
+
         // Returns the VkDevice object used for this device memory manager.
         inline VkDevice GetVkDevice() const
         {
@@ -80,11 +102,17 @@ class VKDeviceMemoryManager
         // Finds a memory type index for the specified attributes.
         std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
 
+        // Returns the memory budget of the specified heap, which is estimated as 80% of the heap size.
+        VkDeviceSize GetHeapBudget(std::uint32_t heapIndex) const;
+
         // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
-        VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
+        VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, bool dedicated);
 
-        // Finds a suitable device memory chunk or allocates a new one.
-        VKDeviceMemory* FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize);
+        // Finds a device memory chunk of the specified memory type that can allocate a block of the specified size, or returns null if there is none.
+        VKDeviceMemory* FindChunk(std::uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceSize alignment) const;
+
+        // Releases the specified device memory chunk.
+        void ReleaseChunk(VKDeviceMemory* chunk);
 
         const VKPtr<VkDevice>&                          device_;
         VkPhysicalDeviceMemoryProperties                memoryProperties_;
@@ -93,6 +121,10 @@ class VKDeviceMemoryManager
         bool                                            reduceFragmentation_    = false;
 
         std::vector<std::unique_ptr<VKDeviceMemory>>    chunks_;
+        std::vector<VKDeviceMemory*>                    chunksByType_[VK_MAX_MEMORY_TYPES];
+
+        std::uint64_t                                   releaseCounter_         = 0;
+        VkDeviceSize                                    heapReservedSizes_[VK_MAX_MEMORY_HEAPS] = {};
 
 };
 
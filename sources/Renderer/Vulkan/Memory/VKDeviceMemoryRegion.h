@@ -63,6 +63,12 @@ class VKDeviceMemoryRegion
             return memoryTypeIndex_;
         }
 
+        // Returns true if this region is currently not allocated, i.e. it is part of a free-list of its parent chunk.
+        inline bool IsFree() const
+        {
+            return free_;
+        }
+
     protected:
 
         friend class VKDeviceMemory;
@@ -75,10 +81,17 @@ class VKDeviceMemoryRegion
 
     private:
 
-        VKDeviceMemory* deviceMemory_       = nullptr;
-        VkDeviceSize    size_               = 0;
-        VkDeviceSize    offset_             = 0;
-        std::uint32_t   memoryTypeIndex_    = 0;
+        VKDeviceMemory*         deviceMemory_       = nullptr;
+        VkDeviceSize            size_               = 0;
+        VkDeviceSize            offset_             = 0;
+        std::uint32_t           memoryTypeIndex_    = 0;
+
+        /* Links to physically adjacent regions and to the neighbours within the free-list, managed by the parent chunk */
+        VKDeviceMemoryRegion*   prevPhysical_       = nullptr;
+        VKDeviceMemoryRegion*   nextPhysical_       = nullptr;
+        VKDeviceMemoryRegion*   prevFree_           = nullptr;
+        VKDeviceMemoryRegion*   nextFree_           = nullptr;
+        bool                    free_               = false;
 
 };
 
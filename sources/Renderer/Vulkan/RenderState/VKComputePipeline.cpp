@@ -19,7 +19,10 @@ namespace LLGL
 
 
 VKComputePipeline::VKComputePipeline(
-    const VKPtr<VkDevice>& device, const ComputePipelineDescriptor& desc, VkPipelineLayout defaultPipelineLayout) :
+    const VKPtr<VkDevice>&              device,
+    const ComputePipelineDescriptor&    desc,
+    VkPipelineLayout                    defaultPipelineLayout,
+    VkPipelineCache                     pipelineCache) :
         device_         { device                    },
         pipelineLayout_ { defaultPipelineLayout     },
         pipeline_       { device, vkDestroyPipeline }
@@ -32,7 +35,7 @@ VKComputePipeline::VKComputePipeline(
     }
 
     /* Create Vulkan compute pipeline object */
-    CreateComputePipeline(desc);
+    CreateComputePipeline(desc, pipelineCache);
 }
 
 
@@ -40,7 +43,7 @@ VKComputePipeline::VKComputePipeline(
  * ======= Private: =======
  */
 
-void VKComputePipeline::CreateComputePipeline(const ComputePipelineDescriptor& desc)
+void VKComputePipeline::CreateComputePipeline(const ComputePipelineDescriptor& desc, VkPipelineCache pipelineCache)
 {
     /* Get shader program object */
     auto shaderProgramVK = LLGL_CAST(const VKShaderProgram*, desc.shaderProgram);
@@ -63,7 +66,7 @@ void VKComputePipeline::CreateComputePipeline(const ComputePipelineDescriptor& d
         createInfo.basePipelineHandle   = VK_NULL_HANDLE;
         createInfo.basePipelineIndex    = 0;
     }
-    auto result = vkCreateComputePipelines(device_, VK_NULL_HANDLE, 1, &createInfo, nullptr, pipeline_.ReleaseAndGetAddressOf());
+    auto result = vkCreateComputePipelines(device_, pipelineCache, 1, &createInfo, nullptr, pipeline_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan compute pipeline");
 }
 
@@ -25,7 +25,12 @@ class VKComputePipeline final : public ComputePipeline
 
     public:
 
-        VKComputePipeline(const VKPtr<VkDevice>& device, const ComputePipelineDescriptor& desc, VkPipelineLayout defaultPipelineLayout);
+        VKComputePipeline(
+            const VKPtr<VkDevice>&              device,
+            const ComputePipelineDescriptor&    desc,
+            VkPipelineLayout                    defaultPipelineLayout,
+            VkPipelineCache                     pipelineCache           = VK_NULL_HANDLE
+        );
 
         inline VkPipeline GetVkPipeline() const
         {
@@ -39,7 +44,7 @@ class VKComputePipeline final : public ComputePipeline
 
     private:
 
-        void CreateComputePipeline(const ComputePipelineDescriptor& desc);
+        void CreateComputePipeline(const ComputePipelineDescriptor& desc, VkPipelineCache pipelineCache);
 
         VkDevice            device_         = VK_NULL_HANDLE;
         VkPipelineLayout    pipelineLayout_ = VK_NULL_HANDLE;
@@ -0,0 +1,252 @@
+/*
+ * VKDescriptorCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDescriptorCache.h"
+#include "../VKCore.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal constants ----- */
+
+// Maximal number of descriptor sets of the first descriptor pool; each further pool doubles this number up to 'g_maxPoolMaxSets'
+static const std::uint32_t g_initialPoolMaxSets = 64;
+static const std::uint32_t g_maxPoolMaxSets     = 4096;
+
+// Average number of descriptors per type and descriptor set each descriptor pool is sized for
+static const std::uint32_t g_descriptorsPerSet  = 4;
+
+// Descriptor types that are supported by resource heaps
+static const VkDescriptorType g_descriptorTypes[] =
+{
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+
+/* ----- VKDescriptorCache class ----- */
+
+VKDescriptorCache::VKDescriptorCache(const VKPtr<VkDevice>& device) :
+    device_          { device              },
+    nextPoolMaxSets_ { g_initialPoolMaxSets }
+{
+}
+
+VkDescriptorSet VKDescriptorCache::Acquire(
+    VkDescriptorSetLayout                       setLayout,
+    const std::vector<VkDescriptorPoolSize>&    poolSizes,
+    const std::vector<std::uint64_t>&           key,
+    bool&                                       isNew)
+{
+    /* Return cached descriptor set with identical bindings */
+    auto it = cachedSets_.find(key);
+    if (it != cachedSets_.end())
+    {
+        descriptorSets_[it->second].refCount++;
+        isNew = false;
+        return it->second;
+    }
+
+    /* Allocate new descriptor set and store it in the cache */
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    auto descriptorSet = AllocateDescriptorSet(setLayout, poolSizes, pool);
+
+    auto& entry = descriptorSets_[descriptorSet];
+    {
+        entry.pool      = pool;
+        entry.refCount  = 1;
+        entry.key       = key;
+        entry.cached    = true;
+    }
+    cachedSets_[key] = descriptorSet;
+
+    /* Index descriptor set by each distinct key value */
+    for (auto value : key)
+    {
+        auto range = handleSets_.equal_range(value);
+        auto setIt = std::find_if(
+            range.first, range.second,
+            [descriptorSet](const std::pair<const std::uint64_t, VkDescriptorSet>& entry)
+            {
+                return (entry.second == descriptorSet);
+            }
+        );
+        if (setIt == range.second)
+            handleSets_.emplace(value, descriptorSet);
+    }
+
+    isNew = true;
+    return descriptorSet;
+}
+
+void VKDescriptorCache::Release(VkDescriptorSet descriptorSet)
+{
+    auto it = descriptorSets_.find(descriptorSet);
+    if (it != descriptorSets_.end())
+    {
+        auto& entry = it->second;
+        if (--entry.refCount == 0)
+        {
+            /* Remove descriptor set from cache and return it to its pool */
+            if (entry.cached)
+                Uncache(descriptorSet, entry);
+
+            auto result = vkFreeDescriptorSets(device_, entry.pool, 1, &descriptorSet);
+            VKThrowIfFailed(result, "failed to release Vulkan descriptor set");
+
+            descriptorSets_.erase(it);
+        }
+    }
+}
+
+void VKDescriptorCache::Evict(std::uint64_t handle)
+{
+    /* Gather all cached descriptor sets that refer to this handle first, since uncaching them modifies the index */
+    auto range = handleSets_.equal_range(handle);
+    if (range.first == range.second)
+        return;
+
+    std::vector<VkDescriptorSet> evictedSets;
+    for (auto it = range.first; it != range.second; ++it)
+        evictedSets.push_back(it->second);
+
+    /* Keep descriptor sets alive for their current resource heaps, but don't share them anymore */
+    for (auto descriptorSet : evictedSets)
+        Uncache(descriptorSet, descriptorSets_[descriptorSet]);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::size_t VKDescriptorCache::KeyHash::operator () (const Key& key) const
+{
+    /* Combine all key values with 64-bit FNV-1a */
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (auto value : key)
+    {
+        hash ^= value;
+        hash *= 0x100000001b3ull;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+VkDescriptorSet VKDescriptorCache::AllocateDescriptorSet(
+    VkDescriptorSetLayout                       setLayout,
+    const std::vector<VkDescriptorPoolSize>&    poolSizes,
+    VkDescriptorPool&                           pool)
+{
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+    VkDescriptorSetAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.descriptorPool        = VK_NULL_HANDLE;
+        allocInfo.descriptorSetCount    = 1;
+        allocInfo.pSetLayouts           = (&setLayout);
+    }
+
+    /* Try to allocate descriptor set from existing pools, starting with the most recent (and largest) one */
+    for (auto it = descriptorPools_.rbegin(); it != descriptorPools_.rend(); ++it)
+    {
+        allocInfo.descriptorPool = it->Get();
+        if (vkAllocateDescriptorSets(device_, &allocInfo, &descriptorSet) == VK_SUCCESS)
+        {
+            pool = allocInfo.descriptorPool;
+            return descriptorSet;
+        }
+    }
+
+    /* Allocate descriptor set from new pool */
+    CreateDescriptorPool(poolSizes);
+
+    allocInfo.descriptorPool = descriptorPools_.back().Get();
+    auto result = vkAllocateDescriptorSets(device_, &allocInfo, &descriptorSet);
+    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+
+    pool = allocInfo.descriptorPool;
+    return descriptorSet;
+}
+
+void VKDescriptorCache::CreateDescriptorPool(const std::vector<VkDescriptorPoolSize>& minPoolSizes)
+{
+    /* Initialize pool sizes for all supported descriptor types, but at least as large as the requested descriptor set */
+    std::vector<VkDescriptorPoolSize> poolSizes;
+
+    for (auto type : g_descriptorTypes)
+        poolSizes.push_back({ type, nextPoolMaxSets_ * g_descriptorsPerSet });
+
+    for (const auto& minPoolSize : minPoolSizes)
+    {
+        auto it = std::find_if(
+            poolSizes.begin(), poolSizes.end(),
+            [&minPoolSize](const VkDescriptorPoolSize& poolSize)
+            {
+                return (poolSize.type == minPoolSize.type);
+            }
+        );
+        if (it != poolSizes.end())
+            it->descriptorCount = std::max(it->descriptorCount, minPoolSize.descriptorCount);
+        else
+            poolSizes.push_back(minPoolSize);
+    }
+
+    /* Create descriptor pool; individual descriptor sets are returned to the pool when they are no longer referenced */
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    {
+        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.pNext            = nullptr;
+        poolCreateInfo.flags            = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        poolCreateInfo.maxSets          = nextPoolMaxSets_;
+        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(poolSizes.size());
+        poolCreateInfo.pPoolSizes       = poolSizes.data();
+    }
+
+    VKPtr<VkDescriptorPool> descriptorPool { device_, vkDestroyDescriptorPool };
+    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, nullptr, descriptorPool.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
+
+    descriptorPools_.push_back(std::move(descriptorPool));
+
+    /* Grow size of next descriptor pool */
+    nextPoolMaxSets_ = std::min(nextPoolMaxSets_ * 2, g_maxPoolMaxSets);
+}
+
+void VKDescriptorCache::Uncache(VkDescriptorSet descriptorSet, DescriptorSetEntry& entry)
+{
+    cachedSets_.erase(entry.key);
+
+    /* Remove descriptor set from the index of each of its key values */
+    for (auto value : entry.key)
+    {
+        auto range = handleSets_.equal_range(value);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == descriptorSet)
+            {
+                handleSets_.erase(it);
+                break;
+            }
+        }
+    }
+
+    entry.cached = false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
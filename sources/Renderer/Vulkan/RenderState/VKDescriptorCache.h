@@ -0,0 +1,119 @@
+/*
+ * VKDescriptorCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DESCRIPTOR_CACHE_H
+#define LLGL_VK_DESCRIPTOR_CACHE_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+
+namespace LLGL
+{
+
+
+/*
+Shared allocator for the descriptor sets of all resource heaps of a render system.
+Descriptor sets are allocated from a growing list of descriptor pools, so creating and releasing many small resource heaps does not create a descriptor pool each.
+Descriptor sets are cached by a key of their set layout and the native resource handles they refer to,
+so resource heaps with identical bindings share the same reference counted descriptor set.
+*/
+class VKDescriptorCache
+{
+
+    public:
+
+        VKDescriptorCache(const VKPtr<VkDevice>& device);
+
+        VKDescriptorCache(const VKDescriptorCache&) = delete;
+        VKDescriptorCache& operator = (const VKDescriptorCache&) = delete;
+
+        /*
+        Returns the descriptor set for the specified key and increments its reference counter.
+        If there is no such descriptor set, a new one is allocated with the specified layout and 'isNew' is set to true,
+        in which case the caller is responsible to update the descriptor set before it is used.
+        */
+        VkDescriptorSet Acquire(
+            VkDescriptorSetLayout                       setLayout,
+            const std::vector<VkDescriptorPoolSize>&    poolSizes,
+            const std::vector<std::uint64_t>&           key,
+            bool&                                       isNew
+        );
+
+        // Decrements the reference counter of the specified descriptor set, and returns it to its descriptor pool once it is no longer referenced.
+        void Release(VkDescriptorSet descriptorSet);
+
+        // Removes all descriptor sets that refer to the specified native handle from the cache, so they are not shared with resource heaps that are created afterwards.
+        void Evict(std::uint64_t handle);
+
+        // Returns the specified native Vulkan handle as key value.
+        template <typename T>
+        static std::uint64_t MakeKeyValue(T handle)
+        {
+            return reinterpret_cast<std::uint64_t>(handle);
+        }
+
+    private:
+
+        using Key = std::vector<std::uint64_t>;
+
+        struct KeyHash
+        {
+            std::size_t operator () (const Key& key) const;
+        };
+
+        struct DescriptorSetEntry
+        {
+            VkDescriptorPool    pool        = VK_NULL_HANDLE;
+            std::uint32_t       refCount    = 0;
+            Key                 key;
+            bool                cached      = true;
+        };
+
+    private:
+
+        // Allocates a new descriptor set from any descriptor pool with enough space left, or from a newly created descriptor pool.
+        VkDescriptorSet AllocateDescriptorSet(
+            VkDescriptorSetLayout                       setLayout,
+            const std::vector<VkDescriptorPoolSize>&    poolSizes,
+            VkDescriptorPool&                           pool
+        );
+
+        // Creates a new descriptor pool that can hold at least the specified descriptors.
+        void CreateDescriptorPool(const std::vector<VkDescriptorPoolSize>& minPoolSizes);
+
+        // Removes the specified descriptor set from the cache and from the handle index, so it is no longer shared.
+        void Uncache(VkDescriptorSet descriptorSet, DescriptorSetEntry& entry);
+
+    private:
+
+        const VKPtr<VkDevice>&                                  device_;
+        std::vector<VKPtr<VkDescriptorPool>>                    descriptorPools_;
+        std::uint32_t                                           nextPoolMaxSets_;
+
+        std::unordered_map<Key, VkDescriptorSet, KeyHash>       cachedSets_;
+        std::unordered_map<VkDescriptorSet, DescriptorSetEntry> descriptorSets_;
+
+        // Index of all cached descriptor sets by each key value, so evicting a handle does not scan the entire cache.
+        std::unordered_multimap<std::uint64_t, VkDescriptorSet> handleSets_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -26,7 +26,8 @@ VKGraphicsPipeline::VKGraphicsPipeline(
     VkPipelineLayout                    defaultPipelineLayout,
     const RenderPass*                   defaultRenderPass,
     const GraphicsPipelineDescriptor&   desc,
-    const VKGraphicsPipelineLimits&     limits) :
+    const VKGraphicsPipelineLimits&     limits,
+    VkPipelineCache                     pipelineCache) :
         device_            { device                             },
         pipeline_          { device, vkDestroyPipeline          },
         scissorEnabled_    { desc.rasterizer.scissorTestEnabled },
@@ -50,7 +51,7 @@ VKGraphicsPipeline::VKGraphicsPipeline(
     {
         /* Create Vulkan graphics pipeline object */
         auto renderPassVK = LLGL_CAST(const VKRenderPass*, renderPass);
-        CreateVkGraphicsPipeline(desc, limits, *renderPassVK, nativePipelineLayout);
+        CreateVkGraphicsPipeline(desc, limits, *renderPassVK, nativePipelineLayout, pipelineCache);
     }
     else
         throw std::invalid_argument("cannot create Vulkan graphics pipeline without render pass");
@@ -317,7 +318,8 @@ void VKGraphicsPipeline::CreateVkGraphicsPipeline(
     const GraphicsPipelineDescriptor&   desc,
     const VKGraphicsPipelineLimits&     limits,
     const VKRenderPass&                 renderPass,
-    VkPipelineLayout                    pipelineLayout)
+    VkPipelineLayout                    pipelineLayout,
+    VkPipelineCache                     pipelineCache)
 {
     /* Get shader program object */
     auto shaderProgramVK = LLGL_CAST(const VKShaderProgram*, desc.shaderProgram);
@@ -390,7 +392,7 @@ void VKGraphicsPipeline::CreateVkGraphicsPipeline(
         createInfo.basePipelineHandle           = VK_NULL_HANDLE;
         createInfo.basePipelineIndex            = 0;
     }
-    auto result = vkCreateGraphicsPipelines(device_, VK_NULL_HANDLE, 1, &createInfo, nullptr, pipeline_.ReleaseAndGetAddressOf());
+    auto result = vkCreateGraphicsPipelines(device_, pipelineCache, 1, &createInfo, nullptr, pipeline_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
 }
 
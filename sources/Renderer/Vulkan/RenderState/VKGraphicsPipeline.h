@@ -40,7 +40,8 @@ class VKGraphicsPipeline final : public GraphicsPipeline
             VkPipelineLayout                    defaultPipelineLayout,
             const RenderPass*                   defaultRenderPass,
             const GraphicsPipelineDescriptor&   desc,
-            const VKGraphicsPipelineLimits&     limits
+            const VKGraphicsPipelineLimits&     limits,
+            VkPipelineCache                     pipelineCache   = VK_NULL_HANDLE
         );
 
         // Returns the native VkPipeline Vulkan object.
@@ -67,7 +68,8 @@ class VKGraphicsPipeline final : public GraphicsPipeline
             const GraphicsPipelineDescriptor&   desc,
             const VKGraphicsPipelineLimits&     limits,
             const VKRenderPass&                 renderPass,
-            VkPipelineLayout                    pipelineLayout
+            VkPipelineLayout                    pipelineLayout,
+            VkPipelineCache                     pipelineCache
         );
 
         VkDevice            device_             = VK_NULL_HANDLE;
@@ -0,0 +1,107 @@
+/*
+ * VKPipelineCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKPipelineCache.h"
+#include "../VKCore.h"
+#include <cstdint>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+VKPipelineCache::VKPipelineCache(
+    const VKPtr<VkDevice>&              device,
+    const VkPhysicalDeviceProperties&   properties,
+    const void*                         initialData,
+    std::size_t                         initialDataSize) :
+        device_        { device                         },
+        pipelineCache_ { device, vkDestroyPipelineCache }
+{
+    /* Discard initial data that was generated for another device or driver */
+    hasInitialData_ = IsCompatibleData(properties, initialData, initialDataSize);
+
+    /* Create pipeline cache object */
+    VkPipelineCacheCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = 0;
+        createInfo.initialDataSize  = (hasInitialData_ ? initialDataSize : 0);
+        createInfo.pInitialData     = (hasInitialData_ ? initialData : nullptr);
+    }
+    auto result = vkCreatePipelineCache(device_, &createInfo, nullptr, pipelineCache_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline cache");
+}
+
+bool VKPipelineCache::GetData(std::vector<char>& data) const
+{
+    /* Query size of cache data (this must not throw, since it's also used when the render system is destroyed) */
+    std::size_t dataSize = 0;
+    if (vkGetPipelineCacheData(device_, pipelineCache_, &dataSize, nullptr) != VK_SUCCESS)
+    {
+        data.clear();
+        return false;
+    }
+
+    /* Retrieve cache data; the size might decrease in the second query */
+    data.resize(dataSize);
+    if (dataSize > 0)
+    {
+        if (vkGetPipelineCacheData(device_, pipelineCache_, &dataSize, data.data()) != VK_SUCCESS)
+        {
+            data.clear();
+            return false;
+        }
+        data.resize(dataSize);
+    }
+
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool VKPipelineCache::IsCompatibleData(const VkPhysicalDeviceProperties& properties, const void* data, std::size_t dataSize)
+{
+    /* Header layout of VK_PIPELINE_CACHE_HEADER_VERSION_ONE (see Vulkan spec. "Pipeline Cache") */
+    struct HeaderVersionOne
+    {
+        std::uint32_t   headerSize;
+        std::uint32_t   headerVersion;
+        std::uint32_t   vendorID;
+        std::uint32_t   deviceID;
+        std::uint8_t    pipelineCacheUUID[VK_UUID_SIZE];
+    };
+
+    if (data == nullptr || dataSize < sizeof(HeaderVersionOne))
+        return false;
+
+    /* Copy header since the data is not necessarily aligned */
+    HeaderVersionOne header;
+    ::memcpy(&header, data, sizeof(header));
+
+    return
+    (
+        header.headerSize       >= sizeof(HeaderVersionOne)                     &&
+        header.headerSize       <= dataSize                                     &&
+        header.headerVersion    == VK_PIPELINE_CACHE_HEADER_VERSION_ONE         &&
+        header.vendorID         == properties.vendorID                          &&
+        header.deviceID         == properties.deviceID                          &&
+        ::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
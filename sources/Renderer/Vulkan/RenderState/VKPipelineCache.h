@@ -0,0 +1,75 @@
+/*
+ * VKPipelineCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_PIPELINE_CACHE_H
+#define LLGL_VK_PIPELINE_CACHE_H
+
+
+#include <vulkan/vulkan.h>
+#include "../VKPtr.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Wrapper for a VkPipelineCache object that is shared between all graphics and compute pipelines of a render system.
+The initial cache data is only passed to the driver if its header matches the physical device (vendor ID, device ID, and pipeline cache UUID),
+so data from another device or driver version is discarded instead of being rejected (or misinterpreted) by the driver.
+*/
+class VKPipelineCache
+{
+
+    public:
+
+        VKPipelineCache(
+            const VKPtr<VkDevice>&              device,
+            const VkPhysicalDeviceProperties&   properties,
+            const void*                         initialData     = nullptr,
+            std::size_t                         initialDataSize = 0
+        );
+
+        // Retrieves the current data of this pipeline cache, including all pipelines that have been created with it. Returns false on failure.
+        bool GetData(std::vector<char>& data) const;
+
+        // Returns true if the initial data has been accepted.
+        inline bool HasInitialData() const
+        {
+            return hasInitialData_;
+        }
+
+        // Returns the native VkPipelineCache object.
+        inline VkPipelineCache GetVkPipelineCache() const
+        {
+            return pipelineCache_.Get();
+        }
+
+    private:
+
+        // Returns true if the specified cache data was generated for the same physical device and driver.
+        static bool IsCompatibleData(const VkPhysicalDeviceProperties& properties, const void* data, std::size_t dataSize);
+
+    private:
+
+        VkDevice                device_             = VK_NULL_HANDLE;
+        VKPtr<VkPipelineCache>  pipelineCache_;
+        bool                    hasInitialData_     = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
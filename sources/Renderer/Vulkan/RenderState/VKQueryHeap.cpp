@@ -8,6 +8,11 @@
 #include "VKQueryHeap.h"
 #include "../VKCore.h"
 #include "../VKTypes.h"
+#include "../VKInitializers.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
 
 
 namespace LLGL
@@ -45,11 +50,37 @@ static VkQueryPipelineStatisticFlags GetPipelineStatisticsFlags(const QueryHeapD
     return 0;
 }
 
-VKQueryHeap::VKQueryHeap(const VKPtr<VkDevice>& device, const QueryHeapDescriptor& desc) :
-    QueryHeap  { desc.type                  },
-    queryPool_ { device, vkDestroyQueryPool },
-    groupSize_ { GetQueryGroupSize(desc)    }
+// Returns the number of native queries for each query, since 'TimeElapsed' queries are implemented with two timestamps
+static std::uint32_t GetNativeQueryStride(const QueryHeapDescriptor& desc)
 {
+    return (desc.type == QueryType::TimeElapsed ? 2u : 1u);
+}
+
+// Writes the specified value either as 32-bit or 64-bit unsigned integer into the output data
+static void WriteQueryResult(void* data, std::size_t index, std::uint64_t value, bool is64Bit)
+{
+    if (is64Bit)
+        reinterpret_cast<std::uint64_t*>(data)[index] = value;
+    else
+        reinterpret_cast<std::uint32_t*>(data)[index] = static_cast<std::uint32_t>(value);
+}
+
+VKQueryHeap::VKQueryHeap(
+    const VKPtr<VkDevice>&      device,
+    VKDeviceMemoryManager&      deviceMemoryMngr,
+    const QueryHeapDescriptor&  desc,
+    float                       timestampPeriod) :
+        QueryHeap         { desc.type                  },
+        device_           { device                     },
+        deviceMemoryMngr_ { deviceMemoryMngr           },
+        queryPool_        { device, vkDestroyQueryPool },
+        groupSize_        { GetQueryGroupSize(desc)    },
+        queryStride_      { GetNativeQueryStride(desc) },
+        resultBuffer_     { device                     },
+        timestampPeriod_  { timestampPeriod            }
+{
+    const auto numNativeQueries = desc.numQueries * queryStride_;
+
     /* Create query pool object */
     VkQueryPoolCreateInfo createInfo;
     {
@@ -57,11 +88,76 @@ VKQueryHeap::VKQueryHeap(const VKPtr<VkDevice>& device, const QueryHeapDescripto
         createInfo.pNext                = nullptr;
         createInfo.flags                = 0;
         createInfo.queryType            = VKTypes::Map(desc.type);
-        createInfo.queryCount           = desc.numQueries;// * groupSize_;
+        createInfo.queryCount           = numNativeQueries;
         createInfo.pipelineStatistics   = GetPipelineStatisticsFlags(desc);
     }
     auto result = vkCreateQueryPool(device, &createInfo, nullptr, queryPool_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan query pool");
+
+    /* Create host visible result buffer with 64-bit values for each native query */
+    resultStride_ = static_cast<VkDeviceSize>(groupSize_ * sizeof(std::uint64_t));
+
+    VkBufferCreateInfo bufferCreateInfo;
+    BuildVkBufferCreateInfo(bufferCreateInfo, resultStride_ * numNativeQueries, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    resultBuffer_.CreateVkBufferAndMemoryRegion(
+        device,
+        bufferCreateInfo,
+        deviceMemoryMngr,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    );
+}
+
+VKQueryHeap::~VKQueryHeap()
+{
+    resultBuffer_.ReleaseMemoryRegion(deviceMemoryMngr_);
+}
+
+void VKQueryHeap::ReadResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
+{
+    if (numQueries == 0)
+        return;
+
+    /* Results are either 32-bit or 64-bit values, depending on the size of the output data */
+    const auto numValues    = static_cast<std::size_t>(numQueries) * groupSize_;
+    const bool is64Bit      = (dataSize == numValues * sizeof(std::uint64_t));
+
+    if (!is64Bit && dataSize != numValues * sizeof(std::uint32_t))
+    {
+        throw std::invalid_argument(
+            "cannot read Vulkan query results with data size of " + std::to_string(dataSize) + " bytes (expected " +
+            std::to_string(numValues * sizeof(std::uint32_t)) + " or " + std::to_string(numValues * sizeof(std::uint64_t)) + " bytes)"
+        );
+    }
+
+    if (auto mappedData = resultBuffer_.Map(device_))
+    {
+        auto results = reinterpret_cast<const std::uint64_t*>(mappedData);
+
+        if (queryStride_ == 2)
+        {
+            /* Convert each pair of timestamps into the elapsed time in nanoseconds */
+            for (std::uint32_t i = 0; i < numQueries; ++i)
+            {
+                const auto query        = (firstQuery + i) * 2;
+                const auto elapsedTicks = results[query + 1] - results[query];
+                WriteQueryResult(data, i, static_cast<std::uint64_t>(static_cast<double>(elapsedTicks) * timestampPeriod_), is64Bit);
+            }
+        }
+        else if (is64Bit)
+        {
+            /* Copy 64-bit values directly into output data */
+            ::memcpy(data, results + static_cast<std::size_t>(firstQuery) * groupSize_, numValues * sizeof(std::uint64_t));
+        }
+        else
+        {
+            /* Truncate values to 32-bit */
+            for (std::size_t i = 0; i < numValues; ++i)
+                WriteQueryResult(data, i, results[static_cast<std::size_t>(firstQuery) * groupSize_ + i], false);
+        }
+
+        resultBuffer_.Unmap(device_);
+    }
 }
 
 
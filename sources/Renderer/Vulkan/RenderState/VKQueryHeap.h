@@ -12,18 +12,41 @@
 #include <LLGL/QueryHeap.h>
 #include "../Vulkan.h"
 #include "../VKPtr.h"
+#include "../Buffer/VKDeviceBuffer.h"
+#include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
+class VKDeviceMemoryManager;
+
+/*
+Query heap with a host visible result buffer. Each command buffer copies the results of all queries it has used into this buffer
+at the end of its encoding (see VKCommandBuffer::End), so the CPU reads the results from memory once the submission has been completed
+instead of polling the query pool. Queries of type 'TimeElapsed' consist of two timestamps each.
+*/
 class VKQueryHeap final : public QueryHeap
 {
 
     public:
 
-        VKQueryHeap(const VKPtr<VkDevice>& device, const QueryHeapDescriptor& desc);
+        VKQueryHeap(
+            const VKPtr<VkDevice>&      device,
+            VKDeviceMemoryManager&      deviceMemoryMngr,
+            const QueryHeapDescriptor&  desc,
+            float                       timestampPeriod
+        );
+        ~VKQueryHeap();
+
+        /*
+        Copies the results of the specified queries from the result buffer into the output data.
+        Must only be called once the command buffer that copied the results has been completed (see GetResultTicket).
+        The data size must be exactly large enough for either 32-bit or 64-bit values, otherwise std::invalid_argument is thrown.
+        */
+        void ReadResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize);
 
         // Returns the Vulkan VkQueryPool object.
         inline VkQueryPool GetVkQueryPool() const
@@ -37,10 +60,50 @@ class VKQueryHeap final : public QueryHeap
             return groupSize_;
         }
 
+        // Returns the number of native queries per query, i.e. 2 for 'TimeElapsed' queries and 1 otherwise.
+        inline std::uint32_t GetQueryStride() const
+        {
+            return queryStride_;
+        }
+
+        // Returns the native buffer that receives the results of all native queries.
+        inline VkBuffer GetResultVkBuffer() const
+        {
+            return resultBuffer_.GetVkBuffer();
+        }
+
+        // Returns the size (in bytes) of each native query result within the result buffer.
+        inline VkDeviceSize GetResultStride() const
+        {
+            return resultStride_;
+        }
+
+        // Sets the upload queue ticket whose completion implies that the last command buffer that copied results into the result buffer has been completed.
+        inline void SetResultTicket(std::uint64_t ticket)
+        {
+            resultTicket_ = ticket;
+        }
+
+        // Returns the upload queue ticket of the latest results, or 0 if no results have been submitted yet.
+        inline std::uint64_t GetResultTicket() const
+        {
+            return resultTicket_;
+        }
+
     private:
 
-        VKPtr<VkQueryPool>  queryPool_;
-        std::uint32_t       groupSize_  = 1;
+        VkDevice                device_             = VK_NULL_HANDLE;
+        VKDeviceMemoryManager&  deviceMemoryMngr_;
+
+        VKPtr<VkQueryPool>      queryPool_;
+        std::uint32_t           groupSize_          = 1;
+        std::uint32_t           queryStride_        = 1;
+
+        VKDeviceBuffer          resultBuffer_;
+        VkDeviceSize            resultStride_       = sizeof(std::uint64_t);
+        std::uint64_t           resultTicket_       = 0;
+
+        float                   timestampPeriod_    = 1.0f;
 
 };
 
@@ -7,6 +7,7 @@
 
 #include "VKResourceHeap.h"
 #include "VKPipelineLayout.h"
+#include "VKDescriptorCache.h"
 #include "../Buffer/VKBuffer.h"
 #include "../Texture/VKSampler.h"
 #include "../Texture/VKTexture.h"
@@ -22,9 +23,9 @@ namespace LLGL
 {
 
 
-VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeapDescriptor& desc) :
-    device_         { device                          },
-    descriptorPool_ { device, vkDestroyDescriptorPool }
+VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, VKDescriptorCache& descriptorCache, const ResourceHeapDescriptor& desc) :
+    device_          { device          },
+    descriptorCache_ { descriptorCache }
 {
     /* Get pipeline layout object */
     auto pipelineLayoutVK = LLGL_CAST(VKPipelineLayout*, desc.pipelineLayout);
@@ -38,24 +39,32 @@ VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeap
     if (desc.resourceViews.size() != bindings.size())
         throw std::invalid_argument("failed to create resource vied heap due to mismatch between number of resources and bindings");
 
-    /* Create resource descriptor pool */
-    CreateDescriptorPool(desc, bindings);
+    /* Get resource descriptor set for pipeline layout from the shared descriptor cache */
+    auto setLayout = pipelineLayoutVK->GetVkDescriptorSetLayout();
+    auto key = MakeDescriptorSetKey(setLayout, desc, bindings);
 
-    /* Create resource descriptor set for pipeline layout */
-    VkDescriptorSetLayout setLayouts[] = { pipelineLayoutVK->GetVkDescriptorSetLayout() };
-    CreateDescriptorSets(1, setLayouts);
+    bool isNew = false;
+    descriptorSets_.push_back(descriptorCache_.Acquire(setLayout, GetDescriptorPoolSizes(bindings), key, isNew));
 
-    /* Update write descriptors in descriptor set */
-    UpdateDescriptorSets(desc, bindings);
+    /* Update write descriptors in descriptor set, unless it has been shared with another resource heap */
+    if (isNew)
+    {
+        try
+        {
+            UpdateDescriptorSets(desc, bindings);
+        }
+        catch (...)
+        {
+            descriptorCache_.Release(descriptorSets_[0]);
+            throw;
+        }
+    }
 }
 
 VKResourceHeap::~VKResourceHeap()
 {
-    //INFO: is automatically deleted when pool is deleted
-    #if 0
-    auto result = vkFreeDescriptorSets(device_, descriptorPool_, 1, &descriptorSet_);
-    VKThrowIfFailed(result, "failed to release Vulkan descriptor sets");
-    #endif
+    for (auto descriptorSet : descriptorSets_)
+        descriptorCache_.Release(descriptorSet);
 }
 
 
@@ -98,11 +107,11 @@ static void CompressDescriptorPoolSizes(std::vector<VkDescriptorPoolSize>& poolS
     );
 }
 
-void VKResourceHeap::CreateDescriptorPool(const ResourceHeapDescriptor& desc, const std::vector<VKLayoutBinding>& bindings)
+std::vector<VkDescriptorPoolSize> VKResourceHeap::GetDescriptorPoolSizes(const std::vector<VKLayoutBinding>& bindings) const
 {
     /* Initialize descriptor pool sizes */
-    std::vector<VkDescriptorPoolSize> poolSizes(desc.resourceViews.size());
-    for (std::size_t i = 0; i < desc.resourceViews.size(); ++i)
+    std::vector<VkDescriptorPoolSize> poolSizes(bindings.size());
+    for (std::size_t i = 0; i < bindings.size(); ++i)
     {
         poolSizes[i].type               = bindings[i].descriptorType;
         poolSizes[i].descriptorCount    = 1;
@@ -111,35 +120,55 @@ void VKResourceHeap::CreateDescriptorPool(const ResourceHeapDescriptor& desc, co
     /* Compress pool sizes by merging equal types with accumulated number of descriptors */
     CompressDescriptorPoolSizes(poolSizes);
 
-    /* Create descriptor pool */
-    VkDescriptorPoolCreateInfo poolCreateInfo;
-    {
-        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolCreateInfo.pNext            = nullptr;
-        poolCreateInfo.flags            = 0;
-        poolCreateInfo.maxSets          = 1;
-        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(poolSizes.size());
-        poolCreateInfo.pPoolSizes       = poolSizes.data();
-    }
-    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, nullptr, descriptorPool_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
+    return poolSizes;
 }
 
-void VKResourceHeap::CreateDescriptorSets(std::uint32_t numSetLayouts, const VkDescriptorSetLayout* setLayouts)
+std::vector<std::uint64_t> VKResourceHeap::MakeDescriptorSetKey(
+    VkDescriptorSetLayout               setLayout,
+    const ResourceHeapDescriptor&       desc,
+    const std::vector<VKLayoutBinding>& bindings) const
 {
-    descriptorSets_.resize(1, VK_NULL_HANDLE);
+    /* Key starts with the descriptor set layout, followed by the binding slot, descriptor type, and native handle of each resource */
+    std::vector<std::uint64_t> key;
+    key.reserve(1 + bindings.size() * 3);
+    key.push_back(VKDescriptorCache::MakeKeyValue(setLayout));
 
-    /* Allocate descriptor set */
-    VkDescriptorSetAllocateInfo allocInfo;
+    for (std::size_t i = 0; i < bindings.size(); ++i)
     {
-        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.pNext                 = nullptr;
-        allocInfo.descriptorPool        = descriptorPool_;
-        allocInfo.descriptorSetCount    = numSetLayouts;
-        allocInfo.pSetLayouts           = setLayouts;
+        const auto& rvDesc = desc.resourceViews[i];
+        auto descriptorType = bindings[i].descriptorType;
+
+        key.push_back((static_cast<std::uint64_t>(descriptorType) << 32) | bindings[i].dstBinding);
+
+        switch (descriptorType)
+        {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+                key.push_back(VKDescriptorCache::MakeKeyValue(LLGL_CAST(VKSampler*, rvDesc.resource)->GetVkSampler()));
+                break;
+
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                key.push_back(VKDescriptorCache::MakeKeyValue(LLGL_CAST(VKTexture*, rvDesc.resource)->GetVkImageView()));
+                break;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            {
+                auto bufferVK = LLGL_CAST(VKBuffer*, rvDesc.resource);
+                key.push_back(VKDescriptorCache::MakeKeyValue(bufferVK->GetVkBuffer()));
+                key.push_back(static_cast<std::uint64_t>(bufferVK->GetSize()));
+            }
+            break;
+
+            default:
+                throw std::invalid_argument(
+                    "invalid descriptor type to create ResourceHeap object: 0x" +
+                    ToHex(static_cast<std::uint32_t>(descriptorType))
+                );
+                break;
+        }
     }
-    auto result = vkAllocateDescriptorSets(device_, &allocInfo, descriptorSets_.data());
-    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+
+    return key;
 }
 
 void VKResourceHeap::UpdateDescriptorSets(const ResourceHeapDescriptor& desc, const std::vector<VKLayoutBinding>& bindings)
@@ -20,6 +20,7 @@ namespace LLGL
 
 
 class VKBuffer;
+class VKDescriptorCache;
 struct VKWriteDescriptorContainer;
 struct VKLayoutBinding;
 
@@ -28,7 +29,7 @@ class VKResourceHeap final : public ResourceHeap
 
     public:
 
-        VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeapDescriptor& desc);
+        VKResourceHeap(const VKPtr<VkDevice>& device, VKDescriptorCache& descriptorCache, const ResourceHeapDescriptor& desc);
         ~VKResourceHeap();
 
         inline VkPipelineLayout GetVkPipelineLayout() const
@@ -36,11 +37,6 @@ class VKResourceHeap final : public ResourceHeap
             return pipelineLayout_;
         }
 
-        inline VkDescriptorPool GetVkDescriptorPool() const
-        {
-            return descriptorPool_.Get();
-        }
-
         inline const std::vector<VkDescriptorSet>& GetVkDescriptorSets() const
         {
             return descriptorSets_;
@@ -48,17 +44,25 @@ class VKResourceHeap final : public ResourceHeap
 
     private:
 
-        void CreateDescriptorPool(const ResourceHeapDescriptor& desc, const std::vector<VKLayoutBinding>& bindings);
-        void CreateDescriptorSets(std::uint32_t numSetLayouts, const VkDescriptorSetLayout* setLayouts);
+        // Returns the descriptor pool sizes that are required for the descriptor set of this resource heap.
+        std::vector<VkDescriptorPoolSize> GetDescriptorPoolSizes(const std::vector<VKLayoutBinding>& bindings) const;
+
+        // Returns the key of the descriptor set for the specified layout and resources (see VKDescriptorCache).
+        std::vector<std::uint64_t> MakeDescriptorSetKey(
+            VkDescriptorSetLayout               setLayout,
+            const ResourceHeapDescriptor&       desc,
+            const std::vector<VKLayoutBinding>& bindings
+        ) const;
+
         void UpdateDescriptorSets(const ResourceHeapDescriptor& desc, const std::vector<VKLayoutBinding>& bindings);
 
         void FillWriteDescriptorForSampler(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container);
         void FillWriteDescriptorForTexture(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container);
         void FillWriteDescriptorForBuffer(const ResourceViewDescriptor& resourceViewDesc, const VKLayoutBinding& binding, VKWriteDescriptorContainer& container);
 
-        VkDevice                        device_         = VK_NULL_HANDLE;
-        VkPipelineLayout                pipelineLayout_ = VK_NULL_HANDLE;
-        VKPtr<VkDescriptorPool>         descriptorPool_;
+        VkDevice                        device_             = VK_NULL_HANDLE;
+        VKDescriptorCache&              descriptorCache_;
+        VkPipelineLayout                pipelineLayout_     = VK_NULL_HANDLE;
         std::vector<VkDescriptorSet>    descriptorSets_;
 
 };
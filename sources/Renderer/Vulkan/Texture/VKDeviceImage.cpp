@@ -24,7 +24,7 @@ VKDeviceImage::~VKDeviceImage()
 {
 }
 
-void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr)
+void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr, bool dedicated)
 {
     auto device = deviceMemoryMngr.GetVkDevice();
 
@@ -37,7 +37,8 @@ void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr
         requirements.size,
         requirements.alignment,
         requirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        dedicated
     );
 
     /* Bind image to device memory region */
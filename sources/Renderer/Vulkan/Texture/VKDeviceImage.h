@@ -31,7 +31,7 @@ class VKDeviceImage
         VKDeviceImage(const VKPtr<VkDevice>& device);
         virtual ~VKDeviceImage();
 
-        void AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
+        void AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr, bool dedicated = false);
         void ReleaseMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
 
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
@@ -23,9 +23,12 @@ VKTexture::VKTexture(
         imageView_    { device, vkDestroyImageView },
         format_       { VKTypes::Map(desc.format)  }
 {
-    /* Create Vulkan image and allocate memory region */
+    /* Create Vulkan image and allocate memory region; attachments get a dedicated region, since they are usually large and long-living */
     CreateImage(device, desc);
-    imageWrapper_.AllocateMemoryRegion(deviceMemoryMngr);
+    imageWrapper_.AllocateMemoryRegion(
+        deviceMemoryMngr,
+        ((desc.bindFlags & (BindFlags::ColorAttachment | BindFlags::DepthStencilAttachment)) != 0)
+    );
 }
 
 Extent3D VKTexture::QueryMipExtent(std::uint32_t mipLevel) const
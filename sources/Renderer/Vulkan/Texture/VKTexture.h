@@ -90,6 +90,18 @@ class VKTexture final : public Texture
             return imageWrapper_.GetMemoryRegion();
         }
 
+        // Sets the ticket of the last upload batch that writes to this texture (see VKUploadQueue).
+        inline void SetUploadTicket(std::uint64_t ticket)
+        {
+            uploadTicket_ = ticket;
+        }
+
+        // Returns the ticket of the last upload batch that writes to this texture.
+        inline std::uint64_t GetUploadTicket() const
+        {
+            return uploadTicket_;
+        }
+
     private:
 
         void CreateImage(VkDevice device, const TextureDescriptor& desc);
@@ -102,6 +114,8 @@ class VKTexture final : public Texture
         std::uint32_t       numMipLevels_   = 0;
         std::uint32_t       numArrayLayers_ = 0;
 
+        std::uint64_t       uploadTicket_   = 0;
+
 };
 
 
@@ -18,10 +18,15 @@
 #include "Texture/VKRenderTarget.h"
 #include "Buffer/VKBuffer.h"
 #include "Buffer/VKBufferArray.h"
+#include "Memory/VKDeviceMemoryDefragmenter.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../StaticLimits.h"
 #include "../../Core/Exception.h"
+#include "../../Core/Helper.h"
 #include <cstddef>
+#include <algorithm>
+#include <functional>
 
 
 namespace LLGL
@@ -30,6 +35,12 @@ namespace LLGL
 
 static const std::uint32_t g_maxNumViewportsPerBatch = 16;
 
+// Size of each page of the transient allocators, which covers multiple buffer updates of the maximal size.
+static const VkDeviceSize  g_transientPageSize       = 256 * 1024;
+
+// Number of consecutive recordings after which an unused page of the transient allocators is released.
+static const std::uint32_t g_transientPageMaxIdle    = 16;
+
 static bool MustEmulateMultiDrawIndirect(const VKPhysicalDevice& physicalDevice)
 {
     return (physicalDevice.GetFeatures().multiDrawIndirect != VK_FALSE);
@@ -40,9 +51,12 @@ VKCommandBuffer::VKCommandBuffer(
     const VKPtr<VkDevice>&          device,
     VkQueue                         graphicsQueue,
     const QueueFamilyIndices&       queueFamilyIndices,
+    VKDeviceMemoryManager&          deviceMemoryMngr,
+    VKDeviceMemoryDefragmenter*     defragmenter,
     const CommandBufferDescriptor&  desc) :
         device_                   { device                                       },
         commandPool_              { device, vkDestroyCommandPool                 },
+        defragmenter_             { defragmenter                                 },
         queuePresentFamily_       { queueFamilyIndices.presentFamily             },
         emulateMultiDrawIndirect_ { MustEmulateMultiDrawIndirect(physicalDevice) }
 {
@@ -55,10 +69,14 @@ VKCommandBuffer::VKCommandBuffer(
         bufferLevel_    = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
     }
 
+    /* Deferred command buffers can be executed multiple times, just like multi-submit command buffers can be submitted multiple times */
+    multiSubmit_ = ((desc.flags & (CommandBufferFlags::DeferredSubmit | CommandBufferFlags::MultiSubmit)) != 0);
+
     /* Create native command buffer objects */
     CreateCommandPool(queueFamilyIndices.graphicsFamily);
     CreateCommandBuffers(bufferCount);
     CreateRecordingFences(graphicsQueue, bufferCount);
+    CreateTransientAllocators(deviceMemoryMngr, bufferCount);
 
     /* Acquire first native command buffer */
     AcquireNextBuffer();
@@ -66,6 +84,9 @@ VKCommandBuffer::VKCommandBuffer(
 
 VKCommandBuffer::~VKCommandBuffer()
 {
+    if (defragmenter_ != nullptr)
+        defragmenter_->RemoveCommandBuffer(*this);
+
     vkFreeCommandBuffers(
         device_,
         commandPool_,
@@ -78,6 +99,8 @@ VKCommandBuffer::~VKCommandBuffer()
 
 void VKCommandBuffer::Begin()
 {
+    LLGL_PROFILE_COUNT(commandBufferEncodings);
+
     /* Use next internal VkCommandBuffer object to reduce latency */
     AcquireNextBuffer();
 
@@ -85,6 +108,13 @@ void VKCommandBuffer::Begin()
     vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
     vkResetFences(device_, 1, &recordingFence_);
 
+    /* Transient data of the previous recording with this command buffer is no longer in use */
+    transientAllocator_->Reset();
+
+    /* Stamp this command buffer with the current generation of relocated buffers, since their native handles are recorded from now on */
+    if (defragmenter_ != nullptr)
+        defragmenter_->BeginEncoding(*this, multiSubmit_);
+
     /* Begin recording of current command buffer */
     VkCommandBufferBeginInfo beginInfo;
     {
@@ -96,10 +126,8 @@ void VKCommandBuffer::Begin()
     auto result = vkBeginCommandBuffer(commandBuffer_, &beginInfo);
     VKThrowIfFailed(result, "failed to begin Vulkan command buffer");
 
-    #if 1//TODO: optimize
-    /* Reset all query pools that were in flight during last encoding */
-    ResetQueryPoolsInFlight();
-    #endif
+    /* Queries are reset when the command buffer is submitted, so only the used queries must be tracked */
+    queryRanges_.clear();
 
     /* Store new record state */
     recordState_ = RecordState::OutsideRenderPass;
@@ -107,6 +135,9 @@ void VKCommandBuffer::Begin()
 
 void VKCommandBuffer::End()
 {
+    /* Copy results of all used queries into their result buffers, so they never need to be polled from the query pools */
+    CopyQueryResults();
+
     /* End encoding of current command buffer */
     auto result = vkEndCommandBuffer(commandBuffer_);
     VKThrowIfFailed(result, "failed to end Vulkan command buffer");
@@ -117,23 +148,38 @@ void VKCommandBuffer::End()
 
 void VKCommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint16_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferUpdates);
+
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
 
-    auto size   = static_cast<VkDeviceSize>(dataSize);
-    auto offset = static_cast<VkDeviceSize>(dstOffset);
+    /*
+    Copy data into transient memory (which is only a pointer bump), instead of using vkCmdUpdateBuffer,
+    which is slow for frequent updates and requires the data size to be a multiple of 4.
+    The data is still copied into the destination buffer, since resource heaps bind constant buffers without dynamic offsets
+    */
+    auto srcRegion = transientAllocator_->Allocate(data, static_cast<VkDeviceSize>(dataSize));
+
+    VkBufferCopy region;
+    {
+        region.srcOffset    = srcRegion.offset;
+        region.dstOffset    = static_cast<VkDeviceSize>(dstOffset);
+        region.size         = static_cast<VkDeviceSize>(dataSize);
+    }
 
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
-        vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, data);
+        vkCmdCopyBuffer(commandBuffer_, srcRegion.buffer, dstBufferVK.GetVkBuffer(), 1, &region);
         ResumeRenderPass();
     }
     else
-        vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, data);
+        vkCmdCopyBuffer(commandBuffer_, srcRegion.buffer, dstBufferVK.GetVkBuffer(), 1, &region);
 }
 
 void VKCommandBuffer::CopyBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
 {
+    LLGL_PROFILE_COUNT(bufferCopies);
+
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
     auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
 
@@ -299,6 +345,8 @@ static VkImageAspectFlags GetDepthStencilAspectMask(long flags)
 
 void VKCommandBuffer::Clear(long flags)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     VkClearAttachment attachments[LLGL_MAX_NUM_ATTACHMENTS];
 
     std::uint32_t numAttachments = 0;
@@ -335,6 +383,8 @@ void VKCommandBuffer::Clear(long flags)
 
 void VKCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_PROFILE_COUNT(attachmentClears);
+
     /* Convert clear attachment descriptors */
     VkClearAttachment attachmentsVK[LLGL_MAX_NUM_ATTACHMENTS];
 
@@ -381,6 +431,8 @@ void VKCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Attac
 
 void VKCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
     VkBuffer buffers[] = { bufferVK.GetVkBuffer() };
@@ -391,6 +443,8 @@ void VKCommandBuffer::SetVertexBuffer(Buffer& buffer)
 
 void VKCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(vertexBufferBindings);
+
     auto& bufferArrayVK = LLGL_CAST(VKBufferArray&, bufferArray);
     vkCmdBindVertexBuffers(
         commandBuffer_,
@@ -403,12 +457,16 @@ void VKCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void VKCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdBindIndexBuffer(commandBuffer_, bufferVK.GetVkBuffer(), 0, bufferVK.GetIndexType());
 }
 
 void VKCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(indexBufferBindings);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdBindIndexBuffer(commandBuffer_, bufferVK.GetVkBuffer(), offset, VKTypes::ToVkIndexType(format));
 }
@@ -417,16 +475,22 @@ void VKCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::u
 
 void VKCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     ThrowVKExtensionNotSupportedExcept(__FUNCTION__, "VK_EXT_transform_feedback");
 }
 
 void VKCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_PROFILE_COUNT(streamOutputBufferBindings);
+
     ThrowVKExtensionNotSupportedExcept(__FUNCTION__, "VK_EXT_transform_feedback");
 }
 
 void VKCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    LLGL_PROFILE_COUNT(streamOutputSections);
+
     ThrowVKExtensionNotSupportedExcept(__FUNCTION__, "VK_EXT_transform_feedback");
 }
 
@@ -454,12 +518,16 @@ void VKCommandBuffer::BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelin
 
 void VKCommandBuffer::SetGraphicsResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
 {
+    LLGL_PROFILE_COUNT(graphicsResourceHeapBindings);
+
     auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
     BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_GRAPHICS, firstSet);
 }
 
 void VKCommandBuffer::SetComputeResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstSet)
 {
+    LLGL_PROFILE_COUNT(computeResourceHeapBindings);
+
     auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
     BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_COMPUTE, firstSet);
 }
@@ -472,6 +540,8 @@ void VKCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    LLGL_PROFILE_COUNT(renderPassSections);
+
     if (renderTarget.IsRenderContext())
     {
         /* Get Vulkan render context object */
@@ -587,6 +657,8 @@ void VKCommandBuffer::EndRenderPass()
 
 void VKCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_PROFILE_COUNT(graphicsPipelineBindings);
+
     auto& graphicsPipelineVK = LLGL_CAST(VKGraphicsPipeline&, graphicsPipeline);
 
     /* Bind graphics pipeline */
@@ -611,6 +683,8 @@ void VKCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 
 void VKCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_PROFILE_COUNT(computePipelineBindings);
+
     auto& computePipelineVK = LLGL_CAST(VKComputePipeline&, computePipeline);
     vkCmdBindPipeline(commandBuffer_, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineVK.GetVkPipeline());
 }
@@ -619,26 +693,45 @@ void VKCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 
 void VKCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_PROFILE_COUNT(querySections);
+
     auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
+    AppendQueryRange(queryHeapVK, query);
 
-    /* Begin query and determine control flags (for either 'SamplesPassed' or 'AnySamplesPassed') */
-    VkQueryControlFlags flags = 0;
+    if (queryHeapVK.GetType() == QueryType::TimeElapsed)
+    {
+        /* Write first timestamp of the query */
+        vkCmdWriteTimestamp(commandBuffer_, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryHeapVK.GetVkQueryPool(), query * 2);
+    }
+    else
+    {
+        /* Begin query and determine control flags (for either 'SamplesPassed' or 'AnySamplesPassed') */
+        VkQueryControlFlags flags = 0;
 
-    if (queryHeapVK.GetType() == QueryType::SamplesPassed)
-        flags |= VK_QUERY_CONTROL_PRECISE_BIT;
+        if (queryHeapVK.GetType() == QueryType::SamplesPassed)
+            flags |= VK_QUERY_CONTROL_PRECISE_BIT;
 
-    vkCmdBeginQuery(commandBuffer_, queryHeapVK.GetVkQueryPool(), query, flags);
+        vkCmdBeginQuery(commandBuffer_, queryHeapVK.GetVkQueryPool(), query, flags);
+    }
 }
 
 void VKCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
     auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
-    vkCmdEndQuery(commandBuffer_, queryHeapVK.GetVkQueryPool(), query);
-    AppendQueryPoolInFlight(queryHeapVK.GetVkQueryPool());
+
+    if (queryHeapVK.GetType() == QueryType::TimeElapsed)
+    {
+        /* Write second timestamp of the query once all previous commands have been completed */
+        vkCmdWriteTimestamp(commandBuffer_, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryHeapVK.GetVkQueryPool(), query * 2 + 1);
+    }
+    else
+        vkCmdEndQuery(commandBuffer_, queryHeapVK.GetVkQueryPool(), query);
 }
 
 void VKCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_PROFILE_COUNT(renderConditionSections);
+
     /*#ifdef LLGL_VK_ENABLE_EXT
     VkConditionalRenderingBeginInfoEXT beginInfo;
     {
@@ -667,52 +760,72 @@ void VKCommandBuffer::EndRenderCondition()
 
 void VKCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     vkCmdDraw(commandBuffer_, numVertices, 1, firstVertex, 0);
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, 0, 0);
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, vertexOffset, 0);
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, 0);
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (emulateMultiDrawIndirect_)
     {
@@ -728,12 +841,16 @@ void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::ui
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_PROFILE_COUNT(drawCommands);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (emulateMultiDrawIndirect_)
     {
@@ -751,11 +868,15 @@ void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
 
 void VKCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     vkCmdDispatch(commandBuffer_, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void VKCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_PROFILE_COUNT(dispatchCommands);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDispatchIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset);
 }
@@ -779,6 +900,7 @@ void VKCommandBuffer::AcquireNextBuffer()
     commandBufferIndex_ = (commandBufferIndex_ + 1) % commandBufferList_.size();
     commandBuffer_      = commandBufferList_[commandBufferIndex_];
     recordingFence_     = recordingFenceList_[commandBufferIndex_].Get();
+    transientAllocator_ = transientAllocatorList_[commandBufferIndex_].get();
 }
 
 
@@ -843,6 +965,13 @@ void VKCommandBuffer::CreateRecordingFences(VkQueue graphicsQueue, std::size_t n
     }
 }
 
+void VKCommandBuffer::CreateTransientAllocators(VKDeviceMemoryManager& deviceMemoryMngr, std::size_t numAllocators)
+{
+    transientAllocatorList_.reserve(numAllocators);
+    for (std::size_t i = 0; i < numAllocators; ++i)
+        transientAllocatorList_.push_back(MakeUnique<VKTransientAllocator>(device_, deviceMemoryMngr, g_transientPageSize, g_transientPageMaxIdle));
+}
+
 void VKCommandBuffer::ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments)
 {
     if (numAttachments > 0)
@@ -968,20 +1097,113 @@ void VKCommandBuffer::EndClearImage(VkImageMemoryBarrier& clearToPresentBarrier)
 
 #endif
 
-void VKCommandBuffer::ResetQueryPoolsInFlight()
+void VKCommandBuffer::AppendQueryRange(VKQueryHeap& queryHeapVK, std::uint32_t query)
 {
-    for (std::size_t i = 0; i < numQueryPoolsInFlight_; ++i)
-        vkCmdResetQueryPool(commandBuffer_, queryPoolsInFlight_[i], 0, 1);
-    numQueryPoolsInFlight_ = 0;
+    /* Extend the most recent run if the query directly follows it, which is the common case for consecutive queries */
+    if (!queryRanges_.empty())
+    {
+        auto& range = queryRanges_.back();
+        if (range.queryHeap == &queryHeapVK && query >= range.firstQuery && query <= range.lastQuery + 1)
+        {
+            range.lastQuery = std::max(range.lastQuery, query);
+            return;
+        }
+    }
+    queryRanges_.push_back({ &queryHeapVK, query, query });
 }
 
-void VKCommandBuffer::AppendQueryPoolInFlight(VkQueryPool queryPool)
+void VKCommandBuffer::MergeQueryRanges()
 {
-    if (numQueryPoolsInFlight_ >= queryPoolsInFlight_.size())
-        queryPoolsInFlight_.push_back(queryPool);
-    else
-        queryPoolsInFlight_[numQueryPoolsInFlight_] = queryPool;
-    ++numQueryPoolsInFlight_;
+    if (queryRanges_.size() < 2)
+        return;
+
+    std::sort(
+        queryRanges_.begin(), queryRanges_.end(),
+        [](const QueryRange& lhs, const QueryRange& rhs)
+        {
+            if (lhs.queryHeap != rhs.queryHeap)
+                return std::less<VKQueryHeap*>()(lhs.queryHeap, rhs.queryHeap);
+            return (lhs.firstQuery < rhs.firstQuery);
+        }
+    );
+
+    /* Merge overlapping and adjacent runs of the same query heap, but never close the gaps between them */
+    auto dst = queryRanges_.begin();
+    for (auto src = queryRanges_.begin() + 1; src != queryRanges_.end(); ++src)
+    {
+        if (src->queryHeap == dst->queryHeap && src->firstQuery <= dst->lastQuery + 1)
+            dst->lastQuery = std::max(dst->lastQuery, src->lastQuery);
+        else
+            *(++dst) = *src;
+    }
+    queryRanges_.erase(dst + 1, queryRanges_.end());
+}
+
+void VKCommandBuffer::CopyQueryResults()
+{
+    if (queryRanges_.empty())
+        return;
+
+    /* Only reset and copy the queries that are actually written, since the copy waits until each query is available */
+    MergeQueryRanges();
+
+    /* Copy results of each run of queries after they are available (no polling on the CPU) */
+    for (const auto& range : queryRanges_)
+    {
+        const auto queryStride  = range.queryHeap->GetQueryStride();
+        const auto firstQuery   = range.firstQuery * queryStride;
+        const auto numQueries   = (range.lastQuery - range.firstQuery + 1) * queryStride;
+        const auto resultStride = range.queryHeap->GetResultStride();
+
+        vkCmdCopyQueryPoolResults(
+            commandBuffer_,
+            range.queryHeap->GetVkQueryPool(),
+            firstQuery,
+            numQueries,
+            range.queryHeap->GetResultVkBuffer(),
+            resultStride * firstQuery,
+            resultStride,
+            (VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT)
+        );
+    }
+
+    /* Make results visible to the host */
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+    }
+    vkCmdPipelineBarrier(
+        commandBuffer_,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+}
+
+void VKCommandBuffer::ResetQueries(VkCommandBuffer cmdBuffer) const
+{
+    for (const auto& range : queryRanges_)
+    {
+        const auto queryStride = range.queryHeap->GetQueryStride();
+        vkCmdResetQueryPool(
+            cmdBuffer,
+            range.queryHeap->GetVkQueryPool(),
+            range.firstQuery * queryStride,
+            (range.lastQuery - range.firstQuery + 1) * queryStride
+        );
+    }
+}
+
+void VKCommandBuffer::SetQueryResultTicket(std::uint64_t ticket) const
+{
+    for (const auto& range : queryRanges_)
+        range.queryHeap->SetResultTicket(ticket);
 }
 
 
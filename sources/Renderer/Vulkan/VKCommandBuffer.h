@@ -13,6 +13,7 @@
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "VKCore.h"
+#include "Buffer/VKTransientAllocator.h"
 
 #include <vector>
 
@@ -23,6 +24,9 @@ namespace LLGL
 
 class VKPhysicalDevice;
 class VKResourceHeap;
+class VKQueryHeap;
+class VKDeviceMemoryManager;
+class VKDeviceMemoryDefragmenter;
 
 class VKCommandBuffer final : public CommandBuffer
 {
@@ -36,6 +40,8 @@ class VKCommandBuffer final : public CommandBuffer
             const VKPtr<VkDevice>&          device,
             VkQueue                         graphicsQueue,
             const QueueFamilyIndices&       queueFamilyIndices,
+            VKDeviceMemoryManager&          deviceMemoryMngr,
+            VKDeviceMemoryDefragmenter*     defragmenter,
             const CommandBufferDescriptor&  desc
         );
         ~VKCommandBuffer();
@@ -163,8 +169,28 @@ class VKCommandBuffer final : public CommandBuffer
             return recordingFence_;
         }
 
+        // Returns true if any queries have been used since the last call to "Begin".
+        inline bool HasQueries() const
+        {
+            return !queryRanges_.empty();
+        }
+
+        // Records commands to reset all queries that have been used by this command buffer into the specified command buffer, which must be submitted before.
+        void ResetQueries(VkCommandBuffer cmdBuffer) const;
+
+        // Sets the specified upload queue ticket for all query heaps that have been used by this command buffer (see VKQueryHeap::SetResultTicket).
+        void SetQueryResultTicket(std::uint64_t ticket) const;
+
     private:
 
+        // Contiguous run of queries within a query heap that have been used since the last call to "Begin".
+        struct QueryRange
+        {
+            VKQueryHeap*    queryHeap;
+            std::uint32_t   firstQuery;
+            std::uint32_t   lastQuery;
+        };
+
         enum class RecordState
         {
             Undefined,          // before "Begin"
@@ -176,6 +202,7 @@ class VKCommandBuffer final : public CommandBuffer
         void CreateCommandPool(std::uint32_t queueFamilyIndex);
         void CreateCommandBuffers(std::size_t bufferCount);
         void CreateRecordingFences(VkQueue graphicsQueue, std::size_t numFences);
+        void CreateTransientAllocators(VKDeviceMemoryManager& deviceMemoryMngr, std::size_t numAllocators);
 
         void ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments);
 
@@ -198,10 +225,14 @@ class VKCommandBuffer final : public CommandBuffer
 
         void BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelineBindPoint bindingPoint, std::uint32_t firstSet);
 
-        #if 1//TODO: optimize
-        void ResetQueryPoolsInFlight();
-        void AppendQueryPoolInFlight(VkQueryPool queryPool);
-        #endif
+        // Appends the specified query to the list of used queries, which is merged into contiguous runs by "MergeQueryRanges".
+        void AppendQueryRange(VKQueryHeap& queryHeapVK, std::uint32_t query);
+
+        // Sorts the used queries and merges them into contiguous runs per query heap, so unused queries in between are never reset or copied.
+        void MergeQueryRanges();
+
+        // Records commands to copy the results of all used queries into the result buffers of their query heaps.
+        void CopyQueryResults();
 
     private:
 
@@ -215,10 +246,16 @@ class VKCommandBuffer final : public CommandBuffer
         std::vector<VKPtr<VkFence>>     recordingFenceList_;
         VkFence                         recordingFence_;
 
+        std::vector<std::unique_ptr<VKTransientAllocator>>  transientAllocatorList_;
+        VKTransientAllocator*                               transientAllocator_ = nullptr;
+
         RecordState                     recordState_                = RecordState::Undefined;
 
         VkCommandBufferUsageFlags       usageFlags_                 = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
         VkCommandBufferLevel            bufferLevel_                = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        bool                            multiSubmit_                = false;
+
+        VKDeviceMemoryDefragmenter*     defragmenter_               = nullptr;
 
         VkClearColorValue               clearColor_                 = { 0.0f, 0.0f, 0.0f, 0.0f };
         VkClearDepthStencilValue        clearDepthStencil_          = { 1.0f, 0 };
@@ -237,10 +274,7 @@ class VKCommandBuffer final : public CommandBuffer
 
         bool                            emulateMultiDrawIndirect_   = false;
 
-        #if 1//TODO: optimize usage of query pools
-        std::vector<VkQueryPool>        queryPoolsInFlight_;
-        std::size_t                     numQueryPoolsInFlight_      = 0;
-        #endif
+        std::vector<QueryRange>         queryRanges_;
 
 };
 
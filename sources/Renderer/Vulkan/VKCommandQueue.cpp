@@ -10,6 +10,7 @@
 #include "RenderState/VKFence.h"
 #include "RenderState/VKQueryHeap.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "VKCore.h"
 
 
@@ -17,9 +18,15 @@ namespace LLGL
 {
 
 
-VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue graphicsQueue) :
-    device_        { device        },
-    graphicsQueue_ { graphicsQueue }
+VKCommandQueue::VKCommandQueue(
+    const VKPtr<VkDevice>&      device,
+    VkQueue                     graphicsQueue,
+    VKUploadQueue&              uploadQueue,
+    VKDeviceMemoryDefragmenter* defragmenter) :
+        device_        { device        },
+        graphicsQueue_ { graphicsQueue },
+        uploadQueue_   { uploadQueue   },
+        defragmenter_  { defragmenter  }
 {
 }
 
@@ -27,10 +34,20 @@ VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue graphicsQu
 
 void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_PROFILE_COUNT(commandBufferSubmittions);
+
     auto& commandBufferVK = LLGL_CAST(VKCommandBuffer&, commandBuffer);
 
     VkCommandBuffer commandBuffers[] = { commandBufferVK.GetVkCommandBuffer() };
 
+    /* Reset queries this command buffer uses within the upload batch, since query pools cannot be reset inside a render pass */
+    if (commandBufferVK.HasQueries())
+        commandBufferVK.ResetQueries(uploadQueue_.GetCommandBuffer());
+
+    /* Submit pending buffer and texture uploads first, so they are complete before this command buffer is executed */
+    uploadQueue_.Flush();
+    uploadQueue_.Poll();
+
     /* Submit command buffer to graphics queue */
     VkSubmitInfo submitInfo;
     {
@@ -46,6 +63,20 @@ void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
     }
     auto result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, commandBufferVK.GetQueueSubmitFence());
     VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
+
+    /* Begin next upload batch, which is submitted after this command buffer, so its completion implies that the query results are available */
+    if (commandBufferVK.HasQueries())
+    {
+        uploadQueue_.GetCommandBuffer();
+        commandBufferVK.SetQueryResultTicket(uploadQueue_.GetCurrentTicket());
+    }
+
+    /* Relocate buffers after submission, so the copies are not submitted before this command buffer which still refers to the previous buffers */
+    if (defragmenter_ != nullptr)
+    {
+        defragmenter_->NotifySubmit(commandBufferVK);
+        defragmenter_->Step();
+    }
 }
 
 /* ----- Queries ----- */
@@ -59,33 +90,21 @@ bool VKCommandQueue::QueryResult(
 {
     auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
 
-    /* Determine flags and stride */
-    VkQueryResultFlags  resultFlags = 0;
-    VkDeviceSize        stride      = sizeof(std::uint32_t);
+    /* Check if the command buffer that copied the latest results has been completed */
+    const auto ticket = queryHeapVK.GetResultTicket();
+    if (ticket == 0)
+        return false;
 
-    if (dataSize != numQueries * sizeof(std::uint32_t))
+    if (!uploadQueue_.IsComplete(ticket))
     {
-        resultFlags |= VK_QUERY_RESULT_64_BIT;
-        stride      = sizeof(std::uint64_t);
-    }
-
-    /* Store result directly into output parameter */
-    auto stateResult = vkGetQueryPoolResults(
-        device_,
-        queryHeapVK.GetVkQueryPool(),
-        firstQuery,
-        numQueries,
-        dataSize,
-        data,
-        stride,
-        resultFlags
-    );
-
-    /* Check if result is not ready yet */
-    if (stateResult == VK_NOT_READY)
+        /* Submit the batch that signals the completion, if that has not happened yet */
+        if (ticket == uploadQueue_.GetCurrentTicket())
+            uploadQueue_.Flush();
         return false;
+    }
 
-    VKThrowIfFailed(stateResult, "failed to retrieve results from Vulkan query pool");
+    /* Read results from the result buffer of the query heap */
+    queryHeapVK.ReadResults(firstQuery, numQueries, data, dataSize);
 
     return true;
 }
@@ -115,19 +134,28 @@ bool VKCommandBuffer::QueryPipelineStatisticsResult(QueryHeap& queryHeap, QueryP
 
 void VKCommandQueue::Submit(Fence& fence)
 {
+    LLGL_PROFILE_COUNT(fenceSubmissions);
+
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
     fenceVK.Reset(device_);
+    uploadQueue_.Flush();
     vkQueueSubmit(graphicsQueue_, 0, nullptr, fenceVK.GetVkFence());
 }
 
 bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
-    return fenceVK.Wait(device_, timeout);
+    auto result = fenceVK.Wait(device_, timeout);
+
+    /* Deliver completed texture readbacks */
+    uploadQueue_.Poll();
+
+    return result;
 }
 
 void VKCommandQueue::WaitIdle()
 {
+    uploadQueue_.WaitIdle();
     vkQueueWaitIdle(graphicsQueue_);
 }
 
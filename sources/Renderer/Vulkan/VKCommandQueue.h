@@ -14,6 +14,8 @@
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "RenderState/VKFence.h"
+#include "VKUploadQueue.h"
+#include "Memory/VKDeviceMemoryDefragmenter.h"
 
 
 namespace LLGL
@@ -27,7 +29,12 @@ class VKCommandQueue final : public CommandQueue
 
         /* ----- Common ----- */
 
-        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue graphicsQueue);
+        VKCommandQueue(
+            const VKPtr<VkDevice>&      device,
+            VkQueue                     graphicsQueue,
+            VKUploadQueue&              uploadQueue,
+            VKDeviceMemoryDefragmenter* defragmenter = nullptr
+        );
 
         /* ----- Command Buffers ----- */
 
@@ -46,8 +53,10 @@ class VKCommandQueue final : public CommandQueue
 
     private:
 
-        VkDevice    device_;
-        VkQueue     graphicsQueue_  = VK_NULL_HANDLE;
+        VkDevice                    device_;
+        VkQueue                     graphicsQueue_  = VK_NULL_HANDLE;
+        VKUploadQueue&              uploadQueue_;
+        VKDeviceMemoryDefragmenter* defragmenter_   = nullptr;
 
 };
 
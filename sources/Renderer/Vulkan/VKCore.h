@@ -67,6 +67,9 @@ std::string VKApiVersionToString(std::uint32_t version);
 // Converts the boolean value into a VkBool322 value.
 VkBool32 VKBoolean(bool value);
 
+// Returns the image aspect flags of the specified format, i.e. depth and/or stencil for depth-stencil formats, and color otherwise.
+VkImageAspectFlags VKGetImageAspectByFormat(VkFormat format);
+
 
 
 /* ----- Query Functions ----- */
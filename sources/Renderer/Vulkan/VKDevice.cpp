@@ -184,11 +184,13 @@ void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
 void VKDevice::TransitionImageLayout(
     VkCommandBuffer commandBuffer,
     VkImage         image,
-    VkFormat        /*format*/,
+    VkFormat        format,
     VkImageLayout   oldLayout,
     VkImageLayout   newLayout,
     std::uint32_t   numMipLevels,
-    std::uint32_t   numArrayLayers)
+    std::uint32_t   numArrayLayers,
+    std::uint32_t   baseMipLevel,
+    std::uint32_t   baseArrayLayer)
 {
     /* Initialize image memory barrier descriptor */
     VkImageMemoryBarrier barrier;
@@ -202,10 +204,10 @@ void VKDevice::TransitionImageLayout(
         barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
         barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
         barrier.image                           = image;
-        barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier.subresourceRange.baseMipLevel   = 0;
+        barrier.subresourceRange.aspectMask     = VKGetImageAspectByFormat(format);
+        barrier.subresourceRange.baseMipLevel   = baseMipLevel;
         barrier.subresourceRange.levelCount     = numMipLevels;
-        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.baseArrayLayer = baseArrayLayer;
         barrier.subresourceRange.layerCount     = numArrayLayers;
     }
 
@@ -227,6 +229,27 @@ void VKDevice::TransitionImageLayout(
         srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
         dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     }
+    else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+    {
+        barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT; // Include writes from previous render passes
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        srcStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
+    else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+    {
+        barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT; // Include writes from previous render passes
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        srcStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
+    else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+    {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    }
 
     /* Record image barrier command */
     vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
@@ -268,15 +291,17 @@ void VKDevice::CopyBufferToImage(
     VkBuffer            srcBuffer,
     VkImage             dstImage,
     const VkExtent3D&   extent,
-    std::uint32_t       numLayers)
+    std::uint32_t       numLayers,
+    std::uint32_t       mipLevel,
+    VkDeviceSize        bufferOffset)
 {
     VkBufferImageCopy region;
     {
-        region.bufferOffset                     = 0;
+        region.bufferOffset                     = bufferOffset;
         region.bufferRowLength                  = 0;
         region.bufferImageHeight                = 0;
         region.imageSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel        = 0;
+        region.imageSubresource.mipLevel        = mipLevel;
         region.imageSubresource.baseArrayLayer  = 0;
         region.imageSubresource.layerCount      = numLayers;
         region.imageOffset                      = { 0, 0, 0 };
@@ -285,6 +310,24 @@ void VKDevice::CopyBufferToImage(
     vkCmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 }
 
+void VKDevice::CopyBufferToImage(
+    VkCommandBuffer             commandBuffer,
+    VkBuffer                    srcBuffer,
+    VkImage                     dstImage,
+    const VkBufferImageCopy&    region)
+{
+    vkCmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+}
+
+void VKDevice::CopyImageToBuffer(
+    VkCommandBuffer             commandBuffer,
+    VkImage                     srcImage,
+    VkBuffer                    dstBuffer,
+    const VkBufferImageCopy&    region)
+{
+    vkCmdCopyImageToBuffer(commandBuffer, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstBuffer, 1, &region);
+}
+
 void VKDevice::GenerateMips(
     VkCommandBuffer     commandBuffer,
     VkImage             image,
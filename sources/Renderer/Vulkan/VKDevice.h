@@ -54,7 +54,9 @@ class VKDevice
             VkImageLayout   oldLayout,
             VkImageLayout   newLayout,
             std::uint32_t   numMipLevels,
-            std::uint32_t   numArrayLayers
+            std::uint32_t   numArrayLayers,
+            std::uint32_t   baseMipLevel    = 0,
+            std::uint32_t   baseArrayLayer  = 0
         );
 
         void CopyBuffer(
@@ -79,7 +81,23 @@ class VKDevice
             VkBuffer            srcBuffer,
             VkImage             dstImage,
             const VkExtent3D&   extent,
-            std::uint32_t       numLayers
+            std::uint32_t       numLayers,
+            std::uint32_t       mipLevel        = 0,
+            VkDeviceSize        bufferOffset    = 0
+        );
+
+        void CopyBufferToImage(
+            VkCommandBuffer             commandBuffer,
+            VkBuffer                    srcBuffer,
+            VkImage                     dstImage,
+            const VkBufferImageCopy&    region
+        );
+
+        void CopyImageToBuffer(
+            VkCommandBuffer             commandBuffer,
+            VkImage                     srcImage,
+            VkBuffer                    dstBuffer,
+            const VkBufferImageCopy&    region
         );
 
         void GenerateMips(
@@ -162,9 +162,10 @@ std::uint32_t VKPhysicalDevice::FindMemoryType(std::uint32_t memoryTypeBits, VkM
 
 void VKPhysicalDevice::QueryDeviceProperties()
 {
-    /* Query physical device features and memory propertiers */
+    /* Query physical device features, properties, and memory propertiers */
     vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &memoryProperties_);
     vkGetPhysicalDeviceFeatures(physicalDevice_, &features_);
+    vkGetPhysicalDeviceProperties(physicalDevice_, &properties_);
 }
 
 
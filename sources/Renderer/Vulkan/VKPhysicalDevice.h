@@ -65,6 +65,12 @@ class VKPhysicalDevice
             return features_;
         }
 
+        // Returns the properties of the physical device.
+        inline const VkPhysicalDeviceProperties& GetProperties() const
+        {
+            return properties_;
+        }
+
     private:
 
         void QueryDeviceProperties();
@@ -73,6 +79,7 @@ class VKPhysicalDevice
 
         VkPhysicalDeviceMemoryProperties    memoryProperties_;
         VkPhysicalDeviceFeatures            features_;
+        VkPhysicalDeviceProperties          properties_;
 
 };
 
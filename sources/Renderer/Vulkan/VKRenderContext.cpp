@@ -31,7 +31,8 @@ VKRenderContext::VKRenderContext(
     const VKPtr<VkDevice>& device,
     VKDeviceMemoryManager& deviceMemoryMngr,
     RenderContextDescriptor desc,
-    const std::shared_ptr<Surface>& surface) :
+    const std::shared_ptr<Surface>& surface,
+    std::uint32_t maxFramesInFlight) :
         RenderContext        { desc.videoMode, desc.vsync    },
         instance_            { instance                      },
         physicalDevice_      { physicalDevice                },
@@ -41,7 +42,8 @@ VKRenderContext::VKRenderContext(
         swapChain_           { device, vkDestroySwapchainKHR },
         swapChainRenderPass_ { device                        },
         secondaryRenderPass_ { device                        },
-        depthStencilBuffer_  { device                        }
+        depthStencilBuffer_  { device                        },
+        numFramesInFlight_   { std::max(1u, maxFramesInFlight) }
 {
     SetOrCreateSurface(surface, desc.videoMode, nullptr);
     desc.videoMode = GetVideoMode();
@@ -60,17 +62,26 @@ VKRenderContext::VKRenderContext(
 
 VKRenderContext::~VKRenderContext()
 {
+    /* Wait for all frames in flight, before their semaphores are destroyed */
+    for (const auto& fence : inFlightFences_)
+    {
+        VkFence fenceHandle = fence.Get();
+        vkWaitForFences(device_, 1, &fenceHandle, VK_TRUE, UINT64_MAX);
+    }
     ReleaseDepthStencilBuffer();
 }
 
 void VKRenderContext::Present()
 {
-    /* Initialize semaphores */
-    VkSemaphore waitSemaphorse[] = { imageAvailableSemaphore_ };
+    /* Initialize semaphores of the current frame */
+    VkSemaphore waitSemaphorse[] = { imageAvailableSemaphores_[frameIndex_] };
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    VkSemaphore signalSemaphores[] = { renderFinishedSemaphore_ };
+    VkSemaphore signalSemaphores[] = { renderFinishedSemaphores_[frameIndex_] };
+
+    /* Submit signal semaphore to graphics queue; the fence is signaled once all commands of this frame have been completed */
+    VkFence inFlightFence = inFlightFences_[frameIndex_].Get();
+    vkResetFences(device_, 1, &inFlightFence);
 
-    /* Submit signal semaphore to graphics queue */
     VkSubmitInfo submitInfo;
     {
         submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -83,7 +94,7 @@ void VKRenderContext::Present()
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores    = signalSemaphores;
     }
-    auto result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
+    auto result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, inFlightFence);
     VKThrowIfFailed(result, "failed to submit semaphore to Vulkan graphics queue");
 
     /* Present result on screen */
@@ -103,6 +114,12 @@ void VKRenderContext::Present()
     result = vkQueuePresentKHR(presentQueue_, &presentInfo);
     VKThrowIfFailed(result, "failed to present Vulkan graphics queue");
 
+    /* Move on to next frame and only wait until the frame that previously used its synchronization objects has been completed */
+    frameIndex_ = (frameIndex_ + 1) % numFramesInFlight_;
+
+    VkFence nextFence = inFlightFences_[frameIndex_].Get();
+    vkWaitForFences(device_, 1, &nextFence, VK_TRUE, UINT64_MAX);
+
     /* Get image index for next presentation */
     AcquireNextPresentImage();
 }
@@ -180,11 +197,39 @@ void VKRenderContext::CreateGpuSemaphore(VKPtr<VkSemaphore>& semaphore)
     VKThrowIfFailed(result, "failed to create Vulkan semaphore");
 }
 
+void VKRenderContext::CreateGpuFence(VKPtr<VkFence>& fence)
+{
+    /* Create fence in signaled state, so the first wait for each frame in flight does not block */
+    VkFenceCreateInfo createInfo;
+    {
+        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    }
+    auto result = vkCreateFence(device_, &createInfo, nullptr, fence.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan fence");
+}
+
 void VKRenderContext::CreatePresentSemaphores()
 {
-    /* Create presentation semaphorse */
-    CreateGpuSemaphore(imageAvailableSemaphore_);
-    CreateGpuSemaphore(renderFinishedSemaphore_);
+    /* Create presentation semaphorse and fences for each frame in flight */
+    imageAvailableSemaphores_.clear();
+    renderFinishedSemaphores_.clear();
+    inFlightFences_.clear();
+
+    for (std::uint32_t i = 0; i < numFramesInFlight_; ++i)
+    {
+        imageAvailableSemaphores_.emplace_back(device_, vkDestroySemaphore);
+        CreateGpuSemaphore(imageAvailableSemaphores_.back());
+
+        renderFinishedSemaphores_.emplace_back(device_, vkDestroySemaphore);
+        CreateGpuSemaphore(renderFinishedSemaphores_.back());
+
+        inFlightFences_.emplace_back(device_, vkDestroyFence);
+        CreateGpuFence(inFlightFences_.back());
+    }
+
+    frameIndex_ = 0;
 }
 
 void VKRenderContext::CreateGpuSurface()
@@ -519,7 +564,7 @@ void VKRenderContext::AcquireNextPresentImage()
         device_,
         swapChain_,
         UINT64_MAX,
-        imageAvailableSemaphore_,
+        imageAvailableSemaphores_[frameIndex_],
         VK_NULL_HANDLE,
         &presentImageIndex_
     );
@@ -39,7 +39,8 @@ class VKRenderContext final : public RenderContext
             const VKPtr<VkDevice>& device,
             VKDeviceMemoryManager& deviceMemoryMngr,
             RenderContextDescriptor desc,
-            const std::shared_ptr<Surface>& surface
+            const std::shared_ptr<Surface>& surface,
+            std::uint32_t maxFramesInFlight = 2
         );
 
         ~VKRenderContext();
@@ -86,6 +87,7 @@ class VKRenderContext final : public RenderContext
         bool OnSetVsync(const VsyncDescriptor& vsyncDesc) override;
 
         void CreateGpuSemaphore(VKPtr<VkSemaphore>& semaphore);
+        void CreateGpuFence(VKPtr<VkFence>& fence);
         void CreatePresentSemaphores();
         void CreateGpuSurface();
 
@@ -134,8 +136,12 @@ class VKRenderContext final : public RenderContext
         VkQueue                             graphicsQueue_              = VK_NULL_HANDLE;
         VkQueue                             presentQueue_               = VK_NULL_HANDLE;
 
-        VKPtr<VkSemaphore>                  imageAvailableSemaphore_;
-        VKPtr<VkSemaphore>                  renderFinishedSemaphore_;
+        // Synchronization objects for each frame in flight, indexed by 'frameIndex_'
+        std::vector<VKPtr<VkSemaphore>>     imageAvailableSemaphores_;
+        std::vector<VKPtr<VkSemaphore>>     renderFinishedSemaphores_;
+        std::vector<VKPtr<VkFence>>         inFlightFences_;
+        std::uint32_t                       numFramesInFlight_          = 2;
+        std::uint32_t                       frameIndex_                 = 0;
 
 };
 
@@ -11,13 +11,17 @@
 #include "Ext/VKExtensions.h"
 #include "Memory/VKDeviceMemory.h"
 #include "../CheckedCast.h"
+#include "../ProfileCounters.h"
 #include "../../Core/Helper.h"
+#include "../../Core/Assertion.h"
 #include "../../Core/Vendor.h"
 #include "../GLCommon/GLTypes.h"
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "VKInitializers.h"
 #include <LLGL/Log.h>
+#include <fstream>
+#include <iterator>
 
 
 namespace LLGL
@@ -80,6 +84,7 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
 
     /* Create default resources */
     CreateDefaultPipelineLayout();
+    CreatePipelineCache(rendererConfigVK);
 
     /* Create device memory manager */
     deviceMemoryMngr_ = MakeUnique<VKDeviceMemoryManager>(
@@ -88,11 +93,50 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
         (rendererConfigVK != nullptr ? rendererConfigVK->minDeviceMemoryAllocationSize : 1024*1024),
         (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false)
     );
+
+    /* Create shared descriptor cache for all resource heaps */
+    descriptorCache_ = MakeUnique<VKDescriptorCache>(device_);
+
+    /* Create upload queue for batched buffer and texture writes, and command queue interface */
+    uploadQueue_ = MakeUnique<VKUploadQueue>(
+        device_,
+        *deviceMemoryMngr_,
+        physicalDevice_.GetMemoryProperties(),
+        (rendererConfigVK != nullptr ? rendererConfigVK->stagingRingBufferSize : 4*1024*1024)
+    );
+
+    /* Create device memory defragmenter if it's enabled */
+    if (rendererConfigVK != nullptr && rendererConfigVK->defragmentationBudget > 0)
+    {
+        defragmenter_ = MakeUnique<VKDeviceMemoryDefragmenter>(
+            device_,
+            *deviceMemoryMngr_,
+            *uploadQueue_,
+            static_cast<VkDeviceSize>(rendererConfigVK->defragmentationBudget)
+        );
+    }
+
+    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue(), *uploadQueue_, defragmenter_.get());
+
+    if (rendererConfigVK != nullptr)
+        maxFramesInFlight_ = std::max(1u, rendererConfigVK->maxFramesInFlight);
 }
 
 VKRenderSystem::~VKRenderSystem()
 {
     device_.WaitIdle();
+    StorePipelineCache();
+}
+
+bool VKRenderSystem::QueryMemoryHeapStatistics(std::vector<MemoryHeapStatistics>& heapStatistics)
+{
+    deviceMemoryMngr_->QueryHeapStatistics(heapStatistics);
+    return true;
+}
+
+bool VKRenderSystem::QueryPipelineCache(std::vector<char>& data)
+{
+    return pipelineCache_->GetData(data);
 }
 
 /* ----- Render Context ----- */
@@ -101,7 +145,7 @@ RenderContext* VKRenderSystem::CreateRenderContext(const RenderContextDescriptor
 {
     return TakeOwnership(
         renderContexts_,
-        MakeUnique<VKRenderContext>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, desc, surface)
+        MakeUnique<VKRenderContext>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, desc, surface, maxFramesInFlight_)
     );
 }
 
@@ -123,7 +167,7 @@ CommandBuffer* VKRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor
 {
     return TakeOwnership(
         commandBuffers_,
-        MakeUnique<VKCommandBuffer>(physicalDevice_, device_, device_.GetVkQueue(), device_.GetQueueFamilyIndices(), desc)
+        MakeUnique<VKCommandBuffer>(physicalDevice_, device_, device_.GetVkQueue(), device_.GetQueueFamilyIndices(), *deviceMemoryMngr_, defragmenter_.get(), desc)
     );
 }
 
@@ -135,7 +179,7 @@ CommandBufferExt* VKRenderSystem::CreateCommandBufferExt(const CommandBufferDesc
 
 void VKRenderSystem::Release(CommandBuffer& commandBuffer)
 {
-    RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
+    ReleaseDeferred(commandBuffers_, commandBuffer);
 }
 
 /* ----- Buffers ------ */
@@ -144,16 +188,6 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
 {
     AssertCreateBuffer(desc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        static_cast<VkDeviceSize>(desc.size),
-        GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
-    );
-
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, desc.size);
-
     /* Create primary buffer object */
     auto buffer = TakeOwnership(buffers_, MakeUnique<VKBuffer>(device_, desc));
 
@@ -164,20 +198,26 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
     );
     buffer->BindMemoryRegion(device_, memoryRegion);
 
-    /* Copy staging buffer into hardware buffer */
-    device_.CopyBuffer(stagingBuffer.GetVkBuffer(), buffer->GetVkBuffer(), static_cast<VkDeviceSize>(desc.size));
+    /* Upload initial data into hardware buffer via upload queue */
+    if (initialData != nullptr && desc.size > 0)
+        buffer->SetUploadTicket(uploadQueue_->WriteBuffer(buffer->GetVkBuffer(), 0, initialData, static_cast<VkDeviceSize>(desc.size)));
 
     if ((desc.cpuAccessFlags & CPUAccessFlags::Write) != 0 || (desc.miscFlags & MiscFlags::DynamicUsage) != 0)
     {
-        /* Store ownership of staging buffer */
-        buffer->TakeStagingBuffer(std::move(stagingBuffer));
-    }
-    else
-    {
-        /* Release staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /* Create staging buffer for CPU access, which mirrors the initial data */
+        VkBufferCreateInfo stagingCreateInfo;
+        BuildVkBufferCreateInfo(
+            stagingCreateInfo,
+            static_cast<VkDeviceSize>(desc.size),
+            GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
+        );
+
+        buffer->TakeStagingBuffer(CreateStagingBuffer(stagingCreateInfo, initialData, desc.size));
     }
 
+    if (defragmenter_)
+        defragmenter_->AddBuffer(*buffer);
+
     return buffer;
 }
 
@@ -185,64 +225,80 @@ BufferArray* VKRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
     auto refBindFlags = bufferArray[0]->GetBindFlags();
+
+    /* Buffer arrays store the native buffer handles, so their buffers must never be relocated */
+    if (defragmenter_)
+    {
+        for (std::uint32_t i = 0; i < numBuffers; ++i)
+            defragmenter_->RemoveBuffer(LLGL_CAST(VKBuffer&, *bufferArray[i]));
+    }
+
     return TakeOwnership(bufferArrays_, MakeUnique<VKBufferArray>(refBindFlags, numBuffers, bufferArray));
 }
 
 void VKRenderSystem::Release(Buffer& buffer)
 {
-    /* Release device memory regions for primary buffer and internal staging buffer, then release buffer object */
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
-    bufferVK.GetDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
-    bufferVK.GetStagingDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
-    RemoveFromUniqueSet(buffers_, &buffer);
+    if (defragmenter_)
+        defragmenter_->RemoveBuffer(bufferVK);
+
+    /* Native handle might be reused by a new buffer, so descriptor sets that refer to it must not be shared anymore */
+    descriptorCache_->Evict(VKDescriptorCache::MakeKeyValue(bufferVK.GetVkBuffer()));
+
+    /*
+    Release device memory regions for primary buffer and internal staging buffer together with the buffer object,
+    once all pending uploads and frames in flight have been completed
+    */
+    if (auto bufferObject = ExtractFromUniqueSet(buffers_, &buffer))
+    {
+        auto deviceMemoryMngr = deviceMemoryMngr_.get();
+        uploadQueue_->ReleaseAfterBatch(
+            std::shared_ptr<void>(
+                bufferObject.release(),
+                [deviceMemoryMngr](void* ptr)
+                {
+                    auto bufferPtr = static_cast<VKBuffer*>(ptr);
+                    bufferPtr->GetDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr);
+                    bufferPtr->GetStagingDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr);
+                    delete bufferPtr;
+                }
+            )
+        );
+    }
 }
 
 void VKRenderSystem::Release(BufferArray& bufferArray)
 {
-    RemoveFromUniqueSet(bufferArrays_, &bufferArray);
+    ReleaseDeferred(bufferArrays_, bufferArray);
 }
 
 void VKRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
 {
+    LLGL_PROFILE_COUNT(bufferWrites);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
 
+    /* Keep staging buffer in sync with hardware buffer, since it is copied back entirely after the buffer has been mapped */
     if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
-    {
-        /* Copy data to staging buffer memory */
         device_.WriteBuffer(bufferVK.GetStagingDeviceBuffer(), data, dataSize, dstOffset);
 
-        /* Copy staging buffer into hardware buffer */
-        device_.CopyBuffer(bufferVK.GetStagingVkBuffer(), bufferVK.GetVkBuffer(), dataSize, dstOffset, dstOffset);
-    }
-    else
-    {
-        /* Create staging buffer */
-        VkBufferCreateInfo stagingCreateInfo;
-        BuildVkBufferCreateInfo(
-            stagingCreateInfo,
-            dataSize,
-            (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)
-        );
-
-        auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, data, dataSize);
-
-        /* Copy staging buffer into hardware buffer */
-        device_.CopyBuffer(stagingBuffer.GetVkBuffer(), bufferVK.GetVkBuffer(), dataSize, 0, dstOffset);
-
-        /* Release device memory region of staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
-    }
+    /* Copy data into hardware buffer via upload queue without waiting for its completion */
+    bufferVK.SetUploadTicket(uploadQueue_->WriteBuffer(bufferVK.GetVkBuffer(), dstOffset, data, dataSize));
 }
 
 void* VKRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    LLGL_PROFILE_COUNT(bufferMappings);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
     if (auto stagingBuffer = bufferVK.GetStagingVkBuffer())
     {
-        /* Copy GPU local buffer into staging buffer for read accces */
+        /* Copy GPU local buffer into staging buffer for read accces (after pending uploads), otherwise wait until the previous copy from the staging buffer has been completed */
         if (access != CPUAccess::WriteOnly && access != CPUAccess::WriteDiscard)
-            device_.CopyBuffer(bufferVK.GetVkBuffer(), stagingBuffer, bufferVK.GetSize());
+            uploadQueue_->Wait(uploadQueue_->CopyBuffer(bufferVK.GetVkBuffer(), stagingBuffer, bufferVK.GetSize()));
+        else
+            uploadQueue_->Wait(bufferVK.GetUploadTicket());
 
         /* Map staging buffer */
         return bufferVK.Map(device_, access);
@@ -260,9 +316,9 @@ void VKRenderSystem::UnmapBuffer(Buffer& buffer)
         /* Unmap staging buffer */
         bufferVK.Unmap(device_);
 
-        /* Copy staging buffer into GPU local buffer for write access */
+        /* Copy staging buffer into GPU local buffer for write access via upload queue without waiting for its completion */
         if (bufferVK.GetMappedCPUAccess() != CPUAccess::ReadOnly)
-            device_.CopyBuffer(stagingBuffer, bufferVK.GetVkBuffer(), bufferVK.GetSize());
+            bufferVK.SetUploadTicket(uploadQueue_->CopyBuffer(stagingBuffer, bufferVK.GetVkBuffer(), bufferVK.GetSize()));
     }
 }
 
@@ -294,12 +350,153 @@ static std::uint32_t GetTextureLayertCount(const TextureDescriptor& desc)
         return 1;
 }
 
+static VkExtent3D GetTextureMipVkExtent(const TextureDescriptor& desc, std::uint32_t mipLevel)
+{
+    const auto extent = GetTextureVkExtent(desc);
+    return
+    {
+        std::max(1u, extent.width  >> mipLevel),
+        std::max(1u, extent.height >> mipLevel),
+        std::max(1u, extent.depth  >> mipLevel),
+    };
+}
+
+// Returns the number of array layers of the initial image data of each MIP-map level, including all faces of cube textures.
+static std::uint32_t GetMipChainLayerCount(const TextureDescriptor& desc)
+{
+    if (IsCubeTexture(desc.type))
+        return desc.arrayLayers;
+    else
+        return GetTextureLayertCount(desc);
+}
+
+// Returns the number of texels of the first 'numMipLevels' MIP-map levels of the specified texture (see MiscFlags::InitialMipChain).
+static std::uint32_t GetMipChainTextureSize(const TextureDescriptor& desc, std::uint32_t numMipLevels)
+{
+    std::uint32_t size = 0;
+
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        const auto extent = GetTextureMipVkExtent(desc, mipLevel);
+        size += extent.width * extent.height * extent.depth;
+    }
+
+    return size * GetMipChainLayerCount(desc);
+}
+
+// Returns the alignment for buffer offsets of image copy commands, i.e. a multiple of the texel (or block) size and of 4.
+static VkDeviceSize GetTextureStagingAlignment(const Format format)
+{
+    if (IsCompressedFormat(format))
+        return 16;
+    const auto texelSize = static_cast<VkDeviceSize>(TextureBufferSize(format, 1));
+    return (texelSize % 4 == 0 ? texelSize : texelSize % 2 == 0 ? texelSize * 2 : texelSize * 4);
+}
+
+/*
+Returns the offsets of each MIP-map level of an initial MIP-map chain within the staging buffer, followed by the size of the staging buffer.
+Each offset is a multiple of the texel size and 4 bytes, as required by vkCmdCopyBufferToImage.
+*/
+static std::vector<VkDeviceSize> GetMipChainStagingOffsets(const TextureDescriptor& desc, std::uint32_t numMipLevels)
+{
+    const auto alignment = GetTextureStagingAlignment(desc.format);
+
+    std::vector<VkDeviceSize> offsets(numMipLevels + 1, 0);
+
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        const auto levelSize = static_cast<VkDeviceSize>(TextureBufferSize(desc.format, GetMipChainTextureSize(desc, mipLevel + 1) - GetMipChainTextureSize(desc, mipLevel)));
+        offsets[mipLevel + 1] = (offsets[mipLevel] + levelSize + alignment - 1) / alignment * alignment;
+    }
+
+    return offsets;
+}
+
+// Returns the image aspect of the specified format that is addressed by buffer-image copies.
+static VkImageAspectFlags GetCopyImageAspectByFormat(VkFormat format)
+{
+    /* Buffer-image copies can only address a single aspect, so only the depth aspect of combined depth-stencil formats is copied */
+    const auto aspectMask = VKGetImageAspectByFormat(format);
+    return ((aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT) != 0 ? VK_IMAGE_ASPECT_DEPTH_BIT : aspectMask);
+}
+
+// Returns the buffer-image copy region for the specified texture region, where the array layers are determined by the texture type (see TextureRegion).
+static VkBufferImageCopy GetTextureRegionVkCopy(const VKTexture& texture, const TextureRegion& textureRegion, VkDeviceSize bufferOffset)
+{
+    const auto& offset = textureRegion.offset;
+    const auto& extent = textureRegion.extent;
+
+    VkBufferImageCopy region;
+
+    region.bufferOffset                     = bufferOffset;
+    region.bufferRowLength                  = 0;
+    region.bufferImageHeight                = 0;
+    region.imageSubresource.aspectMask      = GetCopyImageAspectByFormat(texture.GetVkFormat());
+    region.imageSubresource.mipLevel        = textureRegion.mipLevel;
+
+    switch (texture.GetType())
+    {
+        case TextureType::Texture1D:
+            region.imageSubresource.baseArrayLayer  = 0;
+            region.imageSubresource.layerCount      = 1;
+            region.imageOffset                      = { offset.x, 0, 0 };
+            region.imageExtent                      = { extent.width, 1u, 1u };
+            break;
+
+        case TextureType::Texture1DArray:
+            region.imageSubresource.baseArrayLayer  = static_cast<std::uint32_t>(offset.y);
+            region.imageSubresource.layerCount      = extent.height;
+            region.imageOffset                      = { offset.x, 0, 0 };
+            region.imageExtent                      = { extent.width, 1u, 1u };
+            break;
+
+        case TextureType::Texture2D:
+            region.imageSubresource.baseArrayLayer  = 0;
+            region.imageSubresource.layerCount      = 1;
+            region.imageOffset                      = { offset.x, offset.y, 0 };
+            region.imageExtent                      = { extent.width, extent.height, 1u };
+            break;
+
+        case TextureType::Texture2DArray:   /*pass*/
+        case TextureType::TextureCube:      /*pass*/
+        case TextureType::TextureCubeArray:
+            region.imageSubresource.baseArrayLayer  = static_cast<std::uint32_t>(offset.z);
+            region.imageSubresource.layerCount      = extent.depth;
+            region.imageOffset                      = { offset.x, offset.y, 0 };
+            region.imageExtent                      = { extent.width, extent.height, 1u };
+            break;
+
+        case TextureType::Texture3D:
+            region.imageSubresource.baseArrayLayer  = 0;
+            region.imageSubresource.layerCount      = 1;
+            region.imageOffset                      = { offset.x, offset.y, offset.z };
+            region.imageExtent                      = { extent.width, extent.height, extent.depth };
+            break;
+
+        case TextureType::Texture2DMS:      /*pass*/
+        case TextureType::Texture2DMSArray:
+            throw std::invalid_argument("cannot copy region of multi-sampled texture");
+    }
+
+    return region;
+}
+
 Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
     const auto& cfg = GetConfiguration();
 
+    /* Determine number of MIP-map levels of the initial image data */
+    std::uint32_t numInitialMipLevels = 1;
+
+    if (imageDesc != nullptr && (textureDesc.miscFlags & MiscFlags::InitialMipChain) != 0 && IsMipMappedTexture(textureDesc))
+    {
+        if (IsCompressedFormat(textureDesc.format))
+            throw std::invalid_argument("cannot initialize MIP-map chain of texture with compressed format");
+        numInitialMipLevels = NumMipLevels(textureDesc);
+    }
+
     /* Determine size of image for staging buffer */
-    const auto imageSize        = TextureSize(textureDesc);
+    const auto imageSize        = (numInitialMipLevels > 1 ? GetMipChainTextureSize(textureDesc, numInitialMipLevels) : TextureSize(textureDesc));
     const auto initialDataSize  = static_cast<VkDeviceSize>(TextureBufferSize(textureDesc.format, imageSize));
 
     /* Set up initial image data */
@@ -355,15 +552,36 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
         initialData = tempImageBuffer.get();
     }
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        initialDataSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT  // <-- TODO: support read/write mapping //GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
-    );
+    /* Determine offsets of each MIP-map level of the initial MIP-map chain within the staging buffer */
+    auto stagingSize = initialDataSize;
 
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, initialDataSize);
+    std::vector<VkDeviceSize> mipChainOffsets;
+
+    if (numInitialMipLevels > 1)
+    {
+        mipChainOffsets = GetMipChainStagingOffsets(textureDesc, numInitialMipLevels);
+        stagingSize     = mipChainOffsets.back();
+
+        if (stagingSize != initialDataSize)
+        {
+            /* Rearrange MIP-map levels with aligned offsets */
+            auto alignedImageBuffer = GenerateEmptyByteBuffer(static_cast<std::size_t>(stagingSize));
+            auto srcLevel           = reinterpret_cast<const char*>(initialData);
+
+            for (std::uint32_t mipLevel = 0; mipLevel < numInitialMipLevels; ++mipLevel)
+            {
+                const auto levelSize = TextureBufferSize(
+                    textureDesc.format,
+                    GetMipChainTextureSize(textureDesc, mipLevel + 1) - GetMipChainTextureSize(textureDesc, mipLevel)
+                );
+                ::memcpy(alignedImageBuffer.get() + mipChainOffsets[mipLevel], srcLevel, levelSize);
+                srcLevel += levelSize;
+            }
+
+            tempImageBuffer = std::move(alignedImageBuffer);
+            initialData     = tempImageBuffer.get();
+        }
+    }
 
     /* Create device texture */
     auto textureVK      = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
@@ -372,43 +590,69 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     auto mipLevels      = textureVK->GetNumMipLevels();
     auto arrayLayers    = textureVK->GetNumArrayLayers();
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto formatVK = VKTypes::Map(textureDesc.format);
+    /* Copy initial data into staging memory of the upload queue (before its command buffer is selected) */
+    VKStagingRegion stagingRegion;
 
-    auto cmdBuffer = device_.AllocCommandBuffer();
-    {
-        device_.TransitionImageLayout(
-            cmdBuffer,
-            image,
-            formatVK,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            mipLevels,
-            arrayLayers
-        );
+    if (initialData != nullptr)
+        stagingRegion = uploadQueue_->StageData(initialData, stagingSize, GetTextureStagingAlignment(textureDesc.format));
 
-        device_.CopyBufferToImage(
-            cmdBuffer,
-            stagingBuffer.GetVkBuffer(),
-            image,
-            GetTextureVkExtent(textureDesc),
-            GetTextureLayertCount(textureDesc)
-        );
+    /* Record copy from staging memory into hardware texture, then transfer image into sampling-ready state */
+    auto formatVK   = VKTypes::Map(textureDesc.format);
+    auto cmdBuffer  = uploadQueue_->GetCommandBuffer();
 
-        device_.TransitionImageLayout(
-            cmdBuffer,
-            image,
-            formatVK,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-            mipLevels,
-            arrayLayers
-        );
+    device_.TransitionImageLayout(
+        cmdBuffer,
+        image,
+        formatVK,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        mipLevels,
+        arrayLayers
+    );
+
+    if (initialData != nullptr)
+    {
+        if (numInitialMipLevels > 1)
+        {
+            /* Copy each MIP-map level of the initial MIP-map chain */
+            for (std::uint32_t mipLevel = 0; mipLevel < numInitialMipLevels; ++mipLevel)
+            {
+                device_.CopyBufferToImage(
+                    cmdBuffer,
+                    stagingRegion.buffer,
+                    image,
+                    GetTextureMipVkExtent(textureDesc, mipLevel),
+                    GetMipChainLayerCount(textureDesc),
+                    mipLevel,
+                    stagingRegion.offset + mipChainOffsets[mipLevel]
+                );
+            }
+        }
+        else
+        {
+            device_.CopyBufferToImage(
+                cmdBuffer,
+                stagingRegion.buffer,
+                image,
+                GetTextureVkExtent(textureDesc),
+                GetTextureLayertCount(textureDesc),
+                0,
+                stagingRegion.offset
+            );
+        }
     }
-    device_.FlushCommandBuffer(cmdBuffer);
 
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    device_.TransitionImageLayout(
+        cmdBuffer,
+        image,
+        formatVK,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        mipLevels,
+        arrayLayers
+    );
+
+    textureVK->SetUploadTicket(uploadQueue_->GetCurrentTicket());
 
     /* Create image view for texture */
     textureVK->CreateInternalImageView(device_);
@@ -418,42 +662,136 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
 
 void VKRenderSystem::Release(Texture& texture)
 {
-    /* Release device memory region, then release texture object */
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
-    deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
-    RemoveFromUniqueSet(textures_, &texture);
+    descriptorCache_->Evict(VKDescriptorCache::MakeKeyValue(textureVK.GetVkImageView()));
+
+    /* Release device memory region together with the texture object, once all pending uploads and frames in flight have been completed */
+    if (auto textureObject = ExtractFromUniqueSet(textures_, &texture))
+    {
+        auto deviceMemoryMngr = deviceMemoryMngr_.get();
+        uploadQueue_->ReleaseAfterBatch(
+            std::shared_ptr<void>(
+                textureObject.release(),
+                [deviceMemoryMngr](void* ptr)
+                {
+                    auto texturePtr = static_cast<VKTexture*>(ptr);
+                    auto memoryRegion = texturePtr->GetMemoryRegion();
+                    delete texturePtr;
+                    deviceMemoryMngr->Release(memoryRegion);
+                }
+            )
+        );
+    }
 }
 
 void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
-    //todo
+    LLGL_PROFILE_COUNT(textureWrites);
+
+    LLGL_ASSERT_PTR(imageDesc.data);
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    /* Determine size of image data for staging memory */
+    const auto format       = VKTypes::Unmap(textureVK.GetVkFormat());
+    const auto numTexels    = (textureRegion.extent.width * textureRegion.extent.height * textureRegion.extent.depth);
+    const auto imageSize    = static_cast<VkDeviceSize>(TextureBufferSize(format, numTexels));
+
+    /* Check if image data must be converted */
+    const void* imageData = imageDesc.data;
+    ByteBuffer tempImageBuffer;
+
+    ImageFormat texFormat   = ImageFormat::RGBA;
+    DataType    texDataType = DataType::UInt8;
+
+    if (FindSuitableImageFormat(format, texFormat, texDataType) && (texFormat != imageDesc.format || texDataType != imageDesc.dataType))
+    {
+        /* Validate source image data size, then convert image data into texture format */
+        const auto srcImageDataSize = numTexels * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType);
+        AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(srcImageDataSize));
+        tempImageBuffer = ConvertImageBuffer(imageDesc, texFormat, texDataType, GetConfiguration().threadCount);
+        imageData       = tempImageBuffer.get();
+    }
+    else
+        AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(imageSize));
+
+    /* Copy image data into staging memory of the upload queue (before its command buffer is selected) */
+    auto stagingRegion  = uploadQueue_->StageData(imageData, imageSize, GetTextureStagingAlignment(format));
+    auto cmdBuffer      = uploadQueue_->GetCommandBuffer();
+
+    /* Record copy into the texture region only, so other MIP-map levels and array layers are not affected */
+    const auto copyRegion = GetTextureRegionVkCopy(textureVK, textureRegion, stagingRegion.offset);
+    const auto& subresource = copyRegion.imageSubresource;
+
+    device_.TransitionImageLayout(
+        cmdBuffer,
+        textureVK.GetVkImage(),
+        textureVK.GetVkFormat(),
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        1,
+        subresource.layerCount,
+        subresource.mipLevel,
+        subresource.baseArrayLayer
+    );
+
+    device_.CopyBufferToImage(cmdBuffer, stagingRegion.buffer, textureVK.GetVkImage(), copyRegion);
+
+    device_.TransitionImageLayout(
+        cmdBuffer,
+        textureVK.GetVkImage(),
+        textureVK.GetVkFormat(),
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        1,
+        subresource.layerCount,
+        subresource.mipLevel,
+        subresource.baseArrayLayer
+    );
+
+    textureVK.SetUploadTicket(uploadQueue_->GetCurrentTicket());
 }
 
 void VKRenderSystem::ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc)
 {
-    //todo
+    auto& textureVK = LLGL_CAST(const VKTexture&, texture);
+
+    /* Read entire MIP-map level and only wait for the respective upload queue batch */
+    TextureRegion textureRegion;
+    {
+        textureRegion.mipLevel  = mipLevel;
+        textureRegion.extent    = texture.QueryMipExtent(mipLevel);
+    }
+    uploadQueue_->Wait(ReadTextureRegion(textureVK, textureRegion, imageDesc, nullptr));
+}
+
+void VKRenderSystem::ReadTextureAsync(const Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc, const ReadTextureCallback& callback)
+{
+    auto& textureVK = LLGL_CAST(const VKTexture&, texture);
+    ReadTextureRegion(textureVK, textureRegion, imageDesc, callback);
 }
 
 void VKRenderSystem::GenerateMips(Texture& texture)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
+    /* Record MIP-map generation into the current upload batch, which is submitted with the next command buffer */
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
-    auto cmdBuffer = device_.AllocCommandBuffer();
-    {
-        device_.GenerateMips(
-            cmdBuffer,
-            textureVK.GetVkImage(),
-            textureVK.GetVkExtent(),
-            0,
-            textureVK.GetNumMipLevels(),
-            0,
-            textureVK.GetNumArrayLayers()
-        );
-    }
-    device_.FlushCommandBuffer(cmdBuffer);
+    device_.GenerateMips(
+        uploadQueue_->GetSyncedCommandBuffer(),
+        textureVK.GetVkImage(),
+        textureVK.GetVkExtent(),
+        0,
+        textureVK.GetNumMipLevels(),
+        0,
+        textureVK.GetNumArrayLayers()
+    );
+    textureVK.SetUploadTicket(uploadQueue_->GetCurrentTicket());
 }
 
 void VKRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
+    LLGL_PROFILE_COUNT(mipMapsGenerations);
+
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
 
     const auto maxNumMipLevels      = textureVK.GetNumMipLevels();
@@ -461,19 +799,16 @@ void VKRenderSystem::GenerateMips(Texture& texture, std::uint32_t baseMipLevel,
 
     if (baseMipLevel < maxNumMipLevels && baseArrayLayer < maxNumArrayLayers && numMipLevels > 0 && numArrayLayers > 0)
     {
-        auto cmdBuffer = device_.AllocCommandBuffer();
-        {
-            device_.GenerateMips(
-                cmdBuffer,
-                textureVK.GetVkImage(),
-                textureVK.GetVkExtent(),
-                baseMipLevel,
-                std::min(numMipLevels, maxNumMipLevels - baseMipLevel),
-                baseArrayLayer,
-                std::min(numArrayLayers, maxNumArrayLayers - baseArrayLayer)
-            );
-        }
-        device_.FlushCommandBuffer(cmdBuffer);
+        device_.GenerateMips(
+            uploadQueue_->GetSyncedCommandBuffer(),
+            textureVK.GetVkImage(),
+            textureVK.GetVkExtent(),
+            baseMipLevel,
+            std::min(numMipLevels, maxNumMipLevels - baseMipLevel),
+            baseArrayLayer,
+            std::min(numArrayLayers, maxNumArrayLayers - baseArrayLayer)
+        );
+        textureVK.SetUploadTicket(uploadQueue_->GetCurrentTicket());
     }
 }
 
@@ -486,19 +821,21 @@ Sampler* VKRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 
 void VKRenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    auto& samplerVK = LLGL_CAST(VKSampler&, sampler);
+    descriptorCache_->Evict(VKDescriptorCache::MakeKeyValue(samplerVK.GetVkSampler()));
+    ReleaseDeferred(samplers_, sampler);
 }
 
 /* ----- Resource Heaps ----- */
 
 ResourceHeap* VKRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
 {
-    return TakeOwnership(resourceHeaps_, MakeUnique<VKResourceHeap>(device_, desc));
+    return TakeOwnership(resourceHeaps_, MakeUnique<VKResourceHeap>(device_, *descriptorCache_, desc));
 }
 
 void VKRenderSystem::Release(ResourceHeap& resourceHeap)
 {
-    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+    ReleaseDeferred(resourceHeaps_, resourceHeap);
 }
 
 /* ----- Render Passes ----- */
@@ -511,7 +848,7 @@ RenderPass* VKRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
 
 void VKRenderSystem::Release(RenderPass& renderPass)
 {
-    RemoveFromUniqueSet(renderPasses_, &renderPass);
+    ReleaseDeferred(renderPasses_, renderPass);
 }
 
 /* ----- Render Targets ----- */
@@ -524,10 +861,22 @@ RenderTarget* VKRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& d
 
 void VKRenderSystem::Release(RenderTarget& renderTarget)
 {
-    /* Release device memory region, then release texture object */
-    auto& renderTargetVL = LLGL_CAST(VKRenderTarget&, renderTarget);
-    renderTargetVL.ReleaseDeviceMemoryResources(*deviceMemoryMngr_);
-    RemoveFromUniqueSet(renderTargets_, &renderTarget);
+    /* Release device memory region together with the render target object, once all frames in flight have been completed */
+    if (auto renderTargetObject = ExtractFromUniqueSet(renderTargets_, &renderTarget))
+    {
+        auto deviceMemoryMngr = deviceMemoryMngr_.get();
+        uploadQueue_->ReleaseAfterBatch(
+            std::shared_ptr<void>(
+                renderTargetObject.release(),
+                [deviceMemoryMngr](void* ptr)
+                {
+                    auto renderTargetPtr = static_cast<VKRenderTarget*>(ptr);
+                    renderTargetPtr->ReleaseDeviceMemoryResources(*deviceMemoryMngr);
+                    delete renderTargetPtr;
+                }
+            )
+        );
+    }
 }
 
 /* ----- Shader ----- */
@@ -563,7 +912,9 @@ PipelineLayout* VKRenderSystem::CreatePipelineLayout(const PipelineLayoutDescrip
 
 void VKRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
-    RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
+    auto& pipelineLayoutVK = LLGL_CAST(VKPipelineLayout&, pipelineLayout);
+    descriptorCache_->Evict(VKDescriptorCache::MakeKeyValue(pipelineLayoutVK.GetVkDescriptorSetLayout()));
+    ReleaseDeferred(pipelineLayouts_, pipelineLayout);
 }
 
 /* ----- Pipeline States ----- */
@@ -577,36 +928,37 @@ GraphicsPipeline* VKRenderSystem::CreateGraphicsPipeline(const GraphicsPipelineD
             defaultPipelineLayout_,
             (!renderContexts_.empty() ? (*renderContexts_.begin())->GetRenderPass() : nullptr),
             desc,
-            gfxPipelineLimits_
+            gfxPipelineLimits_,
+            pipelineCache_->GetVkPipelineCache()
         )
     );
 }
 
 ComputePipeline* VKRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
 {
-    return TakeOwnership(computePipelines_, MakeUnique<VKComputePipeline>(device_, desc, defaultPipelineLayout_));
+    return TakeOwnership(computePipelines_, MakeUnique<VKComputePipeline>(device_, desc, defaultPipelineLayout_, pipelineCache_->GetVkPipelineCache()));
 }
 
 void VKRenderSystem::Release(GraphicsPipeline& graphicsPipeline)
 {
-    RemoveFromUniqueSet(graphicsPipelines_, &graphicsPipeline);
+    ReleaseDeferred(graphicsPipelines_, graphicsPipeline);
 }
 
 void VKRenderSystem::Release(ComputePipeline& computePipeline)
 {
-    RemoveFromUniqueSet(computePipelines_, &computePipeline);
+    ReleaseDeferred(computePipelines_, computePipeline);
 }
 
 /* ----- Queries ----- */
 
 QueryHeap* VKRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
 {
-    return TakeOwnership(queryHeaps_, MakeUnique<VKQueryHeap>(device_, desc));
+    return TakeOwnership(queryHeaps_, MakeUnique<VKQueryHeap>(device_, *deviceMemoryMngr_, desc, physicalDevice_.GetProperties().limits.timestampPeriod));
 }
 
 void VKRenderSystem::Release(QueryHeap& queryHeap)
 {
-    RemoveFromUniqueSet(queryHeaps_, &queryHeap);
+    ReleaseDeferred(queryHeaps_, queryHeap);
 }
 
 /* ----- Fences ----- */
@@ -618,7 +970,7 @@ Fence* VKRenderSystem::CreateFence()
 
 void VKRenderSystem::Release(Fence& fence)
 {
-    RemoveFromUniqueSet(fences_, &fence);
+    ReleaseDeferred(fences_, fence);
 }
 
 
@@ -778,9 +1130,6 @@ void VKRenderSystem::CreateLogicalDevice()
 {
     /* Create logical device with all supported physical device feature */
     device_ = physicalDevice_.CreateLogicalDevice();
-
-    /* Create command queue interface */
-    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue());
 }
 
 void VKRenderSystem::CreateDefaultPipelineLayout()
@@ -793,6 +1142,57 @@ void VKRenderSystem::CreateDefaultPipelineLayout()
     VKThrowIfFailed(result, "failed to create Vulkan default pipeline layout");
 }
 
+void VKRenderSystem::CreatePipelineCache(const VulkanRendererConfiguration* rendererConfigVK)
+{
+    const void* initialData = nullptr;
+    std::size_t initialDataSize = 0;
+    std::vector<char> fileBuffer;
+
+    if (rendererConfigVK != nullptr)
+    {
+        pipelineCacheFilename_ = rendererConfigVK->pipelineCacheFilename;
+
+        if (rendererConfigVK->pipelineCacheData != nullptr)
+        {
+            /* Use initial data from renderer configuration */
+            initialData     = rendererConfigVK->pipelineCacheData;
+            initialDataSize = rendererConfigVK->pipelineCacheDataSize;
+        }
+        else if (!pipelineCacheFilename_.empty())
+        {
+            /* Read initial data from file, if it exists */
+            std::ifstream file { pipelineCacheFilename_, std::ios_base::binary };
+            if (file.good())
+            {
+                fileBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+                initialData     = fileBuffer.data();
+                initialDataSize = fileBuffer.size();
+            }
+        }
+    }
+
+    /* Create pipeline cache; incompatible initial data is discarded */
+    pipelineCache_ = MakeUnique<VKPipelineCache>(device_, physicalDevice_.GetProperties(), initialData, initialDataSize);
+
+    if (initialData != nullptr && !pipelineCache_->HasInitialData())
+        Log::PostReport(Log::ReportType::Information, "discarded Vulkan pipeline cache data that was generated for another device or driver");
+}
+
+void VKRenderSystem::StorePipelineCache()
+{
+    if (pipelineCacheFilename_.empty())
+        return;
+
+    /* Write pipeline cache data to file */
+    std::vector<char> data;
+    if (pipelineCache_->GetData(data) && !data.empty())
+    {
+        std::ofstream file { pipelineCacheFilename_, std::ios_base::binary };
+        if (file.good())
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+}
+
 bool VKRenderSystem::IsLayerRequired(const std::string& name) const
 {
     //TODO: make this statically optional
@@ -844,6 +1244,95 @@ VKDeviceBuffer VKRenderSystem::CreateStagingBuffer(
     return stagingBuffer;
 }
 
+template <typename T, typename TBase>
+void VKRenderSystem::ReleaseDeferred(HWObjectContainer<T>& cont, const TBase& object)
+{
+    /* Keep object alive until the current upload batch has been completed, which is submitted after all previous command buffers */
+    if (auto objectToRelease = ExtractFromUniqueSet(cont, &object))
+        uploadQueue_->ReleaseAfterBatch(std::shared_ptr<void>(std::move(objectToRelease)));
+}
+
+std::uint64_t VKRenderSystem::ReadTextureRegion(
+    const VKTexture&            textureVK,
+    const TextureRegion&        textureRegion,
+    const DstImageDescriptor&   imageDesc,
+    const ReadTextureCallback&  callback)
+{
+    LLGL_ASSERT_PTR(imageDesc.data);
+
+    /* Determine size of texture data for readback buffer */
+    const auto format       = VKTypes::Unmap(textureVK.GetVkFormat());
+    const auto numTexels    = (textureRegion.extent.width * textureRegion.extent.height * textureRegion.extent.depth);
+    const auto imageSize    = static_cast<VkDeviceSize>(TextureBufferSize(format, numTexels));
+
+    /* Check if texture data must be converted into destination image */
+    ImageFormat texFormat   = ImageFormat::RGBA;
+    DataType    texDataType = DataType::UInt8;
+
+    const bool convertImage = (FindSuitableImageFormat(format, texFormat, texDataType) && (texFormat != imageDesc.format || texDataType != imageDesc.dataType));
+
+    const auto dstImageSize = (convertImage ? numTexels * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType) : imageSize);
+    AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(dstImageSize));
+
+    /* Schedule readback into pooled host memory, which is written to the destination image once the transfer has been completed */
+    const auto threadCount = GetConfiguration().threadCount;
+
+    auto readbackBuffer = uploadQueue_->ScheduleReadback(
+        imageSize,
+        [=](const void* data, VkDeviceSize dataSize)
+        {
+            if (convertImage)
+            {
+                ConvertImageBuffer(
+                    SrcImageDescriptor { texFormat, texDataType, data, static_cast<std::size_t>(dataSize) },
+                    DstImageDescriptor { imageDesc.format, imageDesc.dataType, imageDesc.data, static_cast<std::size_t>(dstImageSize) },
+                    threadCount
+                );
+            }
+            else
+                ::memcpy(imageDesc.data, data, static_cast<std::size_t>(dataSize));
+
+            if (callback)
+                callback(imageDesc);
+        }
+    );
+
+    /* Record copy from the texture region into the readback buffer */
+    auto cmdBuffer = uploadQueue_->GetCommandBuffer();
+
+    const auto copyRegion = GetTextureRegionVkCopy(textureVK, textureRegion, 0);
+    const auto& subresource = copyRegion.imageSubresource;
+
+    device_.TransitionImageLayout(
+        cmdBuffer,
+        textureVK.GetVkImage(),
+        textureVK.GetVkFormat(),
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        1,
+        subresource.layerCount,
+        subresource.mipLevel,
+        subresource.baseArrayLayer
+    );
+
+    device_.CopyImageToBuffer(cmdBuffer, textureVK.GetVkImage(), readbackBuffer, copyRegion);
+
+    device_.TransitionImageLayout(
+        cmdBuffer,
+        textureVK.GetVkImage(),
+        textureVK.GetVkFormat(),
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        1,
+        subresource.layerCount,
+        subresource.mipLevel,
+        subresource.baseArrayLayer
+    );
+
+    /* Submit batch immediately, so the readback does not depend on the next command buffer submission */
+    return uploadQueue_->Flush();
+}
+
 
 } // /namespace LLGL
 
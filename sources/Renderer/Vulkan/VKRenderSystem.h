@@ -16,6 +16,8 @@
 #include "Memory/VKDeviceMemoryManager.h"
 
 #include "VKCommandQueue.h"
+#include "VKUploadQueue.h"
+#include "Memory/VKDeviceMemoryDefragmenter.h"
 #include "VKCommandBuffer.h"
 #include "VKRenderContext.h"
 
@@ -36,6 +38,8 @@
 #include "RenderState/VKGraphicsPipeline.h"
 #include "RenderState/VKComputePipeline.h"
 #include "RenderState/VKResourceHeap.h"
+#include "RenderState/VKDescriptorCache.h"
+#include "RenderState/VKPipelineCache.h"
 
 #include <string>
 #include <memory>
@@ -58,6 +62,10 @@ class VKRenderSystem final : public RenderSystem
         VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~VKRenderSystem();
 
+        bool QueryMemoryHeapStatistics(std::vector<MemoryHeapStatistics>& heapStatistics) override;
+
+        bool QueryPipelineCache(std::vector<char>& data) override;
+
         /* ----- Render Context ----- */
 
         RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
@@ -96,6 +104,7 @@ class VKRenderSystem final : public RenderSystem
 
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(const Texture& texture, std::uint32_t mipLevel, const DstImageDescriptor& imageDesc) override;
+        void ReadTextureAsync(const Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc, const ReadTextureCallback& callback) override;
 
         void GenerateMips(Texture& texture) override;
         void GenerateMips(Texture& texture, std::uint32_t baseMipLevel, std::uint32_t numMipLevels, std::uint32_t baseArrayLayer = 0, std::uint32_t numArrayLayers = 1) override;
@@ -166,6 +175,8 @@ class VKRenderSystem final : public RenderSystem
         void PickPhysicalDevice();
         void CreateLogicalDevice();
         void CreateDefaultPipelineLayout();
+        void CreatePipelineCache(const VulkanRendererConfiguration* rendererConfigVK);
+        void StorePipelineCache();
 
         bool IsLayerRequired(const std::string& name) const;
         bool IsExtensionRequired(const std::string& name) const;
@@ -178,21 +189,41 @@ class VKRenderSystem final : public RenderSystem
             VkDeviceSize                initialDataSize
         );
 
+        // Removes the specified object from its container and destroys it once all previously submitted commands have been completed.
+        template <typename T, typename TBase>
+        void ReleaseDeferred(HWObjectContainer<T>& cont, const TBase& object);
+
+        // Schedules a readback of the specified texture region into the destination image, and returns the ticket of the respective upload queue batch.
+        std::uint64_t ReadTextureRegion(
+            const VKTexture&            textureVK,
+            const TextureRegion&        textureRegion,
+            const DstImageDescriptor&   imageDesc,
+            const ReadTextureCallback&  callback
+        );
+
         /* ----- Common objects ----- */
 
-        VKPtr<VkInstance>                       instance_;
+        VKPtr<VkInstance>                               instance_;
+
+        VKPhysicalDevice                                physicalDevice_;
+        VKDevice                                        device_;
+
+        VKPtr<VkDebugReportCallbackEXT>                 debugReportCallback_;
+        VKPtr<VkPipelineLayout>                         defaultPipelineLayout_;
 
-        VKPhysicalDevice                        physicalDevice_;
-        VKDevice                                device_;
+        bool                                            debugLayerEnabled_      = false;
 
-        VKPtr<VkDebugReportCallbackEXT>         debugReportCallback_;
-        VKPtr<VkPipelineLayout>                 defaultPipelineLayout_;
+        std::unique_ptr<VKDeviceMemoryManager>          deviceMemoryMngr_;
+        std::unique_ptr<VKDescriptorCache>              descriptorCache_;
+        std::unique_ptr<VKUploadQueue>                  uploadQueue_;
+        std::unique_ptr<VKDeviceMemoryDefragmenter>     defragmenter_;
 
-        bool                                    debugLayerEnabled_      = false;
+        std::unique_ptr<VKPipelineCache>                pipelineCache_;
+        std::string                                     pipelineCacheFilename_;
 
-        std::unique_ptr<VKDeviceMemoryManager>  deviceMemoryMngr_;
+        std::uint32_t                                   maxFramesInFlight_      = 2;
 
-        VKGraphicsPipelineLimits                gfxPipelineLimits_;
+        VKGraphicsPipelineLimits                        gfxPipelineLimits_;
 
         /* ----- Hardware object containers ----- */
 
@@ -0,0 +1,454 @@
+/*
+ * VKUploadQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKUploadQueue.h"
+#include "VKCore.h"
+#include "VKInitializers.h"
+#include "Memory/VKDeviceMemoryManager.h"
+#include "../../Core/Helper.h"
+#include <limits>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Minimal size of readback buffers, so small readbacks share the same pooled buffers.
+static const VkDeviceSize g_minReadbackBufferSize       = 64 * 1024;
+
+// Maximal number of unused readback buffers that are kept in the pool.
+static const std::size_t  g_maxNumPooledReadbackBuffers = 4;
+
+VKUploadQueue::VKUploadQueue(
+    VKDevice&                               device,
+    VKDeviceMemoryManager&                  deviceMemoryMngr,
+    const VkPhysicalDeviceMemoryProperties& memoryProperties,
+    VkDeviceSize                            ringBufferSize) :
+        device_           { device                                         },
+        deviceMemoryMngr_ { deviceMemoryMngr                               },
+        commandPool_      { device.GetVkDevice(), vkDestroyCommandPool     },
+        ringBuffer_       { device.GetVkDevice(), memoryProperties, ringBufferSize }
+{
+    commandPool_ = device.CreateCommandPool();
+}
+
+VKUploadQueue::~VKUploadQueue()
+{
+    /* Wait for all batches in flight; commands of the current batch are discarded */
+    while (!batchesInFlight_.empty())
+        RetireOldestBatch();
+
+    for (auto& stagingBuffer : currentBatch_.stagingBuffers)
+        stagingBuffer.ReleaseMemoryRegion(deviceMemoryMngr_);
+
+    for (auto& readback : currentBatch_.readbacks)
+        readback.buffer.bufferObj.ReleaseMemoryRegion(deviceMemoryMngr_);
+
+    currentBatch_.releasedObjects.clear();
+
+    for (auto& readbackBuffer : readbackBufferPool_)
+        readbackBuffer.bufferObj.ReleaseMemoryRegion(deviceMemoryMngr_);
+}
+
+std::uint64_t VKUploadQueue::WriteBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize)
+{
+    /* Copy data into staging memory before the command buffer is selected, since staging might submit the current batch */
+    auto region     = StageData(data, dataSize);
+    auto cmdBuffer  = GetCommandBuffer();
+
+    SyncDstBuffer(dstBuffer);
+    device_.CopyBuffer(cmdBuffer, region.buffer, dstBuffer, dataSize, region.offset, dstOffset);
+
+    return currentBatch_.ticket;
+}
+
+std::uint64_t VKUploadQueue::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
+{
+    auto cmdBuffer = GetCommandBuffer();
+
+    /* Source buffer must not be read before previous writes to it in the current batch have been completed */
+    if (dstBuffers_.find(srcBuffer) != dstBuffers_.end())
+        RecordTransferBarrier(VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+
+    SyncDstBuffer(dstBuffer);
+    device_.CopyBuffer(cmdBuffer, srcBuffer, dstBuffer, size, 0, 0);
+
+    return currentBatch_.ticket;
+}
+
+void VKUploadQueue::ReleaseAfterBatch(VKDeviceBuffer&& buffer)
+{
+    /* Begin new batch if necessary, so the buffer is not released before any commands that are recorded afterwards */
+    GetCommandBuffer();
+    currentBatch_.stagingBuffers.push_back(std::move(buffer));
+}
+
+void VKUploadQueue::ReleaseAfterBatch(std::shared_ptr<void>&& object)
+{
+    /* Begin new batch if necessary, so the object is not destroyed before any commands that have been submitted so far */
+    GetCommandBuffer();
+    currentBatch_.releasedObjects.push_back(std::move(object));
+}
+
+VKStagingRegion VKUploadQueue::StageData(const void* data, VkDeviceSize dataSize, VkDeviceSize alignment)
+{
+    VKStagingRegion region;
+
+    /* Use ring buffer only for data up to half its size, otherwise it would be drained for a single upload */
+    if (dataSize <= ringBuffer_.GetSize() / 2)
+    {
+        RetireCompletedBatches();
+
+        if (!ringBuffer_.Allocate(dataSize, alignment, region))
+        {
+            /* Submit current batch and reclaim staging memory from the oldest batches until the region fits */
+            Flush();
+            while (!batchesInFlight_.empty())
+            {
+                RetireOldestBatch();
+                if (ringBuffer_.Allocate(dataSize, alignment, region))
+                    break;
+            }
+        }
+
+        if (region.data != nullptr)
+        {
+            ::memcpy(region.data, data, static_cast<std::size_t>(dataSize));
+            return region;
+        }
+    }
+
+    /* Create dedicated staging buffer that is released when the current batch has been completed */
+    VkBufferCreateInfo createInfo;
+    BuildVkBufferCreateInfo(createInfo, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+    VKDeviceBuffer stagingBuffer
+    {
+        device_,
+        createInfo,
+        deviceMemoryMngr_,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    };
+
+    device_.WriteBuffer(stagingBuffer, data, dataSize);
+
+    region.buffer   = stagingBuffer.GetVkBuffer();
+    region.offset   = 0;
+    region.data     = nullptr;
+
+    if (!recording_)
+        BeginBatch();
+
+    currentBatch_.stagingBuffers.push_back(std::move(stagingBuffer));
+
+    return region;
+}
+
+VkBuffer VKUploadQueue::ScheduleReadback(VkDeviceSize dataSize, const ReadbackCallback& callback)
+{
+    /* Reclaim readback buffers of completed batches first */
+    RetireCompletedBatches();
+
+    Readback readback { AcquireReadbackBuffer(dataSize), dataSize, callback };
+
+    auto buffer = readback.buffer.bufferObj.GetVkBuffer();
+
+    if (!recording_)
+        BeginBatch();
+
+    currentBatch_.readbacks.push_back(std::move(readback));
+
+    return buffer;
+}
+
+VkCommandBuffer VKUploadQueue::GetCommandBuffer()
+{
+    if (!recording_)
+        BeginBatch();
+    return currentBatch_.commandBuffer;
+}
+
+VkCommandBuffer VKUploadQueue::GetSyncedCommandBuffer()
+{
+    if (!recording_)
+        BeginBatch();
+    else
+        RecordTransferBarrier(VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+    return currentBatch_.commandBuffer;
+}
+
+std::uint64_t VKUploadQueue::GetCurrentTicket() const
+{
+    return (recording_ ? currentBatch_.ticket : nextTicket_ - 1);
+}
+
+std::uint64_t VKUploadQueue::Flush()
+{
+    if (!recording_)
+        return nextTicket_ - 1;
+
+    /* Make results of all transfer commands available to all commands that are submitted after this batch */
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+    }
+    vkCmdPipelineBarrier(
+        currentBatch_.commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+
+    auto result = vkEndCommandBuffer(currentBatch_.commandBuffer);
+    VKThrowIfFailed(result, "failed to end recording Vulkan upload command buffer");
+
+    /* Submit command buffer to graphics queue without waiting for the fence */
+    VkSubmitInfo submitInfo = {};
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = (&currentBatch_.commandBuffer);
+    }
+    result = vkQueueSubmit(device_.GetVkQueue(), 1, &submitInfo, currentBatch_.fence->GetVkFence());
+    VKThrowIfFailed(result, "failed to submit Vulkan upload command buffer");
+
+    /* Move batch into list of batches in flight; its staging memory ends at the current head of the ring buffer */
+    const auto ticket = currentBatch_.ticket;
+
+    currentBatch_.ringMarker = ringBuffer_.GetHead();
+    batchesInFlight_.push_back(std::move(currentBatch_));
+
+    currentBatch_ = Batch{};
+    recording_ = false;
+    dstBuffers_.clear();
+
+    return ticket;
+}
+
+bool VKUploadQueue::IsComplete(std::uint64_t ticket)
+{
+    RetireCompletedBatches();
+    return (ticket <= completedTicket_);
+}
+
+void VKUploadQueue::Wait(std::uint64_t ticket)
+{
+    if (recording_ && ticket >= currentBatch_.ticket)
+        Flush();
+    while (completedTicket_ < ticket && !batchesInFlight_.empty())
+        RetireOldestBatch();
+}
+
+void VKUploadQueue::WaitIdle()
+{
+    Flush();
+    while (!batchesInFlight_.empty())
+        RetireOldestBatch();
+}
+
+void VKUploadQueue::Poll()
+{
+    RetireCompletedBatches();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKUploadQueue::BeginBatch()
+{
+    if (!freeBatches_.empty())
+    {
+        /* Recycle command buffer and fence of a completed batch */
+        currentBatch_ = std::move(freeBatches_.back());
+        freeBatches_.pop_back();
+        currentBatch_.fence->Reset(device_);
+    }
+    else
+    {
+        /* Allocate new command buffer and fence */
+        VkCommandBufferAllocateInfo allocInfo;
+        {
+            allocInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.pNext                = nullptr;
+            allocInfo.commandPool          = commandPool_;
+            allocInfo.level                = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount   = 1;
+        }
+        auto result = vkAllocateCommandBuffers(device_, &allocInfo, &(currentBatch_.commandBuffer));
+        VKThrowIfFailed(result, "failed to allocate Vulkan upload command buffer");
+
+        currentBatch_.fence = MakeUnique<VKFence>(device_.GetVkDevice());
+    }
+
+    /* Begin command buffer recording; this implicitly resets a recycled command buffer */
+    VkCommandBufferBeginInfo beginInfo;
+    {
+        beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext             = nullptr;
+        beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo  = nullptr;
+    }
+    auto result = vkBeginCommandBuffer(currentBatch_.commandBuffer, &beginInfo);
+    VKThrowIfFailed(result, "failed to begin recording Vulkan upload command buffer");
+
+    /* Wait for all previously submitted commands before transfer commands overwrite resources they might still read */
+    vkCmdPipelineBarrier(
+        currentBatch_.commandBuffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        0, nullptr,
+        0, nullptr,
+        0, nullptr
+    );
+
+    currentBatch_.ticket = nextTicket_++;
+    recording_ = true;
+}
+
+void VKUploadQueue::SyncDstBuffer(VkBuffer dstBuffer)
+{
+    if (!dstBuffers_.insert(dstBuffer).second)
+    {
+        /* Copy commands are not ordered within a command buffer, so consecutive writes to the same buffer require a barrier */
+        RecordTransferBarrier(VK_ACCESS_TRANSFER_WRITE_BIT);
+        dstBuffers_.insert(dstBuffer);
+    }
+}
+
+void VKUploadQueue::RecordTransferBarrier(VkAccessFlags dstAccessMask)
+{
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = dstAccessMask;
+    }
+    vkCmdPipelineBarrier(
+        currentBatch_.commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+
+    dstBuffers_.clear();
+}
+
+void VKUploadQueue::RetireCompletedBatches()
+{
+    while (!batchesInFlight_.empty() && vkGetFenceStatus(device_, batchesInFlight_.front().fence->GetVkFence()) == VK_SUCCESS)
+        RetireOldestBatch();
+}
+
+void VKUploadQueue::RetireOldestBatch()
+{
+    batchesInFlight_.front().fence->Wait(device_, std::numeric_limits<std::uint64_t>::max());
+
+    /* Remove batch from queue before it is retired, since readback callbacks might schedule new batches */
+    auto batch = std::move(batchesInFlight_.front());
+    batchesInFlight_.pop_front();
+
+    RetireBatch(batch);
+}
+
+void VKUploadQueue::RetireBatch(Batch& batch)
+{
+    /* Batches are retired in submission order, so all ring buffer allocations up to this batch can be released */
+    ringBuffer_.Release(batch.ringMarker);
+
+    for (auto& stagingBuffer : batch.stagingBuffers)
+        stagingBuffer.ReleaseMemoryRegion(deviceMemoryMngr_);
+    batch.stagingBuffers.clear();
+    batch.releasedObjects.clear();
+
+    completedTicket_ = batch.ticket;
+
+    /* Pass mapped readback memory to each callback, then return readback buffers to the pool */
+    auto readbacks = std::move(batch.readbacks);
+    batch.readbacks.clear();
+
+    freeBatches_.push_back(std::move(batch));
+
+    for (auto& readback : readbacks)
+    {
+        if (auto data = readback.buffer.bufferObj.Map(device_))
+        {
+            readback.callback(data, readback.dataSize);
+            readback.buffer.bufferObj.Unmap(device_);
+        }
+        RecycleReadbackBuffer(std::move(readback.buffer));
+    }
+}
+
+VKUploadQueue::ReadbackBuffer VKUploadQueue::AcquireReadbackBuffer(VkDeviceSize size)
+{
+    /* Find smallest pooled buffer that is large enough */
+    auto bestFit = readbackBufferPool_.end();
+
+    for (auto it = readbackBufferPool_.begin(); it != readbackBufferPool_.end(); ++it)
+    {
+        if (it->size >= size && (bestFit == readbackBufferPool_.end() || it->size < bestFit->size))
+            bestFit = it;
+    }
+
+    if (bestFit != readbackBufferPool_.end())
+    {
+        auto buffer = std::move(*bestFit);
+        readbackBufferPool_.erase(bestFit);
+        return buffer;
+    }
+
+    /* Create new readback buffer with a power-of-two size, so it can be reused for similar sizes */
+    VkDeviceSize bufferSize = g_minReadbackBufferSize;
+    while (bufferSize < size)
+        bufferSize *= 2;
+
+    VkBufferCreateInfo createInfo;
+    BuildVkBufferCreateInfo(createInfo, bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    ReadbackBuffer buffer
+    {
+        VKDeviceBuffer
+        {
+            device_,
+            createInfo,
+            deviceMemoryMngr_,
+            (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+        },
+        bufferSize
+    };
+
+    return buffer;
+}
+
+void VKUploadQueue::RecycleReadbackBuffer(ReadbackBuffer&& buffer)
+{
+    if (readbackBufferPool_.size() < g_maxNumPooledReadbackBuffers)
+        readbackBufferPool_.push_back(std::move(buffer));
+    else
+        buffer.bufferObj.ReleaseMemoryRegion(deviceMemoryMngr_);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,191 @@
+/*
+ * VKUploadQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_UPLOAD_QUEUE_H
+#define LLGL_VK_UPLOAD_QUEUE_H
+
+
+#include "VKDevice.h"
+#include "Buffer/VKStagingRingBuffer.h"
+#include "RenderState/VKFence.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class VKDeviceMemoryManager;
+
+/*
+Batches transfer commands for buffer and texture uploads into a single command buffer, which is submitted without blocking the CPU.
+Source data is copied into a persistent staging ring buffer; each batch reclaims its ring buffer space once its fence has been signaled.
+Each batch is identified by a ticket, i.e. a monotonically increasing number starting at 1.
+All transfer commands are complete before any commands that are submitted to the graphics queue after the batch.
+Batches can also read back data into pooled host visible buffers, which are passed to a callback once the batch has been completed.
+*/
+class VKUploadQueue
+{
+
+    public:
+
+        // Callback for scheduled readbacks, which receives the mapped readback memory once the respective batch has been completed.
+        using ReadbackCallback = std::function<void(const void* data, VkDeviceSize dataSize)>;
+
+    public:
+
+        VKUploadQueue(
+            VKDevice&                               device,
+            VKDeviceMemoryManager&                  deviceMemoryMngr,
+            const VkPhysicalDeviceMemoryProperties& memoryProperties,
+            VkDeviceSize                            ringBufferSize
+        );
+        ~VKUploadQueue();
+
+        VKUploadQueue(const VKUploadQueue&) = delete;
+        VKUploadQueue& operator = (const VKUploadQueue&) = delete;
+
+        // Copies the data into staging memory and records a copy command into the destination buffer. Returns the ticket of the batch.
+        std::uint64_t WriteBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize);
+
+        /*
+        Copies the data into staging memory that stays valid until the current batch has been completed.
+        Data that exceeds half the ring buffer size is copied into a dedicated staging buffer instead.
+        The caller is responsible to record the respective transfer commands into the command buffer returned by 'GetCommandBuffer',
+        which must be queried after this call since the current batch might be submitted to reclaim staging memory.
+        */
+        VKStagingRegion StageData(const void* data, VkDeviceSize dataSize, VkDeviceSize alignment = 1);
+
+        /*
+        Returns a host visible buffer of at least the specified size from the readback buffer pool, which is bound to the current batch.
+        The caller is responsible to record the respective transfer commands into the command buffer returned by 'GetCommandBuffer'.
+        Once the batch has been completed, the callback is invoked with the mapped buffer memory, and the buffer is returned to the pool.
+        */
+        VkBuffer ScheduleReadback(VkDeviceSize dataSize, const ReadbackCallback& callback);
+
+        // Records a copy command from the source into the destination buffer. Returns the ticket of the batch.
+        std::uint64_t CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+
+        // Keeps the specified buffer alive until the current batch has been completed, then releases it together with its device memory region.
+        void ReleaseAfterBatch(VKDeviceBuffer&& buffer);
+
+        /*
+        Keeps the specified object alive until the current batch has been completed, then destroys it.
+        Since the batch is submitted after all previously submitted command buffers, this defers the destruction of resources that are still used by frames in flight.
+        */
+        void ReleaseAfterBatch(std::shared_ptr<void>&& object);
+
+        // Returns the command buffer of the current batch and begins a new batch if there is none.
+        VkCommandBuffer GetCommandBuffer();
+
+        // Returns the command buffer of the current batch like 'GetCommandBuffer', after recording a barrier that makes all previous transfer writes of the batch visible to subsequent transfer commands.
+        VkCommandBuffer GetSyncedCommandBuffer();
+
+        // Returns the ticket of the current batch, or of the last submitted batch if there is no current batch.
+        std::uint64_t GetCurrentTicket() const;
+
+        // Submits the current batch to the graphics queue without waiting for its completion, and returns its ticket.
+        std::uint64_t Flush();
+
+        // Returns true if the batch with the specified ticket has been completed.
+        bool IsComplete(std::uint64_t ticket);
+
+        // Blocks until the batch with the specified ticket has been completed. The current batch is submitted first if necessary.
+        void Wait(std::uint64_t ticket);
+
+        // Blocks until all batches have been completed.
+        void WaitIdle();
+
+        // Retires all batches that have been completed without blocking, and invokes their readback callbacks.
+        void Poll();
+
+    private:
+
+        struct ReadbackBuffer
+        {
+            VKDeviceBuffer              bufferObj;
+            VkDeviceSize                size;
+        };
+
+        struct Readback
+        {
+            ReadbackBuffer              buffer;
+            VkDeviceSize                dataSize;
+            ReadbackCallback            callback;
+        };
+
+        struct Batch
+        {
+            VkCommandBuffer                     commandBuffer   = VK_NULL_HANDLE;
+            std::unique_ptr<VKFence>            fence;
+            std::uint64_t                       ticket          = 0;
+            VkDeviceSize                        ringMarker      = 0;
+            std::vector<VKDeviceBuffer>         stagingBuffers;                 // Dedicated staging buffers and relocated buffers that are released with the batch
+            std::vector<Readback>               readbacks;
+            std::vector<std::shared_ptr<void>>  releasedObjects;                // Resource objects whose destruction has been deferred until the batch has been completed
+        };
+
+    private:
+
+        // Begins a new batch with a recycled or newly allocated command buffer.
+        void BeginBatch();
+
+        // Records a barrier between transfer commands, if the destination buffer has already been written in the current batch.
+        void SyncDstBuffer(VkBuffer dstBuffer);
+
+        // Records a barrier that makes all previous transfer writes of the current batch available to the specified access types.
+        void RecordTransferBarrier(VkAccessFlags dstAccessMask);
+
+        // Retires all batches whose fences have been signaled.
+        void RetireCompletedBatches();
+
+        // Waits for the oldest batch in flight and retires it.
+        void RetireOldestBatch();
+
+        // Releases the staging memory of the specified batch, invokes its readback callbacks, and moves it into the list of free batches.
+        void RetireBatch(Batch& batch);
+
+        // Returns the smallest pooled readback buffer with at least the specified size, or creates a new one.
+        ReadbackBuffer AcquireReadbackBuffer(VkDeviceSize size);
+
+        // Returns the specified readback buffer to the pool, or releases it if the pool is full.
+        void RecycleReadbackBuffer(ReadbackBuffer&& buffer);
+
+    private:
+
+        VKDevice&                       device_;
+        VKDeviceMemoryManager&          deviceMemoryMngr_;
+        VKPtr<VkCommandPool>            commandPool_;
+        VKStagingRingBuffer             ringBuffer_;
+
+        Batch                           currentBatch_;
+        bool                            recording_          = false;
+        std::set<VkBuffer>              dstBuffers_;                    // Destination buffers that have been written since the last transfer barrier
+
+        std::deque<Batch>               batchesInFlight_;
+        std::vector<Batch>              freeBatches_;
+        std::vector<ReadbackBuffer>     readbackBufferPool_;
+
+        std::uint64_t                   nextTicket_         = 1;
+        std::uint64_t                   completedTicket_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,7 +6,10 @@
  */
 
 #include <LLGL/Image.h>
+#include <LLGL/Constants.h>
 #include <iostream>
+#include <algorithm>
+#include <string>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -108,6 +111,75 @@ void Test_Resize()
     SaveImagePNG(img1, "Output/img1-resize-smaller.png");
 }
 
+void Test_ResizeFiltered()
+{
+    const std::pair<LLGL::ResampleFilter, const char*> filters[] =
+    {
+        { LLGL::ResampleFilter::Nearest, "nearest" },
+        { LLGL::ResampleFilter::Box,     "box"     },
+        { LLGL::ResampleFilter::Linear,  "linear"  },
+        { LLGL::ResampleFilter::Lanczos, "lanczos" },
+        { LLGL::ResampleFilter::Kaiser,  "kaiser"  },
+    };
+
+    for (const auto& filter : filters)
+    {
+        auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+        img1.Resize(LLGL::Extent3D { 100, 75, 1 }, filter.first, LLGL::Constants::maxThreadCount);
+        SaveImagePNG(img1, std::string("Output/img1-resize-") + filter.second + "-smaller.png");
+
+        img1.Resize(LLGL::Extent3D { 600, 450, 1 }, filter.first, LLGL::Constants::maxThreadCount);
+        SaveImagePNG(img1, std::string("Output/img1-resize-") + filter.second + "-larger.png");
+    }
+}
+
+void Test_MipChain()
+{
+    const std::pair<LLGL::ResampleFilter, const char*> filters[] =
+    {
+        { LLGL::ResampleFilter::Box,    "box"    },
+        { LLGL::ResampleFilter::Kaiser, "kaiser" },
+    };
+
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+    const auto& extent      = img1.GetExtent();
+    const auto numMipLevels = LLGL::NumMipLevels(extent.width, extent.height);
+
+    for (const auto& filter : filters)
+    {
+        for (int sRGB = 0; sRGB < 2; ++sRGB)
+        {
+            LLGL::MipChainDescriptor mipChainDesc;
+            {
+                mipChainDesc.filter = filter.first;
+                mipChainDesc.sRGB   = (sRGB != 0);
+            }
+            auto mipChain = img1.GenerateMipChain(mipChainDesc, LLGL::Constants::maxThreadCount);
+
+            /* Save each MIP-map level from its offset within the MIP-map chain */
+            for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+            {
+                const LLGL::Extent3D mipExtent
+                {
+                    std::max(1u, extent.width  >> mipLevel),
+                    std::max(1u, extent.height >> mipLevel),
+                    1u
+                };
+
+                LLGL::Image mipImage { mipExtent, img1.GetFormat(), img1.GetDataType() };
+                ::memcpy(mipImage.GetData(), mipChain.get() + img1.GetMipChainOffset(mipLevel), mipImage.GetDataSize());
+
+                SaveImagePNG(
+                    mipImage,
+                    std::string("Output/img1-mip-") + filter.second + (sRGB != 0 ? "-srgb-" : "-") + std::to_string(mipLevel) + ".png"
+                );
+            }
+        }
+    }
+}
+
 int main(int argc, char* argv[])
 {
     try
@@ -115,6 +187,8 @@ int main(int argc, char* argv[])
         //Test_PixelOperations();
         //Test_Blit();
         Test_Resize();
+        Test_ResizeFiltered();
+        Test_MipChain();
     }
     catch (const std::exception& e)
     {
@@ -0,0 +1,206 @@
+/*
+ * Test_ImageConversion.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include "../sources/Core/ImageConversionKernels.h"
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+
+// Compares the kernel for the specified SIMD features bit by bit with the scalar kernel.
+template <typename TSrc, typename TDst>
+bool TestKernel(
+    const char*                 name,
+    LLGL::ImageConversionKernel kernel,
+    LLGL::ImageConversionKernel scalarKernel,
+    const std::vector<TSrc>&    src,
+    std::size_t                 dstPerElement,
+    std::size_t                 numElements)
+{
+    if (kernel == nullptr || scalarKernel == nullptr)
+        return true;
+
+    /* Convert ranges with odd offsets and lengths to cover the scalar tails */
+    const std::size_t ranges[][2] =
+    {
+        { 0, numElements },
+        { 1, numElements },
+        { 3, numElements - 5 },
+    };
+
+    for (const auto& range : ranges)
+    {
+        std::vector<TDst> dst(numElements * dstPerElement, TDst(0)), dstRef(numElements * dstPerElement, TDst(0));
+
+        kernel(src.data(), dst.data(), range[0], range[1]);
+        scalarKernel(src.data(), dstRef.data(), range[0], range[1]);
+
+        if (std::memcmp(dst.data(), dstRef.data(), dst.size() * sizeof(TDst)) != 0)
+        {
+            std::cerr << "mismatch in kernel: " << name << " [" << range[0] << ", " << range[1] << ")" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TestKernels(long features)
+{
+    using namespace LLGL;
+
+    bool result = true;
+
+    /* UInt8 -> Float32 (all values) */
+    {
+        std::vector<std::uint8_t> src(256 * 3 + 7);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<std::uint8_t>(i * 7);
+
+        result &= TestKernel<std::uint8_t, float>(
+            "UInt8 -> Float32",
+            FindDataTypeConversionKernel(DataType::UInt8, DataType::Float32, features),
+            FindDataTypeConversionKernel(DataType::UInt8, DataType::Float32, 0),
+            src, 1, src.size()
+        );
+    }
+
+    /* Float32 -> UInt8 (range [0, 1]) */
+    {
+        std::vector<float> src(4099);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<float>(i) / static_cast<float>(src.size() - 1);
+
+        result &= TestKernel<float, std::uint8_t>(
+            "Float32 -> UInt8",
+            FindDataTypeConversionKernel(DataType::Float32, DataType::UInt8, features),
+            FindDataTypeConversionKernel(DataType::Float32, DataType::UInt8, 0),
+            src, 1, src.size()
+        );
+    }
+
+    /* Float32 -> Float16 (strided bit patterns, including subnormals, overflows, infinities, and NaNs) */
+    {
+        std::vector<float> src;
+        for (std::uint64_t bits = 0; bits <= 0xFFFFFFFFull; bits += 0x1003F)
+        {
+            auto value = static_cast<std::uint32_t>(bits);
+            float f;
+            std::memcpy(&f, &value, sizeof(f));
+            src.push_back(f);
+        }
+
+        result &= TestKernel<float, std::uint16_t>(
+            "Float32 -> Float16",
+            FindDataTypeConversionKernel(DataType::Float32, DataType::Float16, features),
+            FindDataTypeConversionKernel(DataType::Float32, DataType::Float16, 0),
+            src, 1, src.size()
+        );
+    }
+
+    /* Float16 -> Float32 (all values) */
+    {
+        std::vector<std::uint16_t> src(65536 + 5);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<std::uint16_t>(i);
+
+        result &= TestKernel<std::uint16_t, float>(
+            "Float16 -> Float32",
+            FindDataTypeConversionKernel(DataType::Float16, DataType::Float32, features),
+            FindDataTypeConversionKernel(DataType::Float16, DataType::Float32, 0),
+            src, 1, src.size()
+        );
+    }
+
+    /* RGB -> RGBA (UInt8) */
+    {
+        const std::size_t numPixels = 1027;
+        std::vector<std::uint8_t> src(numPixels * 3);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<std::uint8_t>(i * 13);
+
+        result &= TestKernel<std::uint8_t, std::uint8_t>(
+            "RGB -> RGBA (UInt8)",
+            FindFormatConversionKernel(ImageFormat::RGB, ImageFormat::RGBA, DataType::UInt8, features),
+            FindFormatConversionKernel(ImageFormat::RGB, ImageFormat::RGBA, DataType::UInt8, 0),
+            src, 4, numPixels
+        );
+    }
+
+    /* RGB -> RGBA (Float32) */
+    {
+        const std::size_t numPixels = 1027;
+        std::vector<float> src(numPixels * 3);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<float>(i) * 0.25f;
+
+        result &= TestKernel<float, float>(
+            "RGB -> RGBA (Float32)",
+            FindFormatConversionKernel(ImageFormat::RGB, ImageFormat::RGBA, DataType::Float32, features),
+            FindFormatConversionKernel(ImageFormat::RGB, ImageFormat::RGBA, DataType::Float32, 0),
+            src, 4, numPixels
+        );
+    }
+
+    /* BGRA -> RGBA (UInt8) */
+    {
+        const std::size_t numPixels = 1027;
+        std::vector<std::uint8_t> src(numPixels * 4);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<std::uint8_t>(i * 11);
+
+        result &= TestKernel<std::uint8_t, std::uint8_t>(
+            "BGRA -> RGBA (UInt8)",
+            FindFormatConversionKernel(ImageFormat::BGRA, ImageFormat::RGBA, DataType::UInt8, features),
+            FindFormatConversionKernel(ImageFormat::BGRA, ImageFormat::RGBA, DataType::UInt8, 0),
+            src, 4, numPixels
+        );
+    }
+
+    return result;
+}
+
+
+int main()
+{
+    using LLGL::SIMDFeatures;
+
+    const struct
+    {
+        long        feature;
+        const char* name;
+    }
+    features[] =
+    {
+        { SIMDFeatures::SSE2,  "SSE2"  },
+        { SIMDFeatures::SSSE3, "SSSE3" },
+        { SIMDFeatures::AVX2,  "AVX2"  },
+        { SIMDFeatures::F16C,  "F16C"  },
+        { SIMDFeatures::NEON,  "NEON"  },
+    };
+
+    const auto supportedFeatures = LLGL::GetSIMDFeatures();
+
+    bool result = true;
+
+    for (const auto& f : features)
+    {
+        if ((supportedFeatures & f.feature) != 0)
+        {
+            /* Test each instruction set on its own, since the widest one would hide the others */
+            const bool passed = TestKernels(f.feature);
+            std::cout << f.name << ": " << (passed ? "passed" : "failed") << std::endl;
+            result &= passed;
+        }
+        else
+            std::cout << f.name << ": not supported" << std::endl;
+    }
+
+    return (result ? 0 : 1);
+}
@@ -0,0 +1,307 @@
+/*
+ * Test_MultiThreading.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+
+struct TestConfig
+{
+    std::size_t     maxNumThreads       = 16;
+    std::size_t     numCmdBuffers       = 64;
+    std::size_t     numCommands         = 20000;
+    std::size_t     numRuns             = 5;
+};
+
+class MultiThreadingTest
+{
+
+    private:
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+        LLGL::RenderContext*                context         = nullptr;
+        LLGL::CommandQueue*                 commandQueue    = nullptr;
+        LLGL::CommandBuffer*                primaryCmdBuffer = nullptr;
+        std::vector<LLGL::CommandBuffer*>   secondaryCmdBuffers;
+        LLGL::Buffer*                       vertexBuffer    = nullptr;
+        LLGL::GraphicsPipeline*             pipeline        = nullptr;
+
+        TestConfig                          config;
+
+    private:
+
+        void RecordSecondaryCmdBuffer(LLGL::CommandBuffer& cmdBuffer)
+        {
+            const auto resolution = context->GetVideoMode().resolution;
+
+            cmdBuffer.Begin();
+            {
+                cmdBuffer.SetGraphicsPipeline(*pipeline);
+
+                /* Draw after each state change, so the states are consumed and only the redundant vertex buffer bindings can be removed */
+                for (std::size_t i = 0; i < config.numCommands; ++i)
+                {
+                    const auto offset = static_cast<std::int32_t>(i % 16);
+                    cmdBuffer.SetViewport(LLGL::Viewport{ static_cast<float>(offset), 0.0f, 320.0f, 240.0f });
+                    cmdBuffer.SetScissor(LLGL::Scissor{ offset, 0, static_cast<std::int32_t>(resolution.width), static_cast<std::int32_t>(resolution.height) });
+                    cmdBuffer.SetVertexBuffer(*vertexBuffer);
+                    cmdBuffer.Draw(3, 0);
+                }
+            }
+            cmdBuffer.End();
+        }
+
+        // Returns the number of commands that are recorded into each secondary command buffer.
+        std::size_t NumCommandsPerCmdBuffer() const
+        {
+            return (1 + config.numCommands * 4);
+        }
+
+        // Records all secondary command buffers with the specified number of threads and returns the elapsed time (in milliseconds).
+        double RecordSecondaryCmdBuffers(std::size_t numThreads)
+        {
+            const auto startTime = std::chrono::high_resolution_clock::now();
+
+            std::vector<std::thread> workerThreads;
+            workerThreads.reserve(numThreads);
+
+            for (std::size_t i = 0; i < numThreads; ++i)
+            {
+                workerThreads.emplace_back(
+                    [this, i, numThreads]()
+                    {
+                        /* Each thread records every n-th command buffer */
+                        for (auto j = i; j < secondaryCmdBuffers.size(); j += numThreads)
+                            RecordSecondaryCmdBuffer(*secondaryCmdBuffers[j]);
+                    }
+                );
+            }
+
+            for (auto& thread : workerThreads)
+                thread.join();
+
+            const auto endTime = std::chrono::high_resolution_clock::now();
+
+            return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        }
+
+        // Records the primary command buffer that executes all secondary command buffers and returns the elapsed time (in milliseconds).
+        double RecordPrimaryCmdBuffer()
+        {
+            const auto startTime = std::chrono::high_resolution_clock::now();
+
+            primaryCmdBuffer->Begin();
+            {
+                primaryCmdBuffer->BeginRenderPass(*context);
+                {
+                    for (auto cmdBuffer : secondaryCmdBuffers)
+                        primaryCmdBuffer->Execute(*cmdBuffer);
+                }
+                primaryCmdBuffer->EndRenderPass();
+            }
+            primaryCmdBuffer->End();
+
+            const auto endTime = std::chrono::high_resolution_clock::now();
+
+            return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        }
+
+    public:
+
+        void Load(const std::string& rendererModule, const TestConfig& testConfig, LLGL::RenderingProfiler* profiler = nullptr)
+        {
+            // Store test configuration
+            config = testConfig;
+
+            // Load renderer (with the debug layer if a profiler is specified)
+            renderer = LLGL::RenderSystem::Load(rendererModule, profiler);
+
+            // Create render context
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution = { 640, 480 };
+            }
+            context = renderer->CreateRenderContext(contextDesc);
+            commandQueue = renderer->GetCommandQueue();
+
+            // Create vertex buffer
+            LLGL::VertexFormat vertexFormat;
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+            const float vertices[] = { 0, 0, 1, 0, 1, 1 };
+
+            LLGL::BufferDescriptor vertexBufferDesc;
+            {
+                vertexBufferDesc.size                   = sizeof(vertices);
+                vertexBufferDesc.bindFlags              = LLGL::BindFlags::VertexBuffer;
+                vertexBufferDesc.vertexBuffer.format    = vertexFormat;
+            }
+            vertexBuffer = renderer->CreateBuffer(vertexBufferDesc, vertices);
+
+            // Create shader program
+            LLGL::ShaderDescriptor vertShaderDesc;
+            {
+                vertShaderDesc.type         = LLGL::ShaderType::Vertex;
+                vertShaderDesc.source       =
+                    "#version 130\n"
+                    "in vec2 position;\n"
+                    "void main() {\n"
+                    "    gl_Position = vec4(position, 0.0, 1.0);\n"
+                    "}\n";
+                vertShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+            }
+            auto vertShader = renderer->CreateShader(vertShaderDesc);
+
+            LLGL::ShaderDescriptor fragShaderDesc;
+            {
+                fragShaderDesc.type         = LLGL::ShaderType::Fragment;
+                fragShaderDesc.source       =
+                    "#version 130\n"
+                    "out vec4 fragColor;\n"
+                    "void main() {\n"
+                    "    fragColor = vec4(1.0);\n"
+                    "}\n";
+                fragShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+            }
+            auto fragShader = renderer->CreateShader(fragShaderDesc);
+
+            for (auto shader : { vertShader, fragShader })
+            {
+                if (shader->HasErrors())
+                    std::cerr << shader->QueryInfoLog() << std::endl;
+            }
+
+            LLGL::ShaderProgramDescriptor shaderProgramDesc;
+            {
+                shaderProgramDesc.vertexFormats     = { vertexFormat };
+                shaderProgramDesc.vertexShader      = vertShader;
+                shaderProgramDesc.fragmentShader    = fragShader;
+            }
+            auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+            // Create graphics pipeline with dynamic viewports and scissors
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram                  = shaderProgram;
+                pipelineDesc.rasterizer.scissorTestEnabled  = true;
+            }
+            pipeline = renderer->CreateGraphicsPipeline(pipelineDesc);
+
+            // Create primary and secondary command buffers (GL stitches secondary command buffers by reference only into MultiSubmit primaries)
+            LLGL::CommandBufferDescriptor cmdBufferDesc;
+            {
+                cmdBufferDesc.flags = LLGL::CommandBufferFlags::MultiSubmit;
+            }
+            primaryCmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
+
+            cmdBufferDesc.flags = (LLGL::CommandBufferFlags::DeferredSubmit | LLGL::CommandBufferFlags::MultiSubmit);
+            for (std::size_t i = 0; i < config.numCmdBuffers; ++i)
+                secondaryCmdBuffers.push_back(renderer->CreateCommandBuffer(cmdBufferDesc));
+        }
+
+        void Run()
+        {
+            std::cout << std::endl << "record " << config.numCmdBuffers << " secondary command buffers with " << config.numCommands << " iterations each ..." << std::endl;
+            std::cout << std::fixed << std::setprecision(3);
+
+            double baseTime = 0.0;
+
+            for (std::size_t numThreads = 1; numThreads <= config.maxNumThreads; numThreads *= 2)
+            {
+                // Take the best time of all runs
+                double recordTime = 0.0, mergeTime = 0.0;
+                for (std::size_t run = 0; run < config.numRuns; ++run)
+                {
+                    const auto t0 = RecordSecondaryCmdBuffers(numThreads);
+                    const auto t1 = RecordPrimaryCmdBuffer();
+                    if (run == 0 || t0 < recordTime)
+                        recordTime = t0;
+                    if (run == 0 || t1 < mergeTime)
+                        mergeTime = t1;
+                }
+
+                if (numThreads == 1)
+                    baseTime = recordTime;
+
+                std::cout << "threads: " << std::setw(2) << numThreads;
+                std::cout << ", record: " << std::setw(10) << recordTime << "ms";
+                std::cout << ", merge: " << std::setw(8) << mergeTime << "ms";
+                std::cout << ", speedup: " << (baseTime / recordTime) << "x" << std::endl;
+
+                // Replay merged command buffer once
+                commandQueue->Submit(*primaryCmdBuffer);
+                context->Present();
+            }
+        }
+
+        // Records and replays the merged command buffer once, and prints the number of commands that have been stitched into it.
+        void Verify(LLGL::RenderingProfiler& profiler)
+        {
+            RecordSecondaryCmdBuffers(1);
+            RecordPrimaryCmdBuffer();
+
+            profiler.NextProfile();
+            commandQueue->Submit(*primaryCmdBuffer);
+            context->Present();
+
+            LLGL::FrameProfile profile;
+            profiler.NextProfile(&profile);
+
+            /* Commands that have been removed as redundant state changes are not stitched into the primary command buffer */
+            const auto numRecordedCommands = NumCommandsPerCmdBuffer() * config.numCmdBuffers;
+            const auto numStitchedCommands = numRecordedCommands - profile.redundantStateEliminations;
+
+            std::cout << std::endl;
+            std::cout << "draw commands:            " << profile.drawCommands << " (expected " << config.numCommands * config.numCmdBuffers << ")" << std::endl;
+            std::cout << "recorded commands:        " << numRecordedCommands << std::endl;
+            std::cout << "redundant state commands: " << profile.redundantStateEliminations << std::endl;
+            std::cout << "stitched commands:        " << numStitchedCommands << std::endl;
+        }
+
+};
+
+int main(int argc, char* argv[])
+{
+    std::string rendererModule = "OpenGL";
+    if (argc > 1)
+        rendererModule = argv[1];
+
+    TestConfig testConfig;
+
+    try
+    {
+        {
+            MultiThreadingTest test;
+            test.Load(rendererModule, testConfig);
+            test.Run();
+        }
+
+        // Count the stitched commands in a separate run with the debug layer, which would distort the measured times
+        LLGL::RenderingProfiler profiler;
+        MultiThreadingTest test;
+        test.Load(rendererModule, testConfig, &profiler);
+        test.Verify(profiler);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
+
+
+
+// ================================================================================
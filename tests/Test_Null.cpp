@@ -0,0 +1,108 @@
+/*
+ * Test_Null.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <vector>
+
+
+int main()
+{
+    try
+    {
+        // Load headless render system module
+        auto renderer = LLGL::RenderSystem::Load("Null");
+
+        std::cout << "LLGL Renderer: " << renderer->GetName() << std::endl;
+
+        // Create render context without a native window
+        LLGL::RenderContextDescriptor contextDesc;
+        {
+            contextDesc.videoMode.resolution = { 64, 64 };
+        }
+        renderer->CreateRenderContext(contextDesc);
+
+        // Create buffer with initial data and read it back
+        const float vertices[] = { 1.0f, 2.0f, 3.0f, 4.0f };
+
+        LLGL::BufferDescriptor bufferDesc;
+        {
+            bufferDesc.size         = sizeof(vertices);
+            bufferDesc.bindFlags    = LLGL::BindFlags::VertexBuffer;
+        }
+        auto buffer = renderer->CreateBuffer(bufferDesc, vertices);
+
+        if (auto mappedBuffer = reinterpret_cast<const float*>(renderer->MapBuffer(*buffer, LLGL::CPUAccess::ReadOnly)))
+            std::cout << "buffer content: " << mappedBuffer[0] << ", " << mappedBuffer[1] << ", " << mappedBuffer[2] << ", " << mappedBuffer[3] << std::endl;
+        renderer->UnmapBuffer(*buffer);
+
+        // Create render target with a single color attachment
+        LLGL::TextureDescriptor texDesc;
+        {
+            texDesc.type        = LLGL::TextureType::Texture2D;
+            texDesc.format      = LLGL::Format::RGBA8UNorm;
+            texDesc.extent      = { 4, 4, 1 };
+            texDesc.bindFlags   = LLGL::BindFlags::ColorAttachment;
+        }
+        auto texture = renderer->CreateTexture(texDesc);
+
+        LLGL::RenderTargetDescriptor renderTargetDesc;
+        {
+            renderTargetDesc.resolution     = { 4, 4 };
+            renderTargetDesc.attachments    = { LLGL::AttachmentDescriptor { LLGL::AttachmentType::Color, texture } };
+        }
+        auto renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+        // Record clear and draw commands
+        LLGL::QueryHeapDescriptor queryDesc;
+        {
+            queryDesc.type = LLGL::QueryType::PipelineStatistics;
+        }
+        auto query = renderer->CreateQueryHeap(queryDesc);
+
+        auto commandQueue = renderer->GetCommandQueue();
+        auto commands = renderer->CreateCommandBuffer();
+
+        commands->Begin();
+        {
+            commands->SetClearColor({ 1.0f, 0.5f, 0.0f, 1.0f });
+            commands->BeginRenderPass(*renderTarget);
+            {
+                commands->Clear(LLGL::ClearFlags::Color);
+                commands->BeginQuery(*query);
+                commands->Draw(6, 0);
+                commands->EndQuery(*query);
+            }
+            commands->EndRenderPass();
+        }
+        commands->End();
+
+        commandQueue->Submit(*commands);
+
+        // Evaluate cleared texture
+        std::vector<std::uint8_t> image(4 * 4 * 4);
+        renderer->ReadTexture(*texture, 0, { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data(), image.size() });
+
+        std::cout << "texel[0] = (" << static_cast<int>(image[0]) << ", " << static_cast<int>(image[1]) << ", ";
+        std::cout << static_cast<int>(image[2]) << ", " << static_cast<int>(image[3]) << ")" << std::endl;
+
+        // Evaluate query result
+        LLGL::QueryPipelineStatistics stats;
+        if (commandQueue->QueryResult(*query, 0, 1, &stats, sizeof(stats)))
+            std::cout << "input assembly vertices: " << stats.inputAssemblyVertices << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}